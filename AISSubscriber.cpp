@@ -8,6 +8,10 @@
 #include <QRandomGenerator>
 #include "mainwindow.h"
 #include "SettingsManager.h"
+#include "nodefleet.h"
+#include <QVarLengthArray>
+#include <QPair>
+#include <limits>
 
 AISSubscriber::AISSubscriber(QObject* parent)
     : QObject(parent),
@@ -113,6 +117,9 @@ void AISSubscriber::connectToHost(const QString &host, quint16 port) {
     hasReceivedData = false;
     dataFlag = false;
 
+    // Sisa object setengah jadi dari koneksi lama tidak boleh tersambung ke stream baru
+    framer.reset();
+
     // Create new socket AFTER old one is cleaned up
     socket = new QTcpSocket(this);
 
@@ -199,7 +206,6 @@ void AISSubscriber::onReadyRead() {
     }
 
     QByteArray data = socket->readAll();
-    data = data.simplified().trimmed().replace("\r", "");
 
     // CONNECTION STATUS FLAG
     if (!hasReceivedData) {
@@ -224,39 +230,12 @@ void AISSubscriber::onReadyRead() {
     if (noDataTimer) noDataTimer->start();
 
     // === STREAMING JSON PARSER ===
-    // Append new data to buffer
-    bool wasEmpty = buffer.isEmpty();
-    buffer.append(data);
-
-    // Reset/start buffer timer for timeout detection
-    if (wasEmpty) {
-        bufferTimer.start();
-    }
-
-    // Try to find and process complete JSON objects
-    while (true) {
-        // Check if we should flush the buffer (invalid data)
-        if (shouldFlushBuffer(buffer)) {
-            qWarning() << "[AISSubscriber] Flushing invalid buffer:" << buffer.left(200);
-            buffer.clear();
-            bufferTimer.start();
-            break;
-        }
-
-        // Try to find a complete JSON object
-        int jsonEnd = findCompleteJSON(buffer);
-        if (jsonEnd <= 0) {
-            // No complete JSON found, wait for more data
-            break;
-        }
-
-        // Extract the complete JSON object
-        QByteArray json = buffer.left(jsonEnd);
-        buffer.remove(0, jsonEnd);
-
-        // Reset timer since we made progress
-        bufferTimer.start();
+    // Framer melanjutkan scan dari posisi terakhir; tidak ada rescan / memmove per object
+    const JsonStreamFramer::Stats before = framer.stats();
+    framer.append(data);
 
+    QByteArray json;
+    while (framer.next(json)) {
         // Parse and process the JSON
         QJsonParseError err;
         QJsonDocument doc = QJsonDocument::fromJson(json, &err);
@@ -266,205 +245,111 @@ void AISSubscriber::onReadyRead() {
             continue;
         }
 
-        QJsonObject obj = doc.object();
+        const QJsonObject obj = doc.object();
 
-        auto extractDouble = [&](const QString &key, std::function<void(double)> emitter) {
-            if (obj.contains(key)) {
-                QJsonValue val = obj[key];
-                if(!val.isNull()){
-                    double d = val.isDouble() ? val.toDouble() : val.toString().toDouble();
-                    emitter(d);
-                }
-            }
-        };
-
-        auto extractString = [&](const QString &key, std::function<void(QString)> emitter) {
-            if (obj.contains(key)) {
-                QJsonValue val = obj[key];
-                if(!val.isNull()){
-                    QString s = val.toString();
-                    emitter(s);
-                }
-            }
-        };
-
-        bool hasLat = false, hasLon = false;
-        bool hasAis = false;
-        double lat = 0.0, lon = 0.0, hog = 0.0, cog = 0.0, sog = 0.0, hdg = 0.0, dep = 0.0, spd = 0.0, yaw = 0.0, z = 0.0;
-        QString ais;
-
-        extractDouble("NAV_LAT", [&](double v){
-            if (v != 0.0){
-                lat = v;
-                hasLat = true;
-                emit navLatReceived(v);
-            }
-        });
+        // Satu kali jalan atas key object ini; field masuk ke snapshot, bukan signal per field
+        snapshot.clear();
+        QString mapInfoReq;
+        bool hasMapInfoReq = false;
+        QVarLengthArray<QPair<QString, QString>, 8> nodeReports;
 
-        extractDouble("NAV_LONG", [&](double v){
-            if (v != 0.0){
-                lon = v;
-                hasLon = true;
-                emit navLongReceived(v);
+        for (auto it = obj.constBegin(); it != obj.constEnd(); ++it) {
+            const QJsonValue val = it.value();
+            if (val.isNull()) {
+                continue;
             }
-        });
 
-        extractString("WAIS_NMEA", [&](QString v){
-            if (!v.isEmpty()){
-                ais = v;
-                hasAis = true;
-                emit waisNmeaReceived(v);
+            const QString key = it.key();
+            const NavKey navKey = lookupNavKey(key);
+
+            switch (navKey.kind) {
+            case NavKey::Value: {
+                const double d = val.isDouble() ? val.toDouble() : val.toString().toDouble();
+                // Posisi 0.0 dianggap belum ada fix
+                if (d == 0.0 && (navKey.slot == NavSnapshot::NavLat || navKey.slot == NavSnapshot::NavLong)) {
+                    break;
+                }
+                snapshot.set(NavSnapshot::Value(navKey.slot), d);
+                break;
             }
-        });
-
-        extractDouble("NAV_HEADING", [&](double v){
-            hdg = v;
-            emit navHeadingReceived(v);
-        });
-
-        extractDouble("NAV_HEADING_OVER_GROUND", [&](double v){
-            hog = v;
-            emit navHeadingOGReceived(v);
-        });
-
-        extractDouble("NAV_SOG", [&](double v){
-            sog = v;
-            emit navSOGReceived(v);
-        });
-
-        extractDouble("NAV_COG", [&](double v){
-            cog = v;
-            emit navCourseOGReceived(v);
-        });
-
-        extractString("NAV_LAT_DMS", [&](QString v){ emit navLatDmsReceived(v);});
-        extractString("NAV_LONG_DMS", [&](QString v){ emit navLongDmsReceived(v);});
-        extractString("NAV_LAT_DMM", [&](QString v){ emit navLatDmmReceived(v);});
-        extractString("NAV_LONG_DMM", [&](QString v){ emit navLongDmmReceived(v);});
-        extractString("NAV_NAME", [&](QString v){ emit navNameReceived(v);});
-
-        extractDouble("NAV_SPEED_OVER_GROUND", [=](double v){ emit navSpeedOGReceived(v);});
-        extractDouble("NAV_DEPTH", [=](double v){ emit navDepthReceived(v);});
-        extractDouble("NAV_SPEED", [=](double v){ emit navSpeedReceived(v);});
-        extractDouble("NAV_YAW", [=](double v){ emit navYawReceived(v);});
-        extractDouble("NAV_Z", [=](double v){ emit navZReceived(v);});
-        extractDouble("NAV_STW", [=](double v){ emit navStwReceived(v);});
-        extractDouble("NAV_DRIFT", [=](double v){ emit navDriftReceived(v);});
-        extractDouble("NAV_DRAFT", [=](double v){ emit navDraftReceived(v);});
-        extractDouble("NAV_DRIFT_ANGLE", [=](double v){ emit navDriftAngleReceived(v);});
-        extractDouble("NAV_SET", [=](double v){ emit navSetReceived(v);});
-        extractDouble("NAV_ROT", [=](double v){ emit navRotReceived(v);});
-        extractDouble("NAV_DEPTH_BELOW_KEEL", [=](double v){ emit navDepthBelowKeelReceived(v);});
-
-        extractString("NAV_DR", [=](QString v){ emit navDeadReckonReceived(v);});
-
-        extractString("MAP_INFO_REQ", [=](QString v){ emit mapInfoReqReceived(v);});
-
-        // NODE_NAME_ALL - Parse and store node names
-        extractString("NODE_NAME_ALL", [=](QString v){
-            if (!v.isEmpty()) {
-                // Parse the comma-separated node names
-                nodeNameList.clear();
-                QStringList names = v.split(',', Qt::SkipEmptyParts);
-                for (const QString &name : names) {
-                    nodeNameList.append(name.trimmed().toUpper());
+            case NavKey::Text: {
+                const QString v = val.toString();
+                if (v.isEmpty() && navKey.slot == NavSnapshot::WaisNmea) {
+                    break;
+                }
+                // Tidak muat di record: dibawa utuh lewat NavTextSpill, dihitung untuk log
+                if (!snapshot.set(NavSnapshot::Text(navKey.slot), v)) {
+                    ++spilledValues;
                 }
-                emit nodeNameAllReceived(v);
+                break;
             }
-        });
-
-        // Dynamic NODE_REPORT_* extraction based on NODE_NAME_ALL content
-        if (!nodeNameList.isEmpty()) {
-            for (const QString &nodeName : nodeNameList) {
-                QString nodeReportKey = "NODE_REPORT_" + nodeName;
-                extractString(nodeReportKey, [=](QString v){
-                    if (!v.isEmpty()) {
-                        // Emit raw data first
-                        emit nodeReportReceived(nodeName, v);
-
-                        // Parse the NODE_REPORT data
-                        // Format: "NAME=archie,X=177.14,Y=183.33,SPD=2.87,HDG=29.98,HOG=30.5,DEP=0,LAT=-4.32439555,LON=70.32817697,TYPE=kayak,MODE=MODE:ACTIVE:SURVEYING,ALLSTOP=clear,INDEX=2879,YAW=1.0,TIME=1763534205.16,LENGTH=4,SOG=3.0,COG=31.2,DRAFT=1.5,Z=0.0,STW=2.8,DRIFT=0.2,DRIFT_ANGLE=5.0,SET=180,ROT=0.5"
-
-                        QString name, type, mode;
-                        double x = std::numeric_limits<double>::quiet_NaN();
-                        double y = std::numeric_limits<double>::quiet_NaN();
-                        double spd = std::numeric_limits<double>::quiet_NaN();
-                        double hdg = std::numeric_limits<double>::quiet_NaN();
-                        double dep = std::numeric_limits<double>::quiet_NaN();
-                        double lat = std::numeric_limits<double>::quiet_NaN();
-                        double lon = std::numeric_limits<double>::quiet_NaN();
-                        double yaw = std::numeric_limits<double>::quiet_NaN();
-                        double time = std::numeric_limits<double>::quiet_NaN();
-                        double hog = std::numeric_limits<double>::quiet_NaN();
-                        double sog = std::numeric_limits<double>::quiet_NaN();
-                        double cog = std::numeric_limits<double>::quiet_NaN();
-                        double draft = std::numeric_limits<double>::quiet_NaN();
-                        double z = std::numeric_limits<double>::quiet_NaN();
-                        double stw = std::numeric_limits<double>::quiet_NaN();
-                        double drift = std::numeric_limits<double>::quiet_NaN();
-                        double drift_angle = std::numeric_limits<double>::quiet_NaN();
-                        double set = std::numeric_limits<double>::quiet_NaN();
-                        double rot = std::numeric_limits<double>::quiet_NaN();
-                        int index = 0;
-
-                        // Parse key=value pairs
-                        QStringList pairs = v.split(',', Qt::SkipEmptyParts);
-                        for (const QString &pair : pairs) {
-                            QStringList keyValue = pair.split('=', Qt::SkipEmptyParts);
-                            if (keyValue.size() == 2) {
-                                QString key = keyValue[0].trimmed();
-                                QString value = keyValue[1].trimmed();
-
-                                if (key == "NAME") name = value;
-                                else if (key == "X") x = value.toDouble();
-                                else if (key == "Y") y = value.toDouble();
-                                else if (key == "SPD") spd = value.toDouble();
-                                else if (key == "HDG") hdg = value.toDouble();
-                                else if (key == "HOG") hog = value.toDouble();
-                                else if (key == "DEP") dep = value.toDouble();
-                                else if (key == "LAT") lat = value.toDouble();
-                                else if (key == "LON") lon = value.toDouble();
-                                else if (key == "TYPE") type = value;
-                                else if (key == "MODE") mode = value;
-                                else if (key == "INDEX") index = value.toInt();
-                                else if (key == "YAW") yaw = value.toDouble();
-                                else if (key == "TIME") time = value.toDouble();
-                                else if (key == "SOG") sog = value.toDouble();
-                                else if (key == "COG") cog = value.toDouble();
-                                else if (key == "DRAFT") draft = value.toDouble();
-                                else if (key == "Z") z = value.toDouble();
-                                else if (key == "STW") stw = value.toDouble();
-                                else if (key == "DRIFT") drift = value.toDouble();
-                                else if (key == "DRIFT_ANGLE") drift_angle = value.toDouble();
-                                else if (key == "SET") set = value.toDouble();
-                                else if (key == "ROT") rot = value.toDouble();
-                            }
-                        }
-
-                        // Emit parsed data with all navigation parameters
-                        emit nodeShipDataReceived(nodeName, name, x, y, spd, hdg, dep, lat, lon, type, mode, index, yaw, time,
-                                                  hog, sog, cog, draft, z, stw, drift, drift_angle, set, rot);
+            case NavKey::MapInfoReq:
+                mapInfoReq = val.toString();
+                hasMapInfoReq = true;
+                break;
+            case NavKey::NodeNameAll: {
+                // NODE_NAME_ALL - Parse and store node names
+                const QString v = val.toString();
+                if (!v.isEmpty()) {
+                    nodeNameList.clear();
+                    QStringList names = v.split(',', Qt::SkipEmptyParts);
+                    for (const QString &name : names) {
+                        nodeNameList.append(name.trimmed().toUpper());
                     }
-                });
+                    emit nodeNameAllReceived(v);
+                }
+                break;
+            }
+            case NavKey::NodeReport:
+                nodeReports.append(qMakePair(key.mid(12), val.toString()));
+                break;
+            case NavKey::Unknown:
+                break;
             }
         }
 
-        if (hasLat && hasLon) {
-            emit processingData(lat, lon, cog, sog, hdg, spd, dep, yaw, z);
+        // Dynamic NODE_REPORT_* based on NODE_NAME_ALL content (setelah NODE_NAME_ALL di object yang sama)
+        for (const auto &report : nodeReports) {
+            if (!report.second.isEmpty() && nodeNameList.contains(report.first)) {
+                pushNodeReport(report.first, report.second);
+            }
         }
-        if (hasAis){
-            emit processingAis(ais);
+
+        if (!snapshot.isEmpty()) {
+            NavRecord *rec = beginRecord(NavRecord::Snapshot);
+            if (rec) {
+                rec->nav = snapshot;
+                commitRecord();
+            }
         }
 
-        // ROUTES INFORMATION
-        extractDouble("RTE_WP_BRG", [=](double v){ emit rteWpBrgReceived(v); });
-        extractString("RTE_XTD", [=](QString v){ emit rteXtdReceived(v); });
-        extractDouble("RTE_CRS", [=](double v){ emit rteCrsReceived(v); });
-        extractDouble("RTE_CTM", [=](double v){ emit rteCtmReceived(v); });
-        extractDouble("RTE_DTG", [=](double v){ emit rteDtgReceived(v); });
-        extractDouble("RTE_DTG_M", [=](double v){ emit rteDtgMReceived(v); });
-        extractString("RTE_TTG", [=](QString v){ emit rteTtgReceived(v); });
-        extractString("RTE_ETA", [=](QString v){ emit rteEtaReceived(v); });
+        if (hasMapInfoReq) {
+            emit mapInfoReqReceived(mapInfoReq);
+        }
+    }
+
+    const JsonStreamFramer::Stats &after = framer.stats();
+    if (after.discardedBytes != before.discardedBytes || after.overflows != before.overflows || after.stale != before.stale) {
+        qWarning() << "[AISSubscriber] Framer skipped" << (after.discardedBytes - before.discardedBytes) << "stray bytes,"
+                   << (after.overflows - before.overflows) << "oversized and" << (after.stale - before.stale) << "stale objects";
+    }
+
+    // Laporkan drop sekali per burst, bukan per record
+    if (recordQueue) {
+        const quint64 drops = recordQueue->stats().drops;
+        if (drops != reportedDrops) {
+            qWarning() << "[AISSubscriber] NavRecordQueue full, dropped" << (drops - reportedDrops) << "records";
+            reportedDrops = drops;
+        }
+    }
+    if (oversizeRecords != reportedOversize) {
+        qWarning() << "[AISSubscriber] Skipped" << (oversizeRecords - reportedOversize) << "node reports too large for NavRecord";
+        reportedOversize = oversizeRecords;
+    }
+    if (spilledValues != reportedSpilled) {
+        qInfo() << "[AISSubscriber]" << (spilledValues - reportedSpilled) << "values larger than"
+                << NAV_SNAPSHOT_TEXT << "bytes carried outside NavRecord";
+        reportedSpilled = spilledValues;
     }
 }
 
@@ -550,73 +435,126 @@ void AISSubscriber::setDialogOpen(bool open) {
     dialogIsOpen = open;
 }
 
-// === STREAMING JSON PARSER HELPER FUNCTIONS ===
-
-int AISSubscriber::findCompleteJSON(const QByteArray &data) {
-    if (data.isEmpty()) {
-        return 0;
-    }
+void AISSubscriber::setRecordQueue(NavRecordQueue *queue) {
+    recordQueue = queue;
+    reportedDrops = queue ? queue->stats().drops : 0;
+}
 
-    // Find the first opening brace
-    int start = -1;
-    for (int i = 0; i < data.size(); ++i) {
-        if (data[i] == '{') {
-            start = i;
-            break;
+// === NAV RECORD QUEUE HELPERS ===
+
+AISSubscriber::NavKey AISSubscriber::lookupNavKey(const QString &key) {
+    // Switch pada panjang key dulu, lalu bandingkan dengan literal Latin-1 (tanpa alokasi)
+    auto is = [&key](const char *literal) { return key == QLatin1String(literal); };
+
+    switch (key.size()) {
+    case 5:
+        if (is("NAV_Z")) return { NavKey::Value, NavSnapshot::NavZ };
+        break;
+    case 6:
+        if (is("NAV_DR")) return { NavKey::Text, NavSnapshot::NavDeadReckon };
+        break;
+    case 7:
+        if (key.startsWith(QLatin1String("NAV_"))) {
+            if (is("NAV_LAT")) return { NavKey::Value, NavSnapshot::NavLat };
+            if (is("NAV_SOG")) return { NavKey::Value, NavSnapshot::NavSOG };
+            if (is("NAV_COG")) return { NavKey::Value, NavSnapshot::NavCourseOG };
+            if (is("NAV_YAW")) return { NavKey::Value, NavSnapshot::NavYaw };
+            if (is("NAV_STW")) return { NavKey::Value, NavSnapshot::NavStw };
+            if (is("NAV_SET")) return { NavKey::Value, NavSnapshot::NavSet };
+            if (is("NAV_ROT")) return { NavKey::Value, NavSnapshot::NavRot };
+        } else {
+            if (is("RTE_XTD")) return { NavKey::Text, NavSnapshot::RteXtd };
+            if (is("RTE_CRS")) return { NavKey::Value, NavSnapshot::RteCrs };
+            if (is("RTE_CTM")) return { NavKey::Value, NavSnapshot::RteCtm };
+            if (is("RTE_DTG")) return { NavKey::Value, NavSnapshot::RteDtg };
+            if (is("RTE_TTG")) return { NavKey::Text, NavSnapshot::RteTtg };
+            if (is("RTE_ETA")) return { NavKey::Text, NavSnapshot::RteEta };
         }
+        break;
+    case 8:
+        if (is("NAV_LONG")) return { NavKey::Value, NavSnapshot::NavLong };
+        if (is("NAV_NAME")) return { NavKey::Text, NavSnapshot::NavName };
+        break;
+    case 9:
+        if (is("NAV_DEPTH")) return { NavKey::Value, NavSnapshot::NavDepth };
+        if (is("NAV_SPEED")) return { NavKey::Value, NavSnapshot::NavSpeed };
+        if (is("NAV_DRIFT")) return { NavKey::Value, NavSnapshot::NavDrift };
+        if (is("NAV_DRAFT")) return { NavKey::Value, NavSnapshot::NavDraft };
+        if (is("RTE_DTG_M")) return { NavKey::Value, NavSnapshot::RteDtgM };
+        if (is("WAIS_NMEA")) return { NavKey::Text, NavSnapshot::WaisNmea };
+        break;
+    case 10:
+        if (is("RTE_WP_BRG")) return { NavKey::Value, NavSnapshot::RteWpBrg };
+        break;
+    case 11:
+        if (is("NAV_HEADING")) return { NavKey::Value, NavSnapshot::NavHeading };
+        if (is("NAV_LAT_DMS")) return { NavKey::Text, NavSnapshot::NavLatDms };
+        if (is("NAV_LAT_DMM")) return { NavKey::Text, NavSnapshot::NavLatDmm };
+        break;
+    case 12:
+        if (is("NAV_LONG_DMS")) return { NavKey::Text, NavSnapshot::NavLongDms };
+        if (is("NAV_LONG_DMM")) return { NavKey::Text, NavSnapshot::NavLongDmm };
+        if (is("MAP_INFO_REQ")) return { NavKey::MapInfoReq, 0 };
+        break;
+    case 13:
+        if (is("NODE_NAME_ALL")) return { NavKey::NodeNameAll, 0 };
+        break;
+    case 15:
+        if (is("NAV_DRIFT_ANGLE")) return { NavKey::Value, NavSnapshot::NavDriftAngle };
+        break;
+    case 20:
+        if (is("NAV_DEPTH_BELOW_KEEL")) return { NavKey::Value, NavSnapshot::NavDepthBelowKeel };
+        break;
+    case 21:
+        if (is("NAV_SPEED_OVER_GROUND")) return { NavKey::Value, NavSnapshot::NavSpeedOG };
+        break;
+    case 23:
+        if (is("NAV_HEADING_OVER_GROUND")) return { NavKey::Value, NavSnapshot::NavHeadingOG };
+        break;
+    default:
+        break;
     }
 
-    if (start == -1) {
-        return 0;  // No opening brace found
+    if (key.size() > 12 && key.startsWith(QLatin1String("NODE_REPORT_"))) {
+        return { NavKey::NodeReport, 0 };
     }
-
-    // Count braces to find matching closing brace
-    int braceCount = 0;
-    for (int i = start; i < data.size(); ++i) {
-        if (data[i] == '{') {
-            braceCount++;
-        } else if (data[i] == '}') {
-            braceCount--;
-            if (braceCount == 0) {
-                return i + 1;  // Return position after closing brace
-            }
-        }
-    }
-
-    return -1;  // Incomplete JSON
+    return { NavKey::Unknown, 0 };
 }
 
-bool AISSubscriber::shouldFlushBuffer(const QByteArray &buffer) {
-    if (buffer.isEmpty()) {
-        return false;
+NavRecord* AISSubscriber::beginRecord(NavRecord::Kind kind) {
+    if (!recordQueue) {
+        return nullptr;
     }
 
-    // Condition 3: Check for invalid patterns (NAV_, NODE_ without opening brace)
-    QString str = QString::fromUtf8(buffer).trimmed();
-    if (str.startsWith("NAV_") || str.startsWith("NODE_")) {
-        return true;  // Invalid data, flush buffer
-    }
-
-    // Condition 5: Large buffer (>50KB) - flush to prevent memory issues
-    if (buffer.size() > 50000) {
-        return true;
+    // Slot diisi langsung di ring; kalau tidak jadi di-commit, slot dipakai lagi berikutnya
+    pendingRecord = recordQueue->beginPush();
+    if (pendingRecord) {
+        pendingRecord->kind = kind;
     }
+    return pendingRecord;
+}
 
-    // Condition 6: Timeout (>10 seconds) - data is stale
-    if (bufferTimer.hasExpired(10000)) {
-        return true;
+void AISSubscriber::commitRecord() {
+    if (!pendingRecord) {
+        return;
     }
+    pendingRecord->enqueuedNs = NavRecord::clockNs();
+    pendingRecord = nullptr;
+    recordQueue->commitPush();
+}
 
-    // Condition 1 & 2: Valid JSON patterns - don't flush
-    if (str.startsWith('{') || str.startsWith('"')) {
-        return false;
+void AISSubscriber::pushNodeReport(const QString &nodeName, const QString &report) {
+    // Format: "NAME=archie,X=177.14,Y=183.33,SPD=2.87,HDG=29.98,HOG=30.5,DEP=0,LAT=-4.32439555,LON=70.32817697,TYPE=kayak,MODE=MODE:ACTIVE:SURVEYING,ALLSTOP=clear,INDEX=2879,YAW=1.0,TIME=1763534205.16,LENGTH=4,SOG=3.0,COG=31.2,DRAFT=1.5,Z=0.0,STW=2.8,DRIFT=0.2,DRIFT_ANGLE=5.0,SET=180,ROT=0.5"
+    // Di-parse langsung ke slot ring, tanpa split/QStringList
+    NavRecord *rec = beginRecord(NavRecord::NodeShip);
+    if (!rec) {
+        return;
     }
 
-    // Condition 4: Small unclear buffer - wait for more data
-    if (buffer.size() < 1000) {
-        return false;
+    if (NodeFleet::parseReport(report, rec->node) && rec->node.text.set(NavNodeReport::NodeName, nodeName)) {
+        commitRecord();
+    } else {
+        pendingRecord = nullptr;
+        ++oversizeRecords;
     }
-
-    // Default: flush unclear data
-    return true;
 }
@@ -5,6 +5,8 @@
 #include <QTcpSocket>
 #include <QTimer>
 #include <QElapsedTimer>
+#include "navrecord.h"
+#include "jsonstreamframer.h"
 
 // forward declerations1
 class MainWindow;
@@ -22,63 +24,21 @@ public:
     void setDialogOpen(bool open);
     void setShuttingDown(bool v);
 
-signals:
-    // OWNSHIP
-    void navLatReceived(const double lat);
-    void navLongReceived(const double lon);
-    void navLatDmsReceived(const QString latDms);
-    void navLongDmsReceived(const QString lonDms);
-    void navLatDmmReceived(const QString latDmm);
-    void navLongDmmReceived(const QString lonDmm);
-    void navNameReceived(const QString name);
-    void navDepthReceived(const double depth);
-    void navHeadingReceived(const double heading);
-    void navHeadingOGReceived(const double headingOg);
-    void navCourseOGReceived(const double courseOg);
-    void navSpeedReceived(const double speed);
-    void navSpeedOGReceived(const double speedOg);
-    void navSOGReceived(const double sog);
-    void navYawReceived(const double yaw);
-    void navZReceived(const double z);
-    void navStwReceived(const double stw);
-    void navDriftReceived(const double drift);
-    void navDraftReceived(const double drift);
-    void navDriftAngleReceived(const double driftAngle);
-    void navSetReceived(const double set);
-    void navRotReceived(const double rot);
-    void navDepthBelowKeelReceived(const double DepthBelowKeel);
-    void navDeadReckonReceived(const QString deadReckon);
+    // Data navigasi, rute, AIS dan NODE_REPORT tidak lagi lewat signal per field;
+    // tiap JSON object jadi satu NavSnapshot di NavRecordQueue, di-drain GUI sekali per frame.
+    void setRecordQueue(NavRecordQueue *queue);
 
+signals:
     void mapInfoReqReceived(QString map);
-    void waisNmeaReceived(QString nmea);
 
     // NODE REPORTS
     void nodeNameAllReceived(const QString nodeNames);
-    void nodeReportReceived(const QString nodeName, const QString reportData);
-    void nodeShipDataReceived(const QString nodeName, const QString name, double x, double y, double spd,
-                              double hdg, double dep, double lat, double lon, const QString type,
-                              const QString mode, int index, double yaw, double time,
-                              double hog, double sog, double cog, double draft, double z,
-                              double stw, double drift, double drift_angle, double set, double rot);
-
-    // ROUTES INFORMATION
-    void rteWpBrgReceived(const double &value);
-    void rteXtdReceived(const QString &value);
-    void rteCrsReceived(const double &value);
-    void rteCtmReceived(const double &value);
-    void rteDtgReceived(const double &value);
-    void rteDtgMReceived(const double &value);
-    void rteTtgReceived(const QString &value);
-    void rteEtaReceived(const QString &value);
 
     void publishToMOOSDB(const QString &key, const QString &value);
 
     void errorOccurred(const QString &message);
     void disconnected();
 
-    void processingData(double, double, double, double, double, double, double, double, double);
-    void processingAis(QString);
-
     // CONNECTION STATUS
     void connectionStatusChanged(bool connected);
 
@@ -120,12 +80,30 @@ private:
 
     bool dialogIsOpen;
 
-    // Streaming JSON parser buffer
-    QByteArray buffer;              // Persistent buffer for incomplete JSON
-    QElapsedTimer bufferTimer;       // Timeout detection
-    bool bufferWasEmpty = true;
-    int findCompleteJSON(const QByteArray &data);
-    bool shouldFlushBuffer(const QByteArray &buffer);
+    // Streaming JSON framer (state survives across readyRead)
+    JsonStreamFramer framer;
+
+    // SPSC hand-off ke GUI (dimiliki EcWidget)
+    NavRecordQueue *recordQueue = nullptr;
+    NavRecord* beginRecord(NavRecord::Kind kind);
+    void commitRecord();
+    void pushNodeReport(const QString &nodeName, const QString &report);
+
+    // Dispatch key MOOS -> slot NavSnapshot
+    struct NavKey {
+        enum Kind { Unknown, Value, Text, MapInfoReq, NodeNameAll, NodeReport };
+        Kind kind;
+        int slot;
+    };
+    static NavKey lookupNavKey(const QString &key);
+
+    NavSnapshot snapshot;           // scratch per JSON object, disalin utuh ke ring
+    NavRecord *pendingRecord = nullptr;
+    quint64 reportedDrops = 0;
+    quint64 oversizeRecords = 0;    // NODE_REPORT yang tidak muat di NAV_NODE_TEXT (dibuang)
+    quint64 reportedOversize = 0;
+    quint64 spilledValues = 0;      // teks snapshot > NAV_SNAPSHOT_TEXT, dibawa lewat NavTextSpill
+    quint64 reportedSpilled = 0;
 };
 
 #endif // AISSUBSCRIBER_H
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "IAisDvrPlugin.h"
+
+// Satu baris NMEA untuk recordBatch(): pointer ke byte ASCII milik pemanggil,
+// hanya valid selama panggilan recordBatch() berlangsung.
+struct AisDvrLine {
+    qint64 timeMs;          // waktu terima, ms sejak epoch (UTC)
+    const char* data;
+    int length;
+};
+
+// Versi 2 antarmuka DVR: banyak baris per panggilan virtual, tanpa konversi QString.
+// Plugin lama (hanya IAisDvrPlugin) tetap jalan lewat adapter di AisDvrSink;
+// plugin baru mendeklarasikan Q_INTERFACES(IAisDvrPlugin IAisDvrPlugin2).
+class IAisDvrPlugin2 : public IAisDvrPlugin {
+public:
+    virtual ~IAisDvrPlugin2() {}
+
+    virtual void recordBatch(const AisDvrLine* lines, int count) = 0;
+    // Minta semua baris yang sudah diterima diteruskan ke storage (tidak harus menunggu)
+    virtual void flush() = 0;
+};
+
+#define IAisDvrPlugin2_iid "org.ecdis.plugin.IAisDvrPlugin/2"
+Q_DECLARE_INTERFACE(IAisDvrPlugin2, IAisDvrPlugin2_iid)
@@ -0,0 +1,426 @@
+#include "IndexerWorker.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDate>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+const qint64 kWindowBytes = qint64(64) << 20;  // jendela mmap; aman juga di build 32-bit
+const quint32 kIndexMagic = 0x4e4d4958;         // "NMIX"
+const quint32 kIndexVersion = 2;
+const qint64 kFallbackBytes = qint64(1) << 20;  // entry cadangan tiap 1 MB tanpa waktu baru
+const qint64 kUnixEpochJulianDay = 2440588;
+
+// Field ke-n (0 = address) dari kalimat NMEA yang dimulai di s, berhenti di '*'
+bool nmeaField(const char *s, const char *end, int n, const char *&field, int &len)
+{
+    const char *p = s;
+    for (int i = 0; i < n; ++i) {
+        while (p < end && *p != ',' && *p != '*') ++p;
+        if (p >= end || *p == '*')
+            return false;
+        ++p;
+    }
+    const char *q = p;
+    while (q < end && *q != ',' && *q != '*') ++q;
+    field = p;
+    len = int(q - p);
+    return true;
+}
+
+bool parseDigits(const char *p, int count, int &value)
+{
+    value = 0;
+    for (int i = 0; i < count; ++i) {
+        if (p[i] < '0' || p[i] > '9')
+            return false;
+        value = value * 10 + (p[i] - '0');
+    }
+    return true;
+}
+
+// hhmmss[.sss] -> ms sejak tengah malam
+bool parseTimeOfDay(const char *p, int len, qint64 &ms)
+{
+    int hh, mm, ss;
+    if (len < 6 || !parseDigits(p, 2, hh) || !parseDigits(p + 2, 2, mm) || !parseDigits(p + 4, 2, ss))
+        return false;
+    if (hh > 23 || mm > 59 || ss > 60)
+        return false;
+
+    int frac = 0;
+    if (len > 7 && p[6] == '.') {
+        int scale = 100;
+        for (int i = 7; i < len && scale > 0; ++i, scale /= 10) {
+            if (p[i] < '0' || p[i] > '9')
+                break;
+            frac += (p[i] - '0') * scale;
+        }
+    }
+    ms = ((hh * 60 + mm) * 60 + ss) * qint64(1000) + frac;
+    return true;
+}
+
+qint64 toEpochMs(int year, int month, int day, qint64 msOfDay)
+{
+    const QDate date(year, month, day);
+    if (!date.isValid())
+        return -1;
+    return (date.toJulianDay() - kUnixEpochJulianDay) * qint64(86400000) + msOfDay;
+}
+
+// \s:xxx,c:1577836800*hh\  -> c: dalam detik (atau ms kalau sudah 13 digit)
+qint64 tagBlockTime(const char *p, const char *end)
+{
+    while (p < end && *p != '*') {
+        if (end - p > 2 && p[0] == 'c' && p[1] == ':') {
+            qint64 v = 0;
+            int digits = 0;
+            for (p += 2; p < end && *p >= '0' && *p <= '9' && digits < 14; ++p, ++digits) {
+                v = v * 10 + (*p - '0');
+            }
+            if (digits == 0)
+                return -1;
+            return v >= qint64(100000000000) ? v : v * 1000;
+        }
+        while (p < end && *p != ',' && *p != '*') ++p;
+        if (p < end && *p == ',') ++p;
+    }
+    return -1;
+}
+
+} // namespace
+
+// NmeaLogIndex
+////////////////
+
+qint64 NmeaLogIndex::offsetAt(qint64 timeMs) const
+{
+    auto it = std::upper_bound(entries.constBegin(), entries.constEnd(), timeMs,
+                               [](qint64 t, const NmeaLogIndexEntry &e) { return t < e.timeMs; });
+    if (it == entries.constBegin())
+        return 0;
+    return (it - 1)->offset;
+}
+
+qint64 NmeaLogIndex::timeAt(qint64 offset) const
+{
+    auto it = std::upper_bound(entries.constBegin(), entries.constEnd(), offset,
+                               [](qint64 o, const NmeaLogIndexEntry &e) { return o < e.offset; });
+    if (it == entries.constBegin())
+        return startMs();
+    return (it - 1)->timeMs;
+}
+
+QString NmeaLogIndex::sidecarPath(const QString &logPath)
+{
+    return logPath + QStringLiteral(".idx");
+}
+
+bool NmeaLogIndex::load(const QString &logPath)
+{
+    const QFileInfo info(logPath);
+    QFile f(sidecarPath(logPath));
+    if (!info.exists() || !f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0, version = 0, count = 0;
+    qint64 size = 0, modified = 0, lines = 0;
+    bool synthetic = false;
+    in >> magic >> version >> size >> modified >> lines >> synthetic >> count;
+    if (in.status() != QDataStream::Ok || magic != kIndexMagic || version != kIndexVersion)
+        return false;
+
+    // Log berubah sejak di-index: sidecar basi
+    if (size != info.size() || modified != info.lastModified().toMSecsSinceEpoch())
+        return false;
+
+    QVector<NmeaLogIndexEntry> loaded(static_cast<int>(count));
+    for (NmeaLogIndexEntry &e : loaded) {
+        in >> e.timeMs >> e.offset;
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    entries.swap(loaded);
+    fileSize = size;
+    fileModifiedMs = modified;
+    lineCount = lines;
+    untimed = synthetic;
+    return true;
+}
+
+bool NmeaLogIndex::save(const QString &logPath) const
+{
+    QSaveFile f(sidecarPath(logPath));
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_5_15);
+    out << kIndexMagic << kIndexVersion << fileSize << fileModifiedMs << lineCount
+        << untimed << quint32(entries.size());
+    for (const NmeaLogIndexEntry &e : entries) {
+        out << e.timeMs << e.offset;
+    }
+
+    return out.status() == QDataStream::Ok && f.commit();
+}
+
+// NmeaLogCursor
+////////////////
+
+NmeaLogCursor::NmeaLogCursor(QFile *file)
+    : m_file(file),
+      m_fileSize(file ? file->size() : 0)
+{
+}
+
+NmeaLogCursor::~NmeaLogCursor()
+{
+    unmap();
+}
+
+void NmeaLogCursor::unmap()
+{
+    // QFile::close() sudah melepas semua map; jangan unmap pointer basi
+    if (m_map && m_file->isOpen()) {
+        m_file->unmap(m_map);
+    }
+    m_map = nullptr;
+    m_mapOffset = 0;
+    m_mapSize = 0;
+}
+
+bool NmeaLogCursor::mapWindow(qint64 offset)
+{
+    unmap();
+    const qint64 size = qMin(kWindowBytes, m_fileSize - offset);
+    if (size <= 0)
+        return false;
+
+    m_map = m_file->map(offset, size);
+    if (!m_map)
+        return false;
+
+    m_mapOffset = offset;
+    m_mapSize = size;
+    return true;
+}
+
+bool NmeaLogCursor::seek(qint64 offset)
+{
+    if (offset < 0 || offset > m_fileSize)
+        return false;
+    m_pos = offset;
+    return true;
+}
+
+bool NmeaLogCursor::next(const char *&line, int &len)
+{
+    if (m_pos >= m_fileSize)
+        return false;
+
+    for (;;) {
+        if (!m_map || m_pos < m_mapOffset || m_pos >= m_mapOffset + m_mapSize) {
+            if (!mapWindow(m_pos))
+                return false;
+        }
+
+        const char *begin = reinterpret_cast<const char*>(m_map) + (m_pos - m_mapOffset);
+        const qint64 avail = m_mapOffset + m_mapSize - m_pos;
+        const char *nl = static_cast<const char*>(std::memchr(begin, '\n', size_t(avail)));
+
+        qint64 consumed;
+        if (nl) {
+            len = int(nl - begin);
+            consumed = len + 1;
+        } else if (m_mapOffset + m_mapSize >= m_fileSize || m_mapOffset == m_pos) {
+            // Baris terakhir tanpa newline, atau baris lebih panjang dari satu jendela
+            len = int(avail);
+            consumed = avail;
+        } else {
+            // Baris terpotong batas jendela: geser jendela ke awal baris
+            if (!mapWindow(m_pos))
+                return false;
+            continue;
+        }
+
+        m_lineOffset = m_pos;
+        m_pos += consumed;
+        if (len > 0 && begin[len - 1] == '\r')
+            --len;
+        line = begin;
+        return true;
+    }
+}
+
+// IndexerWorker
+////////////////
+
+qint64 IndexerWorker::lineTimeMs(const char *line, int len)
+{
+    const char *p = line;
+    const char *end = line + len;
+
+    // NMEA 4.0 tag block di depan kalimat
+    if (p < end && *p == '\\') {
+        const char *close = static_cast<const char*>(std::memchr(p + 1, '\\', size_t(end - p - 1)));
+        if (!close)
+            return -1;
+        const qint64 t = tagBlockTime(p + 1, close);
+        if (t >= 0)
+            return t;
+        p = close + 1;
+    }
+
+    if (end - p < 6 || *p != '$')
+        return -1;
+
+    const bool rmc = std::memcmp(p + 3, "RMC", 3) == 0;
+    const bool zda = !rmc && std::memcmp(p + 3, "ZDA", 3) == 0;
+    if (!rmc && !zda)
+        return -1;
+
+    const char *f;
+    int flen;
+    qint64 msOfDay;
+    if (!nmeaField(p, end, 1, f, flen) || !parseTimeOfDay(f, flen, msOfDay))
+        return -1;
+
+    int day, month, year;
+    if (rmc) {
+        // $--RMC,hhmmss.ss,A,llll.ll,a,yyyyy.yy,a,x.x,x.x,ddmmyy,...
+        if (!nmeaField(p, end, 9, f, flen) || flen < 6
+            || !parseDigits(f, 2, day) || !parseDigits(f + 2, 2, month) || !parseDigits(f + 4, 2, year))
+            return -1;
+        year += year < 80 ? 2000 : 1900;
+    } else {
+        // $--ZDA,hhmmss.ss,dd,mm,yyyy,...
+        if (!nmeaField(p, end, 2, f, flen) || flen != 2 || !parseDigits(f, 2, day))
+            return -1;
+        if (!nmeaField(p, end, 3, f, flen) || flen != 2 || !parseDigits(f, 2, month))
+            return -1;
+        if (!nmeaField(p, end, 4, f, flen) || flen != 4 || !parseDigits(f, 4, year))
+            return -1;
+    }
+
+    return toEpochMs(year, month, day, msOfDay);
+}
+
+void IndexerWorker::process()
+{
+    index = NmeaLogIndex();
+
+    // Sudah pernah di-scan dan log belum berubah: langsung pakai sidecar
+    if (index.load(filePath)) {
+        if (onProgress) onProgress(100);
+        if (onFinished) {
+            QList<qint64> offsets;
+            offsets.reserve(index.entries.size());
+            for (const NmeaLogIndexEntry &e : index.entries) {
+                offsets.append(e.offset);
+            }
+            onFinished(offsets);
+        }
+        return;
+    }
+    index = NmeaLogIndex();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (onFinished) onFinished(QList<qint64>());
+        return;
+    }
+
+    const QFileInfo info(file);
+    index.fileSize = file.size();
+    index.fileModifiedMs = info.lastModified().toMSecsSinceEpoch();
+
+    NmeaLogCursor cursor(&file);
+    QList<qint64> offsets;
+
+    const char *line;
+    int len;
+    int lastPercent = -1;
+    qint64 lastTime = -1;
+    qint64 lastOffset = 0;              // offset entry terakhir (atau cadangan terakhir)
+
+    // Bentangan panjang tanpa waktu baru tetap bisa di-seek: offset cadangan tiap
+    // kFallbackBytes, waktunya diinterpolasi saat timestamp berikutnya ketemu
+    QVector<qint64> pending;
+    // Selama belum ada timestamp: entry sintetis (baris ke-n * UntimedLineMs)
+    QVector<NmeaLogIndexEntry> synthetic;
+    synthetic.append({0, 0});
+
+    while (cursor.next(line, len)) {
+        const qint64 lineNo = index.lineCount++;
+        const qint64 offset = cursor.lineOffset();
+
+        // Satu entry per waktu baru; waktu mundur (log disambung) ikut entry sebelumnya
+        // supaya entries tetap urut dan bisa di-binary search
+        const qint64 t = lineTimeMs(line, len);
+        if (t > lastTime) {
+            if (lastTime >= 0) {
+                const qint64 base = index.entries.last().offset;
+                const qint64 span = qMax<qint64>(offset - base, 1);
+                for (qint64 o : pending) {
+                    const qint64 ft = lastTime + qint64(double(t - lastTime) * double(o - base) / double(span));
+                    if (ft > index.entries.last().timeMs && ft < t) {
+                        index.entries.append({ft, o});
+                        offsets.append(o);
+                    }
+                }
+            }
+            pending.clear();
+            synthetic.clear();
+            index.entries.append({t, offset});
+            offsets.append(offset);
+            lastTime = t;
+            lastOffset = offset;
+        } else if (offset - lastOffset >= kFallbackBytes) {
+            if (lastTime >= 0) {
+                pending.append(offset);
+            } else {
+                synthetic.append({lineNo * NmeaLogIndex::UntimedLineMs, offset});
+            }
+            lastOffset = offset;
+        }
+
+        if ((index.lineCount & 0xFFF) == 0) {
+            if (stopFlag && stopFlag->load())
+                return;
+
+            const int percent = int(cursor.pos() * 100 / qMax<qint64>(index.fileSize, 1));
+            if (percent != lastPercent && onProgress) {
+                onProgress(percent);
+            }
+            lastPercent = percent;
+        }
+    }
+
+    // Tanpa satu timestamp pun: replay memakai waktu sintetis, index mengikutinya.
+    // Cadangan setelah timestamp terakhir dibuang (tidak ada waktu untuk interpolasi).
+    if (index.entries.isEmpty() && index.lineCount > 0) {
+        index.entries = synthetic;
+        index.untimed = true;
+        offsets.clear();
+        for (const NmeaLogIndexEntry &e : synthetic) {
+            offsets.append(e.offset);
+        }
+    }
+
+    index.save(filePath);
+
+    if (onProgress) onProgress(100);
+    if (onFinished) onFinished(offsets);
+}
@@ -1,13 +1,92 @@
 #pragma once
 #include <QString>
 #include <QList>
+#include <QVector>
+#include <atomic>
 #include <functional>
 
+class QFile;
+
+// Satu titik seek: waktu (ms since epoch, UTC) dan offset byte awal baris
+// pertama yang membawa waktu itu.
+struct NmeaLogIndexEntry {
+    qint64 timeMs;
+    qint64 offset;
+};
+
+// Index (waktu, offset) sebuah log NMEA, disimpan sebagai sidecar "<log>.idx".
+// Sidecar hanya dipakai kalau ukuran dan mtime log masih sama dengan saat di-scan.
+// Log tanpa timestamp sama sekali (untimed) tetap di-index dengan waktu sintetis
+// UntimedLineMs per baris, sama dengan jarak yang dipakai replay.
+class NmeaLogIndex {
+public:
+    static constexpr qint64 UntimedLineMs = 300;
+
+    QVector<NmeaLogIndexEntry> entries;     // urut waktu naik
+    qint64 fileSize = 0;
+    qint64 fileModifiedMs = 0;
+    qint64 lineCount = 0;
+    bool untimed = false;                   // waktu entry sintetis, bukan waktu log
+
+    bool isEmpty() const { return entries.isEmpty(); }
+    qint64 startMs() const { return entries.isEmpty() ? 0 : entries.first().timeMs; }
+    qint64 endMs() const { return entries.isEmpty() ? 0 : entries.last().timeMs; }
+
+    // Offset untuk mulai replay di timeMs: entry terakhir dengan waktu <= timeMs
+    qint64 offsetAt(qint64 timeMs) const;
+    // Waktu yang berlaku pada offset (entry terakhir dengan offset <= offset)
+    qint64 timeAt(qint64 offset) const;
+
+    bool load(const QString &logPath);
+    bool save(const QString &logPath) const;
+
+    static QString sidecarPath(const QString &logPath);
+};
+
+// Iterasi baris di atas file yang di-mmap per jendela. Baris dicari dengan memchr
+// (libc memakai SIMD), tanpa QTextStream dan tanpa copy per baris.
+// Pointer baris valid sampai next() atau seek() berikutnya.
+class NmeaLogCursor {
+public:
+    explicit NmeaLogCursor(QFile *file);
+    ~NmeaLogCursor();
+
+    // Baris berikutnya tanpa "\r\n"; false di akhir file
+    bool next(const char *&line, int &len);
+    bool seek(qint64 offset);
+
+    qint64 pos() const { return m_pos; }
+    qint64 lineOffset() const { return m_lineOffset; }
+    qint64 size() const { return m_fileSize; }
+    bool atEnd() const { return m_pos >= m_fileSize; }
+
+private:
+    bool mapWindow(qint64 offset);
+    void unmap();
+
+    QFile *m_file;
+    uchar *m_map = nullptr;
+    qint64 m_mapOffset = 0;
+    qint64 m_mapSize = 0;
+    qint64 m_fileSize = 0;
+    qint64 m_pos = 0;
+    qint64 m_lineOffset = 0;
+};
+
+// Scan log sekali, isi 'index' dan tulis sidecar. Kalau sidecar masih valid,
+// scan dilewati. onFinished menerima offset setiap entry index.
+// Dibatalkan lewat stopFlag: sidecar tidak ditulis dan onFinished tidak dipanggil.
 class IndexerWorker {
 public:
     QString filePath;
     std::function<void(int)> onProgress;
     std::function<void(const QList<qint64>&)> onFinished;
+    std::atomic<bool> *stopFlag = nullptr;
+
+    NmeaLogIndex index;
 
     void process();
+
+    // Waktu dari tag block (c:), $--RMC atau $--ZDA; -1 kalau baris tidak membawa waktu
+    static qint64 lineTimeMs(const char *line, int len);
 };
@@ -64,6 +64,19 @@ bool PluginManager::loadPlugin(const QString& pluginPath, const QString& key) {
     return true;
 }
 
+bool PluginManager::registerPlugin(QObject* plugin, const QString& key) {
+    if (!plugin) return false;
+    if (m_plugins.contains(key)) {
+        qCritical() << "[PLUGIN MANAGER] Plugin with key" << key << "already loaded.";
+        delete plugin;
+        return false;
+    }
+
+    m_plugins[key] = plugin;
+    qDebug() << "[PLUGIN MANAGER] Registered built-in plugin:" << plugin->metaObject()->className() << "as key:" << key;
+    return true;
+}
+
 // CRITICAL: Destructor to properly unload all plugins
 PluginManager::~PluginManager() {
     qDebug() << "[PLUGIN MANAGER] Unloading all plugins...";
@@ -13,6 +13,8 @@ public:
     static PluginManager& instance();
 
     bool loadPlugin(const QString& pluginPath, const QString& key);
+    // Plugin yang dikompilasi ke aplikasi (tanpa DLL); PluginManager mengambil alih kepemilikan
+    bool registerPlugin(QObject* plugin, const QString& key);
 
     template<typename T>
     T* getPlugin(const QString& key) {
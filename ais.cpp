@@ -1,13 +1,14 @@
 #include "ais.h"
-#include "IAisDvrPlugin.h"
 #include "PluginManager.h"
 #include "aisdecoder.h"
 #include "pickwindow.h"
 #include "aisdatabasemanager.h"
 #include "aivdoencoder.h"
+#include "aislogreplay.h"
 #include "SettingsManager.h"
 #include "mainwindow.h"
 #include <QElapsedTimer>
+#include <QThread>
 
 // Initialize static member variables
 bool Ais::_isShuttingDown = false;
@@ -68,6 +69,17 @@ Ais::Ais( EcWidget *parent, EcView *view, EcDictInfo *dict,
   ownShipSog = 0.0;
 
   deleteOldOwnShipFeature();
+
+  // Satu storeTarget per update target. Callback transponder bisa datang dari thread
+  // lain; sinyal ini membawa update ke thread Ais, tempat timing wheel dipakai.
+  connect( this, &Ais::targetUpdateReceived, this, [this]( AISTargetData info ) {
+      storeTarget( info.mmsi.toUInt(), info );
+  } );
+
+  // Sisa UI feed per kalimat di-flush sekali per frame, bukan per baris
+  _streamFlushTimer.setSingleShot( true );
+  _streamFlushTimer.setInterval( AIS_UI_FRAME_MS );
+  connect( &_streamFlushTimer, &QTimer::timeout, this, [this]() { flushIngestUi( _streamIngest, true ); } );
 }
 
 Ais::~Ais(){
@@ -108,6 +120,11 @@ Ais::~Ais(){
 
     _latestTi = nullptr;
 
+    if (_ownShipPick){
+        delete _ownShipPick;
+        _ownShipPick = nullptr;
+    }
+
     if (_myAis == this){
         _myAis = nullptr;
     }
@@ -310,8 +327,9 @@ void Ais::AISTargetUpdateCallbackOld( EcAISTargetInfo *ti )
 
           data.feat = feat;
           data._dictInfo = _dictInfo;
+          data.rawInfo = *ti;
 
-          Ais::instance()->_aisTargetMap[ti->mmsi] = data;
+          Ais::instance()->storeTarget(ti->mmsi, data);
 
           // Create a modified copy with @ to space conversion for targetInfoMap
           EcAISTargetInfo tiModified = *ti;
@@ -377,15 +395,6 @@ void Ais::AISTargetUpdateCallbackOld( EcAISTargetInfo *ti )
     } // if( ti->ownShip == False ...
   } // if (dist ...
 
-  if (ti->mmsi == 366884150){
-      QMap<unsigned int, AISTargetData> targets = Ais::instance()->getTargetMap();
-      for (const auto &target : targets) {
-          if (target.mmsi != "366884150") continue;
-
-          //qDebug() << target.lat << ", " << target.lon << ", " << target.sog << ", " << target.cog;
-      }
-  }
-
   // The callback informs the application to refresh the chart display with AIS target by sending an event.
   /////////////////////////////////////////////////////////////////////////////////////////////////////////
   _myAis->emitSignal( ownShipLat, ownShipLon, ti->heading );
@@ -463,6 +472,9 @@ void Ais::AISTargetUpdateCallbackThread(EcAISTargetInfo *ti)
     // Enhanced safety checks during shutdown
     if (!ti || !_myAis || _isShuttingDown) return;
 
+    // Transponder sudah mengubah AIS cell, apa pun mode tampilannya
+    _myAis->touchCell();
+
     EcAISTargetInfo tiCopy = *ti; // copy biar aman
 
     // =================== DISPLAY: MODE AWARE ===================
@@ -569,42 +581,11 @@ void Ais::handleOwnShipUpdate(EcAISTargetInfo *ti)
         Ais::instance()->_aisOwnShip = dataOS;
 
         // EKOR OWNSHIP
+        // Sampling waktu/jarak/setiap fix diputuskan OwnShipTrail sesuai mode setting
         if (ownShipLat != 0 && ownShipLon != 0 && _wParent->getOwnShipTrail()) {
-            int setting = _wParent->getTrackLine();
-            if (setting == 1){
-                int minute = SettingsManager::instance().data().trailMinute;
-                QDateTime now = QDateTime::currentDateTime();
-                if (lastTrailDrawTime.isNull() || lastTrailDrawTime.secsTo(now) >= minute * 60) {
-                    _wParent->ownShipTrailPoints.append(qMakePair(QString::number(ownShipLat, 'f', 10), QString::number(ownShipLon, 'f', 10)));
-                    lastTrailDrawTime = now;
-                }
-            }
-            else if (setting == 2){
-                double trailDistanceMeters = SettingsManager::instance().data().trailDistance * 1852.0;
-
-                if (!_wParent->ownShipTrailPoints.isEmpty()) {
-                    auto last = _wParent->ownShipTrailPoints.last();
-                    double lastLat = last.first.toDouble();
-                    double lastLon = last.second.toDouble();
-                    double dist = _wParent->haversine(lastLat, lastLon, ownShipLat, ownShipLon);
-
-                    if (dist >= trailDistanceMeters) {
-                        _wParent->ownShipTrailPoints.append(qMakePair(
-                            QString::number(ownShipLat, 'f', 10),
-                            QString::number(ownShipLon, 'f', 10)
-                            ));
-                    }
-                } else {
-                    // Titik pertama langsung disimpan
-                    _wParent->ownShipTrailPoints.append(qMakePair(
-                        QString::number(ownShipLat, 'f', 10),
-                        QString::number(ownShipLon, 'f', 10)
-                        ));
-                }
-            }
-            else {
-                _wParent->ownShipTrailPoints.append(qMakePair(QString::number(ownShipLat, 'f', 10), QString::number(ownShipLon, 'f', 10)));
-            }
+            const SettingsData &settings = SettingsManager::instance().data();
+            _wParent->ownShipTrail.append(QDateTime::currentMSecsSinceEpoch(), ownShipLat, ownShipLon,
+                                          _wParent->getTrackLine(), settings.trailMinute, settings.trailDistance);
         }
     }
 }
@@ -725,13 +706,100 @@ void Ais::handleAISTargetUpdate(EcAISTargetInfo *ti)
 void Ais::postTargetUpdate(const AISTargetData& info){
     emit targetUpdateReceived(info);
 }
+
+void Ais::setReplayClock(qint64 msSinceEpoch)
+{
+    _replayClockMs.store(msSinceEpoch, std::memory_order_relaxed);
+}
+
+qint64 Ais::agingClockMs() const
+{
+    const qint64 replayMs = _replayClockMs.load(std::memory_order_relaxed);
+    return replayMs > 0 ? replayMs : QDateTime::currentMSecsSinceEpoch();
+}
+
+qint64 Ais::dataClockMs() const
+{
+    const qint64 replayMs = _replayClockMs.load(std::memory_order_relaxed);
+    if (replayMs > 0 && _logReplay && _logReplay->isOpen()) {
+        return _logReplay->position();
+    }
+    return agingClockMs();
+}
+
+void Ais::storeTarget(quint32 mmsi, const AISTargetData &data)
+{
+    _aisTargets.upsert(mmsi, data);
+
+    // Update baru menggeser deadline; tidak ada sweep per tick.
+    // Saat replay jamnya waktu data, bukan jam dinding.
+    const qint64 now = agingClockMs();
+    if (_iTimeOut > 0) {
+        // _iTimeOut dalam menit, sama dengan EcAISCalcTargetTrackingStatus
+        _targetAging.schedule(agingKey(AgingLost, mmsi), now + qint64(_iTimeOut) * 60 * 1000);
+    }
+    _targetAging.schedule(agingKey(AgingExpire, mmsi), now + qint64(OBJ_CLEAN_TIME) * 1000);
+}
+
+int Ais::expireTargets(qint64 nowMs)
+{
+    _dueAging.clear();
+    if (_targetAging.advance(nowMs, _dueAging) == 0) {
+        return 0;
+    }
+
+    QVector<unsigned int> expired;
+    for (quint64 key : _dueAging) {
+        const quint32 mmsi = quint32(key);
+        EcFeature feat;
+        EcDictInfo *dictInfo = nullptr;
+        if (!_aisTargets.feature(mmsi, feat, dictInfo)) {
+            continue;
+        }
+
+        if ((key >> 32) == AgingLost) {
+            // Target berhenti kirim: tampilkan sebagai lost tanpa menunggu update berikutnya
+            _aisTargets.setFlags(mmsi, AisTargetColumns::Lost);
+            if (ECOK(feat) && dictInfo) {
+                EcAISSetTargetTrackingStatus(feat, dictInfo, aisLost, NULL);
+            }
+        } else {
+            // Feature tetap milik transponder (dicari lagi lewat EcAISFindTargetObject saat
+            // target melapor lagi), jadi tidak di-EcFeatureDelete: cukup ditidurkan sebagai lost
+            if (ECOK(feat) && dictInfo) {
+                EcAISSetTargetTrackingStatus(feat, dictInfo, aisLost, NULL);
+                EcAISSetTargetActivationStatus(feat, dictInfo, aisSleeping, NULL);
+            }
+            _targetAging.cancel(agingKey(AgingLost, mmsi));
+            _aisTargets.remove(mmsi);
+            _aisTargetInfoMap.remove(mmsi);
+            expired.append(mmsi);
+        }
+    }
+
+    _bSymbolize = True;
+    touchCell();
+    if (!expired.isEmpty()) {
+        emit targetsExpired(expired);
+    }
+    return _dueAging.size();
+}
+
+const AisTargetSnapshot& Ais::publishTargets()
+{
+    expireTargets(agingClockMs());
+    _publishClock.restart();
+    return _aisTargets.publish();
+}
 void Ais::setTargetManualStatus(unsigned int mmsi, EcAISTrackingStatus status)
 {
     // Try to use cached feature first
-    if (_aisTargetMap.contains(mmsi)) {
-        AISTargetData &td = _aisTargetMap[mmsi];
-        if (ECOK(td.feat) && td._dictInfo) {
-            EcAISSetTargetTrackingStatus(td.feat, td._dictInfo, status, NULL);
+    EcFeature cachedFeat;
+    EcDictInfo *cachedDict = nullptr;
+    if (_aisTargets.feature(mmsi, cachedFeat, cachedDict)) {
+        if (ECOK(cachedFeat) && cachedDict) {
+            EcAISSetTargetTrackingStatus(cachedFeat, cachedDict, status, NULL);
+            touchCell();
             return;
         }
     }
@@ -741,9 +809,9 @@ void Ais::setTargetManualStatus(unsigned int mmsi, EcAISTrackingStatus status)
     EcFeature feat = EcAISFindTargetObject(_cid, _dictInfo, ti);
     if (ECOK(feat)) {
         EcAISSetTargetTrackingStatus(feat, _dictInfo, status, NULL);
+        touchCell();
         // Update cache
-        _aisTargetMap[mmsi].feat = feat;
-        _aisTargetMap[mmsi]._dictInfo = _dictInfo;
+        _aisTargets.setFeature(mmsi, feat, _dictInfo);
     }
 }
 
@@ -759,6 +827,11 @@ void Ais::emitSignalTarget( double lat, double lon )
 
 void Ais::stopAnimation()
 {
+  if( _logReplay )
+  {
+    _logReplay->close();
+  }
+
   _bReadFromFile = False;
   _bReadFromVariable = False;
   _bReadFromServer = False;
@@ -768,12 +841,17 @@ void Ais::stopAnimation()
   closeSocketConnection();
 }
 
-Ais* Ais::instance() {
-    return _myAis;
+AisLogReplay* Ais::logReplay()
+{
+  if( !_logReplay )
+  {
+    _logReplay = new AisLogReplay( this, this );
+  }
+  return _logReplay;
 }
 
-QMap<unsigned int, AISTargetData>& Ais::getTargetMap() {
-    return _aisTargetMap;
+Ais* Ais::instance() {
+    return _myAis;
 }
 
 AISTargetData& Ais::getOwnShipVar() {
@@ -846,13 +924,12 @@ void Ais::readAISLogfile( const QString &logFile )
     return;
   }
 
-  // NULL DECLARATION
-  EcDENC *denc = nullptr;
-  EcDictInfo *dictInfo = nullptr;
-  QWidget *parentWidget = nullptr;
-
   // Read AIS logfile line by line and add each line to the AIS transponder object by calling EcAISAddTransponderOutput.
   // EcAISAddTransponderOutput calls the callback AISTargetUpdateCallback for each line read from the logfile.
+  // UI (NMEA text, own ship panel) is refreshed once per frame, not per line.
+  IngestContext ctx;
+  beginIngest(ctx);
+
   int iLineNo = 1;
   QTextStream in( _fAisFile );
   while( in.atEnd() == False )
@@ -874,40 +951,116 @@ void Ais::readAISLogfile( const QString &logFile )
     QString nmea;
     nmeaSelection(sLine, nmea);
 
-    emit nmeaTextAppend(nmea);
-    extractNMEA(nmea);
+    if( ingestLine( ctx, nmea, nmea ) == false )
+    {
+      addLogFileEntry( QString( "Error in readAISLogfile(): EcAISAddTransponderOutput() failed in input line %1" ).arg( iLineNo ) );
+      break;
+    }
+
+    iLineNo++;
+  }
+
+  flushIngestUi( ctx, true );
+}
+
+void Ais::beginIngest(IngestContext &ctx)
+{
+    ctx.dvr = AisDvrSink::forKey();
+    ctx.dvrRecording = ctx.dvr && ctx.dvr->isRecording();
+    ctx.dvrBatch.clear();
+    ctx.pendingText.clear();
+    ctx.uiDirty = false;
+    ctx.frameClock.start();
+}
 
-    // OWNSHIP NMEA
-    PickWindow *pickWindow = new PickWindow(parentWidget, dictInfo, denc);
-    if (navShip.lat != 0 && ownShipText){
-        ownShipText->setHtml(pickWindow->ownShipAutoFill());
+bool Ais::ingestLine(IngestContext &ctx, const QString &transponderLine, const QString &displayLine)
+{
+    if (!ctx.ingestOnly) {
+        ctx.pendingText.append(displayLine.trimmed());
     }
+    extractNMEA(displayLine);
+
+    ctx.uiDirty = true;
 
-    // RECORD NMEA
-    IAisDvrPlugin* dvr = PluginManager::instance().getPlugin<IAisDvrPlugin>("IAisDvrPlugin");
+    // NMEA selalu ASCII, toLatin1 ke buffer yang dipakai ulang cukup
+    _transponderLine = transponderLine.toLatin1();
 
-    if (dvr && dvr->isRecording()) {
-        dvr->recordRawNmea(nmea);
+    // RECORD NMEA: byte yang sama dengan yang masuk transponder, dikirim per batch
+    if (ctx.dvrRecording) {
+        ctx.dvrBatch.append(_transponderLine.constData(), _transponderLine.size(),
+                            QDateTime::currentMSecsSinceEpoch());
+        if (ctx.dvrBatch.size() >= AIS_DVR_BATCH_LINES) {
+            ctx.dvrBatch.submit(ctx.dvr);
+        }
     }
 
-    // OWNSHIP RIGHT PANEL
-    if (navShip.lat != 0 && _cpaPanel){
-        _cpaPanel->updateOwnShipInfo(navShip.lat, navShip.lon, navShip.sog, navShip.heading_og);
+    if (EcAISAddTransponderOutput(_transponder, (unsigned char*)_transponderLine.data(), _transponderLine.size()) == False) {
+        return false;
     }
 
-    //qDebug() << nmea;
+    if (!ctx.ingestOnly && ctx.pendingText.size() >= AIS_UI_MAX_PENDING) {
+        flushIngestUi(ctx, true);
+    } else if (!ctx.ingestOnly) {
+        flushIngestUi(ctx, false);
+    }
+    return true;
+}
 
-    if( EcAISAddTransponderOutput( _transponder, (unsigned char*)nmea.toStdString().c_str(), nmea.count() ) == False )
-    {
-      addLogFileEntry( QString( "Error in readAISLogfile(): EcAISAddTransponderOutput() failed in input line %1" ).arg( iLineNo ) );
-      break;
+void Ais::flushIngestUi(IngestContext &ctx, bool force)
+{
+    if (!ctx.uiDirty) {
+        return;
+    }
+    if (!force && ctx.frameClock.elapsed() < AIS_UI_FRAME_MS) {
+        return;
     }
 
-    // hapus pickwindow
-    delete pickWindow;
+    if (ctx.dvr) {
+        ctx.dvrBatch.submit(ctx.dvr);
+        ctx.dvrRecording = ctx.dvr->isRecording();
+    }
 
-    iLineNo++;
-  }
+    if (!ctx.pendingText.isEmpty()) {
+        // Satu append untuk seluruh batch, satu paragraf per baris
+        emit nmeaTextAppend(ctx.pendingText.join(QLatin1Char('\n')));
+        ctx.pendingText.clear();
+    }
+
+    // Frame target dibekukan oleh tick 1 Hz EcWidget. Publish di sini membuat tulisan berikutnya
+    // men-detach semua kolom (termasuk cold/EcAISTargetInfo) tiap frame, jadi hanya dipakai
+    // sebagai cadangan kalau tick tidak berjalan (mis. tanpa subscriber MOOS).
+    if (!_publishClock.isValid() || _publishClock.elapsed() >= AIS_PUBLISH_IDLE_MS) {
+        publishTargets();
+    }
+
+    if (ctx.ownShipUi) {
+        refreshOwnShipUi();
+    }
+
+    ctx.uiDirty = false;
+    ctx.frameClock.restart();
+}
+
+void Ais::refreshOwnShipUi()
+{
+    // Ingest bisa jalan di luar thread GUI: widget & PickWindow hanya disentuh di thread GUI
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, [this]() { refreshOwnShipUi(); }, Qt::QueuedConnection);
+        return;
+    }
+
+    // OWNSHIP PANEL
+    if (navShip.lat != 0 && ownShipText) {
+        if (!_ownShipPick) {
+            _ownShipPick = new PickWindow(nullptr, nullptr, nullptr);
+        }
+        ownShipText->setHtml(_ownShipPick->ownShipAutoFill());
+    }
+
+    // OWNSHIP RIGHT PANEL
+    if (navShip.lat != 0 && _cpaPanel) {
+        _cpaPanel->updateOwnShipInfo(navShip.lat, navShip.lon, navShip.sog, navShip.heading_og);
+    }
 }
 
 void Ais::nmeaSelection(const QString &line, QString &outNmea) {
@@ -946,96 +1099,31 @@ void Ais::nmeaSelection(const QString &line, QString &outNmea) {
 }
 
 
-void Ais::readAISLogfileWDelay(const QString &logFile, int delayMs, std::atomic<bool>* stopFlag)
-{
-    _bReadFromFile = True;
-    _bReadFromVariable = False;
-    _bReadFromServer = False;
-
-    closeSocketConnection();
-
-    _fAisFile->setFileName(logFile);
-    if (_fAisFile->exists() == False) {
-        addLogFileEntry("Error in readAISLogfile(): AIS logfile doesn't exist.");
-        return;
-    }
-
-    if (_fAisFile->open(QIODevice::ReadOnly | QIODevice::Text) == False) {
-        addLogFileEntry(QString("Error in readAISLogfile(): Could not open AIS logfile: %1.").arg(logFile));
-        return;
-    }
-
-    if (!_transponder) {
-        addLogFileEntry("Error in readAISLogfile(): Transponder object is not initialized!");
-        return;
-    }
-
-    QTextStream in(_fAisFile);
-    QWidget *parentWidget = nullptr;
-    EcDictInfo *dictInfo = nullptr;
-    EcDENC *denc = nullptr;
-
-    int iLineNo = 1;
-    while (!in.atEnd())
-    {
-        if (!_bReadFromFile || !_transponder || (stopFlag && stopFlag->load())) {
-            break;
-        }
-
-        QString sLine = in.readLine().append("\r\n");
-
-        emit nmeaTextAppend(sLine);
-        extractNMEA(sLine);
-
-        PickWindow *pickWindow = new PickWindow(parentWidget, dictInfo, denc);
-        if (navShip.lat != 0 && ownShipText) {
-            ownShipText->setHtml(pickWindow->ownShipAutoFill());
-        }
-
-        IAisDvrPlugin* dvr = PluginManager::instance().getPlugin<IAisDvrPlugin>("IAisDvrPlugin");
-        if (dvr && dvr->isRecording()) {
-            dvr->recordRawNmea(sLine);
-        }
-
-        if (navShip.lat != 0 && _cpaPanel) {
-            _cpaPanel->updateOwnShipInfo(navShip.lat, navShip.lon, navShip.sog, navShip.heading_og);
-        }
-
-        if (!EcAISAddTransponderOutput(_transponder, (unsigned char*)sLine.toStdString().c_str(), sLine.count())) {
-            addLogFileEntry(QString("Error in readAISLogfile(): EcAISAddTransponderOutput() failed at line %1").arg(iLineNo));
-            delete pickWindow;
-            break;
-        }
-
-        delete pickWindow;
-        iLineNo++;
-
-        if (delayMs > 0)
-            QThread::msleep(delayMs);
-    }
-
-    _fAisFile->close();
-}
-
-
 void Ais::extractNMEA(QString nmea){
     if (nmea.contains("!AIVDO")){
         auto setIfValid = [&](double &field, double v) {
             if (v != -1) field = v;
         };
 
-        setIfValid(navShip.lat, AisDecoder::decodeAisOption(nmea, "latitude",  "!AIVDO"));
-        setIfValid(navShip.lon, AisDecoder::decodeAisOption(nmea, "longitude", "!AIVDO"));
-        setIfValid(navShip.sog, AisDecoder::decodeAisOption(nmea, "sog", "!AIVDO") / 10.0);
-        setIfValid(navShip.course_og, AisDecoder::decodeAisOption(nmea, "cog", "!AIVDO") / 10.0);
-        setIfValid(navShip.heading, AisDecoder::decodeAisOption(nmea, "heading", "!AIVDO"));
+        // Decode sekali saja, bukan per field
+        AisData data;
+        if (!nmea.startsWith("!AIVDO") || !AisDecoder::decode(nmea, data)) {
+            data = AisData();
+        }
+
+        setIfValid(navShip.lat, data.latitude);
+        setIfValid(navShip.lon, data.longitude);
+        setIfValid(navShip.sog, data.sog / 10.0);
+        setIfValid(navShip.course_og, data.cog / 10.0);
+        setIfValid(navShip.heading, data.heading);
     }
 }
 
 void Ais::clearTargetData()
 {
-    _aisTargetMap.clear();
+    _aisTargets.clear();
     _aisTargetInfoMap.clear();
+    _targetAging.clear();
 
     if (_transponder)
     {
@@ -1070,12 +1158,7 @@ Bool Ais::recreateTransponder()
 void Ais::resetTransponderPreserveTargets()
 {
     // Invalidate feature handles so UI code won't touch stale features
-    for (auto it = _aisTargetMap.begin(); it != _aisTargetMap.end(); ++it) {
-        it.value().feat.id = EC_NOCELLID; // mark invalid
-        it.value().feat.offset = 0;
-        // ensure dictInfo set for rebuilds if needed
-        it.value()._dictInfo = _dictInfo;
-    }
+    _aisTargets.invalidateFeatures(_dictInfo);
 
     // Do not clear transponder targets here to avoid library-side race during reconnect.
     // We rely on incoming AIVDM to refresh existing targets in place.
@@ -1101,13 +1184,13 @@ void Ais::readAISVariable( const QStringList &dataLines )
         return;
     }
 
-    // NULL DECLARATION
-    EcDENC *denc = nullptr;
-    EcDictInfo *dictInfo = nullptr;
-    QWidget *parentWidget = nullptr;
-
     // Read AIS logfile line by line and add each line to the AIS transponder object by calling EcAISAddTransponderOutput.
     // EcAISAddTransponderOutput calls the callback AISTargetUpdateCallback for each line read from the logfile.
+    IngestContext ctx;
+    beginIngest(ctx);
+    ctx.dvr = nullptr; // jalur variable tidak pernah merekam ke DVR
+    ctx.dvrRecording = false;
+
     int iLineNo = 1;
     // for( const QString &sLine : dataLines )
     foreach (const QString &sLine, dataLines)
@@ -1122,24 +1205,7 @@ void Ais::readAISVariable( const QStringList &dataLines )
             break;
         }
 
-        QString line = sLine + "\r\n";
-        emit nmeaTextAppend(sLine);
-        extractNMEA(sLine);
-
-        // qDebug() << sLine;
-
-        // OWNSHIP PANEL
-        PickWindow *pickWindow = new PickWindow(parentWidget, dictInfo, denc);
-
-        if (navShip.lat != 0 && ownShipText){
-            ownShipText->setHtml(pickWindow->ownShipAutoFill());
-            if (_cpaPanel){
-                _cpaPanel->updateOwnShipInfo(navShip.lat, navShip.lon, navShip.sog, navShip.heading_og);
-            }
-        }
-
-        std::string lineStd = line.toStdString();
-        if( EcAISAddTransponderOutput( _transponder, (unsigned char*)lineStd.c_str(), line.count() ) == False )
+        if( ingestLine( ctx, sLine + "\r\n", sLine ) == false )
         {
             addLogFileEntry( QString( "Error in readAISLogfile(): EcAISAddTransponderOutput() failed in input line %1" ).arg( iLineNo ) );
             break;
@@ -1148,6 +1214,7 @@ void Ais::readAISVariable( const QStringList &dataLines )
         iLineNo++;
     }
 
+    flushIngestUi( ctx, true );
     stopAnimation();
 }
 
@@ -1221,34 +1288,27 @@ void Ais::readAISVariableString( const QString &data )
         return;
     }
 
-    if( _bReadFromVariable == False )
+    // Satu kalimat per panggilan (live & playback), lewat jalur ingest-only yang sama
+    // dengan batch: hanya transponder & target store, publish target digabung per frame
+    if( !_streamIngestStarted )
     {
-        addLogFileEntry( QString( "Error in readAISVariable(): Read from AIS variable permitted!" ) );
-        return;
+        beginIngest( _streamIngest );
+        _streamIngest.dvr = nullptr;  // feed ini merekam DVR sendiri (processAis / playback)
+        _streamIngest.dvrRecording = false;
+        _streamIngest.ingestOnly = true;
+        _streamIngest.ownShipUi = false;
+        _streamIngestStarted = true;
     }
 
-    // Read AIS logfile line by line and add each line to the AIS transponder object by calling EcAISAddTransponderOutput.
-    // EcAISAddTransponderOutput calls the callback AISTargetUpdateCallback for each line read from the logfile.
-    int iLineNo = 1;
-    // for( const QString &sLine : dataLines )
-
-    if( _bReadFromVariable == False )
-    {
-        return;
-    }
-
-    if( _transponder == NULL )
+    if( ingestLine( _streamIngest, data + "\r\n", data ) == false )
     {
+        addLogFileEntry( QString( "Error in readAISVariableString(): EcAISAddTransponderOutput() failed!" ) );
         return;
     }
 
-    QString line = data + "\r\n";
-    extractNMEA(line);
-
-    if( EcAISAddTransponderOutput( _transponder, (unsigned char*)line.toStdString().c_str(), line.count() ) == False )
+    if( _streamIngest.uiDirty && !_streamFlushTimer.isActive() && QThread::currentThread() == thread() )
     {
-        addLogFileEntry( QString( "Error in readAISLogfile(): EcAISAddTransponderOutput() failed in input line %1" ).arg( iLineNo ) );
-        return;
+        _streamFlushTimer.start();
     }
 
     stopAnimation();
@@ -1449,6 +1509,7 @@ void Ais::addLogFileEntry( const QString &str )
 void Ais::deleteObject()
 {
     EcObjectDelete(_featureOwnShip);
+    touchCell();
 }
 
 void Ais::setOwnShipNull()
@@ -1477,6 +1538,7 @@ void Ais::deleteOldOwnShipFeature()
 
         // Hapus feature object
         EcFeatureDelete(_featureOwnShip);
+        touchCell();
 
         // Jangan reset handle, biarkan sistem yang handle
         qDebug() << "Old ownship feature deleted successfully";
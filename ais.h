@@ -15,6 +15,9 @@
 #include <QApplication>
 #include <QEvent>
 #include <QKeyEvent>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <atomic>
 
 
 // SevenCs Kernel EC2007
@@ -27,13 +30,22 @@
 
 #include <eckernel.h>
 #include <ecwidget.h>
+#include "aistargetstore.h"
+#include "timingwheel.h"
+#include "aisdvrsink.h"
 
 #define LINEMAX 1024
-#define OBJ_CLEAN_TIME      (10*60)
+#define OBJ_CLEAN_TIME      (10*60)     // detik tanpa update sebelum target dibuang
+#define AIS_AGING_TICK_MS   250         // resolusi timing wheel umur target
 #define DEFAULT_LAT     -7.18551
 #define DEFAULT_LON     112.78012
+#define AIS_UI_FRAME_MS     33      // refresh UI paling cepat 1x per frame (~30 fps)
+#define AIS_UI_MAX_PENDING  500     // batas baris NMEA yang ditahan sebelum dipaksa flush
+#define AIS_PUBLISH_IDLE_MS 2000    // ingest publish sendiri hanya kalau tick 1 Hz diam selama ini
 
 class Ais;
+class AisLogReplay;
+class PickWindow;
 
 // For AIS Callback.
 ////////////////////
@@ -65,7 +77,6 @@ public:
 
     Bool createTransponderObject();
     void readAISLogfile( const QString& );
-    void readAISLogfileWDelay(const QString &logFile, int delayMs, std::atomic<bool>* stopFlag);
     void readAISVariableString( const QString& );
     void readAISVariable( const QStringList& );
     void readAISVariableThread( const QStringList& );
@@ -103,10 +114,34 @@ public:
 
     // CPA TCPA
     void setCPAPanel(CPATCPAPanel* panel) { _cpaPanel = panel; }
-    QMap<unsigned int, AISTargetData>& getTargetMap();
     AISTargetData& getOwnShipVar();
 
-    QMap<unsigned int, AISTargetData> _aisTargetMap;
+    // Target AIS: ditulis di store live, dibaca lewat frame yang dipublish per tick
+    AisTargetStore& targetStore() { return _aisTargets; }
+    AisTargetSnapshot targetSnapshot() const { return _aisTargets.snapshot(); }
+    const AisTargetSnapshot& publishTargets();
+    // Naik setiap kali isi AIS cell berubah (update transponder, status, expire);
+    // dipakai EcWidget sebagai key cache layer AIS
+    quint64 cellRevision() const { return _cellRevision.load(std::memory_order_relaxed); }
+
+    // Replay log berdasarkan timestamp (play/pause/seek/speed); dibuat saat pertama dipakai
+    AisLogReplay* logReplay();
+
+    // Simpan update target dan jadwalkan ulang lost/expire-nya
+    void storeTarget(quint32 mmsi, const AISTargetData &data);
+    // Proses target yang lost/expired sampai nowMs dalam satu batch
+    int expireTargets(qint64 nowMs);
+
+    // Jam umur target: waktu data selama replay (log, DB), jam dinding saat live.
+    // Replay memajukan jam ini per baris/record; 0 = kembali ke jam dinding.
+    void setReplayClock(qint64 msSinceEpoch);
+    qint64 agingClockMs() const;
+    // Jam untuk dead reckoning (GUI thread): sama dengan agingClockMs(), tapi saat replay log
+    // pakai jam virtual player yang terus maju di antara baris sesuai kecepatan replay
+    qint64 dataClockMs() const;
+
+    AisTargetStore _aisTargets;
+    QElapsedTimer _publishClock;        // sejak publishTargets() terakhir
     QMap<unsigned int, EcAISTargetInfo> _aisTargetInfoMap;
     QDateTime _latestNmeaTime; // Timestamp untuk memastikan NMEA masih fresh
     static QString _latestNmea; // Cache untuk NMEA terakhir yang masuk
@@ -148,6 +183,7 @@ signals:
     void pickWindowOwnship();
 
     void targetUpdateReceived(AISTargetData info);
+    void targetsExpired(const QVector<unsigned int> &mmsis);
 
 private slots:
     void slotReadAISServerData();
@@ -193,12 +229,56 @@ private:
     void handleOwnShipUpdate(EcAISTargetInfo *ti);
     void handleAISTargetUpdate(EcAISTargetInfo *ti);
 
-    QDateTime lastTrailDrawTime;
-
     // Recording status tracking
     bool _lastRecordingState = false;
     void updateRecordingStatusUI(bool shouldRecord, const QString& reason = QString());
 
+    // Batched ingest (readAISLogfile / AisLogReplay / readAISVariable)
+    friend class AisLogReplay;
+    AisLogReplay *_logReplay = nullptr;
+
+    struct IngestContext {
+        AisDvrSink *dvr = nullptr;      // di-resolve sekali per batch
+        bool dvrRecording = false;      // dicek ulang tiap flush, bukan per baris
+        AisDvrBatch dvrBatch;           // baris DVR, dikirim sekali per frame UI
+        QStringList pendingText;        // NMEA yang belum dikirim ke nmeaTextAppend
+        bool uiDirty = false;
+        // Ingest-only: baris hanya masuk ke transponder & target store, tanpa teks NMEA;
+        // UI di-refresh sekali per frame / akhir batch. Dipakai feed live dan replay.
+        bool ingestOnly = false;
+        bool ownShipUi = true;          // false: panel own ship tidak disentuh (feed per kalimat)
+        QElapsedTimer frameClock;
+    };
+
+    void beginIngest(IngestContext &ctx);
+    bool ingestLine(IngestContext &ctx, const QString &transponderLine, const QString &displayLine);
+    void flushIngestUi(IngestContext &ctx, bool force);
+    // Panel own ship & CPA; PickWindow hanya dibuat/dipakai di thread GUI
+    void refreshOwnShipUi();
+
+    // Feed per kalimat (readAISVariableString: subscriber live, playback DB/log):
+    // konteks ingest-only yang dipakai terus, flush UI sekali per frame lewat timer
+    IngestContext _streamIngest;
+    bool _streamIngestStarted = false;
+    QTimer _streamFlushTimer;
+
+    PickWindow *_ownShipPick = nullptr;  // dipakai ulang untuk ownShipAutoFill()
+    QByteArray _transponderLine;         // buffer baris untuk EcAISAddTransponderOutput
+
+    // Umur target: satu timing wheel untuk transisi lost dan expire semua target
+    enum AgingEvent : quint64 {
+        AgingLost = 1,
+        AgingExpire = 2
+    };
+    static quint64 agingKey(AgingEvent event, quint32 mmsi) { return (quint64(event) << 32) | mmsi; }
+
+    void touchCell() { _cellRevision.fetch_add(1, std::memory_order_relaxed); }
+    std::atomic<quint64> _cellRevision{0};   // callback transponder bisa dari thread lain
+
+    TimingWheel _targetAging{AIS_AGING_TICK_MS};
+    std::atomic<qint64> _replayClockMs{0};
+    QVector<quint64> _dueAging;
+
     struct OwnShipSnapshot {
         double lat = 0;
         double lon = 0;
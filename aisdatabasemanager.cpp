@@ -1,5 +1,6 @@
 #include "aisdatabasemanager.h"
 #include "SettingsDialog.h"
+#include "aisfragmentassembler.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -7,8 +8,12 @@
 #include <QDir>
 #include <QFile>
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRegularExpression>
 
-AisDatabaseManager::AisDatabaseManager() : asyncProcessingTimer(nullptr) {
+AisDatabaseManager::AisDatabaseManager()
+    : asyncProcessingTimer(nullptr), maintenanceThread(nullptr), maintenanceStop(false), partitioned(false),
+      keyframesReady(false), keyframeChained(false), trackCache(TRACK_CACHE_MAX_POINTS) {
     qDebug() << "AisDatabaseManager initialized with high-performance async processing";
 
     // Setup async processing timer
@@ -24,6 +29,11 @@ AisDatabaseManager::AisDatabaseManager() : asyncProcessingTimer(nullptr) {
 AisDatabaseManager::~AisDatabaseManager() {
     qDebug() << "[AIS DATABASE MANAGER] Destructor START";
 
+    // Maintenance dulu (thread itu yang menyalakan writer), lalu flush sisa antrian
+    // recording selagi koneksi default masih ada
+    stopMaintenance();
+    recordWriter.stop();
+
     // CRITICAL: Stop async timer first to prevent race conditions
     // DO NOT delete the timer - it may be in an invalid state during static destruction
     if (asyncProcessingTimer) {
@@ -44,6 +54,7 @@ AisDatabaseManager::~AisDatabaseManager() {
 
     // Close database connection if still open
     try {
+        statements.invalidate();
         if (db.isOpen()) {
             db.close();
         }
@@ -155,6 +166,9 @@ bool AisDatabaseManager::connect(const QString& host, int port, const QString& d
         return false;
     }
 
+    // Prepared statement lama milik koneksi yang akan diganti
+    statements.invalidate();
+
     db = QSqlDatabase::addDatabase("QPSQL");
     db.setHostName(host);
     db.setPort(port);
@@ -183,6 +197,11 @@ bool AisDatabaseManager::connect(const QString& host, int port, const QString& d
         qDebug() << "Database:" << db.databaseName();
         qDebug() << "Host:" << db.hostName();
         qDebug() << "=================================";
+
+        // Skema (migrasi partisi bisa rename tabel) disiapkan thread maintenance,
+        // yang menyalakan writer setelahnya; GUI tidak menunggu
+        setupPerformanceOptimizations();
+        startMaintenance();
     }
     return connected;
 }
@@ -208,6 +227,10 @@ bool AisDatabaseManager::connectFromSettings()
 
 void AisDatabaseManager::disconnect()
 {
+    stopMaintenance();
+    recordWriter.stop();
+    statements.invalidate();
+
     if (db.isOpen()) {
         db.close();
         qDebug() << "AisDatabaseManager: Disconnected from database";
@@ -219,6 +242,32 @@ bool AisDatabaseManager::isConnected() const
     return db.isOpen();
 }
 
+QString AisDatabaseManager::statementLatencyReport() const
+{
+    return QString("[main]\n%1[writer]\n%2[maintenance]\n%3")
+        .arg(statements.latencyReport(), recordWriter.latencyReport(), maintenanceStatements.latencyReport());
+}
+
+QSqlDatabase AisDatabaseManager::openThreadConnection(const QString& connectionName)
+{
+    QSqlDatabase conn = QSqlDatabase::cloneDatabase(QLatin1String(QSqlDatabase::defaultConnection), connectionName);
+    if (!conn.open()) {
+        qWarning() << "Thread connection" << connectionName << "failed:" << conn.lastError().text();
+    }
+    return conn;
+}
+
+void AisDatabaseManager::closeThreadConnection(const QString& connectionName)
+{
+    {
+        QSqlDatabase conn = QSqlDatabase::database(connectionName, false);
+        if (conn.isOpen()) {
+            conn.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
 void AisDatabaseManager::insertOrUpdateAisTarget(const EcAISTargetInfo& info) {
     QSqlQuery query;
     QString sql = R"(
@@ -436,8 +485,7 @@ bool AisDatabaseManager::insertNmeaRecord(const QString& nmea, const QString& da
     QString vesselName = extractVesselNameFromNmea(nmea);
     QString rawDataType = determineDataType(nmea);
 
-    QSqlQuery query(db);
-    QString sql = R"(
+    QSqlQuery* query = statements.statement("insert_nmea_record", R"(
         INSERT INTO nmea_records (
             timestamp, nmea, data_source, mmsi, message_type,
             vessel_name, raw_data_type, session_id, parsed_successfully
@@ -445,24 +493,25 @@ bool AisDatabaseManager::insertNmeaRecord(const QString& nmea, const QString& da
             ?, ?, ?, ?, ?,
             ?, ?, ?, ?
         )
-    )";
-
-    query.prepare(sql);
+    )");
+    if (!query) {
+        return false;
+    }
 
     // Bind all parameters in order
-    query.addBindValue(QDateTime::currentDateTimeUtc());
-    query.addBindValue(nmea);
-    query.addBindValue(dataSource);
-    query.addBindValue(extractedMmsi > 0 ? QVariant(extractedMmsi) : QVariant());
-    query.addBindValue(msgType.toInt() > 0 ? QVariant(msgType.toInt()) : QVariant());
-    query.addBindValue(!vesselName.isEmpty() ? QVariant(vesselName) : QVariant());
-    query.addBindValue(rawDataType);
-    query.addBindValue(currentSessionId.isNull() ? QVariant() : currentSessionId);
-    query.addBindValue(true);
-
-    if (!query.exec()) {
-        qWarning() << "NMEA record insert failed:" << query.lastError().text();
-        qWarning() << "Executed query:" << query.executedQuery();
+    query->bindValue(0, SqlStatementRegistry::timestamp(QDateTime::currentDateTimeUtc()));
+    query->bindValue(1, nmea);
+    query->bindValue(2, dataSource);
+    query->bindValue(3, SqlStatementRegistry::mmsi(extractedMmsi));
+    query->bindValue(4, msgType.toInt() > 0 ? QVariant(msgType.toInt()) : QVariant(QVariant::Int));
+    query->bindValue(5, SqlStatementRegistry::text(vesselName));
+    query->bindValue(6, rawDataType);
+    query->bindValue(7, currentSessionId.isNull() ? QVariant() : QVariant(currentSessionId));
+    query->bindValue(8, true);
+
+    if (!statements.exec("insert_nmea_record")) {
+        qWarning() << "NMEA record insert failed:" << query->lastError().text();
+        qWarning() << "Executed query:" << query->executedQuery();
         return false;
     }
 
@@ -534,6 +583,15 @@ bool AisDatabaseManager::insertParsedAisDataRev(const QString& nmea, const QStri
     return success;
 }
 
+bool AisDatabaseManager::insertParsedAisDataRev(const AisAssembledMessage& message, const QString& dataSource,
+                                             quint32 mmsi, const EcAISTargetInfo& targetInfo)
+{
+    bool success = true;
+    for (int i = 0; i < message.fragmentCount; ++i) {
+        success = insertParsedAisDataRev(message.fragmentString(i), dataSource, mmsi, targetInfo) && success;
+    }
+    return success;
+}
 
 bool AisDatabaseManager::insertParsedOwnshipData(const QString& nmea, const QString& dataSource,
                                                 double lat, double lon, double sog, double cog, double heading)
@@ -632,6 +690,7 @@ void AisDatabaseManager::getCombinedNmeaData(QSqlQuery& query, const QDateTime&
         SELECT timestamp, nmea, data_source
         FROM nmea_records
         WHERE timestamp BETWEEN ? AND ?
+          AND received_at >= ? AND received_at < ?
           AND data_source IN (%1)
         ORDER BY timestamp ASC
     )").arg(sourceFilter);
@@ -639,6 +698,8 @@ void AisDatabaseManager::getCombinedNmeaData(QSqlQuery& query, const QDateTime&
     query.prepare(sql);
     query.addBindValue(startTime);
     query.addBindValue(endTime);
+    query.addBindValue(startTime.addDays(-RECEIVED_AT_SLACK_DAYS));
+    query.addBindValue(endTime.addDays(RECEIVED_AT_SLACK_DAYS));
 
     if (!query.exec()) {
         qWarning() << "Failed to retrieve combined NMEA data:" << query.lastError().text();
@@ -653,6 +714,7 @@ void AisDatabaseManager::getNmeaDataWithFilter(QSqlQuery& query, const QDateTime
     QStringList conditions;
     QStringList bindValues;
     conditions << "timestamp BETWEEN ? AND ?";
+    conditions << "received_at >= ? AND received_at < ?";
     bindValues << startTime.toString(Qt::ISODate) << endTime.toString(Qt::ISODate);
 
     if (!dataSources.isEmpty()) {
@@ -679,6 +741,8 @@ void AisDatabaseManager::getNmeaDataWithFilter(QSqlQuery& query, const QDateTime
     query.prepare(sql);
     query.addBindValue(startTime);
     query.addBindValue(endTime);
+    query.addBindValue(startTime.addDays(-RECEIVED_AT_SLACK_DAYS));
+    query.addBindValue(endTime.addDays(RECEIVED_AT_SLACK_DAYS));
 
     if (!query.exec()) {
         qWarning() << "Failed to retrieve filtered NMEA data:" << query.lastError().text();
@@ -793,10 +857,6 @@ QString AisDatabaseManager::determineDataType(const QString& nmea)
     }
 }
 
-// Throttling variables initialization
-QDateTime AisDatabaseManager::lastAisRecordTime;
-QDateTime AisDatabaseManager::lastOwnshipRecordTime;
-
 // ========================================
 // HIGH-PERFORMANCE ASYNC PROCESSING
 // ========================================
@@ -818,6 +878,589 @@ void AisDatabaseManager::setupPerformanceOptimizations() {
     qDebug() << "High-performance mode enabled - capable of 60+ records/second";
 }
 
+// ========================================
+// TIME-PARTITIONED STORAGE
+// ========================================
+
+static QString dailyPartitionName(const QDate& day)
+{
+    return QString("nmea_records_p%1").arg(day.toString("yyyyMMdd"));
+}
+
+static QDateTime truncateToMinute(const QDateTime& t)
+{
+    QDateTime minute = t;
+    minute.setTime(QTime(t.time().hour(), t.time().minute()));
+    return minute;
+}
+
+void AisDatabaseManager::setupPartitioning()
+{
+    {
+        QMutexLocker locker(&maintenanceStateMutex);
+        partitioned = false;
+        rollupStart = QDateTime();
+        rollupWatermark = QDateTime();
+    }
+    firstDailyPartition = QDate();
+    partitionsReadyUntil = QDate();
+
+    if (!maintenanceDb.isOpen()) {
+        return;
+    }
+
+    QSqlQuery query(maintenanceDb);
+    if (!query.exec("SHOW server_version_num") || !query.next() || query.value(0).toInt() < 110000) {
+        qWarning() << "[PARTITION] PostgreSQL 11+ required, nmea_records stays a single table";
+        return;
+    }
+
+    // relkind: 'r' = tabel biasa (skema lama), 'p' = sudah dipartisi
+    QString relkind;
+    if (query.exec("SELECT c.relkind FROM pg_class c JOIN pg_namespace n ON n.oid = c.relnamespace "
+                   "WHERE c.relname = 'nmea_records' AND n.nspname = current_schema()") && query.next()) {
+        relkind = query.value(0).toString();
+    }
+    if (relkind == "r") {
+        if (!migrateToPartitionedTable()) {
+            return;
+        }
+    } else if (relkind != "p") {
+        qWarning() << "[PARTITION] nmea_records not found, skipping partition setup";
+        return;
+    }
+    {
+        QMutexLocker locker(&maintenanceStateMutex);
+        partitioned = true;
+    }
+
+    // Partisi harian hanya boleh mulai setelah batas atas partisi legacy
+    if (query.exec("SELECT pg_get_expr(c.relpartbound, c.oid) FROM pg_class c "
+                   "WHERE c.relname = 'nmea_records_legacy' AND c.relispartition") && query.next()) {
+        const QRegularExpressionMatch m = QRegularExpression("TO \\('(\\d{4}-\\d{2}-\\d{2})").match(query.value(0).toString());
+        if (m.hasMatch()) {
+            firstDailyPartition = QDate::fromString(m.captured(1), "yyyy-MM-dd");
+        }
+    }
+
+    // BRIN: beberapa KB per partisi, tidak perlu reindex, cocok untuk data yang masuk berurutan waktu.
+    // Default partition menampung baris di luar partisi harian (jam sistem loncat) supaya insert tidak gagal.
+    const QStringList ddl = {
+        "CREATE INDEX IF NOT EXISTS nmea_records_received_at_brin ON nmea_records "
+        "USING brin (received_at) WITH (pages_per_range = 32)",
+        "CREATE INDEX IF NOT EXISTS nmea_records_timestamp_brin ON nmea_records "
+        "USING brin (timestamp) WITH (pages_per_range = 32)",
+        "CREATE TABLE IF NOT EXISTS nmea_records_default PARTITION OF nmea_records DEFAULT",
+        "CREATE TABLE IF NOT EXISTS nmea_position_minute ("
+        "  minute timestamp NOT NULL,"
+        "  mmsi bigint NOT NULL,"
+        "  latitude double precision,"
+        "  longitude double precision,"
+        "  speed_over_ground double precision,"
+        "  course_over_ground double precision,"
+        "  true_heading double precision,"
+        "  samples integer NOT NULL,"
+        "  PRIMARY KEY (mmsi, minute))",
+        "CREATE INDEX IF NOT EXISTS nmea_position_minute_brin ON nmea_position_minute USING brin (minute)"
+    };
+    for (const QString& sql : ddl) {
+        if (!query.exec(sql)) {
+            qWarning() << "[PARTITION] Setup statement failed:" << query.lastError().text();
+            qWarning() << "SQL:" << sql.left(100);
+        }
+    }
+
+    const QDate today = QDateTime::currentDateTimeUtc().date();
+    ensureDailyPartitions(today.addDays(-1), today.addDays(PARTITION_DAYS_AHEAD));
+    qDebug() << "✓ nmea_records partitioned by day, partitions ready until" << partitionsReadyUntil;
+}
+
+bool AisDatabaseManager::migrateToPartitionedTable()
+{
+    // Satu kali: tabel lama di-rename dan dipasang utuh sebagai partisi (MINVALUE, cutover).
+    // Index B-tree lama tetap di partisi legacy; partisi baru hanya memakai BRIN.
+    qWarning() << "[PARTITION] Converting nmea_records to daily partitions (one-time migration)...";
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery query(maintenanceDb);
+    auto run = [&query](const QString& sql) {
+        if (!query.exec(sql)) {
+            qWarning() << "[PARTITION] Migration failed:" << query.lastError().text();
+            qWarning() << "SQL:" << sql.left(100);
+            return false;
+        }
+        return true;
+    };
+
+    maintenanceDb.transaction();
+
+    // Range partition tidak menerima kunci NULL (baris lama dari jalur insert tanpa received_at)
+    if (!run("UPDATE nmea_records SET received_at = COALESCE(timestamp, now()) WHERE received_at IS NULL")) {
+        maintenanceDb.rollback();
+        return false;
+    }
+
+    QDate cutover = QDateTime::currentDateTimeUtc().date();
+    if (run("SELECT max(received_at) FROM nmea_records") && query.next() && !query.value(0).isNull()) {
+        cutover = qMax(cutover, query.value(0).toDate().addDays(1));
+    }
+
+    const bool ok = run("ALTER TABLE nmea_records RENAME TO nmea_records_legacy")
+                    && run("CREATE TABLE nmea_records (LIKE nmea_records_legacy INCLUDING DEFAULTS INCLUDING CONSTRAINTS) "
+                           "PARTITION BY RANGE (received_at)")
+                    && run(QString("ALTER TABLE nmea_records ATTACH PARTITION nmea_records_legacy "
+                                   "FOR VALUES FROM (MINVALUE) TO ('%1')").arg(cutover.toString("yyyy-MM-dd")));
+    if (!ok || !maintenanceDb.commit()) {
+        maintenanceDb.rollback();
+        return false;
+    }
+
+    qWarning() << "[PARTITION] Migration done in" << timer.elapsed() << "ms, legacy rows end before" << cutover;
+    return true;
+}
+
+void AisDatabaseManager::ensureDailyPartitions(const QDate& from, const QDate& to)
+{
+    if (!partitioned || !maintenanceDb.isOpen()) {
+        return;
+    }
+
+    QDate day = from;
+    if (firstDailyPartition.isValid() && day < firstDailyPartition) {
+        day = firstDailyPartition;
+    }
+    if (partitionsReadyUntil.isValid() && day <= partitionsReadyUntil) {
+        day = partitionsReadyUntil.addDays(1);
+    }
+
+    // Hari yang gagal dilewati (bukan berhenti); partitionsReadyUntil hanya maju selama
+    // belum ada yang gagal, jadi hari itu dicoba lagi di tick berikutnya
+    bool gap = false;
+    QSqlQuery query(maintenanceDb);
+    for (; day <= to; day = day.addDays(1)) {
+        const QString sql = QString("CREATE TABLE IF NOT EXISTS %1 PARTITION OF nmea_records "
+                                    "FOR VALUES FROM ('%2') TO ('%3')")
+                                .arg(dailyPartitionName(day),
+                                     day.toString("yyyy-MM-dd"),
+                                     day.addDays(1).toString("yyyy-MM-dd"));
+        if (!query.exec(sql)) {
+            // Biasanya default partition sudah berisi baris untuk hari itu
+            qWarning() << "[PARTITION] Create" << dailyPartitionName(day) << "failed:" << query.lastError().text();
+            if (!createPartitionFromDefault(day)) {
+                qWarning() << "[PARTITION] Skipping" << day << ", retry next maintenance tick";
+                gap = true;
+                continue;
+            }
+        }
+        if (!gap) {
+            partitionsReadyUntil = day;
+        }
+    }
+}
+
+bool AisDatabaseManager::createPartitionFromDefault(const QDate& day)
+{
+    // Baris hari itu di default partition dipindah ke partisi harian baru. Default dilepas
+    // selama pemindahan supaya ATTACH tidak ditolak karena constraint-nya; satu transaksi,
+    // jadi insert writer ke nmea_records menunggu sebentar, tidak pernah gagal.
+    const QString name = dailyPartitionName(day);
+    const QString from = day.toString("yyyy-MM-dd");
+    const QString to = day.addDays(1).toString("yyyy-MM-dd");
+    const QStringList steps = {
+        "ALTER TABLE nmea_records DETACH PARTITION nmea_records_default",
+        QString("CREATE TABLE %1 PARTITION OF nmea_records FOR VALUES FROM ('%2') TO ('%3')").arg(name, from, to),
+        QString("WITH moved AS (DELETE FROM nmea_records_default "
+                "WHERE received_at >= '%2' AND received_at < '%3' RETURNING *) "
+                "INSERT INTO %1 SELECT * FROM moved").arg(name, from, to),
+        "ALTER TABLE nmea_records ATTACH PARTITION nmea_records_default DEFAULT"
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery query(maintenanceDb);
+    maintenanceDb.transaction();
+    for (const QString& sql : steps) {
+        if (!query.exec(sql)) {
+            qWarning() << "[PARTITION] Move from default failed:" << query.lastError().text();
+            qWarning() << "SQL:" << sql.left(100);
+            maintenanceDb.rollback();
+            return false;
+        }
+    }
+    if (!maintenanceDb.commit()) {
+        qWarning() << "[PARTITION] Move from default commit failed:" << maintenanceDb.lastError().text();
+        maintenanceDb.rollback();
+        return false;
+    }
+
+    qWarning() << "[PARTITION] Created" << name << "from default partition in" << timer.elapsed() << "ms";
+    return true;
+}
+
+void AisDatabaseManager::rollupPositions()
+{
+    if (!partitioned || !maintenanceDb.isOpen()) {
+        return;
+    }
+
+    const QDateTime upper = truncateToMinute(QDateTime::currentDateTimeUtc().addSecs(-ROLLUP_LAG_SECS));
+
+    // State ini hanya ditulis di thread maintenance; lock untuk pembaca di thread GUI
+    if (!rollupWatermark.isValid()) {
+        QDateTime start, watermark;
+        QSqlQuery query(maintenanceDb);
+        if (query.exec("SELECT min(minute), max(minute) FROM nmea_position_minute") && query.next()
+            && !query.value(1).isNull()) {
+            // Kolom timestamp tanpa zona berisi jam UTC
+            start = query.value(0).toDateTime();
+            start.setTimeSpec(Qt::UTC);
+            QDateTime last = query.value(1).toDateTime();
+            last.setTimeSpec(Qt::UTC);
+            watermark = last.addSecs(60);
+        } else {
+            // Tabel rollup baru: isi mundur satu hari saja, data lebih lama tetap dari nmea_records
+            watermark = truncateToMinute(upper.addDays(-1));
+            start = watermark;
+        }
+        QMutexLocker locker(&maintenanceStateMutex);
+        rollupStart = start;
+        rollupWatermark = watermark;
+    }
+    if (rollupWatermark >= upper) {
+        return;
+    }
+    const QDateTime chunkEnd = qMin(upper, rollupWatermark.addSecs(ROLLUP_MAX_MINUTES * 60));
+
+    // Posisi terakhir yang valid per MMSI per menit; predikat received_at memangkas partisi
+    QSqlQuery* query = maintenanceStatements.statement("rollup_position_minute", R"(
+        INSERT INTO nmea_position_minute (minute, mmsi, latitude, longitude,
+                                          speed_over_ground, course_over_ground, true_heading, samples)
+        SELECT date_trunc('minute', received_at), mmsi,
+               (array_agg(latitude ORDER BY received_at DESC) FILTER (WHERE latitude IS NOT NULL))[1],
+               (array_agg(longitude ORDER BY received_at DESC) FILTER (WHERE longitude IS NOT NULL))[1],
+               (array_agg(speed_over_ground ORDER BY received_at DESC) FILTER (WHERE speed_over_ground IS NOT NULL))[1],
+               (array_agg(course_over_ground ORDER BY received_at DESC) FILTER (WHERE course_over_ground IS NOT NULL))[1],
+               (array_agg(true_heading ORDER BY received_at DESC) FILTER (WHERE true_heading IS NOT NULL))[1],
+               count(*)
+        FROM nmea_records
+        WHERE received_at >= ?::timestamp AND received_at < ?::timestamp AND mmsi IS NOT NULL AND mmsi != 0
+        GROUP BY 1, 2
+        ON CONFLICT (mmsi, minute) DO UPDATE SET
+            latitude = EXCLUDED.latitude,
+            longitude = EXCLUDED.longitude,
+            speed_over_ground = EXCLUDED.speed_over_ground,
+            course_over_ground = EXCLUDED.course_over_ground,
+            true_heading = EXCLUDED.true_heading,
+            samples = EXCLUDED.samples
+    )");
+    if (!query) {
+        return;
+    }
+
+    // received_at berisi jam UTC: dikirim sebagai teks, bukan timestamptz yang dikonversi TimeZone sesi
+    query->bindValue(0, SqlStatementRegistry::utcText(rollupWatermark));
+    query->bindValue(1, SqlStatementRegistry::utcText(chunkEnd));
+    if (maintenanceStatements.exec("rollup_position_minute")) {
+        QMutexLocker locker(&maintenanceStateMutex);
+        rollupWatermark = chunkEnd;
+    } else {
+        qWarning() << "[ROLLUP] Position rollup failed:" << query->lastError().text();
+    }
+}
+
+void AisDatabaseManager::setupKeyframes()
+{
+    keyframesReady = false;
+    keyframeChained = false;
+    keyframeWatermark = QDateTime();
+
+    if (!maintenanceDb.isOpen()) {
+        return;
+    }
+
+    // nmea_keyframe_index juga mencatat keyframe kosong supaya rantai tidak putus
+    const QStringList ddl = {
+        "CREATE TABLE IF NOT EXISTS nmea_keyframe_index ("
+        "  taken_at timestamp PRIMARY KEY,"
+        "  targets integer NOT NULL,"
+        "  built_at timestamp NOT NULL DEFAULT now())",
+        "CREATE TABLE IF NOT EXISTS nmea_keyframes ("
+        "  taken_at timestamp NOT NULL,"
+        "  mmsi bigint NOT NULL,"
+        "  data_source varchar(20),"
+        "  last_seen timestamp NOT NULL,"
+        "  nmea text NOT NULL,"
+        "  latitude double precision,"
+        "  longitude double precision,"
+        "  speed_over_ground double precision,"
+        "  course_over_ground double precision,"
+        "  true_heading double precision,"
+        "  PRIMARY KEY (taken_at, mmsi))"
+    };
+    QSqlQuery query(maintenanceDb);
+    for (const QString& sql : ddl) {
+        if (!query.exec(sql)) {
+            qWarning() << "[KEYFRAME] Setup statement failed:" << query.lastError().text();
+            return;
+        }
+    }
+
+    // Rantai baru mulai satu hari ke belakang, seperti rollup; buildKeyframes() juga
+    // memulai rantai baru kalau keyframe terakhir lebih tua dari itu.
+    // taken_at sebanding dengan nmea_records.timestamp (jam TimeZone sesi), jadi dibaca
+    // lewat timestamptz sebagai epoch, bukan dianggap UTC.
+    if (query.exec("SELECT extract(epoch FROM max(taken_at)::timestamptz) FROM nmea_keyframe_index")
+        && query.next() && !query.value(0).isNull()) {
+        const QDateTime last = QDateTime::fromMSecsSinceEpoch(qRound64(query.value(0).toDouble() * 1000), Qt::UTC);
+        keyframeWatermark = last.addSecs(KEYFRAME_INTERVAL_SECS);
+        keyframeChained = true;
+    }
+    keyframesReady = true;
+}
+
+void AisDatabaseManager::buildKeyframes()
+{
+    if (!keyframesReady || !maintenanceDb.isOpen()) {
+        return;
+    }
+
+    // Keyframe K hanya dibangun setelah semua baris < K sudah di-commit writer
+    const QDateTime upper = QDateTime::currentDateTimeUtc().addSecs(-ROLLUP_LAG_SECS);
+
+    // Aplikasi/DB lama mati: jangan bangun ribuan keyframe kosong, mulai rantai baru
+    const QDateTime horizon = truncateToMinute(upper.addDays(-1));
+    if (!keyframeWatermark.isValid() || keyframeWatermark < horizon) {
+        keyframeWatermark = horizon;
+        keyframeChained = false;
+    }
+
+    // Posisi terakhir per MMSI = keyframe sebelumnya digabung baris [lower, K).
+    // Target yang tidak terdengar selama TTL dibuang, sama seperti aging di Ais.
+    QSqlQuery* query = maintenanceStatements.statement("build_keyframe", R"(
+        WITH latest AS (
+            SELECT DISTINCT ON (mmsi) mmsi, data_source, last_seen, nmea, latitude, longitude,
+                   speed_over_ground, course_over_ground, true_heading
+            FROM (
+                SELECT mmsi, data_source, last_seen, nmea, latitude, longitude,
+                       speed_over_ground, course_over_ground, true_heading
+                FROM nmea_keyframes
+                WHERE taken_at = ?::timestamp
+                UNION ALL
+                SELECT mmsi, data_source, timestamp, nmea, latitude, longitude,
+                       speed_over_ground, course_over_ground, true_heading
+                FROM nmea_records
+                WHERE timestamp >= ?::timestamp AND timestamp < ?::timestamp
+                  AND received_at >= ?::timestamp AND received_at < ?::timestamp
+                  AND mmsi IS NOT NULL AND mmsi != 0 AND nmea IS NOT NULL
+                  AND (data_source = 'ownship' OR message_type IN ('1', '2', '3', '18', '19'))
+            ) s
+            ORDER BY mmsi, last_seen DESC
+        ), inserted AS (
+            INSERT INTO nmea_keyframes (taken_at, mmsi, data_source, last_seen, nmea, latitude, longitude,
+                                        speed_over_ground, course_over_ground, true_heading)
+            SELECT ?::timestamp, mmsi, data_source, last_seen, nmea, latitude, longitude,
+                   speed_over_ground, course_over_ground, true_heading
+            FROM latest
+            WHERE last_seen >= ?::timestamp
+            ON CONFLICT (taken_at, mmsi) DO NOTHING
+            RETURNING 1
+        )
+        INSERT INTO nmea_keyframe_index (taken_at, targets)
+        SELECT ?::timestamp, count(*) FROM inserted
+        ON CONFLICT (taken_at) DO UPDATE SET
+            targets = GREATEST(nmea_keyframe_index.targets, EXCLUDED.targets),
+            built_at = now()
+    )");
+    if (!query) {
+        return;
+    }
+
+    for (int built = 0; built < KEYFRAME_MAX_PER_TICK && keyframeWatermark <= upper; ++built) {
+        const QDateTime at = keyframeWatermark;
+        const QDateTime previous = at.addSecs(-KEYFRAME_INTERVAL_SECS);
+        // Keyframe pertama rantai: ambil satu TTL penuh supaya target yang jarang lapor ikut
+        const QDateTime lower = keyframeChained ? previous : at.addSecs(-KEYFRAME_TARGET_TTL_SECS);
+
+        int p = 0;
+        query->bindValue(p++, SqlStatementRegistry::timestamp(previous));
+        query->bindValue(p++, SqlStatementRegistry::timestamp(lower));
+        query->bindValue(p++, SqlStatementRegistry::timestamp(at));
+        query->bindValue(p++, SqlStatementRegistry::utcText(lower.addDays(-RECEIVED_AT_SLACK_DAYS)));
+        query->bindValue(p++, SqlStatementRegistry::utcText(at.addDays(RECEIVED_AT_SLACK_DAYS)));
+        query->bindValue(p++, SqlStatementRegistry::timestamp(at));
+        query->bindValue(p++, SqlStatementRegistry::timestamp(at.addSecs(-KEYFRAME_TARGET_TTL_SECS)));
+        query->bindValue(p++, SqlStatementRegistry::timestamp(at));
+
+        if (!maintenanceStatements.exec("build_keyframe")) {
+            qWarning() << "[KEYFRAME] Build" << at << "failed:" << query->lastError().text();
+            return;
+        }
+        keyframeChained = true;
+        keyframeWatermark = at.addSecs(KEYFRAME_INTERVAL_SECS);
+    }
+}
+
+void AisDatabaseManager::pruneKeyframes()
+{
+    if (!keyframesReady || !partitioned || !maintenanceDb.isOpen()) {
+        return;
+    }
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (keyframesPrunedAt.isValid() && keyframesPrunedAt.secsTo(now) < KEYFRAME_PRUNE_INTERVAL_SECS) {
+        return;
+    }
+    keyframesPrunedAt = now;
+
+    // Data tertua nmea_records: partisi harian terkecil, atau default partition kalau lebih tua.
+    // Partisi legacy yang masih berisi baris tidak punya batas bawah, tidak ada yang dihapus.
+    QSqlQuery query(maintenanceDb);
+    if (!query.exec("SELECT c.relname FROM pg_inherits i "
+                    "JOIN pg_class c ON c.oid = i.inhrelid "
+                    "JOIN pg_class p ON p.oid = i.inhparent "
+                    "WHERE p.relname = 'nmea_records'")) {
+        qWarning() << "[KEYFRAME] Partition lookup failed:" << query.lastError().text();
+        return;
+    }
+    bool hasLegacy = false;
+    bool hasDefault = false;
+    QDate oldest;
+    while (query.next()) {
+        const QString name = query.value(0).toString();
+        if (name == "nmea_records_legacy") {
+            hasLegacy = true;
+        } else if (name == "nmea_records_default") {
+            hasDefault = true;
+        } else {
+            const QDate day = QDate::fromString(name.mid(QString("nmea_records_p").size()), "yyyyMMdd");
+            if (day.isValid() && (!oldest.isValid() || day < oldest)) {
+                oldest = day;
+            }
+        }
+    }
+
+    if (hasLegacy && (!query.exec("SELECT 1 FROM nmea_records_legacy LIMIT 1") || query.next())) {
+        return;
+    }
+    if (hasDefault && query.exec("SELECT min(received_at)::date FROM nmea_records_default")
+        && query.next() && !query.value(0).isNull()) {
+        const QDate day = query.value(0).toDate();
+        if (!oldest.isValid() || day < oldest) {
+            oldest = day;
+        }
+    }
+    if (!oldest.isValid()) {
+        return;
+    }
+
+    // Partisi per received_at (UTC), taken_at jam sesi: batas digeser seperti jendela query lain
+    const QDateTime cutoff = QDateTime(oldest, QTime(0, 0), Qt::UTC).addDays(-RECEIVED_AT_SLACK_DAYS);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    maintenanceDb.transaction();
+    int removed = 0;
+    bool ok = true;
+    for (const QString& table : { QString("nmea_keyframes"), QString("nmea_keyframe_index") }) {
+        query.prepare(QString("DELETE FROM %1 WHERE taken_at < ?").arg(table));
+        query.bindValue(0, SqlStatementRegistry::timestamp(cutoff));
+        if (!query.exec()) {
+            qWarning() << "[KEYFRAME] Prune" << table << "failed:" << query.lastError().text();
+            ok = false;
+            break;
+        }
+        if (table == "nmea_keyframe_index") {
+            removed = query.numRowsAffected();
+        }
+    }
+    if (!ok || !maintenanceDb.commit()) {
+        maintenanceDb.rollback();
+        return;
+    }
+
+    if (removed > 0) {
+        qDebug() << "[KEYFRAME] Pruned" << removed << "keyframes before" << cutoff << "in" << timer.elapsed() << "ms";
+    }
+}
+
+void AisDatabaseManager::startMaintenance()
+{
+    stopMaintenance();
+
+    maintenanceStop = false;
+    maintenanceThread = QThread::create([this]() {
+        maintenanceLoop();
+    });
+    maintenanceThread->setObjectName("NmeaMaintenance");
+    maintenanceThread->start(QThread::LowPriority);
+}
+
+void AisDatabaseManager::stopMaintenance()
+{
+    if (!maintenanceThread) {
+        return;
+    }
+
+    // Migrasi/rollup yang sedang jalan diselesaikan dulu, tidak dibatalkan di tengah
+    maintenanceStop = true;
+    maintenanceThread->wait();
+    delete maintenanceThread;
+    maintenanceThread = nullptr;
+}
+
+void AisDatabaseManager::maintenanceLoop()
+{
+    maintenanceConnName = QString("nmea_maintenance_%1").arg(quintptr(this));
+    maintenanceStatements.setConnectionName(maintenanceConnName);
+    maintenanceDb = openThreadConnection(maintenanceConnName);
+
+    // Skema dulu (migrasi partisi bisa rename tabel), baru writer mulai insert
+    setupPartitioning();
+    setupKeyframes();
+    recordWriter.start();
+
+    QElapsedTimer sinceRun;
+    sinceRun.start();
+    while (!maintenanceStop.load()) {
+        QThread::msleep(200);
+        if (sinceRun.elapsed() < MAINTENANCE_INTERVAL_MS) {
+            continue;
+        }
+        sinceRun.restart();
+        runMaintenance();
+    }
+
+    maintenanceStatements.invalidate();
+    maintenanceDb = QSqlDatabase();
+    closeThreadConnection(maintenanceConnName);
+}
+
+bool AisDatabaseManager::rollupCovers(const QDateTime& from, const QDateTime& to) const
+{
+    QMutexLocker locker(&maintenanceStateMutex);
+    return partitioned && rollupStart.isValid()
+           && from.toUTC() >= rollupStart && to.toUTC() <= rollupWatermark;
+}
+
+void AisDatabaseManager::runMaintenance()
+{
+    if (!maintenanceDb.isOpen()) {
+        return;
+    }
+
+    if (partitioned) {
+        const QDate today = QDateTime::currentDateTimeUtc().date();
+        ensureDailyPartitions(today, today.addDays(PARTITION_DAYS_AHEAD));
+        rollupPositions();
+    }
+    buildKeyframes();
+    pruneKeyframes();
+}
+
 void AisDatabaseManager::processTargetReferencesAsync() {
     if (!db.isOpen()) {
         return;
@@ -830,72 +1473,63 @@ void AisDatabaseManager::processTargetReferencesAsync() {
 
     qDebug() << "Processing" << targetReferenceCache.size() << "target references asynchronously...";
 
-    db.transaction();
-    QSqlQuery query(db);
+    // Satu statement untuk seluruh cache: kolom dikirim sebagai array lalu di-unnest di server
+    QSqlQuery* query = statements.statement("upsert_target_references", R"(
+        INSERT INTO target_references (mmsi, vessel_name, call_sign, imo, ship_type, data_quality, last_seen, source_count)
+        SELECT u.mmsi, u.vessel_name, u.call_sign, u.imo, u.ship_type, 'partial', CURRENT_TIMESTAMP, u.source_count
+        FROM unnest(?::bigint[], ?::text[], ?::text[], ?::bigint[], ?::int[], ?::int[])
+             AS u(mmsi, vessel_name, call_sign, imo, ship_type, source_count)
+        ON CONFLICT (mmsi) DO UPDATE SET
+            vessel_name = CASE
+                WHEN EXCLUDED.vessel_name IS NOT NULL AND EXCLUDED.vessel_name != ''
+                THEN EXCLUDED.vessel_name
+                ELSE target_references.vessel_name
+            END,
+            call_sign = CASE
+                WHEN EXCLUDED.call_sign IS NOT NULL AND EXCLUDED.call_sign != ''
+                THEN EXCLUDED.call_sign
+                ELSE target_references.call_sign
+            END,
+            imo = COALESCE(EXCLUDED.imo, target_references.imo),
+            ship_type = COALESCE(EXCLUDED.ship_type, target_references.ship_type),
+            last_seen = CURRENT_TIMESTAMP,
+            source_count = target_references.source_count + EXCLUDED.source_count
+    )");
+    if (!query) {
+        return;
+    }
 
-    bool hasErrors = false;
-    int processedCount = 0;
-
-    // Process in batches of 100 for better performance
-    QList<quint32> mmsiList = targetReferenceCache.keys();
-    for (int i = 0; i < mmsiList.size(); i += 100) {
-        QStringList batchValues;
-        int batchSize = qMin(100, mmsiList.size() - i);
-
-        // Build batch values
-        for (int j = 0; j < batchSize; ++j) {
-            quint32 mmsi = mmsiList[i + j];
-            const TargetReferenceRecord& record = targetReferenceCache[mmsi];
-
-            if (record.mmsi > 0) {  // Skip invalid records
-                QString escapedVesselName = QString(record.vesselName).replace("'", "''");
-                QString escapedCallSign = QString(record.callSign).replace("'", "''");
-                batchValues << QString("(%1, '%2', '%3', %4, %5, 'partial', CURRENT_TIMESTAMP, %6)")
-                    .arg(record.mmsi)
-                    .arg(escapedVesselName)
-                    .arg(escapedCallSign)
-                    .arg(record.imo > 0 ? QString::number(record.imo) : "NULL")
-                    .arg(record.shipType > 0 ? QString::number(record.shipType) : "NULL")
-                    .arg(record.sourceCount);
-            }
+    QVariantList mmsis, vesselNames, callSigns, imos, shipTypes, sourceCounts;
+    for (auto it = targetReferenceCache.constBegin(); it != targetReferenceCache.constEnd(); ++it) {
+        const TargetReferenceRecord& record = it.value();
+        if (record.mmsi == 0) {  // Skip invalid records
+            continue;
         }
+        mmsis << qint64(record.mmsi);
+        vesselNames << record.vesselName;
+        callSigns << record.callSign;
+        imos << SqlStatementRegistry::int8(qint64(record.imo), record.imo > 0);
+        shipTypes << (record.shipType > 0 ? QVariant(record.shipType) : QVariant(QVariant::Int));
+        sourceCounts << record.sourceCount;
+    }
 
-        if (!batchValues.isEmpty()) {
-            QString batchSql = QString(
-                "INSERT INTO target_references (mmsi, vessel_name, call_sign, imo, ship_type, data_quality, last_seen, source_count) "
-                "VALUES %1 "
-                "ON CONFLICT (mmsi) DO UPDATE SET "
-                "vessel_name = CASE "
-                "WHEN EXCLUDED.vessel_name IS NOT NULL AND EXCLUDED.vessel_name != '' "
-                "THEN EXCLUDED.vessel_name "
-                "ELSE target_references.vessel_name "
-                "END, "
-                "call_sign = CASE "
-                "WHEN EXCLUDED.call_sign IS NOT NULL AND EXCLUDED.call_sign != '' "
-                "THEN EXCLUDED.call_sign "
-                "ELSE target_references.call_sign "
-                "END, "
-                "imo = COALESCE(EXCLUDED.imo, target_references.imo), "
-                "ship_type = COALESCE(EXCLUDED.ship_type, target_references.ship_type), "
-                "last_seen = CURRENT_TIMESTAMP, "
-                "source_count = target_references.source_count + EXCLUDED.source_count"
-            ).arg(batchValues.join(", "));
-
-            if (!query.exec(batchSql)) {
-                qWarning() << "Batch target reference insert failed:" << query.lastError().text();
-                hasErrors = true;
-            } else {
-                processedCount += batchSize;
-            }
-        }
+    if (mmsis.isEmpty()) {
+        targetReferenceCache.clear();
+        return;
     }
 
-    if (!hasErrors) {
-        db.commit();
-        qDebug() << "✓ Processed" << processedCount << "target references successfully";
+    query->bindValue(0, SqlStatementRegistry::arrayLiteral(mmsis));
+    query->bindValue(1, SqlStatementRegistry::arrayLiteral(vesselNames));
+    query->bindValue(2, SqlStatementRegistry::arrayLiteral(callSigns));
+    query->bindValue(3, SqlStatementRegistry::arrayLiteral(imos));
+    query->bindValue(4, SqlStatementRegistry::arrayLiteral(shipTypes));
+    query->bindValue(5, SqlStatementRegistry::arrayLiteral(sourceCounts));
+
+    if (statements.exec("upsert_target_references")) {
+        qDebug() << "✓ Processed" << mmsis.size() << "target references successfully";
         targetReferenceCache.clear(); // Clear processed cache
     } else {
-        db.rollback();
+        qWarning() << "Batch target reference insert failed:" << query->lastError().text();
         qWarning() << "Batch processing failed, keeping cache for retry";
     }
 }
@@ -907,83 +1541,62 @@ bool AisDatabaseManager::insertParsedAisDataFast(const QString& nmea, const QStr
         return false;
     }
 
-    // Convert SevenCs coordinates (1/10000 degree) to decimal degrees
-    double latitude = (targetInfo.latitude != 0) ?
-        ((double)targetInfo.latitude / 10000.0) / 60.0 : 0.0;
-    double longitude = (targetInfo.longitude != 0) ?
-        ((double)targetInfo.longitude / 10000.0) / 60.0 : 0.0;
+    NmeaRecordRow row;
+    row.receivedAt = QDateTime::currentDateTimeUtc();
+    row.nmea = nmea;
+    row.dataSource = dataSource;
+    row.mmsi = mmsi;
 
-    QDateTime currentTime = QDateTime::currentDateTimeUtc();
+    // Convert SevenCs coordinates (1/10000 minute) to decimal degrees
+    if (targetInfo.latitude != 0) {
+        row.latitude = ((double)targetInfo.latitude / 10000.0) / 60.0;
+    }
+    if (targetInfo.longitude != 0) {
+        row.longitude = ((double)targetInfo.longitude / 10000.0) / 60.0;
+    }
 
-    // Extract additional data from targetInfo
-    QString callSign = QString::fromUtf8(targetInfo.callSign).replace("'", "''");
-    QString imo = targetInfo.imoNumber > 0 ? QString::number(targetInfo.imoNumber) : "NULL";
-    QString shipType = targetInfo.shipType > 0 ? QString::number(targetInfo.shipType) : "NULL";
-    QString sog = (targetInfo.sog > 0 && targetInfo.sog < 1023) ? QString::number(targetInfo.sog/10) : "NULL";
-    QString cog = (targetInfo.cog > 0 && targetInfo.cog < 3600) ? QString::number(targetInfo.cog/10) : "NULL";
-    QString trueHeading = (targetInfo.heading > 0 && targetInfo.heading <= 360) ? QString::number(targetInfo.heading) : "NULL";
+    row.vesselName = QString::fromUtf8(targetInfo.shipName);
+    row.callSign = QString::fromUtf8(targetInfo.callSign);
+    row.imo = targetInfo.imoNumber > 0 ? quint64(targetInfo.imoNumber) : 0;
+    row.shipType = targetInfo.shipType > 0 ? int(targetInfo.shipType) : 0;
+    if (targetInfo.sog > 0 && targetInfo.sog < 1023) {
+        row.sog = targetInfo.sog / 10;
+    }
+    if (targetInfo.cog > 0 && targetInfo.cog < 3600) {
+        row.cog = targetInfo.cog / 10;
+    }
+    if (targetInfo.heading > 0 && targetInfo.heading <= 360) {
+        row.heading = targetInfo.heading;
+    }
 
     // Extract message type from NMEA
-    QString messageType = "NULL";
     QStringList parts = nmea.split(',');
     if (parts.length() >= 6 && !parts[1].isEmpty()) {
-        messageType = QString("'%1'").arg(parts[1]); // Message type is field 2 (index 1)
+        row.messageType = parts[1]; // Message type is field 2 (index 1)
     }
+    row.rawDataType = determineDataType(nmea);
 
-    // Handle call sign - empty string should be NULL, not quoted
-    QString callSignSql = callSign.isEmpty() ? "NULL" : QString("'%1'").arg(callSign);
+    if (!recordWriter.enqueue(row)) {
+        // Antrian penuh: sudah dihitung sebagai drop di writer
+        return false;
+    }
 
-    // Fast insert without trigger overhead - using received_at for correct timezone
-    QSqlQuery query(db);
-    QString sql = QString(
-        "INSERT INTO nmea_records (nmea, data_source, mmsi, latitude, longitude, "
-        "vessel_name, raw_data_type, parsed_successfully, received_at, "
-        "message_type, call_sign, imo, ship_type, speed_over_ground, course_over_ground, true_heading, "
-        "destination, draught) "
-        "VALUES ('%1', '%2', %3, %4, %5, '%6', '%7', true, TIMESTAMP '%8', "
-        "%9, %10, %11, %12, %13, %14, %15, NULL, NULL)"
-    ).arg(QString(nmea).replace("'", "''"))
-     .arg(dataSource)
-     .arg(mmsi)
-     .arg(latitude != 0 ? QString::number(latitude, 'f', 6) : "NULL")
-     .arg(longitude != 0 ? QString::number(longitude, 'f', 6) : "NULL")
-     .arg(QString::fromUtf8(targetInfo.shipName).replace("'", "''"))
-     .arg(determineDataType(nmea))
-     .arg(currentTime.toString("yyyy-MM-dd hh:mm:ss.zzz"))
-     .arg(messageType)
-     .arg(callSignSql)
-     .arg(imo)
-     .arg(shipType)
-     .arg(sog)
-     .arg(cog)
-     .arg(trueHeading);
-
-    bool success = query.exec(sql);
-
-    if (success) {
-        // Update cache for async processing - use received_at timestamp
-        QMutexLocker locker(&cacheMutex);
-        TargetReferenceRecord& record = targetReferenceCache[mmsi];
-        if (record.mmsi == 0) { // New record
-            record.mmsi = mmsi;
-            record.vesselName = QString::fromUtf8(targetInfo.shipName);
-            record.callSign = QString::fromUtf8(targetInfo.callSign);
-            record.imo = targetInfo.imoNumber;
-            record.shipType = targetInfo.shipType;
-            record.timestamp = currentTime;
-        } else {
-            record.sourceCount++;
-            record.timestamp = currentTime;
-        }
-        // Normal successful inserts are silent for clean logging
+    // Update cache for async processing - use received_at timestamp
+    QMutexLocker locker(&cacheMutex);
+    TargetReferenceRecord& record = targetReferenceCache[mmsi];
+    if (record.mmsi == 0) { // New record
+        record.mmsi = mmsi;
+        record.vesselName = row.vesselName;
+        record.callSign = row.callSign;
+        record.imo = targetInfo.imoNumber;
+        record.shipType = targetInfo.shipType;
+        record.timestamp = row.receivedAt;
     } else {
-        qWarning() << "Fast AIS insert failed for MMSI:" << mmsi;
-        qWarning() << "SQL Error:" << query.lastError().text();
-        // Only show partial SQL query to avoid log spam
-        qWarning() << "SQL Query (first 100 chars):" << sql.left(100) << "...";
+        record.sourceCount++;
+        record.timestamp = row.receivedAt;
     }
 
-    return success;
+    return true;
 }
 
 bool AisDatabaseManager::insertParsedAisDataFastRev(const QString& nmea, const QString& dataSource,
@@ -993,62 +1606,40 @@ bool AisDatabaseManager::insertParsedAisDataFastRev(const QString& nmea, const Q
         return false;
     }
 
-    QDateTime currentTime = QDateTime::currentDateTimeUtc();
-
-    // Extract additional data from targetInfo
-    QString callSign = QString::fromUtf8(targetInfo.callSign).replace("'", "''");
+    // Versi ringkas: hanya identitas target, tanpa posisi/kinematik
+    NmeaRecordRow row;
+    row.receivedAt = QDateTime::currentDateTimeUtc();
+    row.nmea = nmea;
+    row.dataSource = dataSource;
+    row.mmsi = mmsi;
+    row.vesselName = QString::fromUtf8(targetInfo.shipName);
+    row.callSign = QString::fromUtf8(targetInfo.callSign);
 
-    QString messageType = "NULL";
     QStringList parts = nmea.split(',');
     if (parts.length() >= 6 && !parts[1].isEmpty()) {
-        messageType = QString("'%1'").arg(parts[1]); // Message type is field 2 (index 1)
+        row.messageType = parts[1]; // Message type is field 2 (index 1)
     }
 
-    QString callSignSql = callSign.isEmpty() ? "NULL" : QString("'%1'").arg(callSign);
+    if (!recordWriter.enqueue(row)) {
+        return false;
+    }
 
-    QSqlQuery query(db);
-    QString sql = QString(
-                      "INSERT INTO nmea_records ("
-                      "nmea, data_source, mmsi, "
-                      "vessel_name, message_type, "
-                      "call_sign) "
-                      "VALUES ("
-                      "'%1', '%2', %3, "
-                      "'%4', %5, "
-                      "%6)"
-                      ).arg(QString(nmea).replace("'", "''"))
-                      .arg(dataSource)
-                      .arg(mmsi)
-                      .arg(QString::fromUtf8(targetInfo.shipName).replace("'", "''"))
-                      .arg(messageType)
-                      .arg(callSignSql);
-
-    bool success = query.exec(sql);
-
-    if (success) {
-        // Update cache for async processing - use received_at timestamp
-        QMutexLocker locker(&cacheMutex);
-        TargetReferenceRecord& record = targetReferenceCache[mmsi];
-        if (record.mmsi == 0) { // New record
-            record.mmsi = mmsi;
-            record.vesselName = QString::fromUtf8(targetInfo.shipName);
-            record.callSign = QString::fromUtf8(targetInfo.callSign);
-            record.imo = targetInfo.imoNumber;
-            record.shipType = targetInfo.shipType;
-            record.timestamp = currentTime;
-        } else {
-            record.sourceCount++;
-            record.timestamp = currentTime;
-        }
-        // Normal successful inserts are silent for clean logging
+    // Update cache for async processing - use received_at timestamp
+    QMutexLocker locker(&cacheMutex);
+    TargetReferenceRecord& record = targetReferenceCache[mmsi];
+    if (record.mmsi == 0) { // New record
+        record.mmsi = mmsi;
+        record.vesselName = row.vesselName;
+        record.callSign = row.callSign;
+        record.imo = targetInfo.imoNumber;
+        record.shipType = targetInfo.shipType;
+        record.timestamp = row.receivedAt;
     } else {
-        qWarning() << "Fast AIS insert failed for MMSI:" << mmsi;
-        qWarning() << "SQL Error:" << query.lastError().text();
-        // Only show partial SQL query to avoid log spam
-        qWarning() << "SQL Query (first 100 chars):" << sql.left(100) << "...";
+        record.sourceCount++;
+        record.timestamp = row.receivedAt;
     }
 
-    return success;
+    return true;
 }
 
 
@@ -1058,30 +1649,30 @@ bool AisDatabaseManager::insertParsedOwnshipDataFast(const QString& nmea, const
         return false;
     }
 
-    QDateTime currentTime = QDateTime::currentDateTimeUtc();
-
-    // Fast insert without trigger overhead - using received_at for correct timezone
-    QSqlQuery query(db);
-    QString sql = QString(
-        "INSERT INTO nmea_records (nmea, data_source, mmsi, latitude, longitude, "
-        "speed_over_ground, course_over_ground, true_heading, vessel_name, raw_data_type, parsed_successfully, received_at) "
-        "VALUES ('%1', '%2', 999999999, %3, %4, %5, %6, %7, 'OWNSHIP', '%8', true, TIMESTAMP '%9')"
-    ).arg(QString(nmea).replace("'", "''"))
-     .arg(dataSource)
-     .arg(lat != 0 ? QString::number(lat, 'f', 6) : "NULL")
-     .arg(lon != 0 ? QString::number(lon, 'f', 6) : "NULL")
-     .arg(sog > 0 ? QString::number(sog, 'f', 2) : "NULL")
-     .arg(cog > 0 ? QString::number(cog, 'f', 2) : "NULL")
-     .arg(heading > 0 ? QString::number(heading, 'f', 2) : "NULL")
-     .arg(determineDataType(nmea))
-     .arg(currentTime.toString("yyyy-MM-dd hh:mm:ss.zzz"));
-
-    if (!query.exec(sql)) {
-        qWarning() << "Fast ownship insert failed:" << query.lastError().text();
-        return false;
+    NmeaRecordRow row;
+    row.receivedAt = QDateTime::currentDateTimeUtc();
+    row.nmea = nmea;
+    row.dataSource = dataSource;
+    row.mmsi = 999999999;
+    row.vesselName = "OWNSHIP";
+    row.rawDataType = determineDataType(nmea);
+    if (lat != 0) {
+        row.latitude = lat;
+    }
+    if (lon != 0) {
+        row.longitude = lon;
+    }
+    if (sog > 0) {
+        row.sog = sog;
+    }
+    if (cog > 0) {
+        row.cog = cog;
+    }
+    if (heading > 0) {
+        row.heading = heading;
     }
 
-    return true;
+    return recordWriter.enqueue(row);
 }
 
 // NMEA Playback Control - Get targets for specific date
@@ -1096,61 +1687,106 @@ QList<AisDatabaseManager::TargetData> AisDatabaseManager::getTargetsForDate(cons
     QString dateStr = date.toString("yyyy-MM-dd");
     qCritical() << "Fetching targets for date:" << dateStr;
 
+    // Rentang [hari, hari+1) supaya index waktu tetap terpakai (DATE(kolom) tidak bisa)
+    const QDate day = date.date();
+    const QDate nextDay = day.addDays(1);
+    const QDate windowStart = day.addDays(-RECEIVED_AT_SLACK_DAYS);
+    const QDate windowEnd = nextDay.addDays(RECEIVED_AT_SLACK_DAYS);
+
     // (a) Get static data from target_references
     QHash<quint32, TargetData> staticDataMap;
-    QSqlQuery staticQuery;
-    QString staticSql = QString(
+    QSqlQuery* staticQuery = statements.statement("targets_static_for_date",
         "SELECT DISTINCT mmsi, vessel_name, call_sign, imo, ship_type "
         "FROM target_references "
-        "WHERE DATE(created_at) = DATE('%1') OR DATE(last_seen) = DATE('%1')"
-    ).arg(dateStr);
+        "WHERE (created_at >= ? AND created_at < ?) OR (last_seen >= ? AND last_seen < ?)");
+    if (staticQuery) {
+        staticQuery->bindValue(0, day);
+        staticQuery->bindValue(1, nextDay);
+        staticQuery->bindValue(2, day);
+        staticQuery->bindValue(3, nextDay);
+    }
 
-    if (staticQuery.exec(staticSql)) {
-        while (staticQuery.next()) {
+    if (staticQuery && statements.exec("targets_static_for_date")) {
+        while (staticQuery->next()) {
             TargetData data;
-            data.mmsi = staticQuery.value("mmsi").toUInt();
-            data.vesselName = staticQuery.value("vessel_name").toString();
+            data.mmsi = staticQuery->value("mmsi").toUInt();
+            data.vesselName = staticQuery->value("vessel_name").toString();
             data.vesselName.replace("@", " "); // Fix @ symbols in vessel names
-            data.callSign = staticQuery.value("call_sign").toString();
+            data.callSign = staticQuery->value("call_sign").toString();
             data.callSign.replace("@", " "); // Fix @ symbols in call signs
-            data.imo = staticQuery.value("imo").toULongLong();
-            data.shipType = staticQuery.value("ship_type").toInt();
+            data.imo = staticQuery->value("imo").toULongLong();
+            data.shipType = staticQuery->value("ship_type").toInt();
 
             
             staticDataMap[data.mmsi] = data;
         }
+        staticQuery->finish();
         qCritical() << "Found" << staticDataMap.size() << "static targets from target_references";
     } else {
-        qCritical() << "Error fetching static data:" << staticQuery.lastError().text();
+        qCritical() << "Error fetching static data:" << (staticQuery ? staticQuery->lastError().text() : QString());
     }
 
-    // (b) Get all unique MMSIs with their navigation data directly from nmea_records
+    // (b) Get all unique MMSIs with their navigation data.
+    // Rollup per menit dulu (posisi terakhir hari itu); hari yang belum di-rollup dari nmea_records.
     QHash<quint32, TargetData> nmeaDataMap;
 
-    QSqlQuery nmeaQuery;
-    QString nmeaSql = QString(
+    const QDateTime dayStart(day, QTime(0, 0), Qt::UTC);
+    const bool dayRolledUp = rollupCovers(dayStart, dayStart);
+    QSqlQuery* rollupQuery = dayRolledUp ? statements.statement("targets_rollup_for_date",
+        "SELECT DISTINCT ON (mmsi) mmsi, latitude, longitude, speed_over_ground, course_over_ground, true_heading "
+        "FROM nmea_position_minute "
+        "WHERE minute >= ? AND minute < ? "
+        "ORDER BY mmsi, minute DESC") : nullptr;
+    if (rollupQuery) {
+        rollupQuery->bindValue(0, day);
+        rollupQuery->bindValue(1, nextDay);
+        if (statements.exec("targets_rollup_for_date")) {
+            while (rollupQuery->next()) {
+                TargetData data;
+                data.mmsi = rollupQuery->value("mmsi").toUInt();
+                data.latitude = rollupQuery->value("latitude").toDouble();
+                data.longitude = rollupQuery->value("longitude").toDouble();
+                data.sog = rollupQuery->value("speed_over_ground").toDouble();
+                data.cog = rollupQuery->value("course_over_ground").toDouble();
+                data.heading = rollupQuery->value("true_heading").toDouble();
+                nmeaDataMap[data.mmsi] = data;
+            }
+            rollupQuery->finish();
+        }
+    }
+
+    QSqlQuery* nmeaQuery = nmeaDataMap.isEmpty() ? statements.statement("targets_nav_for_date",
         "SELECT mmsi, latitude, longitude, speed_over_ground, course_over_ground, true_heading "
         "FROM nmea_records "
-        "WHERE DATE(timestamp) = DATE('%1') AND mmsi IS NOT NULL AND mmsi != 0 "
-        "GROUP BY mmsi, latitude, longitude, speed_over_ground, course_over_ground, true_heading"
-    ).arg(dateStr);
-
-    if (nmeaQuery.exec(nmeaSql)) {
-        while (nmeaQuery.next()) {
+        "WHERE timestamp >= ? AND timestamp < ? AND received_at >= ? AND received_at < ? "
+        "AND mmsi IS NOT NULL AND mmsi != 0 "
+        "GROUP BY mmsi, latitude, longitude, speed_over_ground, course_over_ground, true_heading") : nullptr;
+    if (nmeaQuery) {
+        nmeaQuery->bindValue(0, day);
+        nmeaQuery->bindValue(1, nextDay);
+        nmeaQuery->bindValue(2, windowStart);
+        nmeaQuery->bindValue(3, windowEnd);
+    }
+
+    if (!nmeaDataMap.isEmpty()) {
+        qCritical() << "Found" << nmeaDataMap.size() << "targets with navigation data from nmea_position_minute";
+    } else if (nmeaQuery && statements.exec("targets_nav_for_date")) {
+        while (nmeaQuery->next()) {
             TargetData data;
-            data.mmsi = nmeaQuery.value("mmsi").toUInt();
-            data.latitude = nmeaQuery.value("latitude").toDouble();
-            data.longitude = nmeaQuery.value("longitude").toDouble();
-            data.sog = nmeaQuery.value("speed_over_ground").toDouble();
-            data.cog = nmeaQuery.value("course_over_ground").toDouble();
-            data.heading = nmeaQuery.value("true_heading").toDouble();
+            data.mmsi = nmeaQuery->value("mmsi").toUInt();
+            data.latitude = nmeaQuery->value("latitude").toDouble();
+            data.longitude = nmeaQuery->value("longitude").toDouble();
+            data.sog = nmeaQuery->value("speed_over_ground").toDouble();
+            data.cog = nmeaQuery->value("course_over_ground").toDouble();
+            data.heading = nmeaQuery->value("true_heading").toDouble();
 
             // Store the data - this will include all navigation data for each MMSI
             nmeaDataMap[data.mmsi] = data;
         }
+        nmeaQuery->finish();
         qCritical() << "Found" << nmeaDataMap.size() << "targets with navigation data from nmea_records";
     } else {
-        qCritical() << "Error fetching NMEA data:" << nmeaQuery.lastError().text();
+        qCritical() << "Error fetching NMEA data:" << (nmeaQuery ? nmeaQuery->lastError().text() : QString());
     }
 
     // (c) Combine static data from target_references with navigation data from nmea_records
@@ -1193,58 +1829,75 @@ QList<AisDatabaseManager::TargetData> AisDatabaseManager::getTargetsForDateRev(c
     QString dateStr = date.toString("yyyy-MM-dd");
     qCritical() << "Fetching targets for date:" << dateStr;
 
+    // Rentang [hari, hari+1) supaya index waktu tetap terpakai (DATE(kolom) tidak bisa)
+    const QDate day = date.date();
+    const QDate nextDay = day.addDays(1);
+    const QDate windowStart = day.addDays(-RECEIVED_AT_SLACK_DAYS);
+    const QDate windowEnd = nextDay.addDays(RECEIVED_AT_SLACK_DAYS);
+
     // (a) Get static data from target_references
     QHash<quint32, TargetData> staticDataMap;
-    QSqlQuery staticQuery;
-    QString staticSql = QString(
-                            "SELECT DISTINCT mmsi, vessel_name, call_sign, imo, ship_type "
-                            "FROM target_references "
-                            "WHERE DATE(created_at) = DATE('%1') OR DATE(last_seen) = DATE('%1')"
-                            ).arg(dateStr);
-
-    if (staticQuery.exec(staticSql)) {
-        while (staticQuery.next()) {
+    QSqlQuery* staticQuery = statements.statement("targets_static_for_date",
+        "SELECT DISTINCT mmsi, vessel_name, call_sign, imo, ship_type "
+        "FROM target_references "
+        "WHERE (created_at >= ? AND created_at < ?) OR (last_seen >= ? AND last_seen < ?)");
+    if (staticQuery) {
+        staticQuery->bindValue(0, day);
+        staticQuery->bindValue(1, nextDay);
+        staticQuery->bindValue(2, day);
+        staticQuery->bindValue(3, nextDay);
+    }
+
+    if (staticQuery && statements.exec("targets_static_for_date")) {
+        while (staticQuery->next()) {
             TargetData data;
-            data.mmsi = staticQuery.value("mmsi").toUInt();
-            data.vesselName = staticQuery.value("vessel_name").toString();
+            data.mmsi = staticQuery->value("mmsi").toUInt();
+            data.vesselName = staticQuery->value("vessel_name").toString();
             data.vesselName.replace("@", " "); // Fix @ symbols in vessel names
-            data.callSign = staticQuery.value("call_sign").toString();
+            data.callSign = staticQuery->value("call_sign").toString();
             data.callSign.replace("@", " "); // Fix @ symbols in call signs
-            data.imo = staticQuery.value("imo").toULongLong();
-            data.shipType = staticQuery.value("ship_type").toInt();
+            data.imo = staticQuery->value("imo").toULongLong();
+            data.shipType = staticQuery->value("ship_type").toInt();
 
 
             staticDataMap[data.mmsi] = data;
         }
+        staticQuery->finish();
         qCritical() << "Found" << staticDataMap.size() << "static targets from target_references";
     } else {
-        qCritical() << "Error fetching static data:" << staticQuery.lastError().text();
+        qCritical() << "Error fetching static data:" << (staticQuery ? staticQuery->lastError().text() : QString());
     }
 
     // (b) Get all unique MMSIs with their raw NMEA strings from nmea_records
     QHash<quint32, TargetData> nmeaDataMap;
 
-    QSqlQuery nmeaQuery;
-    QString nmeaSql = QString(
-                          "SELECT DISTINCT ON (mmsi) mmsi, nmea "
-                          "FROM nmea_records "
-                          "WHERE DATE(timestamp) = DATE('%1') AND mmsi IS NOT NULL AND mmsi != 0 "
-                          "AND (message_type = '1' OR message_type = '2' OR message_type = '3' OR message_type = '18' OR message_type = '19') "
-                          "ORDER BY mmsi, timestamp DESC"
-                          ).arg(dateStr);
-
-    if (nmeaQuery.exec(nmeaSql)) {
-        while (nmeaQuery.next()) {
+    QSqlQuery* nmeaQuery = statements.statement("targets_raw_nmea_for_date",
+        "SELECT DISTINCT ON (mmsi) mmsi, nmea "
+        "FROM nmea_records "
+        "WHERE timestamp >= ? AND timestamp < ? AND received_at >= ? AND received_at < ? "
+        "AND mmsi IS NOT NULL AND mmsi != 0 "
+        "AND (message_type = '1' OR message_type = '2' OR message_type = '3' OR message_type = '18' OR message_type = '19') "
+        "ORDER BY mmsi, timestamp DESC");
+    if (nmeaQuery) {
+        nmeaQuery->bindValue(0, day);
+        nmeaQuery->bindValue(1, nextDay);
+        nmeaQuery->bindValue(2, windowStart);
+        nmeaQuery->bindValue(3, windowEnd);
+    }
+
+    if (nmeaQuery && statements.exec("targets_raw_nmea_for_date")) {
+        while (nmeaQuery->next()) {
             TargetData data;
-            data.mmsi = nmeaQuery.value("mmsi").toUInt();
-            data.nmea = nmeaQuery.value("nmea").toString();
+            data.mmsi = nmeaQuery->value("mmsi").toUInt();
+            data.nmea = nmeaQuery->value("nmea").toString();
 
             // Store the raw NMEA string
             nmeaDataMap[data.mmsi] = data;
         }
+        nmeaQuery->finish();
         qCritical() << "Found" << nmeaDataMap.size() << "targets with raw NMEA from nmea_records";
     } else {
-        qCritical() << "Error fetching NMEA data:" << nmeaQuery.lastError().text();
+        qCritical() << "Error fetching NMEA data:" << (nmeaQuery ? nmeaQuery->lastError().text() : QString());
     }
 
     // (c) Combine static data from target_references with navigation data from nmea_records
@@ -1272,6 +1925,270 @@ QList<AisDatabaseManager::TargetData> AisDatabaseManager::getTargetsForDateRev(c
     return targets;
 }
 
+AisDatabaseManager::Keyframe AisDatabaseManager::loadKeyframe(const QDateTime& at)
+{
+    Keyframe keyframe;
+
+    if (!db.isOpen() || !at.isValid()) {
+        return keyframe;
+    }
+
+    // Keyframe lebih tua dari TTL tidak menghemat apa-apa (semua targetnya sudah kedaluwarsa)
+    // taken_at ada di jam sesi (sebanding dengan nmea_records.timestamp): dicari dengan
+    // timestamptz, dibaca balik sebagai epoch, dan teks aslinya dipakai untuk join persis
+    QSqlQuery* findQuery = statements.statement("keyframe_at",
+        "SELECT taken_at::text, extract(epoch FROM taken_at::timestamptz) FROM nmea_keyframe_index "
+        "WHERE taken_at <= ? AND taken_at > ? "
+        "ORDER BY taken_at DESC LIMIT 1");
+    if (!findQuery) {
+        return keyframe;
+    }
+    findQuery->bindValue(0, SqlStatementRegistry::timestamp(at));
+    findQuery->bindValue(1, SqlStatementRegistry::timestamp(at.addSecs(-KEYFRAME_TARGET_TTL_SECS)));
+    if (!statements.exec("keyframe_at") || !findQuery->next()) {
+        return keyframe;
+    }
+    const QString takenAtKey = findQuery->value(0).toString();
+    const QDateTime takenAt = QDateTime::fromMSecsSinceEpoch(qRound64(findQuery->value(1).toDouble() * 1000), Qt::UTC);
+    findQuery->finish();
+
+    QSqlQuery* targetQuery = statements.statement("keyframe_targets",
+        "SELECT k.mmsi, k.last_seen, k.nmea, k.latitude, k.longitude, "
+        "       k.speed_over_ground, k.course_over_ground, k.true_heading, "
+        "       t.vessel_name, t.call_sign, t.imo, t.ship_type "
+        "FROM nmea_keyframes k "
+        "LEFT JOIN target_references t ON t.mmsi = k.mmsi "
+        "WHERE k.taken_at = ?::timestamp");
+    if (!targetQuery) {
+        return keyframe;
+    }
+    targetQuery->bindValue(0, takenAtKey);
+    if (!statements.exec("keyframe_targets")) {
+        qWarning() << "[KEYFRAME] Load" << takenAt << "failed:" << targetQuery->lastError().text();
+        return keyframe;
+    }
+
+    while (targetQuery->next()) {
+        TargetData data;
+        data.mmsi = targetQuery->value(0).toUInt();
+        data.timestamp = targetQuery->value(1).toDateTime();
+        data.nmea = targetQuery->value(2).toString();
+        data.latitude = targetQuery->value(3).toDouble();
+        data.longitude = targetQuery->value(4).toDouble();
+        data.sog = targetQuery->value(5).toDouble();
+        data.cog = targetQuery->value(6).toDouble();
+        data.heading = targetQuery->value(7).toDouble();
+        data.vesselName = targetQuery->value(8).toString().replace("@", " ");
+        data.callSign = targetQuery->value(9).toString().replace("@", " ");
+        data.imo = targetQuery->value(10).toULongLong();
+        data.shipType = targetQuery->value(11).toInt();
+        keyframe.targets.append(data);
+    }
+    targetQuery->finish();
+
+    // Kembalikan dalam spec yang sama dengan pemanggil (playback memakai waktu lokal)
+    keyframe.takenAt = takenAt.toTimeSpec(at.timeSpec());
+    return keyframe;
+}
+
+static QString trackCacheKey(quint32 mmsi, qint64 fromMs, qint64 toMs, int level)
+{
+    return QString("%1|%2|%3|%4").arg(mmsi).arg(fromMs).arg(toMs).arg(level);
+}
+
+double AisDatabaseManager::trackToleranceForScale(int scale, double pixels)
+{
+    return TrackSimplifier::metersPerPixel(scale) * pixels;
+}
+
+QList<AisDatabaseManager::VesselTrack> AisDatabaseManager::getSimplifiedTracks(const QList<quint32>& mmsis,
+                                                                               const QDateTime& from,
+                                                                               const QDateTime& to,
+                                                                               double toleranceMeters)
+{
+    QList<VesselTrack> tracks;
+    if (mmsis.isEmpty() || !from.isValid() || !to.isValid() || from >= to) {
+        return tracks;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const int level = TrackSimplifier::toleranceLevel(toleranceMeters);
+    const double tolerance = TrackSimplifier::levelTolerance(level);
+    const qint64 fromMs = from.toMSecsSinceEpoch();
+    const qint64 toMs = to.toMSecsSinceEpoch();
+    // Rentang yang masih berjalan bisa bertambah titik, jangan di-cache
+    const bool cacheable = toMs <= QDateTime::currentMSecsSinceEpoch();
+
+    QHash<quint32, QVector<TrackPoint>> found;
+    QList<quint32> missing;
+    {
+        QMutexLocker locker(&trackCacheMutex);
+        for (quint32 mmsi : mmsis) {
+            if (found.contains(mmsi) || missing.contains(mmsi)) {
+                continue;
+            }
+            if (const QVector<TrackPoint>* cached = trackCache.object(trackCacheKey(mmsi, fromMs, toMs, level))) {
+                found.insert(mmsi, *cached);
+                continue;
+            }
+
+            // Zoom out: turunkan dari level lebih halus yang sudah ada
+            bool derived = false;
+            for (int finer = level - 1; finer >= level - TRACK_CACHE_FINER_LEVELS && !derived; --finer) {
+                const QVector<TrackPoint>* cached = trackCache.object(trackCacheKey(mmsi, fromMs, toMs, finer));
+                if (!cached) {
+                    continue;
+                }
+                const QVector<TrackPoint> simplified = TrackSimplifier::simplify(*cached, tolerance);
+                trackCache.insert(trackCacheKey(mmsi, fromMs, toMs, level),
+                                  new QVector<TrackPoint>(simplified), qMax(1, simplified.size()));
+                found.insert(mmsi, simplified);
+                derived = true;
+            }
+            if (!derived) {
+                missing.append(mmsi);
+            }
+        }
+    }
+
+    if (!missing.isEmpty()) {
+        QHash<quint32, QVector<TrackPoint>> fetched;
+        fetchTracks(missing, from, to, tolerance, fetched);
+
+        QMutexLocker locker(&trackCacheMutex);
+        for (quint32 mmsi : missing) {
+            const QVector<TrackPoint> points = fetched.value(mmsi);
+            if (cacheable) {
+                trackCache.insert(trackCacheKey(mmsi, fromMs, toMs, level),
+                                  new QVector<TrackPoint>(points), qMax(1, points.size()));
+            }
+            found.insert(mmsi, points);
+        }
+    }
+
+    int totalPoints = 0;
+    QSet<quint32> seen;
+    for (quint32 mmsi : mmsis) {
+        if (seen.contains(mmsi)) {
+            continue;
+        }
+        seen.insert(mmsi);
+
+        VesselTrack track;
+        track.mmsi = mmsi;
+        track.points = found.value(mmsi);
+        totalPoints += track.points.size();
+        tracks.append(track);
+    }
+
+    qDebug() << "[TRACK]" << tracks.size() << "tracks," << totalPoints << "points at" << tolerance << "m,"
+             << missing.size() << "from DB," << timer.elapsed() << "ms";
+    return tracks;
+}
+
+bool AisDatabaseManager::fetchTracks(const QList<quint32>& mmsis, const QDateTime& from, const QDateTime& to,
+                                     double toleranceMeters, QHash<quint32, QVector<TrackPoint>>& tracks)
+{
+    if (!db.isOpen()) {
+        return false;
+    }
+
+    QVariantList mmsiValues;
+    for (quint32 mmsi : mmsis) {
+        mmsiValues << qint64(mmsi);
+    }
+    const QString mmsiArray = SqlStatementRegistry::arrayLiteral(mmsiValues);
+
+    // Skala kecil: rollup per menit sudah jauh di bawah toleransi, tidak perlu baca nmea_records
+    const bool useRollup = toleranceMeters >= TRACK_ROLLUP_MIN_TOLERANCE_M && rollupCovers(from, to);
+
+    QString key;
+    QSqlQuery* query = nullptr;
+    if (useRollup) {
+        key = "track_points_rollup";
+        query = statements.statement(key,
+            "SELECT mmsi, (extract(epoch FROM minute) * 1000)::bigint AS time_ms, latitude, longitude "
+            "FROM nmea_position_minute "
+            "WHERE mmsi = ANY(?::bigint[]) AND minute >= ?::timestamp AND minute < ?::timestamp "
+            "AND latitude BETWEEN -90 AND 90 AND longitude BETWEEN -180 AND 180 "
+            "ORDER BY mmsi, minute");
+        if (query) {
+            // minute berisi jam UTC
+            query->bindValue(0, mmsiArray);
+            query->bindValue(1, SqlStatementRegistry::utcText(from));
+            query->bindValue(2, SqlStatementRegistry::utcText(to));
+        }
+    } else {
+        // Satu titik per bucket waktu; dalam satu bucket kapal bergerak kurang dari toleransi
+        const double bucketSecs = qBound(1.0, toleranceMeters / TRACK_MAX_SPEED_MPS, 60.0);
+        key = "track_points_raw";
+        query = statements.statement(key,
+            "SELECT DISTINCT ON (mmsi, bucket) mmsi, "
+            "       floor(extract(epoch FROM timestamp::timestamptz) / ?::float8) AS bucket, "
+            "       (extract(epoch FROM timestamp::timestamptz) * 1000)::bigint AS time_ms, latitude, longitude "
+            "FROM nmea_records "
+            "WHERE mmsi = ANY(?::bigint[]) AND timestamp >= ? AND timestamp < ? "
+            "AND received_at >= ?::timestamp AND received_at < ?::timestamp "
+            "AND latitude BETWEEN -90 AND 90 AND longitude BETWEEN -180 AND 180 "
+            "AND NOT (latitude = 0 AND longitude = 0) "
+            "ORDER BY mmsi, bucket, timestamp");
+        if (query) {
+            query->bindValue(0, bucketSecs);
+            query->bindValue(1, mmsiArray);
+            query->bindValue(2, SqlStatementRegistry::timestamp(from));
+            query->bindValue(3, SqlStatementRegistry::timestamp(to));
+            query->bindValue(4, SqlStatementRegistry::utcText(from.addDays(-RECEIVED_AT_SLACK_DAYS)));
+            query->bindValue(5, SqlStatementRegistry::utcText(to.addDays(RECEIVED_AT_SLACK_DAYS)));
+        }
+    }
+    if (!query) {
+        return false;
+    }
+    query->setForwardOnly(true);
+    if (!statements.exec(key)) {
+        qWarning() << "[TRACK] Fetch failed:" << query->lastError().text();
+        return false;
+    }
+
+    // Baris urut per MMSI: satu track ditahan di memori, disederhanakan begitu MMSI berganti
+    const int mmsiColumn = 0;
+    const int timeColumn = useRollup ? 1 : 2;
+    const int latColumn = timeColumn + 1;
+    const int lonColumn = timeColumn + 2;
+
+    quint32 currentMmsi = 0;
+    QVector<TrackPoint> points;
+    auto finishTrack = [&]() {
+        if (currentMmsi != 0) {
+            tracks.insert(currentMmsi, TrackSimplifier::simplify(points, toleranceMeters));
+        }
+        points.resize(0);
+    };
+
+    while (query->next()) {
+        const quint32 mmsi = query->value(mmsiColumn).toUInt();
+        if (mmsi != currentMmsi) {
+            finishTrack();
+            currentMmsi = mmsi;
+        }
+        TrackPoint point;
+        point.timeMs = query->value(timeColumn).toLongLong();
+        point.lat = query->value(latColumn).toDouble();
+        point.lon = query->value(lonColumn).toDouble();
+        points.append(point);
+    }
+    finishTrack();
+    query->finish();
+    return true;
+}
+
+void AisDatabaseManager::clearTrackCache()
+{
+    QMutexLocker locker(&trackCacheMutex);
+    trackCache.clear();
+}
 
 // Encode targets to NMEA 0183
 QStringList AisDatabaseManager::encodeTargetsToNMEA(const QList<TargetData>& targets) {
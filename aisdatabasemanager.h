@@ -10,7 +10,13 @@
 #include <QObject>
 #include <QQueue>
 #include <QHash>
+#include <QCache>
+#include <QThread>
+#include <atomic>
 #include "AIVDOEncoder.h"
+#include "nmearecordwriter.h"
+#include "sqlstatementregistry.h"
+#include "tracksimplifier.h"
 // SevenCs Kernel EC2007
 #ifdef _WIN32
 #include <windows.h>
@@ -25,6 +31,8 @@
 #include <ecs63.h>
 #endif
 
+struct AisAssembledMessage;
+
 class AisDatabaseManager {
 public:
     static AisDatabaseManager& instance();
@@ -40,6 +48,21 @@ public:
     // Check if database is connected
     bool isConnected() const;
 
+    // Koneksi terpisah untuk thread worker (QSqlDatabase tidak boleh dipakai lintas thread).
+    // Panggil dari thread pemakai; parameter koneksi di-clone dari koneksi default.
+    static QSqlDatabase openThreadConnection(const QString& connectionName);
+    static void closeThreadConnection(const QString& connectionName);
+
+    // nmea_records dipartisi harian per received_at (UTC). Query berbasis kolom timestamp
+    // menambahkan jendela received_at selebar ini di kedua sisi supaya partisi terpangkas
+    // tanpa mengubah hasil (timestamp dan received_at bisa beda zona pada data lama).
+    static const int RECEIVED_AT_SLACK_DAYS = 1;
+
+    // Statistik writer nmea_records (antrian, drop, commit)
+    NmeaRecordWriter::Stats recordWriterStats() const { return recordWriter.stats(); }
+    // Histogram latency semua prepared statement (koneksi utama + writer + maintenance)
+    QString statementLatencyReport() const;
+
     // Legacy functions (keep for backward compatibility)
     void insertOrUpdateAisTarget(const EcAISTargetInfo& info);
     void insertOwnShipToDB(double lat, double lon, double depth,
@@ -53,11 +76,14 @@ public:
     bool insertNmeaRecord(const QString& nmea, const QString& dataSource,
                           quint32 mmsi = 0, const QString& messageType = "");
 
-    // Enhanced recording with parsed AIS data (with throttling)
+    // Enhanced recording with parsed AIS data (enqueue ke NmeaRecordWriter, tidak memblok)
     bool insertParsedAisData(const QString& nmea, const QString& dataSource,
                            quint32 mmsi, const EcAISTargetInfo& targetInfo);
     bool insertParsedAisDataRev(const QString& nmea, const QString& dataSource,
                              quint32 mmsi, const EcAISTargetInfo& targetInfo);
+    // Pesan yang sudah dirakit AisFragmentAssembler milik pemanggil; satu baris per fragmen
+    bool insertParsedAisDataRev(const AisAssembledMessage& message, const QString& dataSource,
+                             quint32 mmsi, const EcAISTargetInfo& targetInfo);
     bool insertParsedOwnshipData(const QString& nmea, const QString& dataSource,
                                double lat, double lon, double sog, double cog, double heading);
 
@@ -101,6 +127,30 @@ public:
 
     QStringList encodeTargetsToNMEA(const QList<TargetData>& targets);
 
+    // Keyframe: snapshot semua target hidup + own ship tiap KEYFRAME_INTERVAL_SECS.
+    // Gambar lalu lintas di waktu T = keyframe terdekat <= T + replay nmea_records [takenAt, T).
+    struct Keyframe {
+        QDateTime takenAt;              // invalid = tidak ada keyframe dekat T, replay dari awal
+        QList<TargetData> targets;      // nmea = laporan posisi terakhir, statis dari target_references
+
+        bool isValid() const { return takenAt.isValid(); }
+    };
+    static const int KEYFRAME_INTERVAL_SECS = 60;
+    Keyframe loadKeyframe(const QDateTime& at);
+
+    // Track historis yang sudah disederhanakan (Douglas-Peucker) untuk skala tampilan.
+    // Hasil di-cache per (MMSI, rentang waktu, level toleranse); level lebih halus yang
+    // sudah ada di cache disederhanakan lagi tanpa ke database.
+    struct VesselTrack {
+        quint32 mmsi = 0;
+        QVector<TrackPoint> points;
+    };
+    // Toleransi untuk skala chart 1:scale, pixels = selisih layar yang masih bisa diterima
+    static double trackToleranceForScale(int scale, double pixels = 1.0);
+    QList<VesselTrack> getSimplifiedTracks(const QList<quint32>& mmsis, const QDateTime& from,
+                                           const QDateTime& to, double toleranceMeters);
+    void clearTrackCache();
+
     ~AisDatabaseManager();
 
 private:
@@ -108,10 +158,11 @@ private:
     QSqlDatabase db;
     QUuid currentSessionId;
 
-    // Simple throttling
-    static QDateTime lastAisRecordTime;
-    static QDateTime lastOwnshipRecordTime;
-    static const int RECORDING_THROTTLE_MS = 2000; // 2 seconds minimum interval
+    // Prepared statement untuk koneksi default (db)
+    SqlStatementRegistry statements;
+
+    // Batch writer nmea_records di thread sendiri
+    NmeaRecordWriter recordWriter;
 
     // High-performance async processing
     struct TargetReferenceRecord {
@@ -130,9 +181,63 @@ private:
     QMutex cacheMutex;
     QTimer* asyncProcessingTimer;
 
+    // Time-partitioned storage.
+    // Migrasi, partisi, rollup dan keyframe jalan di thread maintenance dengan koneksi sendiri
+    // (maintenanceDb); thread GUI hanya membaca state yang dilindungi maintenanceStateMutex.
+    static const int PARTITION_DAYS_AHEAD = 3;     // partisi harian dibuat sebelum dibutuhkan
+    static const int ROLLUP_LAG_SECS = 10;         // menit dianggap selesai setelah writer commit
+    static const int ROLLUP_MAX_MINUTES = 60;      // batas kerja satu tick (backfill bertahap)
+    static const int MAINTENANCE_INTERVAL_MS = 60 * 1000;
+    QThread* maintenanceThread;
+    std::atomic<bool> maintenanceStop;
+    QString maintenanceConnName;
+    QSqlDatabase maintenanceDb;                     // hanya di thread maintenance
+    SqlStatementRegistry maintenanceStatements;
+    mutable QMutex maintenanceStateMutex;           // partitioned, rollupStart, rollupWatermark
+    bool partitioned;
+    QDate firstDailyPartition;      // hari pertama setelah partisi legacy
+    QDate partitionsReadyUntil;
+    QDateTime rollupStart;          // rollup lengkap mulai menit ini (UTC)
+    QDateTime rollupWatermark;      // menit pertama yang belum di-rollup (UTC)
+
+    // Keyframe dibangun maju dari keyframe sebelumnya + baris satu interval
+    static const int KEYFRAME_TARGET_TTL_SECS = 10 * 60;   // sama dengan OBJ_CLEAN_TIME di ais.h
+    static const int KEYFRAME_MAX_PER_TICK = 60;            // batas backfill satu tick maintenance
+    static const int KEYFRAME_PRUNE_INTERVAL_SECS = 60 * 60;
+    bool keyframesReady;
+    bool keyframeChained;           // keyframe sebelumnya ada, cukup baca satu interval
+    QDateTime keyframeWatermark;    // keyframe berikutnya yang harus dibangun (UTC)
+    QDateTime keyframesPrunedAt;
+
+    // Cache track sederhana; cost = jumlah titik
+    static const int TRACK_CACHE_MAX_POINTS = 2000000;
+    static const int TRACK_CACHE_FINER_LEVELS = 4;          // level halus yang boleh diturunkan
+    static const int TRACK_ROLLUP_MIN_TOLERANCE_M = 64;     // di atas ini posisi per menit cukup
+    static const int TRACK_MAX_SPEED_MPS = 10;              // ~20 knot, untuk bucket waktu di SQL
+    QCache<QString, QVector<TrackPoint>> trackCache;
+    QMutex trackCacheMutex;
+    bool fetchTracks(const QList<quint32>& mmsis, const QDateTime& from, const QDateTime& to,
+                     double toleranceMeters, QHash<quint32, QVector<TrackPoint>>& tracks);
+
     // Performance setup
     void setupPerformanceOptimizations();
     void processTargetReferencesAsync();
+    void startMaintenance();
+    void stopMaintenance();
+    void maintenanceLoop();
+    // Rollup per menit mencakup [from, to] dan partisi sudah aktif (aman dari thread mana saja)
+    bool rollupCovers(const QDateTime& from, const QDateTime& to) const;
+    void setupPartitioning();
+    bool migrateToPartitionedTable();
+    void ensureDailyPartitions(const QDate& from, const QDate& to);
+    // Default partition sudah berisi baris hari itu: pindahkan ke partisi harian baru
+    bool createPartitionFromDefault(const QDate& day);
+    void rollupPositions();
+    void setupKeyframes();
+    void buildKeyframes();
+    // Retensi keyframe mengikuti nmea_records: keyframe sebelum partisi tertua dihapus
+    void pruneKeyframes();
+    void runMaintenance();
 
     // Fast insert functions (no trigger overhead)
     bool insertParsedAisDataFast(const QString& nmea, const QString& dataSource,
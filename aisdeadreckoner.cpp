@@ -0,0 +1,79 @@
+#include "aisdeadreckoner.h"
+#include "aistargetstore.h"
+#include <cmath>
+
+namespace {
+
+const double kDegToRad = M_PI / 180.0;
+const double kMaxRotDegMin = 720.0;     // batas wajar ROT; di atas ini dianggap noise
+
+} // namespace
+
+AisDeadReckoner::AisDeadReckoner(double horizonSec, double freshSec)
+    : m_horizonSec(horizonSec),
+      m_freshSec(qMin(freshSec, horizonSec))
+{
+}
+
+void AisDeadReckoner::predict(const AisTargetSnapshot &targets, qint64 nowMs, AisPrediction &out) const
+{
+    const AisTargetColumns &c = targets.columns();
+    const int n = c.size();
+
+    out.dLat.resize(n);
+    out.dLon.resize(n);
+    out.cog.resize(n);
+    out.confidence.resize(n);
+    out.epoch = targets.epoch();
+    out.atMs = nowMs;
+
+    const double *lat = c.lat.constData();
+    const double *sog = c.sog.constData();
+    const double *cog = c.cog.constData();
+    const double *rot = c.rot.constData();
+    const qint64 *updated = c.updatedMs.constData();
+    const quint8 *flags = c.flags.constData();
+
+    double *dLat = out.dLat.data();
+    double *dLon = out.dLon.data();
+    double *outCog = out.cog.data();
+    float *confidence = out.confidence.data();
+
+    const double fadeSec = qMax(m_horizonSec - m_freshSec, 1.0);
+
+    for (int i = 0; i < n; ++i) {
+        // Umur laporan, dibatasi horizon supaya target diam tidak "kabur" jauh
+        const double age = updated[i] > 0 ? qBound(0.0, (nowMs - updated[i]) / 1000.0, m_horizonSec)
+                                           : m_horizonSec;
+
+        // SOG/COG -1 = not available (lihat Ais::handleAISTargetUpdate)
+        const bool moving = sog[i] > 0.0 && sog[i] < 102.3 && cog[i] >= 0.0 && cog[i] < 360.0;
+        const double dist = moving ? sog[i] * age / 3600.0 : 0.0;     // NM
+        const double c0 = moving ? cog[i] * kDegToRad : 0.0;
+
+        const double rotDegMin = std::isfinite(rot[i]) ? qBound(-kMaxRotDegMin, rot[i], kMaxRotDegMin) : 0.0;
+        const double turn = moving ? rotDegMin / 60.0 * age * kDegToRad : 0.0;   // rad selama 'age'
+
+        double north, east;
+        if (std::fabs(turn) < 1e-4) {
+            north = dist * std::cos(c0);
+            east = dist * std::sin(c0);
+        } else {
+            // Busur dengan radius dist/turn
+            const double r = dist / turn;
+            north = r * (std::sin(c0 + turn) - std::sin(c0));
+            east = r * (std::cos(c0) - std::cos(c0 + turn));
+        }
+
+        const double cosLat = std::cos(lat[i] * kDegToRad);
+        dLat[i] = north / 60.0;
+        dLon[i] = cosLat > 1e-6 ? east / (60.0 * cosLat) : 0.0;
+
+        double course = std::fmod(cog[i] + turn / kDegToRad, 360.0);
+        if (course < 0.0) course += 360.0;
+        outCog[i] = moving ? course : cog[i];
+
+        const double fade = qBound(0.0, (age - m_freshSec) / fadeSec, 1.0);
+        confidence[i] = (flags[i] & AisTargetColumns::Lost) ? 0.0f : float(1.0 - fade);
+    }
+}
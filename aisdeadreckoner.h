@@ -0,0 +1,40 @@
+#ifndef AISDEADRECKONER_H
+#define AISDEADRECKONER_H
+
+#include <QtGlobal>
+#include <QVector>
+
+class AisTargetSnapshot;
+
+// Posisi prediksi semua target untuk satu frame, index sama dengan snapshot.
+// Offset dalam derajat relatif ke posisi laporan terakhir, jadi layer gambar cukup
+// memproyeksikan posisi laporan sekali per epoch dan menambah offset per frame.
+struct AisPrediction {
+    QVector<double> dLat;
+    QVector<double> dLon;
+    QVector<double> cog;            // course prediksi (ROT ikut diintegrasikan)
+    QVector<float> confidence;      // 1 = laporan segar, 0 = di luar horizon / lost
+
+    quint64 epoch = 0;              // epoch snapshot sumber
+    qint64 atMs = 0;
+
+    int size() const { return dLat.size(); }
+};
+
+// Ekstrapolasi kinematik (SOG, COG, ROT) dari laporan AIS terakhir.
+// Satu pass lurus atas kolom snapshot tanpa panggilan kernel SevenCs.
+// Gerak belok pakai busur dengan ROT konstan; jarak pendek jadi bumi dianggap datar lokal.
+class AisDeadReckoner {
+public:
+    explicit AisDeadReckoner(double horizonSec = 180.0, double freshSec = 10.0);
+
+    void predict(const AisTargetSnapshot &targets, qint64 nowMs, AisPrediction &out) const;
+
+    double horizonSec() const { return m_horizonSec; }
+
+private:
+    double m_horizonSec;    // ekstrapolasi berhenti di sini
+    double m_freshSec;      // sampai umur ini confidence penuh
+};
+
+#endif // AISDEADRECKONER_H
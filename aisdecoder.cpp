@@ -1,4 +1,6 @@
 #include "aisdecoder.h"
+#include "aispayload.h"
+#include "aisfragmentassembler.h"
 #include <cmath>
 #include <QDebug>
 
@@ -43,83 +45,111 @@ double AisDecoder::decodeAisOption(const QString &nmea, const QString &option, c
 
 AisData AisDecoder::parseAisMessage(const QString &nmea) {
     AisData result;
+    decode(nmea, result);
+    return result;
+}
+
+bool AisDecoder::decode(const QString &nmea, AisData &out) {
+    AisPayload payload;
+    if (!payload.unpackSentence(nmea))
+        return false;
+
+    return decodePayload(payload, out);
+}
 
-    QStringList parts = nmea.split(',');
-    if (parts.length() < 7 || parts[5].isEmpty())
-        return result;
+bool AisDecoder::decode(const AisAssembledMessage &message, AisData &out) {
+    AisPayload payload;
+    if (!payload.unpack(message.payload, message.payloadLength, message.fillBits))
+        return false;
 
-    QString payload = parts[5];
-    QString bin = sixbitToBinary(payload);
-    if (bin.length() < 6)
-        return result;
+    return decodePayload(payload, out);
+}
+
+bool AisDecoder::decodePayload(const AisPayload &p, AisData &result) {
+    const int bits = p.bitCount();
+    if (bits < 6)
+        return false;
 
-    result.messageType = binaryToInt(bin, 0, 6);
+    result.messageType = int(p.readBits(0, 6));
 
-    if (bin.length() >= 38)
-        result.mmsi = binaryToInt(bin, 8, 30);
+    if (bits >= 38)
+        result.mmsi = int(p.readBits(8, 30));
 
     switch (result.messageType) {
     case 1:
     case 2:
     case 3:
-        if (bin.length() >= 168) {
-            result.navStatus = binaryToInt(bin, 38, 4);
-            result.rot = binaryToInt(bin, 42, 8, true);
-            result.sog = binaryToInt(bin, 50, 10);
-            result.posAccuracy = binaryToInt(bin, 60, 1);
-            int lonRaw = binaryToInt(bin, 61, 28, true);
-            int latRaw = binaryToInt(bin, 89, 27, true);
-            result.longitude = decodeLongitude(lonRaw);
-            result.latitude = decodeLatitude(latRaw);
-            result.cog = binaryToInt(bin, 116, 12);
-            result.heading = binaryToInt(bin, 128, 9);
-            result.timestamp = binaryToInt(bin, 137, 6);
+        if (bits >= 168) {
+            result.navStatus = int(p.readBits(38, 4));
+            result.rot = int(p.readBits(42, 8, true));
+            result.sog = int(p.readBits(50, 10));
+            result.posAccuracy = p.readBits(60, 1) != 0;
+            result.longitude = decodeLongitude(int(p.readBits(61, 28, true)));
+            result.latitude = decodeLatitude(int(p.readBits(89, 27, true)));
+            result.cog = int(p.readBits(116, 12));
+            result.heading = int(p.readBits(128, 9));
+            result.timestamp = int(p.readBits(137, 6));
+            result.maneuverIndicator = int(p.readBits(143, 2));
+            result.raim = p.readBits(148, 1) != 0;
+            result.radioStatus = int(p.readBits(149, 19));
         }
         break;
     case 4:
-        if (bin.length() >= 168) {
-            int lonRaw = binaryToInt(bin, 79, 28, true);
-            int latRaw = binaryToInt(bin, 107, 27, true);
-            result.longitude = decodeLongitude(lonRaw);
-            result.latitude = decodeLatitude(latRaw);
+        if (bits >= 168) {
+            QDate date(int(p.readBits(38, 14)), int(p.readBits(52, 4)), int(p.readBits(56, 5)));
+            QTime time(int(p.readBits(61, 5)), int(p.readBits(66, 6)), int(p.readBits(72, 6)));
+            if (date.isValid() && time.isValid())
+                result.timestamp4 = QDateTime(date, time, Qt::UTC);
+            result.posAccuracy = p.readBits(78, 1) != 0;
+            result.longitude = decodeLongitude(int(p.readBits(79, 28, true)));
+            result.latitude = decodeLatitude(int(p.readBits(107, 27, true)));
         }
         break;
     case 5:
-        if (bin.length() >= 424) {
-            result.imo = binaryToInt(bin, 40, 30);
-            result.callsign = decodeSixbitAscii(bin.mid(70, 42));
-            result.shipname = decodeSixbitAscii(bin.mid(112, 120));
-            result.shiptype = binaryToInt(bin, 232, 8);
-            result.dimA = binaryToInt(bin, 240, 9);
-            result.dimB = binaryToInt(bin, 249, 9);
-            result.dimC = binaryToInt(bin, 258, 6);
-            result.dimD = binaryToInt(bin, 264, 6);
+        if (bits >= 424) {
+            result.imo = int(p.readBits(40, 30));
+            result.callsign = p.readString(70, 7);
+            result.shipname = p.readString(112, 20);
+            result.shiptype = int(p.readBits(232, 8));
+            result.dimA = int(p.readBits(240, 9));
+            result.dimB = int(p.readBits(249, 9));
+            result.dimC = int(p.readBits(258, 6));
+            result.dimD = int(p.readBits(264, 6));
         }
         break;
     case 18:
-        if (bin.length() >= 168) {
-            result.sog = binaryToInt(bin, 46, 10);
-            int lonRaw = binaryToInt(bin, 57, 28, true);
-            int latRaw = binaryToInt(bin, 85, 27, true);
-            result.longitude = decodeLongitude(lonRaw);
-            result.latitude = decodeLatitude(latRaw);
-            result.cog = binaryToInt(bin, 112, 12);
-            result.heading = binaryToInt(bin, 124, 9);
+    case 19:
+        if (bits >= 168) {
+            result.sog = int(p.readBits(46, 10));
+            result.posAccuracy = p.readBits(56, 1) != 0;
+            result.longitude = decodeLongitude(int(p.readBits(57, 28, true)));
+            result.latitude = decodeLatitude(int(p.readBits(85, 27, true)));
+            result.cog = int(p.readBits(112, 12));
+            result.heading = int(p.readBits(124, 9));
+            result.timestamp = int(p.readBits(133, 6));
+        }
+        if (result.messageType == 19 && bits >= 301) {
+            result.shipname = p.readString(143, 20);
+            result.shiptype = int(p.readBits(263, 8));
+            result.dimA = int(p.readBits(271, 9));
+            result.dimB = int(p.readBits(280, 9));
+            result.dimC = int(p.readBits(289, 6));
+            result.dimD = int(p.readBits(295, 6));
         }
         break;
 
     case 24:
-        if (bin.length() >= 160) {
-            int partNumber = binaryToInt(bin, 38, 2);
+        if (bits >= 160) {
+            int partNumber = int(p.readBits(38, 2));
             if (partNumber == 0) {
-                result.shipname = decodeSixbitAscii(bin.mid(40, 120));
-            } else if (partNumber == 1) {
-                result.shiptype = binaryToInt(bin, 40, 8);
-                result.callsign = decodeSixbitAscii(bin.mid(48, 42));
-                result.dimA = binaryToInt(bin, 90, 9);
-                result.dimB = binaryToInt(bin, 99, 9);
-                result.dimC = binaryToInt(bin, 108, 6);
-                result.dimD = binaryToInt(bin, 114, 6);
+                result.shipname = p.readString(40, 20);
+            } else if (partNumber == 1 && bits >= 162) {
+                result.shiptype = int(p.readBits(40, 8));
+                result.callsign = p.readString(90, 7);
+                result.dimA = int(p.readBits(132, 9));
+                result.dimB = int(p.readBits(141, 9));
+                result.dimC = int(p.readBits(150, 6));
+                result.dimD = int(p.readBits(156, 6));
             }
         }
         break;
@@ -128,40 +158,7 @@ AisData AisDecoder::parseAisMessage(const QString &nmea) {
         break;
     }
 
-    return result;
-}
-
-QString AisDecoder::decodeSixbitAscii(const QString &bin) {
-    QString result;
-    for (int i = 0; i + 6 <= bin.length(); i += 6) {
-        int val = binaryToInt(bin, i, 6);
-        QChar ch;
-        if (val < 32) ch = QChar(val + 64); // @ to _
-        else ch = QChar(val);
-        if (ch != '@') result.append(ch); // Remove padding '@'
-    }
-    return result.trimmed();
-}
-
-QString AisDecoder::sixbitToBinary(const QString &payload) {
-    QString bin;
-    for (QChar ch : payload) {
-        int val = ch.toLatin1() - 48;
-        if (val > 40) val -= 8;
-        bin += QString("%1").arg(val, 6, 2, QLatin1Char('0'));
-    }
-    return bin;
-}
-
-int AisDecoder::binaryToInt(const QString &bin, int start, int length, bool signedInt) {
-    QString segment = bin.mid(start, length);
-    if (!signedInt) return segment.toInt(nullptr, 2);
-
-    int value = segment.toInt(nullptr, 2);
-    if (segment[0] == '1') {
-        value -= (1 << length);
-    }
-    return value;
+    return true;
 }
 
 double AisDecoder::decodeLatitude(int rawLat) {
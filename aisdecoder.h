@@ -4,6 +4,9 @@
 #include <QDateTime>
 #include <QString>
 
+class AisPayload;
+struct AisAssembledMessage;
+
 struct AisData {
     int messageType = 0;
     int mmsi = 0;
@@ -35,10 +38,16 @@ public:
     static QString decodeAis(const QString &nmea);
     static double decodeAisOption(const QString &nmea, const QString &option, const QString &aivd);
 
+    // Decode a whole sentence once instead of calling decodeAisOption per field.
+    // Stateless: a fragment of a multi-sentence message is decoded on its own.
+    // Callers that need whole messages own an AisFragmentAssembler and use the overload below.
+    static bool decode(const QString &nmea, AisData &out);
+    // Decode a message already reassembled by AisFragmentAssembler
+    static bool decode(const AisAssembledMessage &message, AisData &out);
+    // Decode an already unpacked payload (types 1/2/3/4/5/18/19/24)
+    static bool decodePayload(const AisPayload &payload, AisData &out);
+
 private:
-    static QString decodeSixbitAscii(const QString &bin);
-    static QString sixbitToBinary(const QString &payload);
-    static int binaryToInt(const QString &bin, int start, int length, bool signedInt = false);
     static double decodeLatitude(int rawLat);
     static double decodeLongitude(int rawLon);
     static bool isValidNmea(const QString &nmea, const QString &aivd);
@@ -0,0 +1,232 @@
+#include "aisdvrsink.h"
+#include "PluginManager.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <QStringList>
+
+// Plugin lama: tiap baris dikonversi ke QString dan dikirim lewat recordRawNmea()
+class AisDvrSink::LegacyAdapter : public IAisDvrPlugin2
+{
+public:
+    explicit LegacyAdapter(IAisDvrPlugin* plugin) : m_plugin(plugin) {}
+
+    void startRecording(const QString& filePath) override { m_plugin->startRecording(filePath); }
+    void stopRecording() override { m_plugin->stopRecording(); }
+    bool isRecording() const override { return m_plugin->isRecording(); }
+    void recordRawNmea(const QString& nmeaSentence) override { m_plugin->recordRawNmea(nmeaSentence); }
+
+    void recordBatch(const AisDvrLine* lines, int count) override
+    {
+        for (int i = 0; i < count; ++i) {
+            m_plugin->recordRawNmea(QString::fromLatin1(lines[i].data, lines[i].length));
+        }
+    }
+
+    void flush() override {}    // v1 tidak punya flush; plugin menulis sendiri
+
+private:
+    IAisDvrPlugin* m_plugin;
+};
+
+namespace {
+
+struct SinkRegistry {
+    QMutex mutex;
+    QHash<QString, AisDvrSink*> sinks;
+
+    ~SinkRegistry() { qDeleteAll(sinks); }
+};
+
+SinkRegistry& registry()
+{
+    static SinkRegistry r;
+    return r;
+}
+
+void updateMax(std::atomic<quint64>& target, quint64 value)
+{
+    quint64 current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+AisDvrSink* AisDvrSink::forKey(const QString& key)
+{
+    SinkRegistry& r = registry();
+    QMutexLocker lock(&r.mutex);
+
+    AisDvrSink* sink = r.sinks.value(key, nullptr);
+    if (sink)
+        return sink;
+
+    QObject* object = PluginManager::instance().getPlugin<QObject>(key);
+    IAisDvrPlugin* plugin = qobject_cast<IAisDvrPlugin*>(object);
+    if (!plugin)
+        return nullptr;     // tidak di-cache: plugin masih bisa didaftarkan belakangan
+
+    sink = new AisDvrSink(object, plugin);
+    r.sinks.insert(key, sink);
+    qDebug() << "[DVR] Sink" << key << "->" << sink->pluginName()
+             << (sink->isNative() ? "(IAisDvrPlugin2)" : "(IAisDvrPlugin, adapter)");
+    return sink;
+}
+
+QString AisDvrSink::statsReport()
+{
+    SinkRegistry& r = registry();
+    QMutexLocker lock(&r.mutex);
+
+    QStringList rows;
+    for (auto it = r.sinks.constBegin(); it != r.sinks.constEnd(); ++it) {
+        const Stats s = it.value()->stats();
+        const double avgUs = s.batches ? double(s.totalUs) / s.batches : 0.0;
+        const double usPerLine = s.lines ? double(s.totalUs) / s.lines : 0.0;
+        rows << QString("%1 [%2%3]: %4 lines, %5 KB, %6 batches (avg %7 us, max %8 us, %9 us/line), %10 flushes")
+                    .arg(it.key(), it.value()->pluginName(), it.value()->isNative() ? "" : ", adapter")
+                    .arg(s.lines).arg(s.bytes / 1024).arg(s.batches)
+                    .arg(avgUs, 0, 'f', 1).arg(s.maxUs).arg(usPerLine, 0, 'f', 2)
+                    .arg(s.flushes);
+    }
+    return rows.join('\n');
+}
+
+AisDvrSink::AisDvrSink(QObject* object, IAisDvrPlugin* plugin)
+    : m_plugin(plugin),
+      m_name(object->metaObject()->className())
+{
+    m_target = qobject_cast<IAisDvrPlugin2*>(object);
+    if (!m_target) {
+        m_adapter = new LegacyAdapter(plugin);
+        m_target = m_adapter;
+    }
+}
+
+AisDvrSink::~AisDvrSink()
+{
+    delete m_adapter;
+}
+
+void AisDvrSink::recordBatch(const AisDvrLine* lines, int count)
+{
+    if (count <= 0)
+        return;
+
+    quint64 bytes = 0;
+    for (int i = 0; i < count; ++i) {
+        bytes += quint64(lines[i].length);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    m_target->recordBatch(lines, count);
+    const quint64 us = quint64(timer.nsecsElapsed() / 1000);
+
+    m_lines.fetch_add(quint64(count), std::memory_order_relaxed);
+    m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    m_batches.fetch_add(1, std::memory_order_relaxed);
+    m_totalUs.fetch_add(us, std::memory_order_relaxed);
+    updateMax(m_maxUs, us);
+}
+
+void AisDvrSink::record(const char* data, int length, qint64 timeMs)
+{
+    const AisDvrLine line = { timeMs, data, length };
+    recordBatch(&line, 1);
+}
+
+void AisDvrSink::record(const QString& line)
+{
+    // NMEA 0183 maksimal 82 karakter; baris lebih panjang (tag block) pakai heap
+    char buffer[256];
+    const int length = line.length();
+    if (length > int(sizeof(buffer))) {
+        const QByteArray latin = line.toLatin1();
+        record(latin.constData(), latin.size(), QDateTime::currentMSecsSinceEpoch());
+        return;
+    }
+
+    const QChar* src = line.constData();
+    for (int i = 0; i < length; ++i) {
+        buffer[i] = src[i].toLatin1();
+    }
+    record(buffer, length, QDateTime::currentMSecsSinceEpoch());
+}
+
+void AisDvrSink::flush()
+{
+    m_target->flush();
+    m_flushes.fetch_add(1, std::memory_order_relaxed);
+}
+
+AisDvrSink::Stats AisDvrSink::stats() const
+{
+    Stats s;
+    s.lines = m_lines.load(std::memory_order_relaxed);
+    s.bytes = m_bytes.load(std::memory_order_relaxed);
+    s.batches = m_batches.load(std::memory_order_relaxed);
+    s.flushes = m_flushes.load(std::memory_order_relaxed);
+    s.totalUs = m_totalUs.load(std::memory_order_relaxed);
+    s.maxUs = m_maxUs.load(std::memory_order_relaxed);
+    return s;
+}
+
+void AisDvrSink::resetStats()
+{
+    m_lines = 0;
+    m_bytes = 0;
+    m_batches = 0;
+    m_flushes = 0;
+    m_totalUs = 0;
+    m_maxUs = 0;
+}
+
+// ========================================
+// BATCH
+// ========================================
+
+void AisDvrBatch::append(const char* data, int length, qint64 timeMs)
+{
+    if (length <= 0)
+        return;
+
+    if (m_arena.capacity() == 0) {
+        // reserve() menandai kapasitas tetap, jadi truncate(0) tidak membebaskan buffer
+        m_arena.reserve(AIS_DVR_BATCH_LINES * 96);
+    }
+    const Entry entry = { timeMs, m_arena.size(), length };
+    m_arena.append(data, length);
+    m_entries.append(entry);
+}
+
+void AisDvrBatch::submit(AisDvrSink* sink)
+{
+    if (m_entries.isEmpty())
+        return;
+
+    if (sink) {
+        // Span dibangun setelah arena berhenti tumbuh supaya pointer-nya stabil
+        m_spans.resize(m_entries.size());
+        const char* base = m_arena.constData();
+        for (int i = 0; i < m_entries.size(); ++i) {
+            const Entry& e = m_entries.at(i);
+            m_spans[i] = { e.timeMs, base + e.offset, e.length };
+        }
+        sink->recordBatch(m_spans.constData(), m_spans.size());
+    }
+    clear();
+}
+
+void AisDvrBatch::clear()
+{
+    // Kapasitas arena dan vektor dipertahankan untuk batch berikutnya
+    m_arena.truncate(0);
+    m_entries.resize(0);
+    m_spans.resize(0);
+}
@@ -0,0 +1,96 @@
+#ifndef AISDVRSINK_H
+#define AISDVRSINK_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <atomic>
+
+#include "IAisDvrPlugin2.h"
+
+#define AIS_DVR_PLUGIN_KEY      "IAisDvrPlugin"
+#define AIS_DVR_BATCH_LINES     256     // AisDvrBatch dikirim paling lambat setiap N baris
+
+class QObject;
+
+// Jalur rekam DVR untuk satu plugin. Di-resolve sekali per key (bukan per baris),
+// memakai IAisDvrPlugin2 langsung kalau plugin mendukungnya dan adapter ke
+// recordRawNmea() untuk plugin lama. Mencatat throughput dan latency per plugin.
+// Aman dipanggil dari beberapa thread selama plugin-nya sendiri aman.
+class AisDvrSink
+{
+public:
+    struct Stats {
+        quint64 lines = 0;
+        quint64 bytes = 0;
+        quint64 batches = 0;
+        quint64 flushes = 0;
+        quint64 totalUs = 0;        // waktu di dalam plugin
+        quint64 maxUs = 0;          // batch paling lambat
+    };
+
+    // nullptr kalau tidak ada plugin dengan key ini
+    static AisDvrSink* forKey(const QString& key = QStringLiteral(AIS_DVR_PLUGIN_KEY));
+    // Statistik semua sink yang pernah di-resolve, satu baris per plugin
+    static QString statsReport();
+
+    ~AisDvrSink();
+
+    IAisDvrPlugin* plugin() const { return m_plugin; }
+    bool isNative() const { return m_adapter == nullptr; }
+    QString pluginName() const { return m_name; }
+    bool isRecording() const { return m_plugin->isRecording(); }
+
+    void recordBatch(const AisDvrLine* lines, int count);
+    void record(const char* data, int length, qint64 timeMs);
+    void record(const QString& line);   // NMEA ASCII, waktu = sekarang
+    void flush();
+
+    Stats stats() const;
+    void resetStats();
+
+private:
+    class LegacyAdapter;
+
+    AisDvrSink(QObject* object, IAisDvrPlugin* plugin);
+    Q_DISABLE_COPY(AisDvrSink)
+
+    IAisDvrPlugin* m_plugin;
+    IAisDvrPlugin2* m_target;           // plugin v2 atau m_adapter
+    LegacyAdapter* m_adapter = nullptr;
+    QString m_name;
+
+    std::atomic<quint64> m_lines{0};
+    std::atomic<quint64> m_bytes{0};
+    std::atomic<quint64> m_batches{0};
+    std::atomic<quint64> m_flushes{0};
+    std::atomic<quint64> m_totalUs{0};
+    std::atomic<quint64> m_maxUs{0};
+};
+
+// Kumpulan baris yang disalin ke satu buffer lalu dikirim sebagai satu recordBatch().
+// Dipakai satu thread (mis. Ais::IngestContext).
+class AisDvrBatch
+{
+public:
+    void append(const char* data, int length, qint64 timeMs);
+    int size() const { return m_entries.size(); }
+    bool isEmpty() const { return m_entries.isEmpty(); }
+    // Kirim ke sink (boleh nullptr) lalu kosongkan
+    void submit(AisDvrSink* sink);
+    void clear();
+
+private:
+    struct Entry {
+        qint64 timeMs;
+        int offset;
+        int length;
+    };
+
+    QByteArray m_arena;
+    QVector<Entry> m_entries;
+    QVector<AisDvrLine> m_spans;
+};
+
+#endif // AISDVRSINK_H
@@ -0,0 +1,281 @@
+#include "aisfragmentassembler.h"
+#include <cstring>
+
+namespace {
+
+int hexValue(char ch)
+{
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+    return -1;
+}
+
+// Fields of one !--VDM/!--VDO sentence, as offsets into the original text
+struct SentenceFields {
+    int total = 0;
+    int part = 0;
+    int sequenceId = -1;
+    char channel = 0;
+    int payloadStart = 0;
+    int payloadLength = 0;
+    int fillBits = 0;
+    bool ownShip = false;
+};
+
+bool parseSentence(const char *nmea, int length, SentenceFields &f)
+{
+    if (length < 15 || nmea[0] != '!' || nmea[3] != 'V' || nmea[4] != 'D')
+        return false;
+    if (nmea[5] != 'M' && nmea[5] != 'O')
+        return false;
+    f.ownShip = nmea[5] == 'O';
+
+    // Optional checksum
+    int star = -1;
+    for (int i = length - 1; i > 0 && i >= length - 3; --i) {
+        if (nmea[i] == '*') { star = i; break; }
+    }
+    if (star > 0) {
+        int hi = hexValue(nmea[star + 1]);
+        int lo = star + 2 < length ? hexValue(nmea[star + 2]) : -1;
+        if (hi < 0 || lo < 0)
+            return false;
+        int checksum = 0;
+        for (int i = 1; i < star; ++i) checksum ^= static_cast<unsigned char>(nmea[i]);
+        if (checksum != ((hi << 4) | lo))
+            return false;
+    }
+
+    // !AIVDM,<total>,<part>,<seq>,<chan>,<payload>,<fill>
+    int commas[6];
+    int found = 0;
+    for (int i = 6; i < length && found < 6; ++i) {
+        if (nmea[i] == ',') commas[found++] = i;
+    }
+    if (nmea[6] != ',' || found < 6)
+        return false;
+
+    auto digit = [&](int fieldStart, int fieldEnd) {
+        return (fieldEnd - fieldStart == 1 && nmea[fieldStart] >= '0' && nmea[fieldStart] <= '9')
+                   ? nmea[fieldStart] - '0' : -1;
+    };
+
+    f.total = digit(commas[0] + 1, commas[1]);
+    f.part = digit(commas[1] + 1, commas[2]);
+    f.sequenceId = commas[3] - commas[2] > 1 ? digit(commas[2] + 1, commas[3]) : -1;
+    f.channel = commas[4] - commas[3] > 1 ? nmea[commas[3] + 1] : 0;
+    f.payloadStart = commas[4] + 1;
+    f.payloadLength = commas[5] - f.payloadStart;
+
+    int fill = commas[5] + 1 < length ? nmea[commas[5] + 1] - '0' : 0;
+    f.fillBits = (fill >= 0 && fill <= 5) ? fill : 0;
+
+    return f.total >= 1 && f.total <= AisFragmentAssembler::MAX_PARTS &&
+           f.part >= 1 && f.part <= f.total &&
+           f.payloadLength > 0 && f.payloadLength <= AisFragmentAssembler::MAX_FRAGMENT_PAYLOAD;
+}
+
+} // namespace
+
+AisFragmentAssembler::AisFragmentAssembler(qint64 maxAgeMs)
+    : m_maxAgeMs(maxAgeMs)
+{
+    m_clock.start();
+}
+
+void AisFragmentAssembler::clear()
+{
+    for (Slot &slot : m_slots) {
+        slot.used = false;
+        slot.receivedMask = 0;
+    }
+}
+
+int AisFragmentAssembler::pendingCount() const
+{
+    int count = 0;
+    for (const Slot &slot : m_slots) {
+        if (slot.used) ++count;
+    }
+    return count;
+}
+
+qint64 AisFragmentAssembler::clockMs()
+{
+    return m_clock.elapsed() + 1; // never 0, 0 means "ask the clock"
+}
+
+AisFragmentAssembler::Result AisFragmentAssembler::addSentence(const QString &nmea, AisAssembledMessage &out, qint64 nowMs)
+{
+    int length = nmea.length();
+    if (length > int(sizeof(m_latin1))) {
+        ++m_stats.sentences;
+        ++m_stats.rejected;
+        return Rejected;
+    }
+
+    // NMEA is plain ASCII, a narrowing copy into a fixed buffer is enough
+    const QChar *src = nmea.constData();
+    for (int i = 0; i < length; ++i) {
+        ushort ch = src[i].unicode();
+        m_latin1[i] = ch < 0x80 ? char(ch) : '?';
+    }
+    return addSentence(m_latin1, length, out, nowMs);
+}
+
+AisFragmentAssembler::Result AisFragmentAssembler::addSentence(const char *nmea, int length, AisAssembledMessage &out, qint64 nowMs)
+{
+    ++m_stats.sentences;
+
+    // Line endings are not part of the sentence
+    while (length > 0 && (nmea[length - 1] == '\r' || nmea[length - 1] == '\n' || nmea[length - 1] == ' '))
+        --length;
+
+    SentenceFields f;
+    if (length > MAX_SENTENCE || !parseSentence(nmea, length, f)) {
+        ++m_stats.rejected;
+        return Rejected;
+    }
+
+    if (nowMs <= 0)
+        nowMs = clockMs();
+
+    if (nowMs - m_lastExpireMs >= 250) {
+        expire(nowMs);
+        m_lastExpireMs = nowMs;
+    }
+
+    // Single-sentence messages (the vast majority) bypass the slot table
+    if (f.total == 1) {
+        std::memcpy(m_payloadOut, nmea + f.payloadStart, size_t(f.payloadLength));
+        std::memcpy(m_sentencesOut, nmea, size_t(length));
+
+        out.payload = m_payloadOut;
+        out.payloadLength = f.payloadLength;
+        out.fillBits = f.fillBits;
+        out.sentences = m_sentencesOut;
+        out.sentencesLength = length;
+        out.fragmentCount = 1;
+        out.fragments[0] = m_sentencesOut;
+        out.fragmentLengths[0] = length;
+        out.channel = f.channel;
+        out.ownShip = f.ownShip;
+
+        ++m_stats.completed;
+        return Complete;
+    }
+
+    Slot *slot = findSlot(f.channel, f.sequenceId, f.total, f.ownShip);
+
+    // A new first fragment restarts a half-finished message with the same key
+    if (slot && f.part == 1 && slot->receivedMask != 0) {
+        ++m_stats.expired;
+        slot->receivedMask = 0;
+        slot->firstSeenMs = nowMs;
+    }
+
+    if (!slot) {
+        slot = takeSlot(nowMs);
+        slot->used = true;
+        slot->channel = f.channel;
+        slot->sequenceId = f.sequenceId;
+        slot->total = f.total;
+        slot->ownShip = f.ownShip;
+        slot->receivedMask = 0;
+        slot->firstSeenMs = nowMs;
+    }
+
+    const int index = f.part - 1;
+    std::memcpy(slot->payload[index], nmea + f.payloadStart, size_t(f.payloadLength));
+    std::memcpy(slot->sentence[index], nmea, size_t(length));
+    slot->payloadLength[index] = qint16(f.payloadLength);
+    slot->sentenceLength[index] = qint16(length);
+    slot->receivedMask |= quint16(1u << index);
+    if (f.part == f.total)
+        slot->fillBits = f.fillBits;
+
+    const quint16 fullMask = quint16((1u << f.total) - 1);
+    if (slot->receivedMask != fullMask)
+        return Incomplete;
+
+    Result result = deliver(*slot, out);
+    slot->used = false;
+    slot->receivedMask = 0;
+    return result;
+}
+
+AisFragmentAssembler::Slot* AisFragmentAssembler::findSlot(char channel, int sequenceId, int total, bool ownShip)
+{
+    for (Slot &slot : m_slots) {
+        if (slot.used && slot.channel == channel && slot.sequenceId == sequenceId &&
+            slot.total == total && slot.ownShip == ownShip) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+AisFragmentAssembler::Slot* AisFragmentAssembler::takeSlot(qint64 nowMs)
+{
+    Slot *oldest = &m_slots[0];
+    for (Slot &slot : m_slots) {
+        if (!slot.used)
+            return &slot;
+        if (slot.firstSeenMs < oldest->firstSeenMs)
+            oldest = &slot;
+    }
+
+    // Table full: reuse the oldest partial message
+    if (nowMs - oldest->firstSeenMs > m_maxAgeMs)
+        ++m_stats.expired;
+    else
+        ++m_stats.evicted;
+
+    oldest->used = false;
+    oldest->receivedMask = 0;
+    return oldest;
+}
+
+void AisFragmentAssembler::expire(qint64 nowMs)
+{
+    for (Slot &slot : m_slots) {
+        if (slot.used && nowMs - slot.firstSeenMs > m_maxAgeMs) {
+            slot.used = false;
+            slot.receivedMask = 0;
+            ++m_stats.expired;
+        }
+    }
+}
+
+AisFragmentAssembler::Result AisFragmentAssembler::deliver(const Slot &slot, AisAssembledMessage &out)
+{
+    int payloadLength = 0;
+    int sentencesLength = 0;
+
+    for (int i = 0; i < slot.total; ++i) {
+        std::memcpy(m_payloadOut + payloadLength, slot.payload[i], size_t(slot.payloadLength[i]));
+        payloadLength += slot.payloadLength[i];
+
+        if (i > 0) {
+            m_sentencesOut[sentencesLength++] = '\r';
+            m_sentencesOut[sentencesLength++] = '\n';
+        }
+        std::memcpy(m_sentencesOut + sentencesLength, slot.sentence[i], size_t(slot.sentenceLength[i]));
+        out.fragments[i] = m_sentencesOut + sentencesLength;
+        out.fragmentLengths[i] = slot.sentenceLength[i];
+        sentencesLength += slot.sentenceLength[i];
+    }
+
+    out.payload = m_payloadOut;
+    out.payloadLength = payloadLength;
+    out.fillBits = slot.fillBits;
+    out.sentences = m_sentencesOut;
+    out.sentencesLength = sentencesLength;
+    out.fragmentCount = slot.total;
+    out.channel = slot.channel;
+    out.ownShip = slot.ownShip;
+
+    ++m_stats.completed;
+    return Complete;
+}
@@ -0,0 +1,99 @@
+#ifndef AISFRAGMENTASSEMBLER_H
+#define AISFRAGMENTASSEMBLER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QElapsedTimer>
+
+#define AIS_MAX_FRAGMENTS   9       // total parts is a single digit in the sentence
+
+// A complete AIS message as handed out by AisFragmentAssembler.
+// All pointers refer to the assembler's own buffers and stay valid until the next addSentence().
+struct AisAssembledMessage {
+    const char *payload = nullptr;   // armored payload of all fragments, back to back
+    int payloadLength = 0;
+    int fillBits = 0;                // fill bits of the last fragment
+    const char *sentences = nullptr; // original sentences joined with "\r\n"
+    int sentencesLength = 0;
+    int fragmentCount = 0;
+    const char *fragments[AIS_MAX_FRAGMENTS] = {};  // each original sentence, in part order
+    int fragmentLengths[AIS_MAX_FRAGMENTS] = {};
+    char channel = 0;
+    bool ownShip = false;            // !AIVDO
+
+    QString sentencesString() const { return QString::fromLatin1(sentences, sentencesLength); }
+    QString fragmentString(int part) const { return QString::fromLatin1(fragments[part], fragmentLengths[part]); }
+};
+
+// Multi-sentence AIVDM/AIVDO reassembly.
+// Fragments are keyed by (channel, sequence id, total parts) and parked in a fixed
+// slot table; nothing is allocated per fragment. Stale slots are evicted by age and,
+// when the table is full, the oldest slot is reused.
+class AisFragmentAssembler {
+public:
+    enum Result {
+        Incomplete, // fragment stored, waiting for the rest
+        Complete,   // message ready in 'out'
+        Rejected    // not an AIS sentence, bad checksum or inconsistent fragment
+    };
+
+    struct Stats {
+        quint64 sentences = 0;
+        quint64 completed = 0;
+        quint64 rejected = 0;
+        quint64 expired = 0;   // partial messages dropped because they got too old
+        quint64 evicted = 0;   // partial messages dropped because the table was full
+    };
+
+    static const int MAX_PARTS = AIS_MAX_FRAGMENTS;
+    static const int MAX_FRAGMENT_PAYLOAD = 82;  // a whole sentence is at most 82 chars
+    static const int MAX_SENTENCE = 96;
+    static const int SLOT_COUNT = 32;
+
+    explicit AisFragmentAssembler(qint64 maxAgeMs = 5000);
+
+    // nowMs is any monotonic millisecond clock (e.g. QElapsedTimer); 0 = use internal clock
+    Result addSentence(const char *nmea, int length, AisAssembledMessage &out, qint64 nowMs = 0);
+    Result addSentence(const QString &nmea, AisAssembledMessage &out, qint64 nowMs = 0);
+
+    void clear();
+    const Stats& stats() const { return m_stats; }
+    int pendingCount() const;
+
+    void setMaxAge(qint64 maxAgeMs) { m_maxAgeMs = maxAgeMs; }
+
+private:
+    struct Slot {
+        bool used = false;
+        char channel = 0;
+        int sequenceId = -1;
+        int total = 0;
+        bool ownShip = false;
+        quint16 receivedMask = 0;
+        qint64 firstSeenMs = 0;
+        int fillBits = 0;
+        qint16 payloadLength[MAX_PARTS];
+        qint16 sentenceLength[MAX_PARTS];
+        char payload[MAX_PARTS][MAX_FRAGMENT_PAYLOAD];
+        char sentence[MAX_PARTS][MAX_SENTENCE];
+    };
+
+    Slot* findSlot(char channel, int sequenceId, int total, bool ownShip);
+    Slot* takeSlot(qint64 nowMs);
+    void expire(qint64 nowMs);
+    Result deliver(const Slot &slot, AisAssembledMessage &out);
+    qint64 clockMs();
+
+    Slot m_slots[SLOT_COUNT];
+    qint64 m_maxAgeMs;
+    qint64 m_lastExpireMs = 0;
+    Stats m_stats;
+    QElapsedTimer m_clock;
+
+    // Output buffers for the last completed message
+    char m_payloadOut[MAX_PARTS * MAX_FRAGMENT_PAYLOAD];
+    char m_sentencesOut[MAX_PARTS * (MAX_SENTENCE + 2)];
+    char m_latin1[MAX_SENTENCE * 2];
+};
+
+#endif // AISFRAGMENTASSEMBLER_H
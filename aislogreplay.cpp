@@ -0,0 +1,400 @@
+#include "aislogreplay.h"
+#include "ais.h"
+#include "dvrsegment.h"
+#include "dvrreplaystreamer.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QThread>
+#include <limits>
+
+namespace {
+
+// Log tanpa timestamp sama sekali diputar dengan jarak tetap per baris
+// (sama dengan delay replay lama); index untimed memakai jarak yang sama
+const qint64 kUntimedLineMs = NmeaLogIndex::UntimedLineMs;
+
+// Bagian frame yang boleh dipakai ingest; sisanya untuk paint
+const qint64 kFrameBudgetMs = AIS_UI_FRAME_MS / 2;
+
+// Tertinggal lebih dari ini (waktu dinding) berarti mesin tidak kuat di kecepatan
+// ini: jam virtual ditahan supaya GUI tidak ikut tenggelam mengejar backlog
+const qint64 kMaxLagWallMs = 1000;
+
+// Laporan posisi kelas A tiap 2-10 detik; seek mulai sedikit lebih awal supaya
+// target di sekitar waktu tujuan sudah tergambar
+const qint64 kSeekPrerollMs = 60 * 1000;
+
+// Seek rekaman DVR menunggu worker paling lama sekian supaya pre-roll langsung tergambar;
+// sisanya dikejar tick berikutnya. Tick biasa tidak pernah menunggu worker.
+const qint64 kDvrSeekWaitMs = 250;
+
+// Baris NMEA terakhir per batch yang dikirim ke panel teks
+const int kTailLines = 50;
+
+} // namespace
+
+constexpr double AisLogReplay::MinSpeed;
+constexpr double AisLogReplay::MaxSpeed;
+
+AisLogReplay::AisLogReplay(Ais *ais, QObject *parent)
+    : QObject(parent),
+      m_ais(ais)
+{
+    m_timer.setInterval(AIS_UI_FRAME_MS);
+    connect(&m_timer, &QTimer::timeout, this, &AisLogReplay::tick);
+
+    connect(&m_indexWatcher, &QFutureWatcherBase::finished, this, [this]() {
+        if (m_indexStop.load())
+            return;
+        m_index = m_indexWatcher.result();
+        m_indexReady = true;
+        emit indexReady(m_index.startMs(), m_index.endMs());
+    });
+
+    m_wall.start();
+}
+
+AisLogReplay::~AisLogReplay()
+{
+    close();
+}
+
+bool AisLogReplay::open(const QString &path)
+{
+    close();
+
+    if (path.endsWith(QLatin1String(DVR_SEGMENT_SUFFIX)))
+        return openRecording(path);
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[AIS REPLAY] Could not open AIS logfile:" << path;
+        return false;
+    }
+    m_cursor.reset(new NmeaLogCursor(&m_file));
+
+    m_ais->_bReadFromFile = True;
+    m_ais->_bReadFromVariable = False;
+    m_ais->_bReadFromServer = False;
+    m_ais->closeSocketConnection();
+
+    m_lineTimeMs = 0;
+    m_timed = false;
+    m_started = false;
+    reanchor(0);
+
+    // Sidecar masih valid: seek langsung tersedia
+    if (m_index.load(path)) {
+        m_indexReady = true;
+        emit indexReady(m_index.startMs(), m_index.endMs());
+        return true;
+    }
+
+    // Scan di thread lain, playback tidak menunggu
+    m_indexStop = false;
+    m_indexWatcher.setFuture(QtConcurrent::run([this, path]() {
+        IndexerWorker worker;
+        worker.filePath = path;
+        worker.stopFlag = &m_indexStop;
+        worker.onProgress = [this](int percent) {
+            QMetaObject::invokeMethod(this, [this, percent]() { emit indexProgress(percent); },
+                                      Qt::QueuedConnection);
+        };
+        worker.process();
+        return worker.index;
+    }));
+    return true;
+}
+
+bool AisLogReplay::openRecording(const QString &segmentPath)
+{
+    QScopedPointer<DvrReplayStreamer> dvr(new DvrReplayStreamer);
+    if (!dvr->open(segmentPath)) {
+        qWarning() << "[AIS REPLAY] Could not read DVR recording:" << segmentPath;
+        return false;
+    }
+
+    // Rentang datang dari worker; sinyal dari streamer yang sudah diganti/ditutup diabaikan
+    DvrReplayStreamer *streamer = dvr.data();
+    connect(streamer, &DvrReplayStreamer::rangeReady, this, [this, streamer](qint64 firstMs, qint64 lastMs) {
+        if (m_dvr.data() != streamer)
+            return;
+        m_dvrStartMs = firstMs;
+        m_dvrEndMs = lastMs;
+        m_indexReady = true;
+        emit indexReady(firstMs, lastMs);
+    });
+    m_dvr.swap(dvr);
+
+    m_ais->_bReadFromFile = True;
+    m_ais->_bReadFromVariable = False;
+    m_ais->_bReadFromServer = False;
+    m_ais->closeSocketConnection();
+
+    m_lineTimeMs = 0;
+    m_timed = false;
+    m_started = false;
+    reanchor(0);
+
+    m_dvr->start(std::numeric_limits<qint64>::min());
+    return true;
+}
+
+void AisLogReplay::stopIndexer()
+{
+    if (m_indexWatcher.isRunning()) {
+        m_indexStop = true;
+        m_indexWatcher.waitForFinished();
+    }
+}
+
+void AisLogReplay::close()
+{
+    pause();
+    stopIndexer();
+
+    m_cursor.reset();
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_dvr.reset();
+    m_dvrStartMs = 0;
+    m_dvrEndMs = -1;
+    m_catchUpMs = 0;
+    m_index = NmeaLogIndex();
+    m_indexReady = false;
+    m_tail.clear();
+    m_ais->setReplayClock(0);
+}
+
+qint64 AisLogReplay::position() const
+{
+    if (!m_playing)
+        return m_anchorLogMs;
+    return m_anchorLogMs + qint64((m_wall.elapsed() - m_anchorWallMs) * m_speed);
+}
+
+void AisLogReplay::reanchor(qint64 logMs)
+{
+    m_anchorLogMs = logMs;
+    m_anchorWallMs = m_wall.elapsed();
+}
+
+void AisLogReplay::play()
+{
+    if (m_playing || !isOpen())
+        return;
+    reanchor(m_anchorLogMs);
+    m_playing = true;
+    m_timer.start();
+}
+
+void AisLogReplay::pause()
+{
+    if (!m_playing)
+        return;
+    reanchor(position());
+    m_playing = false;
+    m_timer.stop();
+}
+
+void AisLogReplay::setSpeed(double speed)
+{
+    reanchor(position());
+    m_speed = qBound(MinSpeed, speed, MaxSpeed);
+}
+
+bool AisLogReplay::seek(qint64 logTimeMs)
+{
+    if (!isOpen() || !canSeek())
+        return false;
+
+    const qint64 target = qBound(startMs(), logTimeMs, endMs());
+
+    // Gambar dibangun ulang dari pre-roll, bukan dari state sebelum seek
+    m_ais->clearTargetData();
+
+    if (m_dvr) {
+        // Scan ulang dari pre-roll; segmen dan blok sebelumnya dilewati lewat index blok
+        const qint64 from = qMax(startMs(), target - kSeekPrerollMs);
+        m_dvr->start(from);
+        m_lineTimeMs = from;
+        m_timed = true;
+        m_started = true;
+    } else {
+        m_cursor->seek(m_index.offsetAt(target - kSeekPrerollMs));
+        m_lineTimeMs = m_index.timeAt(m_cursor->pos());
+        // Index untimed: waktu entry = waktu sintetis baris itu sendiri, baris pertama
+        // setelah seek tidak ditambah kUntimedLineMs lagi
+        m_timed = !m_index.untimed;
+        m_started = m_timed;
+    }
+
+    feed(target, -1);
+    reanchor(target);
+    m_catchUpMs = target;
+
+    emit positionChanged(target);
+    return true;
+}
+
+qint64 AisLogReplay::lineTime(qint64 rawMs) const
+{
+    if (rawMs >= 0)
+        return m_timed ? qMax(rawMs, m_lineTimeMs) : rawMs;
+    return (m_timed || !m_started) ? m_lineTimeMs : m_lineTimeMs + kUntimedLineMs;
+}
+
+bool AisLogReplay::nextLine(const char *&line, int &len, qint64 &rawMs)
+{
+    if (m_dvr)
+        return m_dvr->peek(rawMs, line, len);   // waktu rekaman, tidak perlu parse
+
+    if (!m_cursor || !m_cursor->next(line, len))
+        return false;
+    rawMs = IndexerWorker::lineTimeMs(line, len);
+    return true;
+}
+
+void AisLogReplay::unreadLine()
+{
+    // Streamer DVR baru maju di consumeLine()
+    if (!m_dvr) {
+        m_cursor->seek(m_cursor->lineOffset());
+    }
+}
+
+void AisLogReplay::consumeLine()
+{
+    if (m_dvr) {
+        m_dvr->pop();
+    }
+}
+
+bool AisLogReplay::sourceAtEnd()
+{
+    return m_dvr ? m_dvr->atEnd() : true;
+}
+
+bool AisLogReplay::feed(qint64 untilMs, qint64 budgetMs, qint64 *dueMs)
+{
+    if (dueMs) {
+        *dueMs = -1;
+    }
+
+    if (m_ais->_bReadFromFile == False || !m_ais->_transponder)
+        return false;
+
+    // Seluruh batch ingest-only; teks (ekor batch) dan panel di-refresh sekali di akhir
+    Ais::IngestContext ctx;
+    m_ais->beginIngest(ctx);
+    ctx.ingestOnly = true;
+
+    QElapsedTimer budget;
+    budget.start();
+
+    const char *line;
+    int len;
+    qint64 t;
+    bool more = true;
+    int n = 0;
+
+    for (;;) {
+        if (!nextLine(line, len, t)) {
+            if (sourceAtEnd()) {
+                more = false;
+            } else if (budgetMs < 0 && budget.elapsed() < kDvrSeekWaitMs) {
+                // Seek DVR: worker masih mengisi jendela pre-roll
+                QThread::msleep(1);
+                continue;
+            }
+            // Worker DVR belum sampai sini: lanjut di tick berikutnya
+            break;
+        }
+
+        if (t >= 0) {
+            if (!m_timed) {
+                // Baris bertimestamp pertama: jam virtual pindah ke waktu log
+                m_timed = true;
+                m_lineTimeMs = t;
+                reanchor(t);
+                untilMs = t;
+            }
+            t = qMax(t, m_lineTimeMs);
+        } else {
+            t = (m_timed || !m_started) ? m_lineTimeMs : m_lineTimeMs + kUntimedLineMs;
+        }
+
+        if (t > untilMs) {
+            // Belum waktunya: kembalikan baris untuk frame berikutnya
+            unreadLine();
+            break;
+        }
+
+        m_lineTimeMs = t;
+        m_started = true;
+        if (m_timed) {
+            // Umur target mengikuti waktu log, bukan jam dinding
+            m_ais->setReplayClock(m_lineTimeMs);
+        }
+
+        const QString sLine = QString::fromLatin1(line, len).append("\r\n");
+        consumeLine();
+        if (!m_ais->ingestLine(ctx, sLine, sLine)) {
+            Ais::addLogFileEntry(m_dvr
+                ? QString("Error in AisLogReplay: EcAISAddTransponderOutput() failed at %1 ms").arg(m_lineTimeMs)
+                : QString("Error in AisLogReplay: EcAISAddTransponderOutput() failed at offset %1")
+                  .arg(m_cursor->lineOffset()));
+            more = false;
+            break;
+        }
+
+        m_tail.append(sLine.trimmed());
+        if (m_tail.size() > kTailLines) {
+            m_tail.removeFirst();
+        }
+
+        // Cek jam per 64 baris saja
+        if (budgetMs >= 0 && (++n & 63) == 0 && budget.elapsed() >= budgetMs) {
+            // Budget habis: intip baris berikutnya, masih jatuh tempo berarti tertinggal
+            if (dueMs && nextLine(line, len, t)) {
+                const qint64 next = lineTime(t);
+                unreadLine();
+                if (next <= untilMs) {
+                    *dueMs = next;
+                }
+            }
+            break;
+        }
+    }
+
+    ctx.pendingText = m_tail;
+    m_tail.clear();
+    m_ais->flushIngestUi(ctx, true);
+
+    return more;
+}
+
+void AisLogReplay::tick()
+{
+    const qint64 now = position();
+    qint64 due = -1;
+    const bool more = feed(now, kFrameBudgetMs, &due);
+
+    if (!more) {
+        pause();
+        emit positionChanged(m_lineTimeMs);
+        emit finished();
+        return;
+    }
+
+    // Hanya kalau feed berhenti karena budget dengan baris masih jatuh tempo dan
+    // backlog lebih dari kMaxLagWallMs: jam ditahan di baris yang menunggu. Jeda
+    // panjang antar baris di log bukan backlog dan tidak menahan jam.
+    // Pre-roll seek yang masih dikejar (due < m_catchUpMs) juga tidak menahan jam.
+    if (due >= m_catchUpMs && (now - due) > qint64(kMaxLagWallMs * m_speed)) {
+        reanchor(due);
+    }
+
+    emit positionChanged(position());
+}
@@ -0,0 +1,117 @@
+#ifndef AISLOGREPLAY_H
+#define AISLOGREPLAY_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QScopedPointer>
+#include <atomic>
+
+#include "IndexerWorker.h"
+
+class Ais;
+class DvrReplayStreamer;
+
+// Replay log NMEA/AIS mengikuti timestamp asli terhadap jam virtual.
+// Tiap frame UI (AIS_UI_FRAME_MS) semua kalimat yang waktunya <= jam virtual
+// dimasukkan ke transponder sebagai satu batch: satu publish target dan satu
+// append teks NMEA per frame, berapa pun kecepatan replay-nya.
+// Seek lompat lewat index sidecar (NmeaLogIndex), tidak membaca ulang dari awal.
+// Rekaman DVR bawaan (.dvrseg) dibaca langsung dari segmennya oleh DvrReplayStreamer
+// di thread worker; seek memulai ulang scan dari waktu tujuan lewat index blok.
+class AisLogReplay : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AisLogReplay(Ais *ais, QObject *parent = nullptr);
+    ~AisLogReplay() override;
+
+    // Buka log: index dari sidecar kalau ada, kalau tidak dibangun di background.
+    // Playback bisa langsung jalan; seek aktif setelah index siap.
+    // Segmen .dvrseg membuka seluruh rekamannya (semua segmen dengan stem yang sama).
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_file.isOpen() || m_dvr; }
+
+    void play();
+    void pause();
+    bool isPlaying() const { return m_playing; }
+
+    // 0.1x .. 500x
+    void setSpeed(double speed);
+    double speed() const { return m_speed; }
+
+    // Lompat ke waktu log (ms since epoch); false kalau index belum siap / log tanpa waktu
+    bool seek(qint64 logTimeMs);
+    bool canSeek() const { return m_indexReady && (m_dvr ? m_dvrEndMs >= m_dvrStartMs : !m_index.isEmpty()); }
+
+    // Posisi jam virtual dalam waktu log
+    qint64 position() const;
+    qint64 startMs() const { return m_dvr ? m_dvrStartMs : m_index.startMs(); }
+    qint64 endMs() const { return m_dvr ? m_dvrEndMs : m_index.endMs(); }
+
+    static constexpr double MinSpeed = 0.1;
+    static constexpr double MaxSpeed = 500.0;
+
+signals:
+    void indexReady(qint64 startMs, qint64 endMs);
+    void indexProgress(int percent);
+    void positionChanged(qint64 logTimeMs);
+    void finished();
+
+private slots:
+    void tick();
+
+private:
+    // Set jam virtual: waktu log 'logMs' = sekarang
+    void reanchor(qint64 logMs);
+    // Masukkan baris sampai waktu log 'untilMs'; budgetMs < 0 = tanpa batas waktu.
+    // Return false kalau log habis. *dueMs diisi waktu baris berikutnya kalau feed
+    // berhenti karena budget padahal baris itu sudah jatuh tempo, selain itu -1.
+    bool feed(qint64 untilMs, qint64 budgetMs, qint64 *dueMs = nullptr);
+    // Waktu replay baris dengan waktu mentah rawMs (-1 = tanpa waktu), sama dengan aturan di feed
+    qint64 lineTime(qint64 rawMs) const;
+    void stopIndexer();
+    bool openRecording(const QString &segmentPath);
+
+    // Sumber baris: log teks (m_cursor) atau rekaman DVR (m_dvr).
+    // nextLine() false = tidak ada baris sekarang; sourceAtEnd() membedakan habis dan belum datang.
+    // Baris yang belum waktunya dikembalikan dengan unreadLine(), yang sudah masuk dengan consumeLine().
+    bool nextLine(const char *&line, int &len, qint64 &rawMs);
+    void unreadLine();
+    void consumeLine();
+    bool sourceAtEnd();
+
+    Ais *m_ais;
+    QFile m_file;
+    QScopedPointer<NmeaLogCursor> m_cursor;
+    QScopedPointer<DvrReplayStreamer> m_dvr;
+    qint64 m_dvrStartMs = 0;
+    qint64 m_dvrEndMs = -1;
+
+    NmeaLogIndex m_index;
+    bool m_indexReady = false;
+    QFutureWatcher<NmeaLogIndex> m_indexWatcher;
+    std::atomic<bool> m_indexStop{false};
+
+    QTimer m_timer;
+    QElapsedTimer m_wall;
+    bool m_playing = false;
+    double m_speed = 1.0;
+    qint64 m_anchorLogMs = 0;       // waktu log saat m_anchorWallMs
+    qint64 m_anchorWallMs = 0;
+
+    qint64 m_catchUpMs = 0;         // sampai waktu ini baris lama = pre-roll seek, bukan backlog
+    qint64 m_lineTimeMs = 0;        // waktu log baris terakhir yang sudah masuk
+    bool m_timed = false;           // sudah ketemu baris bertimestamp
+    bool m_started = false;         // sudah ada baris yang masuk
+
+    QStringList m_tail;             // ekor teks NMEA batch untuk panel
+};
+
+#endif // AISLOGREPLAY_H
@@ -0,0 +1,163 @@
+#include "aispayload.h"
+#include <cstring>
+
+namespace {
+
+inline int armorCode(char ch) { return static_cast<unsigned char>(ch); }
+inline int armorCode(QChar ch) { return ch.unicode(); }
+
+// AIS armor: '0'..'W' -> 0..39, '`'..'w' -> 40..63, everything else invalid
+inline int armorValue(int code)
+{
+    int val = code - 48;
+    if (val > 40) val -= 8;
+    return (val < 0 || val > 63 || (code > 87 && code < 96)) ? -1 : val;
+}
+
+template<typename Char>
+bool findPayload(const Char *nmea, int length, int &start, int &payloadLength, int &fillBits)
+{
+    // !AIVDM,<total>,<part>,<seq>,<chan>,<payload>,<fill>*CS
+    int field = 0;
+    int fieldStart = 0;
+    start = -1;
+    payloadLength = 0;
+    fillBits = 0;
+
+    for (int i = 0; i < length; ++i) {
+        const int code = armorCode(nmea[i]);
+        if (code != ',') continue;
+
+        ++field;
+        if (field == 5) {
+            fieldStart = i + 1;
+        } else if (field == 6) {
+            start = fieldStart;
+            payloadLength = i - fieldStart;
+            if (i + 1 < length) {
+                const int fill = armorCode(nmea[i + 1]) - '0';
+                if (fill >= 0 && fill <= 5) fillBits = fill;
+            }
+            return payloadLength > 0;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void AisPayload::clear()
+{
+    std::memset(m_words, 0, sizeof(m_words));
+    m_bitCount = 0;
+}
+
+template<typename Char>
+bool AisPayload::unpackArmor(const Char *armor, int length, int fillBits)
+{
+    if (length <= 0 || length > MAX_CHARS) {
+        clear();
+        return false;
+    }
+
+    quint64 acc = 0;
+    int accBits = 0;
+    int word = 0;
+
+    for (int i = 0; i < length; ++i) {
+        const int val = armorValue(armorCode(armor[i]));
+        if (val < 0) {
+            clear();
+            return false;
+        }
+
+        if (accBits <= 58) {
+            acc = (acc << 6) | quint64(val);
+            accBits += 6;
+            if (accBits == 64) {
+                m_words[word++] = acc;
+                acc = 0;
+                accBits = 0;
+            }
+        } else {
+            // Character straddles a word boundary
+            const int take = 64 - accBits;
+            const int rest = 6 - take;
+            m_words[word++] = (acc << take) | quint64(val >> rest);
+            acc = quint64(val) & ((1u << rest) - 1);
+            accBits = rest;
+        }
+    }
+
+    if (accBits > 0)
+        m_words[word++] = acc << (64 - accBits);
+
+    for (int i = word; i <= MAX_WORDS; ++i)
+        m_words[i] = 0;
+
+    m_bitCount = length * 6 - qBound(0, fillBits, 5);
+    return true;
+}
+
+bool AisPayload::unpack(const char *armor, int length, int fillBits)
+{
+    return unpackArmor(armor, length, fillBits);
+}
+
+bool AisPayload::unpack(const QChar *armor, int length, int fillBits)
+{
+    return unpackArmor(armor, length, fillBits);
+}
+
+bool AisPayload::unpackSentence(const QString &nmea)
+{
+    int start, length, fillBits;
+    if (!locatePayload(nmea, start, length, fillBits)) {
+        clear();
+        return false;
+    }
+    return unpack(nmea.constData() + start, length, fillBits);
+}
+
+bool AisPayload::unpackSentence(const char *nmea, int nmeaLength)
+{
+    int start, length, fillBits;
+    if (!locatePayload(nmea, nmeaLength, start, length, fillBits)) {
+        clear();
+        return false;
+    }
+    return unpack(nmea + start, length, fillBits);
+}
+
+bool AisPayload::locatePayload(const QString &nmea, int &start, int &length, int &fillBits)
+{
+    return findPayload(nmea.constData(), nmea.length(), start, length, fillBits);
+}
+
+bool AisPayload::locatePayload(const char *nmea, int nmeaLength, int &start, int &length, int &fillBits)
+{
+    return findPayload(nmea, nmeaLength, start, length, fillBits);
+}
+
+QString AisPayload::readString(int offset, int chars) const
+{
+    // Clamp to the bits we actually have (short type 5 / 24 payloads)
+    const int available = (m_bitCount - offset) / 6;
+    if (chars > available) chars = available;
+    if (chars <= 0) return QString();
+
+    char text[MAX_CHARS + 1];
+    int end = 0;
+    for (int i = 0; i < chars; ++i) {
+        int val = int(readBits(offset + i * 6, 6));
+        char ch = char(val < 32 ? val + 64 : val);
+        if (ch == '@') ch = ' ';
+        text[i] = ch;
+        if (ch != ' ') end = i + 1;
+    }
+
+    int begin = 0;
+    while (begin < end && text[begin] == ' ') ++begin;
+
+    return QString::fromLatin1(text + begin, end - begin);
+}
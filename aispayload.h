@@ -0,0 +1,69 @@
+#ifndef AISPAYLOAD_H
+#define AISPAYLOAD_H
+
+#include <QtGlobal>
+#include <QString>
+
+// Packed AIS payload.
+// The 6-bit ASCII armor of an AIVDM/AIVDO payload is unpacked once into
+// MSB-first 64-bit words; fields are then read straight from the words
+// instead of going through a '0'/'1' QString per bit.
+class AisPayload {
+public:
+    // 5 slots = 1008 bits, rounded up to whole words
+    static const int MAX_BITS = 1024;
+    static const int MAX_WORDS = MAX_BITS / 64;
+    static const int MAX_CHARS = MAX_BITS / 6;
+
+    AisPayload() { clear(); }
+
+    void clear();
+
+    // Unpack armored characters; fillBits are the trailing pad bits from the sentence.
+    bool unpack(const char *armor, int length, int fillBits = 0);
+    bool unpack(const QChar *armor, int length, int fillBits = 0);
+
+    // Locate the payload field of a single !AIVDM/!AIVDO sentence and unpack it.
+    bool unpackSentence(const QString &nmea);
+    bool unpackSentence(const char *nmea, int length);
+
+    int bitCount() const { return m_bitCount; }
+    bool isEmpty() const { return m_bitCount == 0; }
+    int messageType() const { return m_bitCount >= 6 ? int(readBits(0, 6)) : 0; }
+
+    // Read a 1..32 bit field starting at bit offset. Bits past the end read as zero.
+    inline qint64 readBits(int offset, int length, bool signedInt = false) const
+    {
+        if (offset < 0 || offset + length > MAX_BITS)
+            return 0;
+
+        const int word = offset >> 6;
+        const int shift = offset & 63;
+
+        // Two-word window; the double shift keeps shift == 0 defined without a branch
+        const quint64 window = (m_words[word] << shift) | ((m_words[word + 1] >> 1) >> (63 - shift));
+        const quint64 value = window >> (64 - length);
+
+        if (!signedInt)
+            return qint64(value);
+
+        return qint64(value << (64 - length)) >> (64 - length);
+    }
+
+    // Decode 6-bit ASCII text ('@' padding becomes space), trimmed like the old decoders.
+    QString readString(int offset, int chars) const;
+
+    // Helper for callers that already split the sentence themselves.
+    static bool locatePayload(const QString &nmea, int &start, int &length, int &fillBits);
+    static bool locatePayload(const char *nmea, int nmeaLength, int &start, int &length, int &fillBits);
+
+private:
+    template<typename Char>
+    bool unpackArmor(const Char *armor, int length, int fillBits);
+
+    // One extra zero word so readBits() can always touch word + 1
+    quint64 m_words[MAX_WORDS + 1];
+    int m_bitCount;
+};
+
+#endif // AISPAYLOAD_H
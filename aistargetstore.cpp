@@ -0,0 +1,326 @@
+#include "aistargetstore.h"
+#include "ecwidget.h"
+#include <QDateTime>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const int kMinSlots = 64;
+
+inline QDateTime fromMs(qint64 ms)
+{
+    return ms != 0 ? QDateTime::fromMSecsSinceEpoch(ms) : QDateTime();
+}
+
+inline qint64 toMs(const QDateTime &dt)
+{
+    return dt.isValid() ? dt.toMSecsSinceEpoch() : 0;
+}
+
+void fillKinematics(const AisTargetColumns &c, int i, AISTargetData &out)
+{
+    const quint8 flags = c.flags.at(i);
+    const AisTargetColumns::Cold &cold = c.cold.at(i);
+
+    out.mmsi = QString::number(c.mmsi.at(i));
+    out.lat = c.lat.at(i);
+    out.lon = c.lon.at(i);
+    out.cog = c.cog.at(i);
+    out.sog = c.sog.at(i);
+    out.heading = c.heading.at(i);
+    out.cpa = c.cpa.at(i);
+    out.tcpa = c.tcpa.at(i);
+    out.isDangerous = flags & AisTargetColumns::Dangerous;
+    out.lastUpdate = fromMs(c.updatedMs.at(i));
+    out.currentRange = c.range.at(i);
+    out.relativeBearing = c.bearing.at(i);
+    out.cpaCalculationValid = flags & AisTargetColumns::CpaValid;
+    out.cpaCalculatedAt = fromMs(cold.cpaCalculatedAtMs);
+    out.feat = cold.feat;
+    out._dictInfo = cold.dictInfo;
+}
+
+} // namespace
+
+quint32 AisTargetColumns::hash(quint32 id)
+{
+    // MMSI berurutan per negara (MID); diacak dulu supaya tidak menggerombol
+    id ^= id >> 16;
+    id *= 0x45d9f3bu;
+    id ^= id >> 16;
+    return id;
+}
+
+double AisTargetColumns::decodeRot(int rotAis)
+{
+    // +-127 berarti belok > 5 deg/30 s tanpa nilai pasti; tidak dipakai untuk ekstrapolasi
+    if (rotAis <= -127 || rotAis >= 127)
+        return std::numeric_limits<double>::quiet_NaN();
+
+    const double r = rotAis / 4.733;
+    return rotAis < 0 ? -r * r : r * r;
+}
+
+int AisTargetColumns::slotOf(quint32 id) const
+{
+    const int count = slotTable.size();
+    if (count == 0)
+        return -1;
+
+    const quint32 mask = quint32(count - 1);
+    const qint32 *table = slotTable.constData();
+    const quint32 *keys = mmsi.constData();
+
+    for (quint32 s = hash(id) & mask; ; s = (s + 1) & mask) {
+        const qint32 index = table[s];
+        if (index < 0)
+            return -1;
+        if (keys[index] == id)
+            return int(s);
+    }
+}
+
+int AisTargetColumns::indexOf(quint32 id) const
+{
+    const int s = slotOf(id);
+    return s >= 0 ? slotTable.at(s) : -1;
+}
+
+AISTargetData AisTargetSnapshot::kinematics(int i) const
+{
+    AISTargetData data;
+    fillKinematics(m_cols, i, data);
+    return data;
+}
+
+AISTargetData AisTargetSnapshot::target(int i) const
+{
+    AISTargetData data;
+    fillKinematics(m_cols, i, data);
+    data.rawInfo = m_cols.cold.at(i).rawInfo;
+    return data;
+}
+
+AisTargetStore::AisTargetStore()
+{
+    rehash(kMinSlots);
+}
+
+void AisTargetStore::rehash(int slotCount)
+{
+    m_cols.slotTable.fill(-1, slotCount);
+
+    const quint32 mask = quint32(slotCount - 1);
+    qint32 *table = m_cols.slotTable.data();
+    for (int i = 0; i < m_cols.size(); ++i) {
+        quint32 s = AisTargetColumns::hash(m_cols.mmsi.at(i)) & mask;
+        while (table[s] >= 0)
+            s = (s + 1) & mask;
+        table[s] = i;
+    }
+}
+
+int AisTargetStore::insertSlot(quint32 mmsi)
+{
+    // Jaga load factor <= 0.5 supaya probe tetap pendek
+    if ((m_cols.size() + 1) * 2 > m_cols.slotTable.size())
+        rehash(m_cols.slotTable.size() * 2);
+
+    const int index = m_cols.size();
+    const quint32 mask = quint32(m_cols.slotTable.size() - 1);
+    qint32 *table = m_cols.slotTable.data();
+
+    quint32 s = AisTargetColumns::hash(mmsi) & mask;
+    while (table[s] >= 0)
+        s = (s + 1) & mask;
+    table[s] = index;
+
+    AisTargetColumns::Cold cold;
+    std::memset(&cold, 0, sizeof(cold));
+    cold.feat.id = EC_NOCELLID;
+
+    m_cols.mmsi.append(mmsi);
+    m_cols.lat.append(0.0);
+    m_cols.lon.append(0.0);
+    m_cols.cog.append(0.0);
+    m_cols.sog.append(0.0);
+    m_cols.heading.append(0.0);
+    m_cols.rot.append(std::numeric_limits<double>::quiet_NaN());
+    m_cols.cpa.append(0.0);
+    m_cols.tcpa.append(0.0);
+    m_cols.range.append(0.0);
+    m_cols.bearing.append(0.0);
+    m_cols.updatedMs.append(0);
+    m_cols.flags.append(0);
+    m_cols.cold.append(cold);
+    return index;
+}
+
+int AisTargetStore::upsert(quint32 mmsi, const AISTargetData &data)
+{
+    int i = indexOf(mmsi);
+    if (i < 0)
+        i = insertSlot(mmsi);
+
+    quint8 flags = 0;
+    if (data.isDangerous) flags |= AisTargetColumns::Dangerous;
+    if (data.cpaCalculationValid) flags |= AisTargetColumns::CpaValid;
+
+    m_cols.lat[i] = data.lat;
+    m_cols.lon[i] = data.lon;
+    m_cols.cog[i] = data.cog;
+    m_cols.sog[i] = data.sog;
+    m_cols.heading[i] = data.heading;
+    m_cols.rot[i] = data.rawInfo.mmsi == mmsi ? AisTargetColumns::decodeRot(data.rawInfo.rot)
+                                              : std::numeric_limits<double>::quiet_NaN();
+    m_cols.cpa[i] = data.cpa;
+    m_cols.tcpa[i] = data.tcpa;
+    m_cols.range[i] = data.currentRange;
+    m_cols.bearing[i] = data.relativeBearing;
+    m_cols.updatedMs[i] = toMs(data.lastUpdate);
+    m_cols.flags[i] = flags;
+
+    AisTargetColumns::Cold &cold = m_cols.cold[i];
+    cold.feat = data.feat;
+    cold.dictInfo = data._dictInfo;
+    cold.cpaCalculatedAtMs = toMs(data.cpaCalculatedAt);
+    cold.rawInfo = data.rawInfo;
+
+    ++m_epoch;
+    return i;
+}
+
+void AisTargetStore::eraseSlot(int hole)
+{
+    // Backward-shift deletion: tarik entry sesudahnya ke lubang selama
+    // home slot-nya tidak berada di antara lubang dan posisinya sekarang
+    const quint32 mask = quint32(m_cols.slotTable.size() - 1);
+    qint32 *table = m_cols.slotTable.data();
+
+    quint32 h = quint32(hole);
+    for (quint32 s = (h + 1) & mask; table[s] >= 0; s = (s + 1) & mask) {
+        const quint32 home = AisTargetColumns::hash(m_cols.mmsi.at(table[s])) & mask;
+        if (((s - home) & mask) >= ((s - h) & mask)) {
+            table[h] = table[s];
+            h = s;
+        }
+    }
+    table[h] = -1;
+}
+
+bool AisTargetStore::remove(quint32 mmsi)
+{
+    const int s = m_cols.slotOf(mmsi);
+    if (s < 0)
+        return false;
+
+    const int index = m_cols.slotTable.at(s);
+    const int last = m_cols.size() - 1;
+    eraseSlot(s);
+
+    // Swap-remove: entry terakhir pindah ke index yang kosong, kolom tetap rapat
+    if (index != last) {
+        m_cols.slotTable[m_cols.slotOf(m_cols.mmsi.at(last))] = index;
+
+        m_cols.mmsi[index] = m_cols.mmsi.at(last);
+        m_cols.lat[index] = m_cols.lat.at(last);
+        m_cols.lon[index] = m_cols.lon.at(last);
+        m_cols.cog[index] = m_cols.cog.at(last);
+        m_cols.sog[index] = m_cols.sog.at(last);
+        m_cols.heading[index] = m_cols.heading.at(last);
+        m_cols.rot[index] = m_cols.rot.at(last);
+        m_cols.cpa[index] = m_cols.cpa.at(last);
+        m_cols.tcpa[index] = m_cols.tcpa.at(last);
+        m_cols.range[index] = m_cols.range.at(last);
+        m_cols.bearing[index] = m_cols.bearing.at(last);
+        m_cols.updatedMs[index] = m_cols.updatedMs.at(last);
+        m_cols.flags[index] = m_cols.flags.at(last);
+        m_cols.cold[index] = m_cols.cold.at(last);
+    }
+
+    m_cols.mmsi.removeLast();
+    m_cols.lat.removeLast();
+    m_cols.lon.removeLast();
+    m_cols.cog.removeLast();
+    m_cols.sog.removeLast();
+    m_cols.heading.removeLast();
+    m_cols.rot.removeLast();
+    m_cols.cpa.removeLast();
+    m_cols.tcpa.removeLast();
+    m_cols.range.removeLast();
+    m_cols.bearing.removeLast();
+    m_cols.updatedMs.removeLast();
+    m_cols.flags.removeLast();
+    m_cols.cold.removeLast();
+
+    ++m_epoch;
+    return true;
+}
+
+void AisTargetStore::clear()
+{
+    m_cols = AisTargetColumns();
+    rehash(kMinSlots);
+    ++m_epoch;
+}
+
+EcAISTargetInfo* AisTargetStore::rawInfo(quint32 mmsi)
+{
+    const int i = indexOf(mmsi);
+    return i >= 0 ? &m_cols.cold[i].rawInfo : nullptr;
+}
+
+bool AisTargetStore::feature(quint32 mmsi, EcFeature &feat, EcDictInfo *&dictInfo) const
+{
+    const int i = indexOf(mmsi);
+    if (i < 0)
+        return false;
+    feat = m_cols.cold.at(i).feat;
+    dictInfo = m_cols.cold.at(i).dictInfo;
+    return true;
+}
+
+bool AisTargetStore::setFeature(quint32 mmsi, const EcFeature &feat, EcDictInfo *dictInfo)
+{
+    const int i = indexOf(mmsi);
+    if (i < 0)
+        return false;
+    AisTargetColumns::Cold &cold = m_cols.cold[i];
+    cold.feat = feat;
+    cold.dictInfo = dictInfo;
+    ++m_epoch;
+    return true;
+}
+
+bool AisTargetStore::setFlags(quint32 mmsi, quint8 set, quint8 clear)
+{
+    const int i = indexOf(mmsi);
+    if (i < 0)
+        return false;
+    m_cols.flags[i] = quint8((m_cols.flags.at(i) & ~clear) | set);
+    ++m_epoch;
+    return true;
+}
+
+void AisTargetStore::invalidateFeatures(EcDictInfo *dictInfo)
+{
+    for (int i = 0; i < m_cols.size(); ++i) {
+        AisTargetColumns::Cold &cold = m_cols.cold[i];
+        cold.feat.id = EC_NOCELLID; // mark invalid
+        cold.feat.offset = 0;
+        // ensure dictInfo set for rebuilds if needed
+        cold.dictInfo = dictInfo;
+    }
+    ++m_epoch;
+}
+
+const AisTargetSnapshot& AisTargetStore::publish()
+{
+    if (m_published.m_epoch != m_epoch) {
+        m_published.m_cols = m_cols;
+        m_published.m_epoch = m_epoch;
+    }
+    return m_published;
+}
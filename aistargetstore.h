@@ -0,0 +1,145 @@
+#ifndef AISTARGETSTORE_H
+#define AISTARGETSTORE_H
+
+#include <QtGlobal>
+#include <QVector>
+
+// SevenCs Kernel EC2007
+#ifdef _WIN32
+#include <windows.h>
+#pragma pack(push, 4)
+#include <eckernel.h>
+#pragma pack (pop)
+#else
+#include <stdio.h>
+#include <X11/Xlib.h>
+#include <eckernel.h>
+#endif
+
+struct AISTargetData;
+
+// Kolom target AIS. Field kinematik (yang dibaca tiap tick oleh CPA, guard zone,
+// draw) disimpan structure-of-arrays; feature, dictInfo dan EcAISTargetInfo
+// mentah dipisah di 'cold' supaya loop panas tidak ikut menarik data statis.
+// Semua kolom QVector (implicitly shared): copy satu Columns hanya menaikkan refcount.
+struct AisTargetColumns {
+    enum Flag : quint8 {
+        Dangerous = 0x01,
+        CpaValid  = 0x02,
+        Lost      = 0x04    // tidak ada update selama timeout SevenCs
+    };
+
+    struct Cold {
+        EcFeature feat;
+        EcDictInfo *dictInfo;
+        qint64 cpaCalculatedAtMs;
+        EcAISTargetInfo rawInfo;
+    };
+
+    QVector<quint32> mmsi;
+    QVector<double> lat, lon, cog, sog, heading;
+    QVector<double> rot;            // deg/min dari rawInfo.rot, NaN = tidak tersedia
+    QVector<double> cpa, tcpa, range, bearing;
+    QVector<qint64> updatedMs;      // lastUpdate, ms since epoch (0 = invalid)
+    QVector<quint8> flags;
+    QVector<Cold> cold;
+
+    // Open addressing (linear probing) MMSI -> index kolom, -1 = kosong.
+    // Ukuran selalu pangkat dua, load factor <= 0.5.
+    QVector<qint32> slotTable;
+
+    int size() const { return mmsi.size(); }
+    int indexOf(quint32 id) const;
+    int slotOf(quint32 id) const;   // slot yang berisi id, atau -1
+
+    static quint32 hash(quint32 id);
+    // ROT AIS (-126..126, +-127 tanpa sensor, -128 n/a) ke deg/min
+    static double decodeRot(int rotAis);
+};
+
+// Frame read-only dari AisTargetStore pada satu epoch.
+// Dipegang by value; copy murah dan isinya tidak berubah walaupun store terus ditulis.
+class AisTargetSnapshot {
+public:
+    AisTargetSnapshot() = default;
+
+    quint64 epoch() const { return m_epoch; }
+    int size() const { return m_cols.size(); }
+    bool isEmpty() const { return m_cols.size() == 0; }
+
+    int indexOf(quint32 mmsi) const { return m_cols.indexOf(mmsi); }
+    bool contains(quint32 mmsi) const { return indexOf(mmsi) >= 0; }
+
+    quint32 mmsi(int i) const { return m_cols.mmsi.at(i); }
+    double lat(int i) const { return m_cols.lat.at(i); }
+    double lon(int i) const { return m_cols.lon.at(i); }
+    double cog(int i) const { return m_cols.cog.at(i); }
+    double sog(int i) const { return m_cols.sog.at(i); }
+    double heading(int i) const { return m_cols.heading.at(i); }
+    double rot(int i) const { return m_cols.rot.at(i); }
+    qint64 updatedMs(int i) const { return m_cols.updatedMs.at(i); }
+    bool isLost(int i) const { return m_cols.flags.at(i) & AisTargetColumns::Lost; }
+    const AisTargetColumns::Cold& cold(int i) const { return m_cols.cold.at(i); }
+
+    // Posisi valid versi kode lama (lat/lon 0 dianggap belum ada)
+    bool hasPosition(int i) const { return lat(i) != 0.0 && lon(i) != 0.0; }
+
+    // Akses kolom mentah untuk pass batch (mis. AisDeadReckoner)
+    const AisTargetColumns& columns() const { return m_cols; }
+
+    // AISTargetData tanpa rawInfo (mmsi, kinematik, CPA, feat, dictInfo)
+    AISTargetData kinematics(int i) const;
+    // AISTargetData lengkap termasuk rawInfo
+    AISTargetData target(int i) const;
+
+private:
+    friend class AisTargetStore;
+
+    AisTargetColumns m_cols;
+    quint64 m_epoch = 0;
+};
+
+// Store target AIS berbasis MMSI uint32, rata (tanpa node per target) sampai 10k+ target.
+// Penulis (thread GUI) mengubah kolom live; publish() membekukan frame baru hanya kalau
+// ada perubahan sejak frame terakhir. Kolom yang masih dibagi dengan frame lama di-detach
+// sekali pada tulisan pertama setelah publish (copy-on-write QVector).
+class AisTargetStore {
+public:
+    AisTargetStore();
+
+    // Insert atau update; return index kolom
+    int upsert(quint32 mmsi, const AISTargetData &data);
+    bool remove(quint32 mmsi);
+    void clear();
+
+    int size() const { return m_cols.size(); }
+    bool isEmpty() const { return m_cols.size() == 0; }
+    int indexOf(quint32 mmsi) const { return m_cols.indexOf(mmsi); }
+    bool contains(quint32 mmsi) const { return indexOf(mmsi) >= 0; }
+
+    // Akses langsung ke kolom live. Pointer valid sampai mutasi berikutnya.
+    EcAISTargetInfo* rawInfo(quint32 mmsi);
+    bool feature(quint32 mmsi, EcFeature &feat, EcDictInfo *&dictInfo) const;
+    bool setFeature(quint32 mmsi, const EcFeature &feat, EcDictInfo *dictInfo);
+    bool setFlags(quint32 mmsi, quint8 set, quint8 clear = 0);
+
+    // Tandai semua feature handle invalid (dipakai saat transponder dibuat ulang)
+    void invalidateFeatures(EcDictInfo *dictInfo);
+
+    quint64 epoch() const { return m_epoch; }
+
+    // Bekukan frame dari state sekarang; tanpa perubahan, frame lama dikembalikan
+    const AisTargetSnapshot& publish();
+    const AisTargetSnapshot& snapshot() const { return m_published; }
+
+private:
+    int insertSlot(quint32 mmsi);
+    void rehash(int slotCount);
+    void eraseSlot(int hole);
+
+    AisTargetColumns m_cols;
+    quint64 m_epoch = 0;
+    AisTargetSnapshot m_published;
+};
+
+#endif // AISTARGETSTORE_H
@@ -1,5 +1,7 @@
 #include "AIVDOEncoder.h"
 #include "aisdecoder.h"
+#include "aispayload.h"
+#include "aisfragmentassembler.h"
 #include <QDebug>
 #include <QString>
 #include <QByteArray>
@@ -479,99 +481,150 @@ QStringList AIVDOEncoder::splitPayloadToVDM(const QString &payload) {
 
 /// DECODERRRRR /////////
 
+namespace {
+
+void fillDecoded(AisDecoded &result, bool ownShip) {
+    result.source = ownShip ? "AIVDO" : "AIVDM";
+    result.type = result.data.type;
+    result.mmsi = result.data.mmsi;
+    if (ownShip && result.mmsi == 0) {
+        result.mmsi = -1; // mark as ownship with unknown MMSI
+    }
+
+    result.callsign = result.data.callsign;
+    result.name = result.data.name;
+    result.destination = result.data.destination;
+    result.shipType = result.data.shipType;
+    result.length = result.data.length;
+    result.width = result.data.width;
+}
+
+} // namespace
+
 AisDecoded AIVDOEncoder::decodeNMEALine(const QString &line) {
     AisDecoded result;
 
     if (!line.startsWith("!AIVDM") && !line.startsWith("!AIVDO"))
         return result;
 
-    QStringList parts = line.split(',');
-    if (parts.length() < 6)
+    AisPayload payload;
+    if (!payload.unpackSentence(line))
+        return result;
+
+    if (!decodePayload(payload, result.data, &result.partNumber))
         return result;
 
-    result.source = line.startsWith("!AIVDO") ? "AIVDO" : "AIVDM";
+    fillDecoded(result, line.startsWith("!AIVDO"));
+    return result;
+}
 
-    QString payload = parts[5];
-    QString bin = sixbitToBinary(payload);
+AisDecoded AIVDOEncoder::decodeMessage(const AisAssembledMessage &message) {
+    AisDecoded result;
 
-    if (bin.length() < 168) // minimum bits for message type 1/2/3
+    AisPayload payload;
+    if (!payload.unpack(message.payload, message.payloadLength, message.fillBits))
         return result;
 
-    result.type = bin.mid(0, 6).toInt(nullptr, 2);
+    if (!decodePayload(payload, result.data, &result.partNumber))
+        return result;
 
-    // Handle MMSI (bit 8–37, 30 bit)
-    result.mmsi = bin.mid(8, 30).toInt(nullptr, 2);
-    if (result.source == "AIVDO" && result.mmsi == 0) {
-        result.mmsi = -1; // mark as ownship with unknown MMSI
-    }
+    fillDecoded(result, message.ownShip);
+    return result;
+}
+
+bool AIVDOEncoder::decodePayload(const AisPayload &p, AISData &data, int *partNumber) {
+    const int bits = p.bitCount();
+    if (bits < 38)
+        return false;
 
-    switch (result.type) {
+    data.type = int(p.readBits(0, 6));
+    data.mmsi = int(p.readBits(8, 30));
+
+    switch (data.type) {
     case 1:
     case 2:
     case 3:
-        result.data.navStatus = bin.mid(38, 4).toInt(nullptr, 2);
-        result.data.rot = decodeSigned(bin.mid(42, 8), 8);
-        result.data.sog = bin.mid(50, 10).toInt(nullptr, 2) / 10.0;
-        result.data.posAcc = bin.mid(60, 1) == "1";
-        result.data.longitude = decodeSigned(bin.mid(61, 28), 28) / 600000.0;
-        result.data.latitude  = decodeSigned(bin.mid(89, 27), 27) / 600000.0;
-        result.data.cog = bin.mid(116, 12).toInt(nullptr, 2) / 10.0;
-        result.data.heading = bin.mid(128, 9).toInt(nullptr, 2);
-        result.data.timestamp = bin.mid(137, 6).toInt(nullptr, 2);
-        result.data.maneuverIndicator = bin.mid(143, 2).toInt(nullptr, 2);
-        result.data.raim = bin.mid(148, 1) == "1";
-        result.data.radioStatus = bin.mid(149, 19).toInt(nullptr, 2);
+        if (bits < 168) return false;
+        data.navStatus = int(p.readBits(38, 4));
+        data.rot = int(p.readBits(42, 8, true));
+        data.sog = p.readBits(50, 10) / 10.0;
+        data.posAcc = int(p.readBits(60, 1));
+        data.longitude = p.readBits(61, 28, true) / 600000.0;
+        data.latitude  = p.readBits(89, 27, true) / 600000.0;
+        data.cog = p.readBits(116, 12) / 10.0;
+        data.heading = int(p.readBits(128, 9));
+        data.timestamp = int(p.readBits(137, 6));
+        data.maneuverIndicator = int(p.readBits(143, 2));
+        data.raim = p.readBits(148, 1) != 0;
+        data.radioStatus = int(p.readBits(149, 19));
         break;
 
-    case 4:
-        result.data.longitude = decodeSigned(bin.mid(79, 28), 28) / 600000.0;
-        result.data.latitude  = decodeSigned(bin.mid(107, 27), 27) / 600000.0;
+    case 4: {
+        if (bits < 168) return false;
+        QDate date(int(p.readBits(38, 14)), int(p.readBits(52, 4)), int(p.readBits(56, 5)));
+        QTime time(int(p.readBits(61, 5)), int(p.readBits(66, 6)), int(p.readBits(72, 6)));
+        if (date.isValid() && time.isValid())
+            data.utc = QDateTime(date, time, Qt::UTC);
+        data.posAcc = int(p.readBits(78, 1));
+        data.longitude = p.readBits(79, 28, true) / 600000.0;
+        data.latitude  = p.readBits(107, 27, true) / 600000.0;
         break;
+    }
 
     case 5:
-        // Static and Voyage Related Data
-        // Callsign: bits 40-81 (42 bits = 7 chars)
-        result.callsign = decode6bitToString(bin.mid(40, 42));
-        // Name: bits 82-201 (120 bits = 20 chars)
-        result.name = decode6bitToString(bin.mid(82, 120));
-        // Ship Type: bits 202-209 (8 bits)
-        result.shipType = bin.mid(202, 8).toInt(nullptr, 2);
-        // Dimension: A to D bits 210-245 (36 bits total)
-        if (bin.length() >= 279) {  // Check if we have enough bits for dimensions
-            int dimA = bin.mid(210, 9).toInt(nullptr, 2);
-            int dimB = bin.mid(219, 9).toInt(nullptr, 2);
-            int dimC = bin.mid(228, 9).toInt(nullptr, 2);
-            int dimD = bin.mid(237, 9).toInt(nullptr, 2);
-            result.length = dimA + dimB;
-            result.width = dimC + dimD;
-            // Destination: bits 302-421 (120 bits = 20 chars) - only if full packet
-            if (bin.length() >= 422) {
-                result.destination = decode6bitToString(bin.mid(302, 120));
-            }
-        }
+        // Static and Voyage Related Data (ITU-R M.1371 layout)
+        if (bits < 270) return false;
+        data.callsign = p.readString(70, 7);
+        data.name = p.readString(112, 20);
+        data.shipType = int(p.readBits(232, 8));
+        data.dimA = p.readBits(240, 9);
+        data.dimB = p.readBits(249, 9);
+        data.dimC = p.readBits(258, 6);
+        data.dimD = p.readBits(264, 6);
+        data.length = data.dimA + data.dimB;
+        data.width = data.dimC + data.dimD;
+        // Destination only if the full packet arrived
+        if (bits >= 422)
+            data.destination = p.readString(302, 20);
         break;
 
     case 18:
-        result.data.sog = bin.mid(46, 10).toInt(nullptr, 2) / 10.0;
-        result.data.longitude = decodeSigned(bin.mid(57, 28), 28) / 600000.0;
-        result.data.latitude  = decodeSigned(bin.mid(85, 27), 27) / 600000.0;
-        result.data.cog = bin.mid(112, 12).toInt(nullptr, 2) / 10.0;
-        result.data.heading = bin.mid(124, 9).toInt(nullptr, 2);
+    case 19:
+        if (bits < 168) return false;
+        data.sog = p.readBits(46, 10) / 10.0;
+        data.posAcc = int(p.readBits(56, 1));
+        data.longitude = p.readBits(57, 28, true) / 600000.0;
+        data.latitude  = p.readBits(85, 27, true) / 600000.0;
+        data.cog = p.readBits(112, 12) / 10.0;
+        data.heading = int(p.readBits(124, 9));
+        data.timestamp = int(p.readBits(133, 6));
+        if (data.type == 19 && bits >= 301) {
+            data.name = p.readString(143, 20);
+            data.shipType = int(p.readBits(263, 8));
+            data.dimA = p.readBits(271, 9);
+            data.dimB = p.readBits(280, 9);
+            data.dimC = p.readBits(289, 6);
+            data.dimD = p.readBits(295, 6);
+            data.length = data.dimA + data.dimB;
+            data.width = data.dimC + data.dimD;
+        }
         break;
 
     case 24: {
-        result.partNumber = bin.mid(38, 8).toInt(nullptr, 2);
-        if (result.partNumber == 0) {
-            result.name = decode6bitToString(bin.mid(46, 120));
-        } else if (result.partNumber == 1) {
-            result.callsign = decode6bitToString(bin.mid(46, 42));
-            result.shipType = bin.mid(88, 8).toInt(nullptr, 2);
-            int dimA = bin.mid(96, 9).toInt(nullptr, 2);
-            int dimB = bin.mid(105, 9).toInt(nullptr, 2);
-            int dimC = bin.mid(114, 6).toInt(nullptr, 2);
-            int dimD = bin.mid(120, 6).toInt(nullptr, 2);
-            result.length = dimA + dimB;
-            result.width  = dimC + dimD;
+        if (bits < 160) return false;
+        int part = int(p.readBits(38, 2));
+        if (partNumber) *partNumber = part;
+        if (part == 0) {
+            data.name = p.readString(40, 20);
+        } else if (part == 1 && bits >= 162) {
+            data.shipType = int(p.readBits(40, 8));
+            data.callsign = p.readString(90, 7);
+            data.dimA = p.readBits(132, 9);
+            data.dimB = p.readBits(141, 9);
+            data.dimC = p.readBits(150, 6);
+            data.dimD = p.readBits(156, 6);
+            data.length = data.dimA + data.dimB;
+            data.width  = data.dimC + data.dimD;
         }
         break;
     }
@@ -580,7 +633,7 @@ AisDecoded AIVDOEncoder::decodeNMEALine(const QString &line) {
         break;
     }
 
-    return result;
+    return true;
 }
 
 int AIVDOEncoder::decodeSigned(const QString &bits, int len) {
@@ -5,6 +5,9 @@
 #include <QBitArray>
 #include <QDateTime>
 
+class AisPayload;
+struct AisAssembledMessage;
+
 struct AISData {
     // Umum
     int type = 0;
@@ -44,16 +47,16 @@ struct AISData {
 
 struct AisDecoded {
     QString source;     // "AIVDO" / "AIVDM"
-    int type;           // AIS message type (1–27)
-    int mmsi;
+    int type = 0;       // AIS message type (1–27)
+    int mmsi = 0;
     AISData data;       // Semua field seperti lat, lon, sog, dll
-    int partNumber;     // untuk type 24
+    int partNumber = 0; // untuk type 24
     QString callsign;
     QString name;
     QString destination;
-    int shipType;
-    double length;
-    double width;
+    int shipType = 0;
+    double length = 0.0;
+    double width = 0.0;
 };
 
 class AIVDOEncoder {
@@ -75,7 +78,11 @@ public:
 
 
     // DECODER
+    // Satu kalimat apa adanya, tanpa state: fragmen multi-sentence di-decode sendiri.
+    // Pesan lengkap dari AisFragmentAssembler milik pemanggil lewat decodeMessage().
     static AisDecoded decodeNMEALine(const QString &line);
+    static AisDecoded decodeMessage(const AisAssembledMessage &message);
+    static bool decodePayload(const AisPayload &payload, AISData &data, int *partNumber = nullptr);
     static QString decode6bitToString(const QString &bitstream);
     static int decodeSigned(const QString &bits, int len);
     static QString sixbitToBinary(const QString &payload);
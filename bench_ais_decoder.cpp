@@ -0,0 +1,165 @@
+// Microbenchmark: QString bitstream decoder vs packed AisPayload decoder.
+// Usage: bench_ais_decoder <recorded.log> [passes]
+// Only !AIVDM / !AIVDO lines of the log are used.
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QDebug>
+#include <cmath>
+#include "aisdecoder.h"
+#include "aispayload.h"
+
+namespace {
+
+// Old decoder path (sixbitToBinary + binaryToInt on a '0'/'1' QString), kept here as the baseline.
+QString legacySixbitToBinary(const QString &payload) {
+    QString bin;
+    for (QChar ch : payload) {
+        int val = ch.toLatin1() - 48;
+        if (val > 40) val -= 8;
+        bin += QString("%1").arg(val, 6, 2, QLatin1Char('0'));
+    }
+    return bin;
+}
+
+int legacyBinaryToInt(const QString &bin, int start, int length, bool signedInt = false) {
+    QString segment = bin.mid(start, length);
+    int value = segment.toInt(nullptr, 2);
+    if (signedInt && segment[0] == '1')
+        value -= (1 << length);
+    return value;
+}
+
+double legacyLat(int raw) { return (raw == 0x3412140 || raw == 0xFFFFFFF) ? NAN : raw / 600000.0; }
+double legacyLon(int raw) { return (raw == 0x6791AC0 || raw == 0xFFFFFFF) ? NAN : raw / 600000.0; }
+
+AisData legacyParse(const QString &nmea) {
+    AisData result;
+    QStringList parts = nmea.split(',');
+    if (parts.length() < 7 || parts[5].isEmpty())
+        return result;
+
+    QString bin = legacySixbitToBinary(parts[5]);
+    if (bin.length() < 6)
+        return result;
+
+    result.messageType = legacyBinaryToInt(bin, 0, 6);
+    if (bin.length() >= 38)
+        result.mmsi = legacyBinaryToInt(bin, 8, 30);
+
+    switch (result.messageType) {
+    case 1: case 2: case 3:
+        if (bin.length() >= 168) {
+            result.sog = legacyBinaryToInt(bin, 50, 10);
+            result.longitude = legacyLon(legacyBinaryToInt(bin, 61, 28, true));
+            result.latitude = legacyLat(legacyBinaryToInt(bin, 89, 27, true));
+            result.cog = legacyBinaryToInt(bin, 116, 12);
+            result.heading = legacyBinaryToInt(bin, 128, 9);
+        }
+        break;
+    case 18:
+        if (bin.length() >= 168) {
+            result.sog = legacyBinaryToInt(bin, 46, 10);
+            result.longitude = legacyLon(legacyBinaryToInt(bin, 57, 28, true));
+            result.latitude = legacyLat(legacyBinaryToInt(bin, 85, 27, true));
+            result.cog = legacyBinaryToInt(bin, 112, 12);
+            result.heading = legacyBinaryToInt(bin, 124, 9);
+        }
+        break;
+    default:
+        break;
+    }
+    return result;
+}
+
+bool samePosition(const AisData &a, const AisData &b) {
+    auto same = [](double x, double y) {
+        return (std::isnan(x) && std::isnan(y)) || std::fabs(x - y) < 1e-9;
+    };
+    return a.messageType == b.messageType && a.mmsi == b.mmsi &&
+           same(a.latitude, b.latitude) && same(a.longitude, b.longitude) &&
+           a.sog == b.sog && a.cog == b.cog && a.heading == b.heading;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    if (argc < 2) {
+        qInfo() << "Usage: bench_ais_decoder <recorded.log> [passes]";
+        return 1;
+    }
+
+    QFile file(QString::fromLocal8Bit(argv[1]));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCritical() << "Cannot open" << file.fileName();
+        return 1;
+    }
+
+    QStringList lines;
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        if (line.startsWith("!AIVDM") || line.startsWith("!AIVDO"))
+            lines << line;
+    }
+
+    const int passes = argc > 2 ? qMax(1, atoi(argv[2])) : 20;
+    const qint64 total = qint64(lines.size()) * passes;
+    if (total == 0) {
+        qCritical() << "No AIS sentences in" << file.fileName();
+        return 1;
+    }
+
+    // Correctness first: new decoder must agree with the old one on position reports.
+    // Only single-sentence messages are compared: a fragment of a multi-sentence message
+    // is not a complete payload, so neither path has a meaningful answer for it.
+    int mismatches = 0;
+    int fragments = 0;
+    for (const QString &line : lines) {
+        if (line.section(QLatin1Char(','), 1, 1) != QLatin1String("1")) {
+            ++fragments;
+            continue;
+        }
+        AisData legacy = legacyParse(line);
+        AisData packed;
+        AisDecoder::decode(line, packed);
+        if ((legacy.messageType <= 3 || legacy.messageType == 18) && !samePosition(legacy, packed))
+            ++mismatches;
+    }
+
+    volatile qint64 sink = 0;
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int p = 0; p < passes; ++p)
+        for (const QString &line : lines)
+            sink = sink + legacyParse(line).mmsi;
+    const qint64 legacyNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int p = 0; p < passes; ++p) {
+        for (const QString &line : lines) {
+            AisData data;
+            AisDecoder::decode(line, data);
+            sink = sink + data.mmsi;
+        }
+    }
+    const qint64 packedNs = timer.nsecsElapsed();
+
+    auto rate = [total](qint64 ns) { return ns > 0 ? total * 1e9 / ns : 0.0; };
+
+    qInfo().noquote() << QString("sentences: %1 x %2 passes").arg(lines.size()).arg(passes);
+    qInfo().noquote() << QString("QString bitstream : %1 sentences/s").arg(rate(legacyNs), 0, 'f', 0);
+    qInfo().noquote() << QString("packed AisPayload : %1 sentences/s").arg(rate(packedNs), 0, 'f', 0);
+    qInfo().noquote() << QString("speedup           : %1x").arg(packedNs > 0 ? double(legacyNs) / packedNs : 0.0, 0, 'f', 1);
+    qInfo().noquote() << QString("position mismatches: %1 (%2 multi-sentence fragments not compared)")
+                             .arg(mismatches).arg(fragments);
+
+    return mismatches == 0 ? 0 : 2;
+}
@@ -0,0 +1,18 @@
+QT += core
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = bench_ais_decoder
+
+SOURCES += \
+    bench_ais_decoder.cpp \
+    aisdecoder.cpp \
+    aispayload.cpp \
+    aisfragmentassembler.cpp
+
+HEADERS += \
+    aisdecoder.h \
+    aispayload.h \
+    aisfragmentassembler.h
@@ -0,0 +1,239 @@
+#include "builtindvrrecorder.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <cstring>
+
+namespace {
+
+const unsigned long kIdleSleepMs = 5;
+const int kMaxLinesPerPass = 1024;
+
+} // namespace
+
+BuiltinDvrRecorder::BuiltinDvrRecorder(QObject *parent)
+    : QObject(parent),
+      m_queue(new MpscRing<Line, DVR_QUEUE_CAPACITY>)
+{
+}
+
+BuiltinDvrRecorder::~BuiltinDvrRecorder()
+{
+    stopRecording();
+    delete m_queue;
+}
+
+void BuiltinDvrRecorder::startRecording(const QString& filePath)
+{
+    stopRecording();
+
+    const QFileInfo info(filePath);
+    m_dir = info.absolutePath();
+    m_stem = info.fileName();
+    for (const char *suffix : {".log", ".nmea"}) {
+        if (m_stem.endsWith(QLatin1String(suffix))) {
+            m_stem.chop(int(qstrlen(suffix)));
+        }
+    }
+    if (m_stem.isEmpty()) {
+        m_stem = "ais_log_" + QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
+    }
+    QDir().mkpath(m_dir);
+
+    m_segmentSeq = 0;
+    m_stop = false;
+    m_recording = true;
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("BuiltinDvrRecorder");
+    m_thread->start();
+
+    qDebug() << "[DVR] Recording to" << QDir(m_dir).filePath(m_stem + ".*" DVR_SEGMENT_SUFFIX);
+}
+
+void BuiltinDvrRecorder::stopRecording()
+{
+    if (!m_thread)
+        return;
+
+    m_recording = false;
+    m_stop = true;
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+
+    const Stats s = stats();
+    qDebug() << "[DVR] Recording stopped:" << s.recorded << "lines," << s.segments << "segments,"
+             << s.bytes / 1024 << "KB, dropped" << s.dropped + s.oversize;
+}
+
+void BuiltinDvrRecorder::recordRawNmea(const QString& nmeaSentence)
+{
+    if (!m_recording.load())
+        return;
+
+    // NMEA 0183 hanya ASCII: salin langsung tanpa QByteArray sementara
+    const int length = nmeaSentence.length();
+    if (length > DVR_LINE_MAX) {
+        m_oversize.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Line line;
+    line.timeMs = QDateTime::currentMSecsSinceEpoch();
+    line.length = quint16(length);
+    const QChar *src = nmeaSentence.constData();
+    for (int i = 0; i < length; ++i) {
+        line.text[i] = src[i].toLatin1();
+    }
+    m_queue->tryPush(line);
+}
+
+void BuiltinDvrRecorder::recordBatch(const AisDvrLine* lines, int count)
+{
+    if (!m_recording.load())
+        return;
+
+    for (int i = 0; i < count; ++i) {
+        push(lines[i].timeMs, lines[i].data, lines[i].length);
+    }
+}
+
+void BuiltinDvrRecorder::push(qint64 timeMs, const char* data, int length)
+{
+    if (length > DVR_LINE_MAX) {
+        m_oversize.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Line line;
+    line.timeMs = timeMs;
+    line.length = quint16(length);
+    memcpy(line.text, data, size_t(length));
+    m_queue->tryPush(line);
+}
+
+void BuiltinDvrRecorder::flush()
+{
+    if (m_recording.load()) {
+        m_flushRequested = true;
+    }
+}
+
+BuiltinDvrRecorder::Stats BuiltinDvrRecorder::stats() const
+{
+    const auto q = m_queue->stats();
+    Stats s;
+    s.queued = q.depth;
+    s.highWater = q.highWater;
+    s.dropped = q.drops;
+    s.recorded = m_recorded.load(std::memory_order_relaxed);
+    s.oversize = m_oversize.load(std::memory_order_relaxed);
+    s.blocks = m_blocks.load(std::memory_order_relaxed);
+    s.segments = m_segments.load(std::memory_order_relaxed);
+    s.bytes = m_bytes.load(std::memory_order_relaxed);
+    s.syncs = m_syncs.load(std::memory_order_relaxed);
+    return s;
+}
+
+// Semua penulisan lewat closeBlock()/finishSegment() supaya statistik byte/blok ikut terhitung
+void BuiltinDvrRecorder::closeBlock()
+{
+    const qint64 before = m_writer.size();
+    if (m_writer.closeBlock() && m_writer.size() > before) {
+        m_blocks.fetch_add(1, std::memory_order_relaxed);
+        m_bytes.fetch_add(quint64(m_writer.size() - before), std::memory_order_relaxed);
+        m_dirty = true;
+    }
+}
+
+void BuiltinDvrRecorder::finishSegment()
+{
+    if (!m_writer.isOpen())
+        return;
+
+    closeBlock();
+    const qint64 before = m_writer.size();
+    const QString path = m_writer.path();
+    if (!m_writer.finish()) {
+        qWarning() << "[DVR] Segment not finished cleanly:" << path;
+    }
+    // finish() menutup file; ukuran footer dihitung dari file di disk
+    m_bytes.fetch_add(quint64(qMax<qint64>(0, QFileInfo(path).size() - before)), std::memory_order_relaxed);
+    m_syncs.fetch_add(1, std::memory_order_relaxed);
+    m_dirty = false;
+}
+
+bool BuiltinDvrRecorder::rotate()
+{
+    finishSegment();
+
+    ++m_segmentSeq;
+    const QString path = QDir(m_dir).filePath(QString("%1.%2" DVR_SEGMENT_SUFFIX)
+                                                  .arg(m_stem).arg(m_segmentSeq, 4, 10, QLatin1Char('0')));
+    if (!m_writer.open(path))
+        return false;
+
+    m_segments.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(quint64(m_writer.size()), std::memory_order_relaxed);
+    return true;
+}
+
+void BuiltinDvrRecorder::run()
+{
+    QElapsedTimer syncClock;
+    syncClock.start();
+    m_dirty = false;
+
+    Line line;
+    for (;;) {
+        const bool stopping = m_stop.load();
+
+        int popped = 0;
+        while (popped < kMaxLinesPerPass && m_queue->tryPop(line)) {
+            ++popped;
+
+            // Rotasi tidak memotong pesan multi-fragmen di antara dua segmen
+            const bool hasLines = m_writer.blockCount() > 0 || !m_writer.blockEmpty();
+            const bool segmentFull = hasLines && !m_writer.inMultipart(line.timeMs)
+                                     && (m_writer.size() >= MaxSegmentBytes
+                                         || line.timeMs - m_writer.firstMs() >= qint64(MaxSegmentSecs) * 1000);
+            if ((!m_writer.isOpen() || segmentFull) && !rotate()) {
+                continue;
+            }
+
+            if (!m_writer.append(line.timeMs, line.text, line.length)) {
+                closeBlock();
+                m_writer.append(line.timeMs, line.text, line.length);
+            }
+            m_recorded.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Blok ditutup karena umur atau flush(), kecuali sedang di tengah pesan multi-fragmen
+        const bool flushRequested = m_flushRequested.exchange(false);
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        if (m_writer.isOpen() && !m_writer.blockEmpty() && !m_writer.inMultipart(nowMs)
+            && (flushRequested || nowMs - m_writer.blockFirstMs() >= BlockMaxAgeMs)) {
+            closeBlock();
+        }
+
+        if (m_dirty && (flushRequested || syncClock.elapsed() >= SyncIntervalMs)) {
+            if (m_writer.sync()) {
+                m_syncs.fetch_add(1, std::memory_order_relaxed);
+            }
+            m_dirty = false;
+            syncClock.restart();
+        }
+
+        if (stopping && m_queue->depth() == 0)
+            break;
+
+        if (popped == 0) {
+            QThread::msleep(kIdleSleepMs);
+        }
+    }
+
+    finishSegment();
+}
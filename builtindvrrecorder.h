@@ -0,0 +1,97 @@
+#ifndef BUILTINDVRRECORDER_H
+#define BUILTINDVRRECORDER_H
+
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <atomic>
+
+#include "IAisDvrPlugin2.h"
+#include "dvrsegment.h"
+#include "mpscring.h"
+
+#define DVR_LINE_MAX        256     // NMEA 82 karakter + tag block; lebih panjang dibuang
+#define DVR_QUEUE_CAPACITY  4096    // ~1 MB antrian tetap
+
+// Recorder DVR bawaan, dipakai kalau AisDvrPlugin.dll tidak dimuat.
+// recordRawNmea() hanya menyalin baris ke ring MPSC berukuran tetap; thread recorder
+// menulis ke segmen append-only (dvrsegment.h), memutar segmen per ukuran/waktu,
+// dan fsync dikumpulkan per SyncIntervalMs, bukan per baris.
+class BuiltinDvrRecorder : public QObject, public IAisDvrPlugin2
+{
+    Q_OBJECT
+    Q_INTERFACES(IAisDvrPlugin IAisDvrPlugin2)
+
+public:
+    enum {
+        MaxSegmentBytes = 64 * 1024 * 1024,
+        MaxSegmentSecs = 60 * 60,
+        BlockMaxAgeMs = 5000,       // blok ditutup walau belum penuh (batas data hilang saat crash)
+        SyncIntervalMs = 1000
+    };
+
+    struct Stats {
+        quint32 queued = 0;
+        quint32 highWater = 0;
+        quint64 recorded = 0;
+        quint64 dropped = 0;        // antrian penuh
+        quint64 oversize = 0;       // baris > DVR_LINE_MAX
+        quint64 blocks = 0;
+        quint64 segments = 0;
+        quint64 bytes = 0;
+        quint64 syncs = 0;
+    };
+
+    explicit BuiltinDvrRecorder(QObject *parent = nullptr);
+    ~BuiltinDvrRecorder() override;
+
+    // filePath mengikuti pemanggil lama ("<dir>/ais_log_<waktu>.nmea.log"); segmen ditulis
+    // sebagai "<dir>/ais_log_<waktu>.0001.dvrseg", ".0002", ...
+    void startRecording(const QString& filePath) override;
+    void stopRecording() override;
+    bool isRecording() const override { return m_recording.load(); }
+    void recordRawNmea(const QString& nmeaSentence) override;
+    void recordBatch(const AisDvrLine* lines, int count) override;
+    // Blok berjalan ditutup dan di-fsync pada putaran thread recorder berikutnya
+    void flush() override;
+
+    QString recordingDir() const { return m_dir; }
+    QString recordingStem() const { return m_stem; }
+    Stats stats() const;
+
+private:
+    struct Line {
+        qint64 timeMs;
+        quint16 length;
+        char text[DVR_LINE_MAX];
+    };
+
+    void push(qint64 timeMs, const char* data, int length);
+    void run();
+    bool rotate();
+    void closeBlock();
+    void finishSegment();
+
+    MpscRing<Line, DVR_QUEUE_CAPACITY> *m_queue;
+    QThread *m_thread = nullptr;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_recording{false};
+    std::atomic<bool> m_flushRequested{false};
+
+    QString m_dir;
+    QString m_stem;
+
+    // Hanya dipakai di thread recorder
+    DvrSegmentWriter m_writer;
+    int m_segmentSeq = 0;
+    bool m_dirty = false;       // ada blok yang belum di-fsync
+
+    std::atomic<quint64> m_recorded{0};
+    std::atomic<quint64> m_oversize{0};
+    std::atomic<quint64> m_blocks{0};
+    std::atomic<quint64> m_segments{0};
+    std::atomic<quint64> m_bytes{0};
+    std::atomic<quint64> m_syncs{0};
+};
+
+#endif // BUILTINDVRRECORDER_H
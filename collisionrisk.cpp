@@ -648,19 +648,19 @@ void CollisionRiskCalculator::updateTargetMotionState(const QString& mmsi, const
     state.rot = target.rot;
     state.lastUpdate = QDateTime::currentDateTime();
     state.updateCount++;
+
+    staleWheel.schedule(mmsi.toUInt(), state.lastUpdate.toMSecsSinceEpoch() + MAX_STALE_AGE_SECONDS * 1000);
 }
 
 void CollisionRiskCalculator::cleanupStaleTargetData()
 {
     QMutexLocker locker(&dataMutex);
-    QDateTime cutoff = QDateTime::currentDateTime().addSecs(-MAX_STALE_AGE_SECONDS);
 
-    for (auto it = targetStates.begin(); it != targetStates.end();) {
-        if (it.value().lastUpdate < cutoff) {
-            it = targetStates.erase(it);
-        } else {
-            ++it;
-        }
+    // Hanya target yang deadline-nya lewat yang disentuh
+    QVector<quint64> stale;
+    staleWheel.advance(QDateTime::currentMSecsSinceEpoch(), stale);
+    for (quint64 mmsi : stale) {
+        targetStates.remove(QString::number(mmsi));
     }
 
     QMutexLocker perfLocker(&performanceMutex);
@@ -5,6 +5,7 @@
 #include "aistargetpanel.h"
 #include "cpatcpacalculator.h"
 #include "guardzone.h"
+#include "timingwheel.h"
 
 #include <QObject>
 #include <QVector>
@@ -273,6 +274,7 @@ private:
     mutable QMutex dataMutex;
     TargetMotionState ownShipState;
     QHash<QString, TargetMotionState> targetStates;
+    TimingWheel staleWheel;     // deadline stale per MMSI, pengganti sweep targetStates
     QVector<GuardZone> guardZones;
     QVector<CollisionRiskResult> currentRisks;
     RiskLevel currentHighestRiskLevel;
@@ -384,7 +384,8 @@ void CPATCPAPanel::updateTargetsDisplay()
 
     // Ambil data AIS target dari sistem
     //ecWidget->updateAISTargetsList();
-    QMap<unsigned int, AISTargetData> targets = Ais::instance()->getTargetMap();
+    // Frame yang sama dengan yang dipakai EcWidget untuk CPA/draw pada tick ini
+    const AisTargetSnapshot targets = Ais::instance()->targetSnapshot();
 
     // Variabel status
     dangerousCount = 0;
@@ -408,7 +409,8 @@ void CPATCPAPanel::updateTargetsDisplay()
     for (const auto &d : ecWidget->getDangerousAISList()) dangerousSet.insert(d.mmsi);
 
     QList<TargetWithResult> sortedList;
-    for (const auto &target : targets) {
+    for (int i = 0; i < targets.size(); ++i) {
+        const AISTargetData target = targets.target(i);
         //if (target.mmsi != "367159080" && target.mmsi != "366973590" && target.mmsi != "366996240") continue;
 
         VesselState ownShip;
@@ -771,11 +773,10 @@ void CPATCPAPanel::onTargetsContextMenuRequested(const QPoint& pos)
             ecWidget->TrackTarget("");
         } else {
             // Set track target and optionally seed last known position
-            QMap<unsigned int, AISTargetData>& targets = Ais::instance()->getTargetMap();
-            unsigned int mmsiInt = mmsi.toUInt();
-            if (targets.contains(mmsiInt)) {
-                const AISTargetData& td = targets[mmsiInt];
-                AISTargetData track; track.mmsi = mmsi; track.lat = td.lat; track.lon = td.lon;
+            const AisTargetSnapshot targets = Ais::instance()->targetSnapshot();
+            const int index = targets.indexOf(mmsi.toUInt());
+            if (index >= 0) {
+                AISTargetData track; track.mmsi = mmsi; track.lat = targets.lat(index); track.lon = targets.lon(index);
                 ecWidget->setAISTrack(track);
             }
             ecWidget->TrackTarget(mmsi);
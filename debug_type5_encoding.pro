@@ -8,9 +8,13 @@ TARGET = debug_type5_encoding
 
 SOURCES += \
     debug_type5_encoding.cpp \
-    aivdoencoder.cpp
+    aivdoencoder.cpp \
+    aispayload.cpp \
+    aisfragmentassembler.cpp
 
 HEADERS += \
-    aivdoencoder.h
+    aivdoencoder.h \
+    aispayload.h \
+    aisfragmentassembler.h
 
 DEFINES += _WIN32
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "dvrreplaystreamer.h"
+#include "dvrsegment.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+#include <QFileInfo>
+#include <QThread>
+#include <limits>
+
+namespace {
+
+const int kChunkTextBytes = DvrReplayStreamer::ChunkLines * 64;
+
+void resetChunk(DvrLineChunk &chunk)
+{
+    chunk = DvrLineChunk();
+    chunk.text.reserve(kChunkTextBytes);
+    chunk.lines.reserve(DvrReplayStreamer::ChunkLines);
+}
+
+} // namespace
+
+DvrReplayStreamer::DvrReplayStreamer(QObject *parent)
+    : QObject(parent)
+{
+}
+
+DvrReplayStreamer::~DvrReplayStreamer()
+{
+    stop();
+}
+
+bool DvrReplayStreamer::open(const QString &segmentPath)
+{
+    stop();
+
+    const QFileInfo info(segmentPath);
+    m_segments = DvrSegmentReader::segmentsIn(info.absolutePath(), DvrSegmentReader::stemOf(segmentPath));
+    m_rangeSent = false;
+    return !m_segments.isEmpty();
+}
+
+void DvrReplayStreamer::start(qint64 fromMs)
+{
+    stop();
+
+    m_ring.reset(new ChunkRing);
+    m_stop = false;
+    m_producerDone = false;
+    m_current = DvrLineChunk();
+    m_currentPos = 0;
+
+    m_future = QtConcurrent::run([this, fromMs]() { run(fromMs); });
+}
+
+void DvrReplayStreamer::stop()
+{
+    m_stop = true;
+    if (m_future.isRunning()) {
+        m_future.waitForFinished();
+    }
+    m_ring.reset();
+    m_current = DvrLineChunk();
+    m_currentPos = 0;
+}
+
+bool DvrReplayStreamer::push(DvrLineChunk &chunk)
+{
+    // Jendela prefetch penuh: tunggu GUI mengonsumsi (backpressure ke scan segmen)
+    while (m_ring->depth() >= quint32(PrefetchChunks)) {
+        if (m_stop.load())
+            return false;
+        QThread::msleep(10);
+    }
+    m_ring->tryPush(chunk);
+    resetChunk(chunk);
+    return !m_stop.load();
+}
+
+void DvrReplayStreamer::run(qint64 fromMs)
+{
+    // Rentang dari segmen pertama dan terakhir saja; segmen yang masih ditulis
+    // (tanpa footer) dipulihkan index bloknya di sini, bukan di thread GUI
+    if (!m_rangeSent && !m_segments.isEmpty()) {
+        m_rangeSent = true;
+        DvrSegmentReader first;
+        DvrSegmentReader last;
+        const bool single = m_segments.size() == 1;
+        if (first.open(m_segments.first()) && (single || last.open(m_segments.last()))) {
+            emit rangeReady(first.firstMs(), single ? first.lastMs() : last.lastMs());
+        }
+    }
+
+    qint64 total = 0;
+    bool ok = true;
+    DvrLineChunk chunk;
+    resetChunk(chunk);
+
+    for (const QString &path : m_segments) {
+        if (m_stop.load())
+            break;
+
+        DvrSegmentReader reader;
+        if (!reader.open(path)) {
+            qWarning() << "[DVR] Skipping unreadable segment:" << path;
+            continue;
+        }
+        if (reader.blocks().isEmpty() || reader.lastMs() < fromMs)
+            continue;
+
+        const bool scanned = reader.scan(fromMs, std::numeric_limits<qint64>::max(), 0,
+                                         [&](qint64 timeMs, const char *line, int length) {
+            while (length > 0 && (line[length - 1] == '\r' || line[length - 1] == '\n')) {
+                --length;
+            }
+            if (length == 0)
+                return true;
+
+            chunk.lines.append({timeMs, chunk.text.size(), length});
+            chunk.text.append(line, length);
+            if (chunk.lines.size() < ChunkLines)
+                return !m_stop.load();
+
+            total += chunk.lines.size();
+            return push(chunk);
+        });
+        if (!scanned) {
+            qWarning() << "[DVR] Corrupt block, rest of segment skipped:" << path;
+            ok = false;
+        }
+    }
+
+    if (!chunk.lines.isEmpty() && !m_stop.load()) {
+        total += chunk.lines.size();
+        push(chunk);
+    }
+
+    m_producerDone = true;
+    if (!m_stop.load()) {
+        emit streamFinished(total, ok);
+    }
+}
+
+bool DvrReplayStreamer::peek(qint64 &timeMs, const char *&line, int &length)
+{
+    while (m_currentPos >= m_current.lines.size()) {
+        if (!m_ring || !m_ring->tryPop(m_current))
+            return false;
+        m_currentPos = 0;
+    }
+    const DvrLineChunk::Line &l = m_current.lines.at(m_currentPos);
+    timeMs = l.timeMs;
+    line = m_current.text.constData() + l.offset;
+    length = l.length;
+    return true;
+}
+
+void DvrReplayStreamer::pop()
+{
+    if (m_currentPos < m_current.lines.size()) {
+        ++m_currentPos;
+    }
+}
+
+bool DvrReplayStreamer::atEnd()
+{
+    qint64 timeMs;
+    const char *line;
+    int length;
+    return m_producerDone.load() && !peek(timeMs, line, length);
+}
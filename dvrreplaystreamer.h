@@ -0,0 +1,83 @@
+#ifndef DVRREPLAYSTREAMER_H
+#define DVRREPLAYSTREAMER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QStringList>
+#include <QVector>
+#include <QFuture>
+#include <QScopedPointer>
+#include <atomic>
+
+#include "spscring.h"
+
+// Satu halaman baris rekaman DVR: teks baris berurutan dalam satu buffer
+struct DvrLineChunk {
+    struct Line {
+        qint64 timeMs;
+        int offset;
+        int length;
+    };
+
+    QByteArray text;
+    QVector<Line> lines;
+};
+
+// Playback rekaman DVR bawaan (semua segmen satu stem) langsung dari segmen, tanpa ekspor teks.
+// Thread worker membaca lewat DvrSegmentReader::scan() mulai dari waktu yang diminta: segmen
+// yang berakhir sebelum waktu itu dilewati, dan di dalam segmen hanya blok yang overlap yang
+// didekompres (index blok di footer). Baris masuk per ChunkLines ke ring SPSC berukuran tetap;
+// kalau ring penuh worker menunggu. Seek = start() ulang dari waktu baru.
+// GUI membaca lewat peek()/pop() dari tick AisLogReplay.
+class DvrReplayStreamer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum {
+        ChunkLines = 2000,
+        PrefetchChunks = 16
+    };
+
+    explicit DvrReplayStreamer(QObject *parent = nullptr);
+    ~DvrReplayStreamer() override;
+
+    // Kumpulkan segmen rekaman dari path salah satu segmennya; false kalau tidak ada
+    bool open(const QString &segmentPath);
+    const QStringList& segments() const { return m_segments; }
+
+    // Baca dari waktu rekaman fromMs sampai akhir rekaman
+    void start(qint64 fromMs);
+    void stop();
+
+    // Sisi konsumen (thread GUI). false = belum ada baris di jendela prefetch.
+    // Pointer baris valid sampai pop() berikutnya.
+    bool peek(qint64 &timeMs, const char *&line, int &length);
+    void pop();
+    // Worker selesai dan semua baris sudah dikonsumsi
+    bool atEnd();
+
+signals:
+    // Rentang waktu rekaman (awal segmen pertama .. akhir segmen terakhir), sekali per open()
+    void rangeReady(qint64 firstMs, qint64 lastMs);
+    void streamFinished(qint64 totalLines, bool ok);
+
+private:
+    typedef SpscRing<DvrLineChunk, PrefetchChunks> ChunkRing;
+
+    void run(qint64 fromMs);
+    bool push(DvrLineChunk &chunk);
+
+    QStringList m_segments;
+    bool m_rangeSent = false;   // hanya disentuh worker; run() tidak pernah paralel
+
+    QScopedPointer<ChunkRing> m_ring;
+    QFuture<void> m_future;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_producerDone{false};
+
+    DvrLineChunk m_current;
+    int m_currentPos = 0;
+};
+
+#endif // DVRREPLAYSTREAMER_H
@@ -0,0 +1,491 @@
+#include "dvrsegment.h"
+#include "aispayload.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QtEndian>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const quint32 kSegmentMagic = 0x53525644;   // "DVRS"
+const quint32 kBlockMagic = 0x42525644;     // "DVRB"
+const quint32 kFooterMagic = 0x46525644;    // "DVRF"
+const quint16 kVersion = 1;
+
+const int kFileHeaderBytes = 16;
+const int kBlockHeaderBytes = 68;
+const int kFooterEntryBytes = 60;
+const int kTrailerBytes = 16;
+const int kFrameHeaderBytes = 6;            // delta ms int32 + panjang uint16
+
+struct BlockHeader {
+    quint32 storedSize = 0;
+    quint32 rawSize = 0;
+    quint16 crc = 0;
+    DvrBlockSummary summary;
+};
+
+QDataStream& writeSummary(QDataStream &out, const DvrBlockSummary &s, bool withOffset)
+{
+    if (withOffset) {
+        out << s.offset;
+    }
+    out << s.firstMs << s.lastMs;
+    for (int i = 0; i < DVR_BLOOM_WORDS; ++i) {
+        out << s.mmsiBloom[i];
+    }
+    return out;
+}
+
+QDataStream& readSummary(QDataStream &in, DvrBlockSummary &s, bool withOffset)
+{
+    if (withOffset) {
+        in >> s.offset;
+    }
+    in >> s.firstMs >> s.lastMs;
+    for (int i = 0; i < DVR_BLOOM_WORDS; ++i) {
+        in >> s.mmsiBloom[i];
+    }
+    return in;
+}
+
+bool parseBlockHeader(const QByteArray &bytes, BlockHeader &h)
+{
+    if (bytes.size() != kBlockHeaderBytes)
+        return false;
+
+    QDataStream in(bytes);
+    in.setByteOrder(QDataStream::LittleEndian);
+    quint32 magic = 0;
+    quint16 reserved = 0;
+    in >> magic >> h.storedSize >> h.rawSize >> h.summary.lineCount;
+    readSummary(in, h.summary, false);
+    in >> h.crc >> reserved;
+    return magic == kBlockMagic && in.status() == QDataStream::Ok;
+}
+
+void bloomBits(quint32 mmsi, int &a, int &b)
+{
+    const quint64 x = quint64(mmsi) * Q_UINT64_C(0x9E3779B97F4A7C15);
+    a = int(x >> 56);
+    b = int((x >> 48) & 0xff);
+}
+
+// Awal kalimat setelah tag block "\...\" (-1 kalau tag block tidak ditutup)
+int sentenceStart(const char *line, int length)
+{
+    if (length <= 0 || line[0] != '\\')
+        return 0;
+    const void *end = std::memchr(line + 1, '\\', size_t(length - 1));
+    return end ? int(static_cast<const char*>(end) - line) + 1 : -1;
+}
+
+bool syncFile(QFile &file)
+{
+    if (!file.flush())
+        return false;
+#ifdef _WIN32
+    return _commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+} // namespace
+
+void DvrBlockSummary::addMmsi(quint32 mmsi)
+{
+    int a, b;
+    bloomBits(mmsi, a, b);
+    mmsiBloom[a >> 6] |= Q_UINT64_C(1) << (a & 63);
+    mmsiBloom[b >> 6] |= Q_UINT64_C(1) << (b & 63);
+}
+
+bool DvrBlockSummary::mayContain(quint32 mmsi) const
+{
+    int a, b;
+    bloomBits(mmsi, a, b);
+    return (mmsiBloom[a >> 6] & (Q_UINT64_C(1) << (a & 63)))
+           && (mmsiBloom[b >> 6] & (Q_UINT64_C(1) << (b & 63)));
+}
+
+// ========================================
+// WRITER
+// ========================================
+
+DvrSegmentWriter::DvrSegmentWriter()
+{
+    // reserve() supaya truncate(0) tidak melepas buffer tiap blok
+    m_raw.reserve(DVR_BLOCK_RAW_BYTES + 512);
+}
+
+DvrSegmentWriter::~DvrSegmentWriter()
+{
+    if (m_file.isOpen()) {
+        finish();
+    }
+}
+
+bool DvrSegmentWriter::open(const QString &path)
+{
+    if (m_file.isOpen()) {
+        finish();
+    }
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[DVR] Cannot create segment" << path << ":" << m_file.errorString();
+        return false;
+    }
+
+    m_raw.truncate(0);
+    m_block = DvrBlockSummary();
+    m_index.clear();
+    m_firstMs = 0;
+    m_fragmentsPending = false;
+    m_fragmentsSinceMs = 0;
+
+    QByteArray header;
+    QDataStream out(&header, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out << kSegmentMagic << kVersion << quint16(0) << QDateTime::currentMSecsSinceEpoch();
+    return m_file.write(header) == kFileHeaderBytes;
+}
+
+bool DvrSegmentWriter::append(qint64 timeMs, const char *line, int length)
+{
+    length = qBound(0, length, 0xffff);
+    if (!blockEmpty() && m_raw.size() + kFrameHeaderBytes + length > DVR_BLOCK_RAW_BYTES)
+        return false;
+
+    // Waktu dibuat monoton di dalam segmen: beberapa producer bisa selisih beberapa ms,
+    // dan reader boleh berhenti di baris pertama setelah akhir rentang.
+    if (m_block.lineCount == 0) {
+        if (!m_index.isEmpty()) {
+            timeMs = qMax(timeMs, m_index.last().lastMs);
+        }
+        m_block.firstMs = timeMs;
+        if (m_index.isEmpty()) {
+            m_firstMs = timeMs;
+        }
+    } else {
+        timeMs = qMax(timeMs, m_block.lastMs);
+    }
+    m_block.lastMs = timeMs;
+    ++m_block.lineCount;
+
+    char frame[kFrameHeaderBytes];
+    qToLittleEndian<qint32>(qint32(timeMs - m_block.firstMs), frame);
+    qToLittleEndian<quint16>(quint16(length), frame + 4);
+    m_raw.append(frame, kFrameHeaderBytes);
+    m_raw.append(line, length);
+
+    int number = 0, count = 0;
+    if (DvrSegmentReader::fragmentOf(line, length, number, count)) {
+        if (number == 1 && count > 1) {
+            m_fragmentsSinceMs = timeMs;
+        }
+        m_fragmentsPending = number < count;
+        if (number == 1) {
+            const quint32 mmsi = DvrSegmentReader::mmsiOf(line, length);
+            if (mmsi != 0) {
+                m_block.addMmsi(mmsi);
+            }
+        }
+    }
+    return true;
+}
+
+bool DvrSegmentWriter::closeBlock()
+{
+    if (!m_file.isOpen() || blockEmpty())
+        return true;
+
+    const QByteArray payload = qCompress(m_raw);
+
+    QByteArray header;
+    QDataStream out(&header, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out << kBlockMagic << quint32(payload.size()) << quint32(m_raw.size()) << m_block.lineCount;
+    writeSummary(out, m_block, false);
+    out << qChecksum(payload.constData(), uint(payload.size())) << quint16(0);
+
+    m_block.offset = m_file.pos();
+    const bool ok = m_file.write(header) == kBlockHeaderBytes && m_file.write(payload) == payload.size();
+    if (ok) {
+        m_index.append(m_block);
+    } else {
+        qWarning() << "[DVR] Block write failed:" << m_file.errorString();
+    }
+
+    m_raw.truncate(0);
+    m_block = DvrBlockSummary();
+    return ok;
+}
+
+bool DvrSegmentWriter::sync()
+{
+    return m_file.isOpen() && syncFile(m_file);
+}
+
+bool DvrSegmentWriter::finish()
+{
+    if (!m_file.isOpen())
+        return false;
+
+    bool ok = closeBlock();
+
+    QByteArray footer;
+    QDataStream out(&footer, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    const qint64 indexOffset = m_file.pos();
+    for (const DvrBlockSummary &s : m_index) {
+        writeSummary(out, s, true);
+        out << s.lineCount;
+    }
+    out << kFooterMagic << quint32(m_index.size()) << indexOffset;
+
+    ok = ok && m_file.write(footer) == footer.size();
+    ok = syncFile(m_file) && ok;
+    m_file.close();
+    m_index.clear();
+    return ok;
+}
+
+// ========================================
+// READER
+// ========================================
+
+bool DvrSegmentReader::open(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(m_file.read(kFileHeaderBytes));
+    in.setByteOrder(QDataStream::LittleEndian);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != kSegmentMagic || version != kVersion) {
+        qWarning() << "[DVR] Not a segment file:" << path;
+        close();
+        return false;
+    }
+
+    m_complete = readFooter();
+    if (!m_complete && !recoverIndex()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void DvrSegmentReader::close()
+{
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_blocks.clear();
+    m_complete = false;
+}
+
+qint64 DvrSegmentReader::lastMs() const
+{
+    return m_blocks.isEmpty() ? 0 : m_blocks.last().lastMs;
+}
+
+bool DvrSegmentReader::readFooter()
+{
+    const qint64 size = m_file.size();
+    if (size < kFileHeaderBytes + kTrailerBytes)
+        return false;
+
+    m_file.seek(size - kTrailerBytes);
+    QDataStream trailer(m_file.read(kTrailerBytes));
+    trailer.setByteOrder(QDataStream::LittleEndian);
+    quint32 magic = 0, count = 0;
+    qint64 indexOffset = 0;
+    trailer >> magic >> count >> indexOffset;
+    if (magic != kFooterMagic || indexOffset + qint64(count) * kFooterEntryBytes + kTrailerBytes != size)
+        return false;
+
+    m_file.seek(indexOffset);
+    QDataStream in(m_file.read(qint64(count) * kFooterEntryBytes));
+    in.setByteOrder(QDataStream::LittleEndian);
+    m_blocks.resize(int(count));
+    for (DvrBlockSummary &s : m_blocks) {
+        readSummary(in, s, true);
+        in >> s.lineCount;
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+bool DvrSegmentReader::recoverIndex()
+{
+    // Segmen terbuka atau crash: kumpulkan blok utuh, berhenti di ekor yang sobek
+    const qint64 size = m_file.size();
+    qint64 pos = kFileHeaderBytes;
+    while (pos + kBlockHeaderBytes <= size) {
+        m_file.seek(pos);
+        BlockHeader h;
+        if (!parseBlockHeader(m_file.read(kBlockHeaderBytes), h))
+            break;
+        if (qint64(h.storedSize) > size - pos - kBlockHeaderBytes)
+            break;
+
+        const QByteArray payload = m_file.read(h.storedSize);
+        if (qChecksum(payload.constData(), uint(payload.size())) != h.crc)
+            break;
+
+        h.summary.offset = pos;
+        m_blocks.append(h.summary);
+        pos += kBlockHeaderBytes + h.storedSize;
+    }
+    return true;
+}
+
+bool DvrSegmentReader::readBlock(const DvrBlockSummary &summary, QByteArray &raw)
+{
+    if (!m_file.seek(summary.offset))
+        return false;
+
+    BlockHeader h;
+    if (!parseBlockHeader(m_file.read(kBlockHeaderBytes), h))
+        return false;
+
+    const QByteArray payload = m_file.read(h.storedSize);
+    if (payload.size() != int(h.storedSize) || qChecksum(payload.constData(), uint(payload.size())) != h.crc) {
+        qWarning() << "[DVR] Corrupt block at" << summary.offset << "in" << m_file.fileName();
+        return false;
+    }
+
+    raw = qUncompress(payload);
+    return raw.size() == int(h.rawSize);
+}
+
+bool DvrSegmentReader::scan(qint64 fromMs, qint64 toMs, quint32 mmsi, const LineVisitor &visit)
+{
+    QByteArray raw;
+    bool continuation = false;     // fragmen lanjutan dari MMSI yang dicari
+
+    for (const DvrBlockSummary &block : m_blocks) {
+        if (block.firstMs > toMs)
+            break;
+        if (!block.overlaps(fromMs, toMs))
+            continue;
+        if (mmsi != 0 && !block.mayContain(mmsi) && !continuation)
+            continue;
+        if (!readBlock(block, raw))
+            return false;
+
+        const char *data = raw.constData();
+        int pos = 0;
+        while (pos + kFrameHeaderBytes <= raw.size()) {
+            const qint64 timeMs = block.firstMs + qFromLittleEndian<qint32>(data + pos);
+            const int length = qFromLittleEndian<quint16>(data + pos + 4);
+            const char *line = data + pos + kFrameHeaderBytes;
+            pos += kFrameHeaderBytes + length;
+            if (pos > raw.size())
+                return false;
+
+            if (timeMs > toMs)
+                return true;
+            if (timeMs < fromMs)
+                continue;
+
+            if (mmsi != 0) {
+                int number = 0, count = 0;
+                if (!fragmentOf(line, length, number, count))
+                    continue;
+                if (number == 1) {
+                    if (mmsiOf(line, length) != mmsi) {
+                        continuation = false;
+                        continue;
+                    }
+                } else if (!continuation) {
+                    continue;
+                }
+                continuation = number < count;
+            }
+
+            if (!visit(timeMs, line, length))
+                return true;
+        }
+    }
+    return true;
+}
+
+QStringList DvrSegmentReader::segmentsIn(const QString &dir, const QString &stem)
+{
+    const QDir d(dir);
+    const QString pattern = stem.isEmpty() ? QString("*" DVR_SEGMENT_SUFFIX)
+                                           : QString("%1.*" DVR_SEGMENT_SUFFIX).arg(stem);
+    QStringList paths;
+    for (const QString &name : d.entryList({pattern}, QDir::Files, QDir::Name)) {
+        paths << d.absoluteFilePath(name);
+    }
+    return paths;
+}
+
+QString DvrSegmentReader::stemOf(const QString &segmentPath)
+{
+    QString stem = QFileInfo(segmentPath).fileName();
+    if (stem.endsWith(QLatin1String(DVR_SEGMENT_SUFFIX))) {
+        stem.chop(int(qstrlen(DVR_SEGMENT_SUFFIX)));
+    }
+    const int dot = stem.lastIndexOf(QLatin1Char('.'));
+    return (dot > 0) ? stem.left(dot) : stem;
+}
+
+bool DvrSegmentReader::fragmentOf(const char *line, int length, int &number, int &count)
+{
+    const int pos = sentenceStart(line, length);
+    if (pos < 0)
+        return false;
+
+    // !xxVDM,count,number,...
+    if (length - pos < 11 || line[pos] != '!' || line[pos + 3] != 'V' || line[pos + 4] != 'D'
+        || (line[pos + 5] != 'M' && line[pos + 5] != 'O') || line[pos + 6] != ',')
+        return false;
+
+    const char c = line[pos + 7];
+    const char n = line[pos + 9];
+    if (c < '1' || c > '9' || line[pos + 8] != ',' || n < '1' || n > '9')
+        return false;
+
+    count = c - '0';
+    number = n - '0';
+    return true;
+}
+
+quint32 DvrSegmentReader::mmsiOf(const char *line, int length)
+{
+    int number = 0, count = 0;
+    if (!fragmentOf(line, length, number, count) || number != 1)
+        return 0;
+
+    // Koma di dalam tag block akan menggeser hitungan field
+    const int pos = sentenceStart(line, length);
+    int start = 0, payloadLength = 0, fillBits = 0;
+    if (!AisPayload::locatePayload(line + pos, length - pos, start, payloadLength, fillBits))
+        return 0;
+
+    // Tipe + repeat + MMSI = 38 bit pertama, cukup 7 karakter
+    AisPayload payload;
+    if (!payload.unpack(line + pos + start, qMin(payloadLength, 7)) || payload.bitCount() < 38)
+        return 0;
+    return quint32(payload.readBits(8, 30));
+}
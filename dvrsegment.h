@@ -0,0 +1,118 @@
+#ifndef DVRSEGMENT_H
+#define DVRSEGMENT_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QFile>
+#include <functional>
+
+#define DVR_SEGMENT_SUFFIX      ".dvrseg"
+#define DVR_BLOCK_RAW_BYTES     (64 * 1024)     // baris mentah per blok sebelum dikompres
+#define DVR_BLOOM_WORDS         4               // 256 bit bloom MMSI per blok
+#define DVR_FRAGMENT_MAX_AGE_MS 5000            // fragmen tanpa pasangan tidak menahan blok lebih lama
+
+// Segmen DVR: file append-only berisi blok-blok terkompresi.
+//
+//   header   : magic 'DVRS', versi, waktu dibuat                    (16 byte)
+//   blok     : header blok (ringkasan + ukuran + crc) + payload qCompress
+//              payload mentah = [delta ms int32][len uint16][byte baris] berulang
+//   footer   : ringkasan semua blok, lalu trailer (magic 'DVRF', jumlah, offset index)
+//
+// Semua angka little-endian. Segmen yang tidak sempat ditutup (crash) tidak punya footer;
+// reader lalu menyusun index dengan membaca header blok satu per satu sampai blok rusak.
+
+// Ringkasan satu blok: rentang waktu dan bloom MMSI. Dipakai di header blok dan footer.
+struct DvrBlockSummary {
+    qint64 offset = 0;          // posisi header blok di file
+    qint64 firstMs = 0;
+    qint64 lastMs = 0;
+    quint64 mmsiBloom[DVR_BLOOM_WORDS] = {};
+    quint32 lineCount = 0;
+
+    bool overlaps(qint64 fromMs, qint64 toMs) const { return lastMs >= fromMs && firstMs <= toMs; }
+    void addMmsi(quint32 mmsi);
+    // false = MMSI pasti tidak ada di blok ini
+    bool mayContain(quint32 mmsi) const;
+};
+
+class DvrSegmentWriter
+{
+public:
+    DvrSegmentWriter();
+    ~DvrSegmentWriter();
+
+    bool open(const QString &path);
+    bool isOpen() const { return m_file.isOpen(); }
+    QString path() const { return m_file.fileName(); }
+
+    // false kalau blok berjalan penuh; panggil closeBlock() lalu ulangi
+    bool append(qint64 timeMs, const char *line, int length);
+    bool blockEmpty() const { return m_block.lineCount == 0; }
+    qint64 blockFirstMs() const { return m_block.firstMs; }
+    // Baris terakhir adalah fragmen AIVDM yang belum lengkap; jangan tutup blok karena umur.
+    // Sama seperti AisFragmentAssembler, grup yang lebih tua dari DVR_FRAGMENT_MAX_AGE_MS
+    // dianggap basi (mis. "1 dari 2" tanpa pasangan) dan tidak lagi menahan blok/segmen.
+    bool inMultipart(qint64 nowMs) const
+    {
+        return m_fragmentsPending && nowMs - m_fragmentsSinceMs < DVR_FRAGMENT_MAX_AGE_MS;
+    }
+
+    bool closeBlock();      // kompres dan tulis blok berjalan
+    bool sync();            // flush + fsync
+    bool finish();          // tutup blok, tulis footer, fsync, tutup file
+
+    qint64 size() const { return m_file.isOpen() ? m_file.pos() : 0; }
+    qint64 firstMs() const { return m_firstMs; }
+    int blockCount() const { return m_index.size(); }
+
+private:
+    QFile m_file;
+    QByteArray m_raw;
+    DvrBlockSummary m_block;
+    QVector<DvrBlockSummary> m_index;
+    qint64 m_firstMs = 0;
+    bool m_fragmentsPending = false;
+    qint64 m_fragmentsSinceMs = 0;      // waktu fragmen pertama grup yang sedang terbuka
+};
+
+class DvrSegmentReader
+{
+public:
+    // Dipanggil per baris; return false untuk berhenti
+    typedef std::function<bool(qint64 timeMs, const char *line, int length)> LineVisitor;
+
+    bool open(const QString &path);
+    void close();
+
+    bool isComplete() const { return m_complete; }    // footer ada
+    const QVector<DvrBlockSummary>& blocks() const { return m_blocks; }
+    qint64 firstMs() const { return m_blocks.isEmpty() ? 0 : m_blocks.first().firstMs; }
+    qint64 lastMs() const;
+
+    // Hanya blok yang overlap [fromMs, toMs] (dan bloom-nya cocok kalau mmsi != 0) yang dibaca.
+    // Dengan filter MMSI, fragmen lanjutan ikut terkirim setelah fragmen pertamanya.
+    bool scan(qint64 fromMs, qint64 toMs, quint32 mmsi, const LineVisitor &visit);
+
+    // Segmen satu rekaman (atau semua kalau stem kosong), urut nama = urut waktu
+    static QStringList segmentsIn(const QString &dir, const QString &stem = QString());
+    // "<dir>/ais_log_x.0003.dvrseg" -> "ais_log_x"
+    static QString stemOf(const QString &segmentPath);
+    // MMSI dari fragmen pertama !AIVDM/!AIVDO, 0 untuk kalimat lain
+    static quint32 mmsiOf(const char *line, int length);
+    // Nomor dan jumlah fragmen; false kalau bukan AIVDM/AIVDO
+    static bool fragmentOf(const char *line, int length, int &number, int &count);
+
+private:
+    bool readFooter();
+    bool recoverIndex();
+    bool readBlock(const DvrBlockSummary &summary, QByteArray &raw);
+
+    QFile m_file;
+    QVector<DvrBlockSummary> m_blocks;
+    bool m_complete = false;
+};
+
+#endif // DVRSEGMENT_H
@@ -37,6 +37,7 @@ HEADERS += mainwindow.h ecwidget.h pickwindow.h ais.h \
     chartmanagerpanel.h \
     AISSubscriber.h \
     IAisDvrPlugin.h \
+    IAisDvrPlugin2.h \
     IndexerWorker.h \
     PluginManager.h \
     SettingsData.h \
@@ -44,6 +45,28 @@ HEADERS += mainwindow.h ecwidget.h pickwindow.h ais.h \
     SettingsManager.h \
     aisdatabasemanager.h \
     aisdecoder.h \
+    aisfragmentassembler.h \
+    jsonstreamframer.h \
+    nodefleet.h \
+    aistargetstore.h \
+    timingwheel.h \
+    aisdeadreckoner.h \
+    aislogreplay.h \
+    nmeadbstreamer.h \
+    nmearecordwriter.h \
+    mpscring.h \
+    sqlstatementregistry.h \
+    dvrsegment.h \
+    dvrreplaystreamer.h \
+    builtindvrrecorder.h \
+    aisdvrsink.h \
+    tracksimplifier.h \
+    geoprojector.h \
+    ownshiptrail.h \
+    labelplacer.h \
+    navrecord.h \
+    spscring.h \
+    aispayload.h \
     aistooltip.h \
     aivdoencoder.h \
     alertmanager.h \
@@ -102,6 +125,25 @@ SOURCES += main.cpp mainwindow.cpp ecwidget.cpp pickwindow.cpp ais.cpp \
     SettingsManager.cpp \
     aisdatabasemanager.cpp \
     aisdecoder.cpp \
+    aisfragmentassembler.cpp \
+    jsonstreamframer.cpp \
+    nodefleet.cpp \
+    aistargetstore.cpp \
+    timingwheel.cpp \
+    aisdeadreckoner.cpp \
+    aislogreplay.cpp \
+    nmeadbstreamer.cpp \
+    nmearecordwriter.cpp \
+    sqlstatementregistry.cpp \
+    dvrsegment.cpp \
+    dvrreplaystreamer.cpp \
+    builtindvrrecorder.cpp \
+    aisdvrsink.cpp \
+    tracksimplifier.cpp \
+    geoprojector.cpp \
+    ownshiptrail.cpp \
+    labelplacer.cpp \
+    aispayload.cpp \
     aistooltip.cpp \
     aivdoencoder.cpp \
     appconfig.cpp \
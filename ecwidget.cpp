@@ -26,6 +26,7 @@
 #include "ais.h"
 #include "pickwindow.h"
 #include "aistooltip.h"
+#include "aislogreplay.h"
 #include "mainwindow.h"
 #include "aoi.h"
 #include "satellitetilelayer.h"
@@ -60,7 +61,7 @@
 #include <QFormLayout>
 
 // Guardzone
-#include "IAisDvrPlugin.h"
+#include "aisdvrsink.h"
 #include "PluginManager.h"
 #include "guardzonecheckdialog.h"
 #include "guardzonemanager.h"
@@ -88,8 +89,6 @@ int EcWidget::maxScale = 50000000;
 // NOTE: Removed duplicate globals for AIS threading/socket state.
 // Use EcWidget member variables declared in ecwidget.h instead.
 
-std::atomic<bool> stopFlag;
-
 QTextEdit *nmeaText;
 QTextEdit *aisText;
 QTextEdit *ownShipText;
@@ -100,7 +99,7 @@ QTextEdit *ownShipTemp;
 ShipStruct mapShip = {};
 ShipStruct navShip = {};
 ActiveRouteStruct activeRoute = {};
-QMap<QString, ShipStruct> nodeShips;
+NodeFleet nodeFleet;
 
 QString aivdo;
 QString nmea;
@@ -275,9 +274,16 @@ EcWidget::EcWidget (EcDictInfo *dict, QString *libStr, QWidget *parent)
   satelliteLayer = new SatelliteTileLayer(this);
   showSatelliteLayer = false;
   connect(satelliteLayer, &SatelliteTileLayer::tileUpdated, this, [this](int, int, int) {
+      invalidateChartLayer(); // tile baru masuk ke chart base pada tick berikutnya
       update(); // Trigger repaint when tiles are loaded
   });
 
+  // Tile chart pan/zoom dirender satu per satu saat GUI idle
+  chartTiles.setMaxCost(CHART_TILE_CACHE_KB);
+  chartTilePrefetchTimer.setSingleShot(true);
+  chartTilePrefetchTimer.setInterval(CHART_TILE_IDLE_MS);
+  connect(&chartTilePrefetchTimer, &QTimer::timeout, this, [this]() { prefetchChartTile(); });
+
   // Initialize alert system (delayed to ensure EcWidget is fully constructed)
   QTimer::singleShot(100, this, &EcWidget::initializeAlertSystem);
 
@@ -1819,6 +1825,148 @@ bool EcWidget::LatLonToXy (EcCoordinate lat, EcCoordinate lon, int & x, int & y)
 
 /*---------------------------------------------------------------------------*/
 
+// Transformasi untuk viewport kernel saat ini. Di-capture ulang hanya kalau view berubah;
+// proyeksi yang tidak dikenal (atau capture yang tidak lolos cek) membuat projector tidak valid
+// dan projectLatLon() kembali ke kernel.
+const GeoProjector &EcWidget::frameProjector()
+{
+  FrameProjectorKey key;
+  key.projLat = chartProjLat;
+  key.projLon = chartProjLon;
+  key.viewLat = currentLat;
+  key.viewLon = currentLon;
+  key.scale = currentScale;
+  key.heading = currentHeading;
+  key.projection = int(currentProjection);
+  key.size = size();
+  key.viewChange = viewChangeCounter;
+  key.generation = frameProjectorGeneration;
+
+  if (frameProjectorCaptured && key == frameProjectorKey)
+    return frameProjectorCache;
+
+  GeoProjector next;
+  bool supported = true;
+  GeoProjector::Projection projection = GeoProjector::Mercator;
+  switch (currentProjection)
+  {
+  case EC_GEO_PROJECTION_MERCATOR:
+    projection = GeoProjector::Mercator;
+    break;
+  case EC_GEO_PROJECTION_STEREOGRAPHIC:
+    projection = GeoProjector::Stereographic;
+    break;
+  case EC_GEO_PROJECTION_POLAR_STEREOGRAPHIC:
+    projection = GeoProjector::PolarStereographic;
+    break;
+  case EC_GEO_PROJECTION_GNOMONIC:
+    projection = GeoProjector::Gnomonic;
+    break;
+  case EC_GEO_PROJECTION_CYLINDRIC:
+    projection = GeoProjector::Cylindrical;
+    break;
+  default:
+    supported = false;
+    break;
+  }
+
+  if (supported && initialized && view)
+  {
+    next.capture(projection, chartProjLat, chartProjLon, size(),
+                 [this](double lat, double lon, int &x, int &y) { return EcDrawLatLonToXy(view, lat, lon, &x, &y) != False; },
+                 [this](int x, int y, double &lat, double &lon) { return EcDrawXyToLatLon(view, x, y, &lat, &lon) != False; });
+  }
+
+  // Transformasi sama (mis. hanya generation yang naik): cache titik layar overlay tetap berlaku
+  if (!frameProjectorCaptured || !next.isValid() || !next.sameTransform(frameProjectorCache))
+    ++frameProjectionStamp;
+
+  frameProjectorCache = next;
+  frameProjectorKey = key;
+  frameProjectorCaptured = true;
+  return frameProjectorCache;
+}
+
+quint64 EcWidget::projectionStamp()
+{
+  frameProjector();
+  return frameProjectionStamp;
+}
+
+const EcWidget::ProjectedOverlay &EcWidget::projectOverlay(const QString &key, const QVector<double> &lat, const QVector<double> &lon)
+{
+  const quint64 stamp = projectionStamp();
+  if (stamp != projectedOverlaysStamp)
+  {
+    // View berubah: semua titik lama tidak berlaku (sekaligus membuang overlay yang sudah dihapus)
+    projectedOverlays.clear();
+    projectedOverlaysStamp = stamp;
+  }
+
+  const uint inputHash = qHashRange(lon.constBegin(), lon.constEnd(), qHashRange(lat.constBegin(), lat.constEnd()));
+  ProjectedOverlay &entry = projectedOverlays[key];
+  if (entry.stamp == stamp && entry.inputHash == inputHash && entry.points.size() == lat.size())
+    return entry;
+
+  const int count = qMin(lat.size(), lon.size());
+  entry.points.resize(count);
+  entry.ok.resize(count);
+  projectLatLon(lat.constData(), lon.constData(), count, entry.points.data(), entry.ok.data());
+  entry.stamp = stamp;
+  entry.inputHash = inputHash;
+  return entry;
+}
+
+void EcWidget::projectLatLon(const double *lat, const double *lon, int count, QPoint *out, bool *ok)
+{
+  const GeoProjector &projector = frameProjector();
+  if (!projector.isValid())
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      int x = 0, y = 0;
+      ok[i] = LatLonToXy(lat[i], lon[i], x, y);
+      out[i] = QPoint(x, y);
+    }
+    return;
+  }
+
+  QPointF buffer[GEO_PROJECTOR_CHUNK];
+  for (int begin = 0; begin < count; begin += GEO_PROJECTOR_CHUNK)
+  {
+    const int n = qMin(GEO_PROJECTOR_CHUNK, count - begin);
+    projector.project(lat + begin, lon + begin, n, buffer);
+    for (int i = 0; i < n; ++i)
+    {
+      ok[begin + i] = std::isfinite(buffer[i].x()) && std::isfinite(buffer[i].y());
+      out[begin + i] = ok[begin + i] ? buffer[i].toPoint() : QPoint();
+    }
+  }
+}
+
+void EcWidget::projectLatLon(const double *lat, const double *lon, int count, QPointF *out, bool *ok)
+{
+  const GeoProjector &projector = frameProjector();
+  if (!projector.isValid())
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      int x = 0, y = 0;
+      ok[i] = LatLonToXy(lat[i], lon[i], x, y);
+      out[i] = QPointF(x, y);
+    }
+    return;
+  }
+
+  projector.project(lat, lon, count, out);
+  for (int i = 0; i < count; ++i)
+  {
+    ok[i] = std::isfinite(out[i].x()) && std::isfinite(out[i].y());
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
 bool EcWidget::latLonToWidgetPoint(double lat, double lon, QPoint& out)
 {
   int x = 0, y = 0;
@@ -2189,6 +2337,7 @@ void EcWidget::drawWorks(bool upd)
   }
 
   EcDrawSetProjection(view, currentProjection, currentLat, currentLon, 0, 0);
+  invalidateFrameProjector();
 
   if (denc != NULL)
   {
@@ -2247,15 +2396,25 @@ void EcWidget::drawWorks(bool upd)
 }
 
 // AUV WORKS
-void EcWidget::draw(bool upd)
+void EcWidget::draw(bool upd, bool force)
 {
     static bool inDraw = false;
     if(inDraw) return;        // ❌ prevent reentrant crash
     if(!initialized) return;
 
-    inDraw = true;
+#ifdef _WIN32
+    // Chart base tidak berubah sejak render terakhir: kernel chart draw dilewati
+    const ChartLayerKey layerKey = currentChartLayerKey();
+    if(!force && chartLayerValid && layerKey == chartLayerKey &&
+       chartPixmap.cacheKey() == chartLayerPixmapKey)
+    {
+        drawPixmap = chartPixmap;
+        if(upd) update();
+        return;
+    }
+#endif
 
-    clearBackground();
+    inDraw = true;
 
     // Outline ship/target symbols
     if(currentScale < 10000)
@@ -2269,7 +2428,36 @@ void EcWidget::draw(bool upd)
         EcChartSetOutlinedTargetSymbol(view, False);
     }
 
-    EcDrawSetProjection(view, currentProjection, currentLat, currentLon, 0, 0);
+    // Pan/zoom/follow: chart base disusun dari tile cache kalau tile set masih berlaku
+    if(!force && drawChartFromTiles())
+    {
+        if(upd) update();
+
+        emit projection();
+        emit scale(currentScale);
+
+        inDraw = false;
+        return;
+    }
+
+    clearBackground();
+
+    // Selama tile set berlaku, proyeksi tetap di anchor-nya supaya chart dan tile bisa disambung.
+    // Draw paksa selalu membangun ulang tile set dengan anchor di tengah view (sama seperti dulu),
+    // dan menunda prefetch: Draw() paksa beruntun (playback, update sensor) membuang tile lagi.
+    if(force)
+        chartTileQuiet.restart();
+    if(force || !chartTileSetMatches())
+        resetChartTiles();
+    chartProjLat = chartTilesValid ? chartTileKey.lat : currentLat;
+    chartProjLon = chartTilesValid ? chartTileKey.lon : currentLon;
+    chartViewLat = currentLat;
+    chartViewLon = currentLon;
+    chartViewScale = currentScale;
+    chartViewInTileFrame = false;
+
+    EcDrawSetProjection(view, currentProjection, chartProjLat, chartProjLon, 0, 0);
+    invalidateFrameProjector();
 
     if(!denc) {
         QMessageBox::critical(this, tr("showAIS - Drawing"), tr("DENC structure could not be found"));
@@ -2316,9 +2504,16 @@ void EcWidget::draw(bool upd)
         drawSatelliteTilesToChart();
     }
 
+    chartLayerKey = layerKey;
+    chartLayerPixmapKey = chartPixmap.cacheKey();
+    chartLayerValid = true;
+
     drawPixmap = chartPixmap;
     SelectPalette(hdc, oldPal, false);
 
+    if(chartTilesValid)
+        noteChartInTileFrame();
+
 #else
     #if QT_VERSION > 0x040400
         if(!drawGC || !x11pixmap) { inDraw = false; return; }
@@ -2355,6 +2550,9 @@ void EcWidget::draw(bool upd)
 
     // drawPixmap = extendedPixmap;
 
+    // Pemanggil eksplisit tetap mendapat redraw penuh, termasuk route/waypoint
+    if(force) routeLayerValid = false;
+
     if(upd) update();
 
     emit projection();
@@ -2363,14 +2561,449 @@ void EcWidget::draw(bool upd)
     inDraw = false;
 }
 
+EcWidget::ChartLayerKey EcWidget::currentChartLayerKey() const
+{
+    ChartLayerKey key;
+    key.lat = currentLat;
+    key.lon = currentLon;
+    key.scale = currentScale;
+    key.heading = currentHeading;
+    key.projection = int(currentProjection);
+    key.size = chartPixmap.size();
+    key.grid = showGrid;
+    key.satellite = showSatelliteLayer && satelliteLayer && satelliteLayer->isEnabled();
+    key.colorScheme = currentColorScheme;
+    key.brightness = currentBrightness;
+    key.greyMode = currentGreyMode;
+    key.revision = chartLayerRevision;
+    return key;
+}
+
+// Semua input yang memengaruhi waypointDraw(): view, isi waypoint/route, visibilitas, seleksi dan warna
+uint EcWidget::routeLayerHash()
+{
+    uint h = qHash(waypointList.size());
+    h = qHash(currentLat, h);
+    h = qHash(currentLon, h);
+    h = qHash(currentScale, h);
+    h = qHash(currentHeading, h);
+    h = qHash(int(currentProjection), h);
+    h = qHash(drawPixmap.width(), h);
+    h = qHash(drawPixmap.height(), h);
+    h = qHash(selectedRouteId, h);
+
+    for (const Waypoint &wp : waypointList) {
+        h = qHash(wp.lat, h);
+        h = qHash(wp.lon, h);
+        h = qHash(wp.label, h);
+        h = qHash(wp.active, h);
+        h = qHash(wp.routeId, h);
+    }
+
+    h = qHash(getRouteColor(0).rgba(), h);
+    for (const Route &route : routeList) {
+        h = qHash(route.routeId, h);
+        h = qHash(route.name, h);
+        h = qHash(route.attachedToShip, h);
+        h = qHash(route.activeWaypointIndex, h);
+        h = qHash(route.showNmUnit, h);
+        h = qHash(route.showYardUnit, h);
+        h = qHash(route.showKmUnit, h);
+        h = qHash(route.showMilesUnit, h);
+        h = qHash(getRouteColor(route.routeId).rgba(), h);
+    }
+
+    for (auto it = routeVisibility.constBegin(); it != routeVisibility.constEnd(); ++it) {
+        h = qHash(it.key(), h);
+        h = qHash(it.value(), h);
+    }
+    return h;
+}
+
+// Route/waypoint dirender ke layer transparan lalu ditempel ke drawPixmap.
+// Layer dan label rect-nya dipakai ulang selama routeLayerHash() sama.
+void EcWidget::drawRouteLayer()
+{
+    const uint key = routeLayerHash();
+    if (!routeLayerValid || key != routeLayerKey || routeLayerPixmap.size() != drawPixmap.size()) {
+        QPixmap base = drawPixmap;
+        drawPixmap = QPixmap(base.size());
+        drawPixmap.fill(Qt::transparent);
+
+        waypointDraw();
+
+        routeLayerPixmap = drawPixmap;
+        routeLayerLabelRects = labelPlacer.occupied();
+        routeLayerWaypointLabelCount = sceneWaypointLabelCount;
+        routeLayerKey = key;
+        routeLayerValid = true;
+        drawPixmap = base;
+    } else {
+        labelPlacer.setOccupied(routeLayerLabelRects);
+        sceneLabelRects = routeLayerLabelRects;
+        sceneWaypointLabelCount = routeLayerWaypointLabelCount;
+    }
+
+    if (!waypointList.isEmpty()) {
+        QPainter p(&drawPixmap);
+        p.drawPixmap(0, 0, routeLayerPixmap);
+    }
+}
+
+// ========================================
+// CHART TILE CACHE (pan/zoom)
+// ========================================
+
+static int floorDiv(int a, int b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+bool EcWidget::chartTilesEnabled() const
+{
+#ifdef _WIN32
+    // Tile hanya berlaku untuk satu heading. Head-up/course-up memutar chart setiap fix,
+    // jadi tile yang dirender tidak akan pernah dipakai lagi.
+    if (orientation != NorthUp || (chartTilesValid && currentHeading != chartTileKey.heading))
+        return false;
+    // Tile satelit digambar per viewport di atas chart, jadi tidak ikut di-tile
+    return initialized && !(showSatelliteLayer && satelliteLayer && satelliteLayer->isEnabled());
+#else
+    // X11: AIS cell digambar ke x11pixmap chart, surface tidak bisa dipakai bergantian
+    return false;
+#endif
+}
+
+EcWidget::ChartLayerKey EcWidget::currentTileSetKey() const
+{
+    ChartLayerKey key = currentChartLayerKey();
+    key.lat = chartTileKey.lat;
+    key.lon = chartTileKey.lon;
+    key.scale = 0;
+    return key;
+}
+
+bool EcWidget::chartTileSetMatches() const
+{
+    return chartTilesValid && chartTilesEnabled() && currentTileSetKey() == chartTileKey;
+}
+
+void EcWidget::resetChartTiles()
+{
+    chartTiles.clear();
+    chartTileQueue.clear();
+    chartTilePrefetchTimer.stop();
+    chartViewInTileFrame = false;
+
+    chartTileKey = currentChartLayerKey();
+    chartTileKey.scale = 0;
+    chartTilesValid = chartTilesEnabled();
+}
+
+// Posisi kiri-atas viewport (center lat/lon pada skala scale) dalam frame tile.
+// Mengubah projection/viewport kernel; pemanggil harus menggambar atau restoreChartViewport().
+bool EcWidget::chartTileOrigin(int scale, EcCoordinate lat, EcCoordinate lon, QPoint &origin)
+{
+    const QSize tileSize = chartTileKey.size;
+    invalidateFrameProjector();
+    EcDrawSetProjection(view, currentProjection, chartTileKey.lat, chartTileKey.lon, 0, 0);
+    if (!EcDrawSetViewport(view, chartTileKey.lat, chartTileKey.lon, GetRange(scale), currentHeading))
+        return false;
+
+    int x = 0, y = 0;
+    if (!EcDrawLatLonToXy(view, lat, lon, &x, &y))
+        return false;
+
+    origin = QPoint(x - tileSize.width() / 2, y - tileSize.height() / 2);
+    return true;
+}
+
+bool EcWidget::renderChartTile(const ChartTileId &id)
+{
+#ifdef _WIN32
+    if (!hdc || !hBitmap || !denc) return false;
+    EcCatList *catList = EcDENCGetCatalogueList(denc);
+    if (!catList) return false;
+
+    const QSize tileSize = chartTileKey.size;
+    invalidateFrameProjector();
+    EcDrawSetProjection(view, currentProjection, chartTileKey.lat, chartTileKey.lon, 0, 0);
+    if (!EcDrawSetViewport(view, chartTileKey.lat, chartTileKey.lon, GetRange(id.scale), currentHeading))
+        return false;
+
+    EcCoordinate lat = 0, lon = 0;
+    if (!EcDrawXyToLatLon(view, tileSize.width() / 2 + id.x * tileSize.width(),
+                          tileSize.height() / 2 + id.y * tileSize.height(), &lat, &lon))
+        return false;
+
+    clearBackground();
+    HPALETTE oldPal = SelectPalette(hdc, hPalette, true);
+
+    const EcCellId aisCell = (_aisObj) ? _aisObj->getAISCell() : EC_NOCELLID;
+    if(aisCell != EC_NOCELLID)
+        EcChartUnAssignCellFromView(view, aisCell);
+
+    EcDrawNTDrawChart(view, hdc, NULL, dictInfo, catList, lat, lon, GetRange(id.scale), currentHeading);
+
+    if(aisCell != EC_NOCELLID)
+        EcChartAssignCellToView(view, aisCell);
+
+    if(showGrid)
+        EcDrawNTDrawGrid(view, hdc, tileSize.width(), tileSize.height(), 8, 8, True);
+
+    QPixmap *tile = new QPixmap(QtWin::fromHBITMAP(hBitmap));
+    SelectPalette(hdc, oldPal, false);
+
+    chartTiles.insert(id, tile, qMax(1, tile->width() * tile->height() * 4 / 1024));
+    return true;
+#else
+    Q_UNUSED(id);
+    return false;
+#endif
+}
+
+// Susun chartPixmap dari tile yang menutup viewport. Paling banyak satu tile yang belum ada
+// dirender di tempat; kalau lebih, satu kernel draw viewport lebih murah dan sisanya di-prefetch.
+bool EcWidget::drawChartFromTiles()
+{
+    if (!chartTileSetMatches())
+        return false;
+
+    const QSize tileSize = chartTileKey.size;
+    if (tileSize.isEmpty() || tileSize != chartPixmap.size())
+        return false;
+
+    QPoint origin;
+    if (!chartTileOrigin(currentScale, currentLat, currentLon, origin))
+        return false;
+
+    if (qAbs(origin.x()) > CHART_TILE_MAX_DRIFT * tileSize.width() ||
+        qAbs(origin.y()) > CHART_TILE_MAX_DRIFT * tileSize.height()) {
+        resetChartTiles();
+        return false;
+    }
+
+    const int x0 = floorDiv(origin.x(), tileSize.width());
+    const int x1 = floorDiv(origin.x() + tileSize.width() - 1, tileSize.width());
+    const int y0 = floorDiv(origin.y(), tileSize.height());
+    const int y1 = floorDiv(origin.y() + tileSize.height() - 1, tileSize.height());
+
+    QList<ChartTileId> missing;
+    for (int ty = y0; ty <= y1; ++ty) {
+        for (int tx = x0; tx <= x1; ++tx) {
+            const ChartTileId id = { currentScale, tx, ty };
+            if (!chartTiles.contains(id))
+                missing.append(id);
+        }
+    }
+    if (missing.size() > 1)
+        return false;
+    for (const ChartTileId &id : missing) {
+        if (!renderChartTile(id))
+            return false;
+    }
+
+    QPixmap composed(tileSize);
+    QPainter painter(&composed);
+    for (int ty = y0; ty <= y1; ++ty) {
+        for (int tx = x0; tx <= x1; ++tx) {
+            const QPixmap *tile = chartTiles.object({ currentScale, tx, ty });
+            if (!tile) {
+                painter.end();
+                return false;
+            }
+            painter.drawPixmap(tx * tileSize.width() - origin.x(), ty * tileSize.height() - origin.y(), *tile);
+        }
+    }
+    painter.end();
+
+    // Viewport kernel diletakkan tepat di piksel hasil susunan supaya LatLonToXy overlay cocok
+    EcCoordinate lat = currentLat, lon = currentLon;
+    chartTileOrigin(currentScale, currentLat, currentLon, origin);
+    EcDrawXyToLatLon(view, origin.x() + tileSize.width() / 2, origin.y() + tileSize.height() / 2, &lat, &lon);
+
+    chartProjLat = chartTileKey.lat;
+    chartProjLon = chartTileKey.lon;
+    chartViewLat = lat;
+    chartViewLon = lon;
+    chartViewScale = currentScale;
+    chartViewOrigin = origin;
+    chartViewInTileFrame = true;
+    restoreChartViewport();
+
+    chartPixmap = composed;
+    drawPixmap = chartPixmap;
+    chartLayerKey = currentChartLayerKey();
+    chartLayerPixmapKey = chartPixmap.cacheKey();
+    chartLayerValid = true;
+
+    scheduleChartTilePrefetch();
+    return true;
+}
+
+// Setelah kernel draw: catat posisi chartPixmap di frame tile dan simpan sebagai tile kalau sejajar grid
+void EcWidget::noteChartInTileFrame()
+{
+    QPoint origin;
+    if (chartTileOrigin(currentScale, currentLat, currentLon, origin)) {
+        const QSize tileSize = chartTileKey.size;
+        chartViewOrigin = origin;
+        chartViewInTileFrame = true;
+
+        if (chartPixmap.size() == tileSize &&
+            origin.x() % tileSize.width() == 0 && origin.y() % tileSize.height() == 0) {
+            const ChartTileId id = { currentScale, origin.x() / tileSize.width(), origin.y() / tileSize.height() };
+            chartTiles.insert(id, new QPixmap(chartPixmap), qMax(1, tileSize.width() * tileSize.height() * 4 / 1024));
+        }
+    }
+    restoreChartViewport();
+    scheduleChartTilePrefetch();
+}
+
+void EcWidget::restoreChartViewport()
+{
+    EcDrawSetProjection(view, currentProjection, chartProjLat, chartProjLon, 0, 0);
+    EcDrawSetViewport(view, chartViewLat, chartViewLon, GetRange(chartViewScale), currentHeading);
+    invalidateFrameProjector();
+}
+
+// Antrian prefetch: cincin tile di sekitar viewport, lalu viewport pada skala zoom in/out
+void EcWidget::scheduleChartTilePrefetch()
+{
+    chartTileQueue.clear();
+    if (!chartTileSetMatches())
+        return;
+
+    const QSize tileSize = chartTileKey.size;
+    const int scales[] = { currentScale, wheelScale(true), wheelScale(false) };
+    for (int i = 0; i < 3; ++i) {
+        const int scale = scales[i];
+        if (i > 0 && scale == currentScale)
+            continue;
+
+        QPoint origin;
+        if (!chartTileOrigin(scale, currentLat, currentLon, origin))
+            continue;
+
+        const int ring = (i == 0) ? 1 : 0;
+        const int x0 = floorDiv(origin.x(), tileSize.width()) - ring;
+        const int x1 = floorDiv(origin.x() + tileSize.width() - 1, tileSize.width()) + ring;
+        const int y0 = floorDiv(origin.y(), tileSize.height()) - ring;
+        const int y1 = floorDiv(origin.y() + tileSize.height() - 1, tileSize.height()) + ring;
+
+        QList<ChartTileId> level;
+        for (int ty = y0; ty <= y1; ++ty) {
+            for (int tx = x0; tx <= x1; ++tx) {
+                const ChartTileId id = { scale, tx, ty };
+                if (!chartTiles.contains(id))
+                    level.append(id);
+            }
+        }
+
+        // Yang paling dekat ke tengah viewport duluan
+        const QPointF center(origin.x() + tileSize.width() / 2.0, origin.y() + tileSize.height() / 2.0);
+        auto distance = [&](const ChartTileId &id) {
+            const QPointF tileCenter((id.x + 0.5) * tileSize.width(), (id.y + 0.5) * tileSize.height());
+            return QLineF(center, tileCenter).length();
+        };
+        std::sort(level.begin(), level.end(), [&](const ChartTileId &a, const ChartTileId &b) {
+            return distance(a) < distance(b);
+        });
+        chartTileQueue.append(level);
+    }
+    restoreChartViewport();
+
+    // View bergerak (follow, pan): tunggu sampai diam dulu
+    if (currentLat != chartTileQuietLat || currentLon != chartTileQuietLon || currentScale != chartTileQuietScale) {
+        chartTileQuietLat = currentLat;
+        chartTileQuietLon = currentLon;
+        chartTileQuietScale = currentScale;
+        chartTileQuiet.restart();
+    }
+
+    if (!chartTileQueue.isEmpty())
+        chartTilePrefetchTimer.start(chartTilePrefetchDelay());
+}
+
+int EcWidget::chartTilePrefetchDelay() const
+{
+    if (!chartTileQuiet.isValid())
+        return CHART_TILE_IDLE_MS;
+    return int(qMax<qint64>(CHART_TILE_IDLE_MS, CHART_TILE_QUIET_MS - chartTileQuiet.elapsed()));
+}
+
+void EcWidget::prefetchChartTile()
+{
+    if (shuttingDown || !initialized)
+        return;
+    if (!chartTileSetMatches()) {
+        chartTileQueue.clear();
+        return;
+    }
+    // Jangan ganggu interaksi atau Draw() paksa yang masih beruntun; coba lagi setelah view diam
+    if (isDragging || (chartTileQuiet.isValid() && chartTileQuiet.elapsed() < CHART_TILE_QUIET_MS)) {
+        chartTilePrefetchTimer.start(isDragging ? CHART_TILE_IDLE_MS : chartTilePrefetchDelay());
+        return;
+    }
+
+    while (!chartTileQueue.isEmpty()) {
+        const ChartTileId id = chartTileQueue.takeFirst();
+        if (chartTiles.contains(id))
+            continue;
+        renderChartTile(id);
+        restoreChartViewport();
+        break;
+    }
+
+    if (!chartTileQueue.isEmpty())
+        chartTilePrefetchTimer.start(CHART_TILE_IDLE_MS);
+}
+
+// Selama drag: area yang terbuka di luar drawPixmap diisi tile tetangga yang sudah ada
+void EcWidget::drawChartTilesBehind(QPainter &painter)
+{
+    if (!chartViewInTileFrame || !chartTileSetMatches() || chartViewScale != currentScale)
+        return;
+
+    const QSize tileSize = chartTileKey.size;
+    const int x0 = floorDiv(chartViewOrigin.x(), tileSize.width()) - 1;
+    const int y0 = floorDiv(chartViewOrigin.y(), tileSize.height()) - 1;
+    for (int ty = y0; ty <= y0 + 3; ++ty) {
+        for (int tx = x0; tx <= x0 + 3; ++tx) {
+            const QPixmap *tile = chartTiles.object({ chartViewScale, tx, ty });
+            if (tile)
+                painter.drawPixmap(tx * tileSize.width() - chartViewOrigin.x(),
+                                   ty * tileSize.height() - chartViewOrigin.y(), *tile);
+        }
+    }
+}
+
+int EcWidget::wheelScale(bool zoomIn) const
+{
+    const int scale = zoomIn ? int(GetScale() / 1.2) : int(GetScale() * 1.2);
+    return qBound(minScale, scale, maxScale);
+}
+
 
 /*---------------------------------------------------------------------------*/
 void EcWidget::Draw()
+{
+    drawScene(true);
+}
+
+void EcWidget::DrawFromTiles()
+{
+    drawScene(false);
+}
+
+void EcWidget::drawScene(bool forceChart)
 {
     // Clear label collision tracking at start of new draw
-    usedLabelRects.clear();
+    labelPlacer.clear();
+    sceneLabelRects.clear();
+    sceneWaypointLabelCount = 0;
 
-    draw(true);
+    draw(true, forceChart);
 
     // ROUTE FIX: Enhanced conditional drawAISCell() for route stability
     // Always call drawAISCell() if routes exist to ensure proper pixmap management
@@ -2473,7 +3106,7 @@ void EcWidget::waypointDraw(){
 
     // Clear label collision rects before drawing waypoints
     // This ensures fresh collision detection for current frame
-    usedLabelRects.clear();
+    labelPlacer.clear();
 
     // Get current range for adaptive rendering
     int currentScale = GetScale();
@@ -2496,8 +3129,29 @@ void EcWidget::waypointDraw(){
         drawRouteNamesOnly();
     } else {
         // Range < 123: Full details with waypoint labels
-        for (const Waypoint &wp : waypointList)
+        // Label ditempatkan dulu (placeAll: route terpilih, waypoint aktif, lalu sisanya), baru digambar
+        const bool showLabelsAtThisZoom = (currentRange < 50.0);
+        const QRect labelBounds = rect().adjusted(-50, -50, 50, 50);
+        QVector<LabelPlacer::Request> requests;
+        QVector<int> requestOf(waypointList.size(), -1);
+        for (int i = 0; showLabelsAtThisZoom && i < waypointList.size(); ++i) {
+            const Waypoint &wp = waypointList[i];
+            if (wp.label.isEmpty() || (wp.routeId > 0 && !isRouteVisible(wp.routeId))) {
+                continue;
+            }
+            int x = 0, y = 0;
+            if (!LatLonToXy(wp.lat, wp.lon, x, y) || !labelBounds.contains(x, y)) {
+                continue;
+            }
+            requestOf[i] = requests.size();
+            requests.append(waypointLabelRequest(wp, QPoint(x, y)));
+        }
+        const QVector<int> placed = labelPlacer.placeAll(requests);
+
+        for (int i = 0; i < waypointList.size(); ++i)
         {
+            const Waypoint &wp = waypointList[i];
+
             // Check visibility - skip hidden routes
             if (wp.routeId > 0 && !isRouteVisible(wp.routeId)) {
                 continue; // Skip waypoints from hidden routes
@@ -2511,11 +3165,16 @@ void EcWidget::waypointDraw(){
             }
 
             // Always show full details with labels when range < 123
-            drawWaypointWithLabel(wp.lat, wp.lon, wp.label, waypointColor);
+            const int request = requestOf[i];
+            drawWaypointWithLabel(wp.lat, wp.lon, wp.label, waypointColor,
+                                  request >= 0 ? requests[request].candidates.at(placed[request]) : QRect());
         }
     }
 
+    sceneWaypointLabelCount = labelPlacer.occupied().size();
     drawLeglineLabels();
+
+    sceneLabelRects = labelPlacer.occupied();
 }
 /*---------------------------------------------------------------------------*/
 
@@ -2525,6 +3184,9 @@ void EcWidget::paintEvent (QPaintEvent *e)
     if (!initialized) return;
     QPainter painter(this);
 
+    // Label overlay (POI, dll) dihitung ulang tiap paint di atas label yang sudah ada di drawPixmap
+    labelPlacer.setOccupied(sceneLabelRects);
+
     // Debug: Show current mode (only log occasionally to avoid spam)
     static int paintCount = 0;
     if (++paintCount % 100 == 1) {
@@ -2547,6 +3209,10 @@ void EcWidget::paintEvent (QPaintEvent *e)
         // geser seluruh painter, semua layer ikut
         painter.translate(centerOffset);
 
+        // area yang terbuka saat drag diisi tile chart tetangga
+        if (isDragging && !panUsesMargin)
+            drawChartTilesBehind(painter);
+
         // gambar chart pixmap di (0,0)
         // drawPixmap sudah berisi chart + satellite tiles (digambar di waypointDraw)
         painter.drawPixmap(0, 0, drawPixmap);
@@ -2569,15 +3235,6 @@ void EcWidget::paintEvent (QPaintEvent *e)
 
 
 
-  // FORCE CLEANUP: Run cleanup from paint event as fallback
-  static int paintCleanupCounter = 0;
-  if (++paintCleanupCounter % 100 == 0) { // Every ~100 paint events (less frequent)
-      qDebug() << "[PAINT-CLEANUP] Running obstacle cleanup from paintEvent";
-      if (!obstacleMarkers.isEmpty()) {
-          removeOutdatedObstacleMarkers();
-      }
-  }
-
   // Draw ghost waypoint saat move mode
   if (ghostWaypoint.visible) {
       drawGhostWaypoint(painter, ghostWaypoint.lat, ghostWaypoint.lon, ghostWaypoint.label);
@@ -2616,6 +3273,8 @@ void EcWidget::paintEvent (QPaintEvent *e)
       drawGribData(painter);
   }
 
+  // Draw historical tracks of DB playback under the other overlays
+  drawHistoricalTracks(painter);
   // Draw AOIs always on top of chart
   drawAOIs(painter);
   drawPois(painter);
@@ -2631,6 +3290,8 @@ void EcWidget::paintEvent (QPaintEvent *e)
   eblvrm.draw(this, painter);
   // Draw AI Target Tracker
   aiTargetTracker.draw(this, painter);
+  // Draw dead-reckoned AIS target positions
+  drawAisPrediction(painter);
   // Draw ship dot if enabled (debug/utility)
   drawShipDot(painter);
   // Draw AOI creation preview (including first-point ghost)
@@ -3322,12 +3983,21 @@ void EcWidget::drawAOIs(QPainter& painter)
         lat0_for_proj /= a.vertices.size(); lon0_for_proj /= a.vertices.size();
         double lat0rad_for_proj = lat0_for_proj * M_PI / 180.0;
         const double k_nm = 60.0;
-        for (int vi = 0; vi < a.vertices.size(); ++vi) {
+        // Semua vertex diproyeksikan sekaligus
+        const int vcount = a.vertices.size();
+        QVector<double> vlat(vcount), vlon(vcount);
+        for (int vi = 0; vi < vcount; ++vi) {
+            vlat[vi] = a.vertices[vi].x();
+            vlon[vi] = a.vertices[vi].y();
+        }
+        const ProjectedOverlay &projected = projectOverlay(QString("aoi:%1").arg(a.id), vlat, vlon);
+        const QVector<QPoint> &vxy = projected.points;
+        const QVector<bool> &vok = projected.ok;
+        for (int vi = 0; vi < vcount; ++vi) {
             const QPointF& ll = a.vertices[vi];
             if (!qIsFinite(ll.x()) || !qIsFinite(ll.y())) continue;
-            int x=0, y=0;
-            if (LatLonToXy(ll.x(), ll.y(), x, y)) {
-                pts.append(QPoint(x, y));
+            if (vok[vi]) {
+                pts.append(vxy[vi]);
                 double xnm = (ll.y() - lon0_for_proj) * k_nm * std::cos(lat0rad_for_proj);
                 double ynm = (ll.x() - lat0_for_proj) * k_nm;
                 ptsXYFiltered.append(QPointF(xnm, ynm));
@@ -3653,6 +4323,50 @@ bool EcWidget::focusPoi(int poiId)
     return true;
 }
 
+// Kandidat label marker (waypoint/POI), urutan preferensi: kanan (posisi lama), kiri, atas, bawah, diagonal kanan
+static QVector<QRect> markerLabelCandidates(const QPoint& anchor, int radius, const QSize& size)
+{
+    const int x = anchor.x(), y = anchor.y();
+    const int w = size.width(), h = size.height();
+    return {
+        QRect(x + radius + 10, y - h / 2, w, h),
+        QRect(x - radius - 10 - w, y - h / 2, w, h),
+        QRect(x - w / 2, y - radius - 6 - h, w, h),
+        QRect(x - w / 2, y + radius + 6, w, h),
+        QRect(x + radius + 4, y - radius - 4 - h, w, h),
+        QRect(x + radius + 4, y + radius + 4, w, h)
+    };
+}
+
+// Waypoint tanpa feature SevenCs dikenali dari route, label dan posisinya
+QString EcWidget::waypointLabelKey(const Waypoint& wp) const
+{
+    if (wp.isValid()) {
+        return QString("wp:%1:%2:%3").arg(wp.routeId).arg(wp.featureHandle.id).arg(wp.featureHandle.offset);
+    }
+    return QString("wp:%1:%2:%3:%4").arg(wp.routeId).arg(wp.label)
+            .arg(wp.lat, 0, 'f', 7).arg(wp.lon, 0, 'f', 7);
+}
+
+LabelPlacer::Request EcWidget::waypointLabelRequest(const Waypoint& wp, const QPoint& anchor) const
+{
+    // Font dan padding sama dengan drawWaypointWithLabel()
+    const QFontMetrics fm(QFont("Arial", 9, QFont::Bold));
+    const int radius = 8; // Waypoint radius
+    const QRect textRect = fm.boundingRect(wp.label).adjusted(-8, -4, 8, 4);
+
+    LabelPlacer::Request request;
+    request.key = waypointLabelKey(wp);
+    request.anchor = anchor;
+    request.candidates = markerLabelCandidates(anchor, radius, textRect.size());
+    if (selectedRouteId > 0 && wp.routeId == selectedRouteId) {
+        request.priority = 0;
+    } else {
+        request.priority = wp.active ? 1 : 2;
+    }
+    return request;
+}
+
 void EcWidget::drawPois(QPainter& painter)
 {
     if (poiList.isEmpty()) {
@@ -3692,16 +4406,34 @@ void EcWidget::drawPois(QPainter& painter)
     QFont labelFont = painter.font();
     QFontMetrics fm(labelFont);
 
-    for (const auto& poi : poiList) {
+    const int poiCount = poiList.size();
+    QVector<double> poiLat(poiCount), poiLon(poiCount);
+    for (int i = 0; i < poiCount; ++i) {
+        poiLat[i] = poiList[i].latitude;
+        poiLon[i] = poiList[i].longitude;
+    }
+    const ProjectedOverlay &projected = projectOverlay(QStringLiteral("poi"), poiLat, poiLon);
+    const QVector<QPoint> &poiXy = projected.points;
+    const QVector<bool> &poiOk = projected.ok;
+
+    // Check zoom level for label visibility
+    int currentScale = GetScale();
+    double currentRange = GetRange(currentScale);
+    bool showLabelsAtThisZoom = (currentRange < 50.0); // Hide labels when zoomed out beyond 50 NM
+
+    // Marker digambar dulu sambil mengumpulkan label; POI yang di-highlight ditempatkan lebih dulu
+    QVector<LabelPlacer::Request> requests;
+    QStringList labelTexts;
+
+    for (int poiIndex = 0; poiIndex < poiCount; ++poiIndex) {
+        const auto& poi = poiList[poiIndex];
         if (!std::isfinite(poi.latitude) || !std::isfinite(poi.longitude)) {
             continue;
         }
-        int x = 0;
-        int y = 0;
-        if (!LatLonToXy(poi.latitude, poi.longitude, x, y)) {
+        if (!poiOk[poiIndex]) {
             continue;
         }
-        const QPoint screenPoint(x, y);
+        const QPoint screenPoint = poiXy[poiIndex];
         if (!viewport.contains(screenPoint)) {
             continue;
         }
@@ -3724,11 +4456,6 @@ void EcWidget::drawPois(QPainter& painter)
         // Enhanced POI visualization using EC2007 kernel
         drawEnhancedPOI(painter, poi, screenPoint);
 
-        // Check zoom level for label visibility
-        int currentScale = GetScale();
-        double currentRange = GetRange(currentScale);
-        bool showLabelsAtThisZoom = (currentRange < 50.0); // Hide labels when zoomed out beyond 50 NM
-
         if (showPoiLabels && poi.showLabel && showLabelsAtThisZoom) {
             const QString labelText = poi.label.isEmpty()
                     ? tr("Point Object %1").arg(poi.id)
@@ -3736,19 +4463,30 @@ void EcWidget::drawPois(QPainter& painter)
 
             QRect textRect = fm.boundingRect(labelText);
             textRect.adjust(-8, -4, 8, 4);
-            textRect.moveLeft(screenPoint.x() + radius + 10);
-            textRect.moveTop(screenPoint.y() - textRect.height() / 2);
-
-            QColor labelBg = QColor(20, 20, 20, active ? 170 : 110);
-            painter.setPen(Qt::NoPen);
-            painter.setBrush(labelBg);
-            painter.drawRoundedRect(textRect, 4, 4);
 
-            painter.setPen(Qt::white);
-            painter.drawText(textRect, Qt::AlignCenter, labelText);
+            LabelPlacer::Request request;
+            request.key = QString("poi:%1").arg(poi.id);
+            request.anchor = screenPoint;
+            request.candidates = markerLabelCandidates(screenPoint, radius, textRect.size());
+            request.priority = highlighted ? 0 : 1;
+            requests.append(request);
+            labelTexts.append(labelText);
         }
     }
 
+    const QVector<int> placed = labelPlacer.placeAll(requests);
+    for (int i = 0; i < requests.size(); ++i) {
+        const QRect textRect = requests[i].candidates.at(placed[i]);
+
+        QColor labelBg = QColor(20, 20, 20, 170);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(labelBg);
+        painter.drawRoundedRect(textRect, 4, 4);
+
+        painter.setPen(Qt::white);
+        painter.drawText(textRect, Qt::AlignCenter, labelTexts[i]);
+    }
+
     painter.restore();
 }
 
@@ -3767,8 +4505,11 @@ void EcWidget::drawWaypointsOverlay(QPainter& painter)
         viewport.translate(-t.x(), -t.y());
     }
 
-    // Clear label collision tracking for overlay to ensure clean label positioning
-    usedLabelRects.clear();
+    // Label waypoint di drawPixmap digambar ulang di sini, jadi tidak ikut dihindari
+    // (nanti bertabrakan dengan salinannya sendiri). Label leg dari drawPixmap dan label
+    // overlay paint ini (POI, dll) tetap ditempati.
+    labelPlacer.setOccupied(sceneLabelRects.mid(sceneWaypointLabelCount)
+                            + labelPlacer.occupied().mid(sceneLabelRects.size()));
 
     // Decide label density based on range (mirror logic from waypointDraw)
     int currentScale = GetScale();
@@ -3781,7 +4522,12 @@ void EcWidget::drawWaypointsOverlay(QPainter& painter)
     QFont labelFont("Arial", 9, QFont::Bold);
     painter.setFont(labelFont);
 
-    for (const Waypoint &wp : waypointList) {
+    // Marker digambar dulu, label dikumpulkan lalu ditempatkan sekaligus (urutan sama dengan waypointDraw)
+    QVector<LabelPlacer::Request> requests;
+    QStringList labelTexts;
+
+    for (int wpIndex = 0; wpIndex < waypointList.size(); ++wpIndex) {
+        const Waypoint &wp = waypointList[wpIndex];
         if (wp.routeId > 0 && !isRouteVisible(wp.routeId)) continue;
         int x=0, y=0; if (!LatLonToXy(wp.lat, wp.lon, x, y)) continue;
         if (!viewport.contains(x, y)) continue;
@@ -3790,27 +4536,26 @@ void EcWidget::drawWaypointsOverlay(QPainter& painter)
         QPen pen(waypointColor); pen.setWidth(2); painter.setPen(pen); painter.setBrush(Qt::NoBrush);
         painter.drawEllipse(QPoint(x,y), 8, 8);
 
-        // Draw label with POI-style positioning during drag
         if (!showRouteNamesOnly && showLabelsAtThisZoom && !wp.label.isEmpty()) {
-            // Use POI-style label positioning (always to the right)
-            QFontMetrics fm(labelFont);
-            const int radius = 8; // Waypoint radius
+            requests.append(waypointLabelRequest(wp, QPoint(x, y)));
+            labelTexts.append(wp.label);
+        }
+    }
 
-            QRect textRect = fm.boundingRect(wp.label);
-            textRect.adjust(-8, -4, 8, 4);
-            textRect.moveLeft(x + radius + 10);  // Same positioning as POI
-            textRect.moveTop(y - textRect.height() / 2);
+    // Draw label with POI-style positioning during drag
+    const QVector<int> placed = labelPlacer.placeAll(requests);
+    for (int i = 0; i < requests.size(); ++i) {
+        const QRect textRect = requests[i].candidates.at(placed[i]);
 
-            // POI-style background (dark, no border)
-            QColor labelBg = QColor(20, 20, 20, 110);  // Same transparency as inactive POI
-            painter.setPen(Qt::NoPen);
-            painter.setBrush(labelBg);
-            painter.drawRoundedRect(textRect, 4, 4);  // Same radius as POI
+        // POI-style background (dark, no border)
+        QColor labelBg = QColor(20, 20, 20, 110);  // Same transparency as inactive POI
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(labelBg);
+        painter.drawRoundedRect(textRect, 4, 4);  // Same radius as POI
 
-            // White text
-            painter.setPen(Qt::white);
-            painter.drawText(textRect, Qt::AlignCenter, wp.label);
-        }
+        // White text
+        painter.setPen(Qt::white);
+        painter.drawText(textRect, Qt::AlignCenter, labelTexts[i]);
     }
 
     painter.restore();
@@ -4379,51 +5124,111 @@ void EcWidget::showAoiToolbox(const QPoint& pos, int aoiId, int vertexIndex){
 
 void EcWidget::drawOwnShipTrail(QPainter &painter)
 {
-    if (ownShipTrailPoints.size() < 2)
+    if (ownShipTrail.size() < 2)
         return;
 
-    for (int i = 1; i < ownShipTrailPoints.size(); ++i)
+    // Setengah piksel layar: penyederhanaan tidak terlihat pada skala ini
+    int level = 0;
+    const double tolerance = TrackSimplifier::metersPerPixel(currentScale) * 0.5;
+    const quint64 stamp = projectionStamp();
+    const quint64 revision = ownShipTrail.revision();
+    if (stamp != ownShipTrailStamp || revision != ownShipTrailRevision ||
+        TrackSimplifier::toleranceLevel(tolerance) != ownShipTrailLevel || ownShipTrailPolygons.isEmpty())
     {
-        const QPair<QString, QString> &prev = ownShipTrailPoints[i - 1];
-        const QPair<QString, QString> &curr = ownShipTrailPoints[i];
-
-        bool ok1a = false, ok1b = false, ok2a = false, ok2b = false;
-        double lat1 = prev.first.toDouble(&ok1a);
-        double lon1 = prev.second.toDouble(&ok1b);
-        double lat2 = curr.first.toDouble(&ok2a);
-        double lon2 = curr.second.toDouble(&ok2b);
+        // Chunk di luar layar (diperluas satu layar ke tiap sisi) tidak disederhanakan
+        // maupun diproyeksikan; zoom-in pada ekor panjang hanya memproses bagian yang terlihat
+        const QSize screen = drawPixmap.size();
+        const QRect area(-screen.width(), -screen.height(), 3 * screen.width(), 3 * screen.height());
+        QRectF bounds;
+        QVector<QVector<TrackPoint>> runs;
+        if (viewGeoBounds(area, bounds))
+            runs = ownShipTrail.decimatedRuns(tolerance, bounds, &level);
+        else
+            runs.append(ownShipTrail.decimated(tolerance, &level));
 
-        if (!(ok1a && ok1b && ok2a && ok2b))
+        ownShipTrailPolygons.clear();
+        for (const QVector<TrackPoint> &points : runs)
         {
-            qDebug() << "Invalid conversion to double at index" << i;
-            continue;
-        }
+            const int count = points.size();
+            QVector<double> lat(count), lon(count);
+            for (int i = 0; i < count; ++i)
+            {
+                lat[i] = points[i].lat;
+                lon[i] = points[i].lon;
+            }
 
-        if (!qIsFinite(lat1) || !qIsFinite(lon1) || !qIsFinite(lat2) || !qIsFinite(lon2))
-        {
-            qDebug() << "Non-finite coordinate at index" << i;
-            continue;
+            QVector<QPointF> xy(count);
+            QVector<bool> ok(count);
+            projectLatLon(lat.constData(), lon.constData(), count, xy.data(), ok.data());
+
+            QPolygonF polygon;
+            polygon.reserve(count);
+            for (int i = 0; i < count; ++i)
+            {
+                if (ok[i])
+                    polygon.append(xy[i]);
+            }
+            if (polygon.size() >= 2)
+                ownShipTrailPolygons.append(polygon);
         }
 
-        int x1 = 0, y1 = 0, x2 = 0, y2 = 0;
-        bool ok1 = LatLonToXy(lat1, lon1, x1, y1);
-        bool ok2 = LatLonToXy(lat2, lon2, x2, y2);
+        ownShipTrailStamp = stamp;
+        ownShipTrailRevision = revision;
+        ownShipTrailLevel = level;
+    }
 
-        if (!ok1 || !ok2)
-        {
-            qDebug() << "LatLonToXy failed at index" << i;
-            continue;
-        }
+    if (ownShipTrailPolygons.isEmpty())
+        return;
 
-        double dist = haversine(lat1, lon1, lat2, lon2);
+    QPen pen(QColor(0, 150, 0), 4);
+    pen.setCapStyle(Qt::RoundCap);
+    pen.setJoinStyle(Qt::RoundJoin);
+
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setPen(pen);
+    painter.setBrush(Qt::NoBrush);
+    for (const QPolygonF &polygon : ownShipTrailPolygons)
+        painter.drawPolyline(polygon);
+    painter.restore();
+}
+
+bool EcWidget::viewGeoBounds(const QRect &area, QRectF &bounds)
+{
+    // Tepi area dicek di beberapa titik: pada proyeksi non-silinder tepi layar tidak lurus di lat/lon
+    const int steps = 4;
+    double minLat = 90, maxLat = -90, minLon = 180, maxLon = -180;
+    for (int j = 0; j <= steps; ++j)
+    {
+        for (int i = 0; i <= steps; ++i)
+        {
+            if (i != 0 && i != steps && j != 0 && j != steps)
+                continue;
 
-        // if (dist > 100.0)
-        //     painter.setPen(QPen(Qt::gray, 4));
-        // else
-        painter.setPen(QPen(QColor(0, 150, 0), 4));
+            EcCoordinate lat = 0, lon = 0;
+            const int x = area.left() + area.width() * i / steps;
+            const int y = area.top() + area.height() * j / steps;
+            if (!XyToLatLon(x, y, lat, lon) || !qIsFinite(lat) || !qIsFinite(lon))
+                return false;
+            minLat = qMin(minLat, double(lat));
+            maxLat = qMax(maxLat, double(lat));
+            minLon = qMin(minLon, double(lon));
+            maxLon = qMax(maxLon, double(lon));
+        }
+    }
 
-        painter.drawLine(x1, y1, x2, y2);
+    // Area melewati antimeridian atau memuat kutub: bujur tidak monoton, jangan pangkas
+    if (maxLon - minLon > 180.0)
+        return false;
+    for (const double pole : { 90.0, -90.0 })
+    {
+        int px = 0, py = 0;
+        if (LatLonToXy(pole, currentLon, px, py) && area.contains(px, py))
+            return false;
     }
+
+    bounds = QRectF(minLon, minLat, maxLon - minLon, maxLat - minLat);
+    return true;
 }
 
 
@@ -4444,10 +5249,117 @@ double EcWidget::haversine(double lat1, double lon1, double lat2, double lon2)
 
 void EcWidget::clearOwnShipTrail()
 {
-    ownShipTrailPoints.clear();
+    ownShipTrail.clear();
+    ownShipTrailPolygons.clear();
+    update();
+}
+
+void EcWidget::showHistoricalTracks(const QList<quint32> &mmsis, const QDateTime &from, const QDateTime &to)
+{
+    historicalTrackMmsis = mmsis;
+    historicalTrackFrom = from;
+    historicalTrackTo = to;
+    historicalTracks.clear();
+    historicalTrackPolygons.clear();
+    historicalTrackLevel = -1;
+    loadHistoricalTracks();
+}
+
+void EcWidget::clearHistoricalTracks()
+{
+    historicalTrackMmsis.clear();
+    historicalTracks.clear();
+    historicalTrackPolygons.clear();
+    historicalTrackLevel = -1;
     update();
 }
 
+void EcWidget::loadHistoricalTracks()
+{
+    historicalTrackLoadPending = false;
+    if (historicalTrackMmsis.isEmpty())
+        return;
+
+    // Satu piksel layar; level yang sudah pernah dimuat diambil dari cache AisDatabaseManager
+    const double tolerance = AisDatabaseManager::trackToleranceForScale(currentScale);
+    const int level = TrackSimplifier::toleranceLevel(tolerance);
+    if (level == historicalTrackLevel)
+        return;
+
+    const QList<AisDatabaseManager::VesselTrack> tracks = AisDatabaseManager::instance().getSimplifiedTracks(
+        historicalTrackMmsis, historicalTrackFrom, historicalTrackTo, tolerance);
+
+    historicalTracks.clear();
+    historicalTracks.reserve(tracks.size());
+    for (const AisDatabaseManager::VesselTrack &track : tracks) {
+        if (track.points.size() >= 2)
+            historicalTracks.append(track.points);
+    }
+    historicalTrackLevel = level;
+    historicalTrackPolygons.clear();
+    update();
+}
+
+void EcWidget::drawHistoricalTracks(QPainter &painter)
+{
+    if (historicalTrackMmsis.isEmpty())
+        return;
+
+    // Skala berubah: muat level baru di luar paint, sementara itu level lama tetap digambar
+    const int level = TrackSimplifier::toleranceLevel(AisDatabaseManager::trackToleranceForScale(currentScale));
+    if (level != historicalTrackLevel && !historicalTrackLoadPending) {
+        historicalTrackLoadPending = true;
+        QTimer::singleShot(0, this, &EcWidget::loadHistoricalTracks);
+    }
+    if (historicalTracks.isEmpty())
+        return;
+
+    const quint64 stamp = projectionStamp();
+    if (stamp != historicalTrackStamp || historicalTrackPolygons.size() != historicalTracks.size())
+    {
+        historicalTrackPolygons.resize(historicalTracks.size());
+        for (int t = 0; t < historicalTracks.size(); ++t)
+        {
+            const QVector<TrackPoint> &points = historicalTracks[t];
+            const int count = points.size();
+            QVector<double> lat(count), lon(count);
+            for (int i = 0; i < count; ++i)
+            {
+                lat[i] = points[i].lat;
+                lon[i] = points[i].lon;
+            }
+
+            QVector<QPointF> xy(count);
+            QVector<bool> ok(count);
+            projectLatLon(lat.constData(), lon.constData(), count, xy.data(), ok.data());
+
+            QPolygonF &polygon = historicalTrackPolygons[t];
+            polygon.clear();
+            polygon.reserve(count);
+            for (int i = 0; i < count; ++i)
+            {
+                if (ok[i])
+                    polygon.append(xy[i]);
+            }
+        }
+        historicalTrackStamp = stamp;
+    }
+
+    QPen pen(QColor(90, 90, 160, 180), 1.5);
+    pen.setJoinStyle(Qt::RoundJoin);
+
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setPen(pen);
+    painter.setBrush(Qt::NoBrush);
+    for (const QPolygonF &polygon : historicalTrackPolygons)
+    {
+        if (polygon.size() >= 2)
+            painter.drawPolyline(polygon);
+    }
+    painter.restore();
+}
+
 void EcWidget::clearAisTargets()
 {
     if (_aisObj) {
@@ -5475,8 +6387,12 @@ void EcWidget::waypointLeftClick(QMouseEvent *e){
 
                     setCursor(Qt::OpenHandCursor);
 
-                    QResizeEvent ev(size(), size());  // oldSize = newSize
-                    this->resizeEvent(&ev);
+                    // Tanpa tile cache, buffer chart diperbesar PAN_MARGIN selama drag
+                    panUsesMargin = !chartTileSetMatches();
+                    if (panUsesMargin) {
+                        QResizeEvent ev(size(), size());  // oldSize = newSize
+                        this->resizeEvent(&ev);
+                    }
                 }
                 else {
                     // ======== STABLE ========= //
@@ -5793,8 +6709,11 @@ void EcWidget::mouseReleaseEvent(QMouseEvent *e)
 
     if (e->button() == Qt::LeftButton && isDragging && dragMode) {
         isDragging = false;
-        QResizeEvent ev(size(), size());
-        this->resizeEvent(&ev);
+        if (panUsesMargin) {
+            QResizeEvent ev(size(), size());
+            this->resizeEvent(&ev);
+            panUsesMargin = false;
+        }
 
         QPoint releasePos = e->pos();
 
@@ -5805,7 +6724,7 @@ void EcWidget::mouseReleaseEvent(QMouseEvent *e)
             unsetCursor();
             maxZoomDragActive = false;
             maxZoomTriedUpDrag = false;
-            Draw();
+            DrawFromTiles();
             QWidget::mouseReleaseEvent(e);
             return;
         }
@@ -5841,7 +6760,7 @@ void EcWidget::mouseReleaseEvent(QMouseEvent *e)
         tempOffset = QPoint();  // reset drag offset
         unsetCursor();
 
-        Draw();             // redraw chart penuh (termasuk waypointDraw yang menggambar tiles)
+        DrawFromTiles();    // chart dari tile cache, hanya tile yang belum ada dirender
     }
 
     // Handle tidal station clicks
@@ -5863,15 +6782,15 @@ void EcWidget::wheelEvent  (QWheelEvent *e)
   if (shuttingDown || view == nullptr) { e->accept(); return; }
   if (e->delta() > 0)
   {
-    SetScale(GetScale()/1.2);
+    SetScale(wheelScale(true));
     //draw(true);
-    Draw();
+    DrawFromTiles();
   }
   else if (e->delta() < 0)
   {
-    SetScale(GetScale()*1.2);
+    SetScale(wheelScale(false));
     //draw(true);
-    Draw();
+    DrawFromTiles();
   }
   e->accept();
 }
@@ -6249,6 +7168,7 @@ bool EcWidget::drawUdo(void)
 {
     // projection
     EcDrawSetProjection(view, EC_GEO_PROJECTION_MERCATOR, wplat, wplon, 0, 0);
+    invalidateFrameProjector();
 
     // symbolize udo cell
     if (!EcChartSymbolizeCell(view,udoCid))
@@ -6332,6 +7252,11 @@ void EcWidget::InitAIS( EcDictInfo *dict)
     ownShip.sog, ownShip.cog, dWarnDist, dWarnCPA,
     iWarnTCPA, strAisLib, iTimeOut, bInternalGPS, &bAISSymbolize, strErrLogAis );
 
+  // Target digerakkan per frame di antara laporan AIS (tanpa panggilan kernel per frame)
+  aisPredictTimer.setInterval(AIS_UI_FRAME_MS);
+  connect(&aisPredictTimer, &QTimer::timeout, this, &EcWidget::updateAisPrediction, Qt::UniqueConnection);
+  aisPredictTimer.start();
+
   // QObject::connect( _aisObj, SIGNAL( signalRefreshChartDisplay( double, double, double ) ), this, SLOT( slotRefreshChartDisplay( double, double, double ) ) );
   // QObject::connect( _aisObj, SIGNAL( signalRefreshCenter( double, double ) ), this, SLOT( slotRefreshCenter( double, double ) ) );
 }
@@ -6410,10 +7335,13 @@ void EcWidget::ReadAISLogfileWDelay( const QString &aisLogFile)
     //deleteAISCell();
     //createAISCell();
 
-    stopFlag = false;
-
     _aisObj->setAISCell( aisCellId );
-    _aisObj->readAISLogfileWDelay(aisLogFile, 300, &stopFlag);
+
+    // Diputar mengikuti timestamp log, tidak memblok thread GUI
+    AisLogReplay *replay = _aisObj->logReplay();
+    if (replay->open(aisLogFile)) {
+        replay->play();
+    }
 }
 
 // Read an AIS from MOOSDB -- NAV INFO
@@ -6473,120 +7401,17 @@ void EcWidget::startAISConnection()
         subscriber->connectToHost(sshIP, sshPort);
     });
 
-    // OWNSHIP
-    connect(subscriber, &AISSubscriber::navLatReceived, this, [=](double lat) {
-        navShip.lat = lat;
-
-        // QString slat = latLonToDegMin(lat, true);
-        // navShip.slat = slat;
-        updateAttachedGuardZoneFromNavShip();
-
-        // Update AI Target Tracker
-        if (aiTargetTracker.trackingEnabled && !qIsNaN(navShip.lat) && !qIsNaN(navShip.lon)) {
-            aiTargetTracker.updateOwnShipPosition(navShip.lat, navShip.lon, navShip.heading, navShip.sog);
-            update(); // Trigger redraw to show updated target line
-        }
-
-        if (!showCustomOwnShip && navShip.lat != 0.0 && navShip.lon != 0.0) {
-            showCustomOwnShip = true;
-        }
-        if (shipDotEnabled) update();
-    });
-    connect(subscriber, &AISSubscriber::navLongReceived, this, [=](double lon) {
-        navShip.lon = lon;
-
-        // QString slon = latLonToDegMin(lon, false);
-        // navShip.slon = slon;
-        updateAttachedGuardZoneFromNavShip();
-
-        // Update AI Target Tracker
-        if (aiTargetTracker.trackingEnabled && !qIsNaN(navShip.lat) && !qIsNaN(navShip.lon)) {
-            aiTargetTracker.updateOwnShipPosition(navShip.lat, navShip.lon, navShip.heading, navShip.sog);
-            update(); // Trigger redraw to show updated target line
-        }
-
-        if (!showCustomOwnShip && navShip.lat != 0.0 && navShip.lon != 0.0) {
-            showCustomOwnShip = true;
-        }
-        if (shipDotEnabled) update();
-    });
-
-
-    connect(subscriber, &AISSubscriber::navDepthReceived, this, [=](double depth) { navShip.depth = depth;});
-
-    connect(subscriber, &AISSubscriber::navHeadingReceived, this, [=](double hdg) {
-        navShip.heading = hdg;
-        if (mainWindow && orientation == NorthUp){
-            mainWindow->setCompassHeading(hdg);
-        }
-        updateAttachedGuardZoneFromNavShip();
-
-        // Update AI Target Tracker
-        if (aiTargetTracker.trackingEnabled && !qIsNaN(navShip.lat) && !qIsNaN(navShip.lon)) {
-            aiTargetTracker.updateOwnShipPosition(navShip.lat, navShip.lon, navShip.heading, navShip.sog);
-            update(); // Trigger redraw to show updated target line
-        }
-    });
-
-    connect(subscriber, &AISSubscriber::navHeadingOGReceived, this, [=](double hog) { navShip.heading_og = hog;});
-
-    connect(subscriber, &AISSubscriber::navCourseOGReceived, this, [=](double cog) {
-        navShip.course_og = cog;
-    });
-
-    // connect(subscriber, &AISSubscriber::navSOGReceived, this, [=](double sog) {
-    //     navShip.sog = sog;
-    //     // QDateTime now = QDateTime::currentDateTime();
-    //     // speedBuffer.append(qMakePair(now, sog));
-    // });
-
-    connect(subscriber, &AISSubscriber::navLatDmsReceived, this, [=](const QString &v) { navShip.lat_dms = v;});
-    connect(subscriber, &AISSubscriber::navLongDmsReceived, this, [=](const QString &v) { navShip.lon_dms = v;});
-
-    connect(subscriber, &AISSubscriber::navLatDmmReceived, this, [=](const QString &v) { navShip.lat_dmm = v;});
-    connect(subscriber, &AISSubscriber::navLongDmmReceived, this, [=](const QString &v) { navShip.lon_dmm = v;});
-    connect(subscriber, &AISSubscriber::navNameReceived, this, [=](const QString &v) {
-        navShip.name = v;
-    });
+    // OWNSHIP, ROUTE, AIS, NODE REPORTS
+    // Semua lewat navQueue (SPSC), bukan queued signal per field
+    subscriber->setRecordQueue(&navQueue);
 
-    connect(subscriber, &AISSubscriber::navSpeedOGReceived, this, [=](double speed_og) {
-        navShip.speed_og = speed_og;
-        // Update AI Target Tracker
-        if (aiTargetTracker.trackingEnabled && !qIsNaN(navShip.lat) && !qIsNaN(navShip.lon)) {
-            aiTargetTracker.updateOwnShipPosition(navShip.lat, navShip.lon, navShip.heading, navShip.sog);
-            update(); // Trigger redraw to show updated target line
-        }
-    });
-    connect(subscriber, &AISSubscriber::navSOGReceived, this, [=](double sog) {
-        navShip.sog = sog;
-        // Update AI Target Tracker
-        if (aiTargetTracker.trackingEnabled && !qIsNaN(navShip.lat) && !qIsNaN(navShip.lon)) {
-            aiTargetTracker.updateOwnShipPosition(navShip.lat, navShip.lon, navShip.heading, navShip.sog);
-            update(); // Trigger redraw to show updated target line
-        }
-    });
-    connect(subscriber, &AISSubscriber::navSpeedReceived, this, [=](double spe) { navShip.speed = spe;});
-    connect(subscriber, &AISSubscriber::navYawReceived, this, [=](double yaw) { navShip.yaw = yaw;});
-    connect(subscriber, &AISSubscriber::navZReceived, this, [=](double z) { navShip.z = z;});
-    connect(subscriber, &AISSubscriber::navStwReceived, this, [=](double stw) { navShip.stw = stw;});
-    connect(subscriber, &AISSubscriber::navDraftReceived, this, [=](double draft) { navShip.draft = draft;});
-    connect(subscriber, &AISSubscriber::navDriftReceived, this, [=](double drift) { navShip.drift = drift;});
-    connect(subscriber, &AISSubscriber::navDriftAngleReceived, this, [=](double drift_angle) { navShip.drift_angle = drift_angle;});
-    connect(subscriber, &AISSubscriber::navSetReceived, this, [=](double set) { navShip.set = set;});
-    connect(subscriber, &AISSubscriber::navRotReceived, this, [=](double rot) { navShip.rot = rot;});
-    connect(subscriber, &AISSubscriber::navDepthBelowKeelReceived, this, [=](double depth_below_keel) { navShip.depth_below_keel = depth_below_keel;});
-
-    connect(subscriber, &AISSubscriber::navDeadReckonReceived, this, [=](QString deadReckon) {
-        if (navShip.deadReckon != deadReckon){
-            navShip.deadReckon = deadReckon;
-
-            emit subscriber->connectionStatusChanged(true);
-        }
-    });
+    navDrainTimer.setInterval(AIS_UI_FRAME_MS);
+    if (!navDrainTimer.isActive()) {
+        connect(&navDrainTimer, &QTimer::timeout, this, &EcWidget::drainNavQueue, Qt::UniqueConnection);
+        navDrainTimer.start();
+    }
 
     connect(subscriber, &AISSubscriber::mapInfoReqReceived, this, &EcWidget::processMapInfoReq);
-    connect(subscriber, &AISSubscriber::processingAis, this, &EcWidget::processAis);
-    connect(subscriber, &AISSubscriber::processingData, this, &EcWidget::processData);
 
     // NODE REPORTS
     connect(subscriber, &AISSubscriber::nodeNameAllReceived, this, [=](const QString nodeNames){
@@ -6601,84 +7426,18 @@ void EcWidget::startAISConnection()
         }
     });
 
-    connect(subscriber, &AISSubscriber::nodeReportReceived, this, [=](const QString nodeName, const QString reportData){
-        // Process individual node report - no debug logging
-        // Data will be parsed by nodeShipDataReceived
-    });
-
-    connect(subscriber, &AISSubscriber::nodeShipDataReceived, this, [=](const QString nodeName, const QString name, double x, double y, double spd, double hdg, double dep, double lat, double lon, const QString type, const QString mode, int index, double yaw, double time,
-                                                                          double hog, double sog, double cog, double draft, double z,
-                                                                          double stw, double drift, double drift_angle, double set, double rot){
-        // Debug log untuk tracking data yang masuk
-        static int nodeDataCounter = 0;
-        if (++nodeDataCounter % 100 == 0) { // Log tiap 100 data
-            qDebug() << "[NODE DATA] Total ships in map:" << nodeShips.size()
-                     << "| Keys:" << nodeShips.keys().join(", ");
-        }
-
-        // Debug log khusus untuk tracked ship
-        if (isNavigatingToShip && nodeName == lastNavigatedShipName) {
-            qDebug() << "[NODE DATA] Received NODE_REPORT for tracked ship:" << nodeName
-                     << "lat:" << lat << "lon:" << lon << "heading:" << hdg
-                     << "| Map contains key:" << nodeShips.contains(nodeName);
-        }
-
-        // Create or update node ship data
-        ShipStruct &nodeShip = nodeShips[nodeName];
-
-        // Map NODE_REPORT variables to ShipStruct fields
-        nodeShip.name = name;              // NAME
-        nodeShip.x = x;                    // X
-        nodeShip.y = y;                    // Y
-        nodeShip.speed = spd;              // SPD
-        nodeShip.heading = hdg;            // HDG
-        nodeShip.heading_og = hog;         // HOG
-        nodeShip.depth = dep;              // DEP
-        nodeShip.lat = lat;                // LAT
-        nodeShip.lon = lon;                // LON
-        nodeShip.yaw = yaw;                // YAW
-        nodeShip.speed_og = sog;           // SOG
-        nodeShip.sog = sog;                // SOG (duplicate for compatibility)
-        nodeShip.course_og = cog;          // COG
-        nodeShip.draft = draft;            // DRAFT
-        nodeShip.z = z;                    // Z
-        nodeShip.stw = stw;                // STW
-        nodeShip.drift = drift;            // DRIFT
-        nodeShip.drift_angle = drift_angle; // DRIFT_ANGLE
-        nodeShip.set = set;                // SET
-        nodeShip.rot = rot;                // ROT
-
-        // Note: TYPE, MODE, INDEX, TIME are not in ShipStruct, so they're ignored
-        // Note: ALLSTOP, LENGTH are also not in ShipStruct
-
-        // Update Node Ships Panel in MainWindow
-        if (mainWindow) {
-            mainWindow->updateNodeShipsPanel();
-        }
-
-        // NOTE: Do NOT call update() here to prevent paint storm!
-        // Node ship position will be updated by the throttled timer in MainWindow
-        // This prevents "not responding" when node data arrives rapidly
-    });
-
-    // ROUTE INFORMATION
-    connect(subscriber, &AISSubscriber::rteWpBrgReceived, this, [=](const double &v) { activeRoute.rteWpBrg = v;});
-    connect(subscriber, &AISSubscriber::rteXtdReceived, this, [=](const QString &v) { activeRoute.rteXtd = v;});
-    connect(subscriber, &AISSubscriber::rteCrsReceived, this, [=](const double &v) { activeRoute.rteCrs = v;});
-    connect(subscriber, &AISSubscriber::rteCtmReceived, this, [=](const double &v) { activeRoute.rteCtm = v;});
-    connect(subscriber, &AISSubscriber::rteDtgReceived, this, [=](const double &v) { activeRoute.rteDtg = v;});
-    connect(subscriber, &AISSubscriber::rteDtgMReceived, this, [=](const double &v) { activeRoute.rteDtgM = v;});
-    connect(subscriber, &AISSubscriber::rteTtgReceived, this, [=](const QString &v) { activeRoute.rteTtg = v;});
-    connect(subscriber, &AISSubscriber::rteEtaReceived, this, [=](const QString &v) { activeRoute.rteEta = v;});
-
     connect(subscriber, &AISSubscriber::publishToMOOSDB, this, &EcWidget::publishToMOOSDB);
 
     // AIS
     connect(_aisObj, &Ais::nmeaTextAppend, this, [=](const QString &msg){ if (nmeaText) nmeaText->append(msg);});
 
-    connect(_aisObj, &Ais::targetUpdateReceived, this, [=](AISTargetData info){
-        // Keep AIS target cache updated; UI refresh handled by 1s timer
-        Ais::instance()->_aisTargetMap[info.mmsi.toInt()] = info;
+    connect(_aisObj, &Ais::targetsExpired, this, [=](const QVector<unsigned int> &mmsis){
+        // Feature dan entry store sudah dibuang di Ais; lepas tracking kalau targetnya ikut hilang
+        bool ok = false;
+        const unsigned int tracked = getTrackMMSI().toUInt(&ok);
+        if (ok && isTrackTarget() && mmsis.contains(tracked)) {
+            TrackTarget("");
+        }
     });
 
     connect(_aisObj, &Ais::signalRefreshChartDisplay, this, &EcWidget::slotRefreshChartDisplayThread, Qt::QueuedConnection);
@@ -6860,6 +7619,167 @@ void EcWidget::stopAllThread()
 }
 
 
+void EcWidget::drainNavQueue()
+{
+    if (shuttingDown) {
+        return;
+    }
+
+    bool ownShipMoved = false;     // lat/lon/heading -> guard zone
+    bool trackerDirty = false;     // lat/lon/heading/sog -> AI target tracker
+    bool headingChanged = false;
+    bool nodeShipsChanged = false;
+    bool deadReckonChanged = false;
+
+    const qint64 nowNs = NavRecord::clockNs();
+    int drained = 0;
+
+    // Batasi satu frame ke isi ring saat ini supaya producer yang cepat tidak menahan GUI
+    while (drained < NavRecordQueue::capacity()) {
+        const NavRecord *rec = navQueue.front();
+        if (!rec) {
+            break;
+        }
+
+        const qint64 latencyNs = nowNs - rec->enqueuedNs;
+        if (latencyNs > navQueueMaxLatencyNs) {
+            navQueueMaxLatencyNs = latencyNs;
+        }
+
+        switch (rec->kind) {
+        case NavRecord::Snapshot: {
+            // Seluruh field satu JSON object diterapkan sekaligus
+            const NavSnapshot &nav = rec->nav;
+
+            if (nav.has(NavSnapshot::NavLat))            { navShip.lat = nav.value[NavSnapshot::NavLat]; ownShipMoved = trackerDirty = true; }
+            if (nav.has(NavSnapshot::NavLong))           { navShip.lon = nav.value[NavSnapshot::NavLong]; ownShipMoved = trackerDirty = true; }
+            if (nav.has(NavSnapshot::NavHeading))        { navShip.heading = nav.value[NavSnapshot::NavHeading]; ownShipMoved = trackerDirty = headingChanged = true; }
+            if (nav.has(NavSnapshot::NavSpeedOG))        { navShip.speed_og = nav.value[NavSnapshot::NavSpeedOG]; trackerDirty = true; }
+            if (nav.has(NavSnapshot::NavSOG))            { navShip.sog = nav.value[NavSnapshot::NavSOG]; trackerDirty = true; }
+            if (nav.has(NavSnapshot::NavDepth))          navShip.depth = nav.value[NavSnapshot::NavDepth];
+            if (nav.has(NavSnapshot::NavHeadingOG))      navShip.heading_og = nav.value[NavSnapshot::NavHeadingOG];
+            if (nav.has(NavSnapshot::NavCourseOG))       navShip.course_og = nav.value[NavSnapshot::NavCourseOG];
+            if (nav.has(NavSnapshot::NavSpeed))          navShip.speed = nav.value[NavSnapshot::NavSpeed];
+            if (nav.has(NavSnapshot::NavYaw))            navShip.yaw = nav.value[NavSnapshot::NavYaw];
+            if (nav.has(NavSnapshot::NavZ))              navShip.z = nav.value[NavSnapshot::NavZ];
+            if (nav.has(NavSnapshot::NavStw))            navShip.stw = nav.value[NavSnapshot::NavStw];
+            if (nav.has(NavSnapshot::NavDrift))          navShip.drift = nav.value[NavSnapshot::NavDrift];
+            if (nav.has(NavSnapshot::NavDraft))          navShip.draft = nav.value[NavSnapshot::NavDraft];
+            if (nav.has(NavSnapshot::NavDriftAngle))     navShip.drift_angle = nav.value[NavSnapshot::NavDriftAngle];
+            if (nav.has(NavSnapshot::NavSet))            navShip.set = nav.value[NavSnapshot::NavSet];
+            if (nav.has(NavSnapshot::NavRot))            navShip.rot = nav.value[NavSnapshot::NavRot];
+            if (nav.has(NavSnapshot::NavDepthBelowKeel)) navShip.depth_below_keel = nav.value[NavSnapshot::NavDepthBelowKeel];
+
+            if (nav.has(NavSnapshot::NavLatDms))  navShip.lat_dms = nav.get(NavSnapshot::NavLatDms);
+            if (nav.has(NavSnapshot::NavLongDms)) navShip.lon_dms = nav.get(NavSnapshot::NavLongDms);
+            if (nav.has(NavSnapshot::NavLatDmm))  navShip.lat_dmm = nav.get(NavSnapshot::NavLatDmm);
+            if (nav.has(NavSnapshot::NavLongDmm)) navShip.lon_dmm = nav.get(NavSnapshot::NavLongDmm);
+            if (nav.has(NavSnapshot::NavName))    navShip.name = nav.get(NavSnapshot::NavName);
+            if (nav.has(NavSnapshot::NavDeadReckon)) {
+                const QString deadReckon = nav.get(NavSnapshot::NavDeadReckon);
+                if (navShip.deadReckon != deadReckon) {
+                    navShip.deadReckon = deadReckon;
+                    deadReckonChanged = true;
+                }
+            }
+
+            // ROUTE INFORMATION
+            if (nav.has(NavSnapshot::RteWpBrg)) activeRoute.rteWpBrg = nav.value[NavSnapshot::RteWpBrg];
+            if (nav.has(NavSnapshot::RteCrs))   activeRoute.rteCrs = nav.value[NavSnapshot::RteCrs];
+            if (nav.has(NavSnapshot::RteCtm))   activeRoute.rteCtm = nav.value[NavSnapshot::RteCtm];
+            if (nav.has(NavSnapshot::RteDtg))   activeRoute.rteDtg = nav.value[NavSnapshot::RteDtg];
+            if (nav.has(NavSnapshot::RteDtgM))  activeRoute.rteDtgM = nav.value[NavSnapshot::RteDtgM];
+            if (nav.has(NavSnapshot::RteXtd))   activeRoute.rteXtd = nav.get(NavSnapshot::RteXtd);
+            if (nav.has(NavSnapshot::RteTtg))   activeRoute.rteTtg = nav.get(NavSnapshot::RteTtg);
+            if (nav.has(NavSnapshot::RteEta))   activeRoute.rteEta = nav.get(NavSnapshot::RteEta);
+
+            // Own ship fix (encode AIVDO, DVR, DB) hanya kalau object membawa lat & lon
+            if (nav.has(NavSnapshot::NavLat) && nav.has(NavSnapshot::NavLong)) {
+                processData(nav.value[NavSnapshot::NavLat], nav.value[NavSnapshot::NavLong],
+                            nav.get(NavSnapshot::NavCourseOG), nav.get(NavSnapshot::NavSOG),
+                            nav.get(NavSnapshot::NavHeading), nav.get(NavSnapshot::NavSpeed),
+                            nav.get(NavSnapshot::NavDepth), nav.get(NavSnapshot::NavYaw),
+                            nav.get(NavSnapshot::NavZ));
+            }
+
+            if (nav.has(NavSnapshot::WaisNmea)) {
+                processAis(nav.get(NavSnapshot::WaisNmea));
+            }
+            break;
+        }
+        case NavRecord::NodeShip: {
+            const int id = nodeFleet.apply(rec->node);
+            nodeShipsChanged = true;
+
+            // Debug log khusus untuk tracked ship
+            const NodeFleet::Node &node = nodeFleet.at(id);
+            if (isNavigatingToShip && node.nodeName == lastNavigatedShipName) {
+                qDebug() << "[NODE DATA] Received NODE_REPORT for tracked ship:" << node.nodeName
+                         << "lat:" << node.lat() << "lon:" << node.lon()
+                         << "heading:" << node.value[NavNodeReport::Hdg];
+            }
+
+            static int nodeDataCounter = 0;
+            if (++nodeDataCounter % 100 == 0) { // Log tiap 100 data
+                qDebug() << "[NODE DATA] Total ships in fleet:" << nodeFleet.size()
+                         << "| Keys:" << nodeFleet.names().join(", ");
+            }
+            break;
+        }
+        }
+
+        navQueue.release();
+        ++drained;
+    }
+
+    if (drained == 0) {
+        return;
+    }
+
+    // Teks besar (WAIS_NMEA) yang tertimpa sebelum sempat dibaca: lapor sekali per frame
+    const quint64 spillLost = NavTextSpill::instance().lost();
+    if (spillLost != navSpillLostReported) {
+        qWarning() << "[NAV] Lost" << (spillLost - navSpillLostReported) << "oversized values carried outside NavRecordQueue";
+        navSpillLostReported = spillLost;
+    }
+
+    // Side effect own ship cukup sekali per frame, bukan per field
+    if (headingChanged && mainWindow && orientation == NorthUp) {
+        mainWindow->setCompassHeading(navShip.heading);
+    }
+
+    if (ownShipMoved) {
+        updateAttachedGuardZoneFromNavShip();
+
+        if (!showCustomOwnShip && navShip.lat != 0.0 && navShip.lon != 0.0) {
+            showCustomOwnShip = true;
+        }
+    }
+
+    bool needUpdate = ownShipMoved && shipDotEnabled;
+
+    // Update AI Target Tracker
+    if (trackerDirty && aiTargetTracker.trackingEnabled && !qIsNaN(navShip.lat) && !qIsNaN(navShip.lon)) {
+        aiTargetTracker.updateOwnShipPosition(navShip.lat, navShip.lon, navShip.heading, navShip.sog);
+        needUpdate = true; // Trigger redraw to show updated target line
+    }
+
+    if (needUpdate) {
+        update();
+    }
+
+    if (deadReckonChanged && subscriber) {
+        emit subscriber->connectionStatusChanged(true);
+    }
+
+    // Update Node Ships Panel in MainWindow
+    // NOTE: Do NOT call update() for node ships to prevent paint storm!
+    // Node ship position will be updated by the throttled timer in MainWindow
+    if (nodeShipsChanged && mainWindow) {
+        mainWindow->updateNodeShipsPanel();
+    }
+}
+
 void EcWidget::processData(double lat, double lon, double cog, double sog, double hdg, double spd, double dep, double yaw, double z){
     QString nmea = AIVDOEncoder::encodeAIVDO1(lat, lon, cog, sog, hdg, 0, 1);
 
@@ -6869,25 +7789,20 @@ void EcWidget::processData(double lat, double lon, double cog, double sog, doubl
     }
 
     // Legacy recording (keep for compatibility) - record even during playback
-    IAisDvrPlugin* dvr = PluginManager::instance().getPlugin<IAisDvrPlugin>("IAisDvrPlugin");
-    if (dvr && dvr->isRecording() && !nmea.isEmpty()) {
-        dvr->recordRawNmea(nmea);
+    if (!dvrSink) dvrSink = AisDvrSink::forKey();
+    if (dvrSink && dvrSink->isRecording() && !nmea.isEmpty()) {
+        dvrSink->record(nmea);
     }
 
     // Record ownship data to database (record even during playback for parallel operation)
     if (AisDatabaseManager::instance().isConnected()) {
         try {
-            static QDateTime lastOwnshipRecord;
-            QDateTime currentTime = QDateTime::currentDateTime();
-
-            if (!lastOwnshipRecord.isValid() || lastOwnshipRecord.secsTo(currentTime) >= 2) {
-                AisDatabaseManager::instance().insertParsedOwnshipData(
-                    nmea,
-                    "ownship",
-                    lat, lon, sog, cog, hdg
-                );
-                lastOwnshipRecord = currentTime;
-            }
+            // Tanpa throttle: insert hanya enqueue ke writer thread
+            AisDatabaseManager::instance().insertParsedOwnshipData(
+                nmea,
+                "ownship",
+                lat, lon, sog, cog, hdg
+            );
         } catch (const std::exception& e) {
             qWarning() << "Error recording ownship data:" << e.what();
         }
@@ -7000,23 +7915,25 @@ void EcWidget::allFunctionPerTime(PickWindow *pickWindow){
                 // Update dangerous AIS list in the same tick before drawing
                 clearDangerousAISList();
                 {
-                    QMap<unsigned int, AISTargetData> targets = Ais::instance()->getTargetMap();
+                    // Satu frame target untuk seluruh tick: CPA, draw, guard zone dan panel membaca epoch yang sama
+                    const AisTargetSnapshot targets = Ais::instance()->publishTargets();
                     AISTargetData own = Ais::instance()->getOwnShipVar();
                     CPATCPASettings& settings = CPATCPASettings::instance();
+                    VesselState ownShip; ownShip.lat = own.lat; ownShip.lon = own.lon; ownShip.sog = own.sog; ownShip.cog = own.cog;
 
-                    for (const auto &entry : targets) {
-                        VesselState ownShip; ownShip.lat = own.lat; ownShip.lon = own.lon; ownShip.sog = own.sog; ownShip.cog = own.cog;
-                        VesselState targetVessel; targetVessel.lat = entry.lat; targetVessel.lon = entry.lon; targetVessel.sog = entry.sog; targetVessel.cog = entry.cog;
+                    for (int i = 0; i < targets.size(); ++i) {
+                        VesselState targetVessel; targetVessel.lat = targets.lat(i); targetVessel.lon = targets.lon(i); targetVessel.sog = targets.sog(i); targetVessel.cog = targets.cog(i);
                         CPATCPACalculator calc; CPATCPAResult res = calc.calculateCPATCPA(ownShip, targetVessel);
                         bool isDanger = false;
                         if (res.isValid && res.currentRange < 0.5) {
                             if (settings.isCPAAlarmEnabled() && res.cpa < SettingsManager::instance().data().cpaThreshold) isDanger = true;
                             if (settings.isTCPAAlarmEnabled() && res.tcpa > 0 && res.tcpa < SettingsManager::instance().data().tcpaThreshold) isDanger = true;
                         }
-                        if (isDanger) addDangerousAISTarget(entry);
+                        if (isDanger) addDangerousAISTarget(targets.kinematics(i));
                     }
                 }
-                draw(true);
+                // Kernel chart draw hanya kalau view/display berubah; selebihnya re-composite layer
+                draw(true, false);
                 slotUpdateAISTargets(true);
             }
 
@@ -7039,9 +7956,10 @@ void EcWidget::allFunctionPerTime(PickWindow *pickWindow){
                 QString mmsi = getTrackMMSI();
                 bool ok=false; unsigned int mmsiInt = mmsi.toUInt(&ok);
                 if (ok) {
-                    QMap<unsigned int, AISTargetData>& targets = Ais::instance()->getTargetMap();
-                    if (targets.contains(mmsiInt)) {
-                        const AISTargetData &td = targets[mmsiInt];
+                    const AisTargetSnapshot targets = Ais::instance()->targetSnapshot();
+                    const int index = targets.indexOf(mmsiInt);
+                    if (index >= 0) {
+                        const AISTargetData td = targets.kinematics(index);
                         if (ECOK(td.feat) && td._dictInfo != nullptr && navShip.lat != 0 && navShip.lon != 0) {
                             double rangeNm = 0.0, bearDeg = 0.0;
                             EcCalculateRhumblineDistanceAndBearing(EC_GEO_DATUM_WGS84,
@@ -7090,23 +8008,25 @@ void EcWidget::allFunctionPerTimeNMEA(PickWindow *pickWindow){
         // Update dangerous AIS list in the same tick before drawing
         clearDangerousAISList();
         {
-            QMap<unsigned int, AISTargetData> targets = Ais::instance()->getTargetMap();
+            // Satu frame target untuk seluruh tick: CPA, draw, guard zone dan panel membaca epoch yang sama
+            const AisTargetSnapshot targets = Ais::instance()->publishTargets();
             AISTargetData own = Ais::instance()->getOwnShipVar();
             CPATCPASettings& settings = CPATCPASettings::instance();
+            VesselState ownShip; ownShip.lat = own.lat; ownShip.lon = own.lon; ownShip.sog = own.sog; ownShip.cog = own.cog;
 
-            for (const auto &entry : targets) {
-                VesselState ownShip; ownShip.lat = own.lat; ownShip.lon = own.lon; ownShip.sog = own.sog; ownShip.cog = own.cog;
-                VesselState targetVessel; targetVessel.lat = entry.lat; targetVessel.lon = entry.lon; targetVessel.sog = entry.sog; targetVessel.cog = entry.cog;
+            for (int i = 0; i < targets.size(); ++i) {
+                VesselState targetVessel; targetVessel.lat = targets.lat(i); targetVessel.lon = targets.lon(i); targetVessel.sog = targets.sog(i); targetVessel.cog = targets.cog(i);
                 CPATCPACalculator calc; CPATCPAResult res = calc.calculateCPATCPA(ownShip, targetVessel);
                 bool isDanger = false;
                 if (res.isValid && res.currentRange < 0.5) {
                     if (settings.isCPAAlarmEnabled() && res.cpa < SettingsManager::instance().data().cpaThreshold) isDanger = true;
                     if (settings.isTCPAAlarmEnabled() && res.tcpa > 0 && res.tcpa < SettingsManager::instance().data().tcpaThreshold) isDanger = true;
                 }
-                if (isDanger) addDangerousAISTarget(entry);
+                if (isDanger) addDangerousAISTarget(targets.kinematics(i));
             }
         }
-        draw(true);
+        // Kernel chart draw hanya kalau view/display berubah; selebihnya re-composite layer
+        draw(true, false);
         slotUpdateAISTargets(true);
     }
 
@@ -7121,9 +8041,10 @@ void EcWidget::allFunctionPerTimeNMEA(PickWindow *pickWindow){
         QString mmsi = getTrackMMSI();
         bool ok=false; unsigned int mmsiInt = mmsi.toUInt(&ok);
         if (ok) {
-            QMap<unsigned int, AISTargetData>& targets = Ais::instance()->getTargetMap();
-            if (targets.contains(mmsiInt)) {
-                const AISTargetData &td = targets[mmsiInt];
+            const AisTargetSnapshot targets = Ais::instance()->targetSnapshot();
+            const int index = targets.indexOf(mmsiInt);
+            if (index >= 0) {
+                const AISTargetData td = targets.kinematics(index);
                 if (ECOK(td.feat) && td._dictInfo != nullptr && navShip.lat != 0 && navShip.lon != 0) {
                     // Gunakan perhitungan yang sama dengan CPATCPAPanel untuk konsistensi
                     CPATCPACalculator calculator;
@@ -7194,11 +8115,14 @@ void EcWidget::processAis(QString ais)
     QStringList sentences = ais.split(QRegExp("(?=[!$])"), Qt::SkipEmptyParts);
 
     for (const QString &sentence : sentences) {
+        AisAssembledMessage message;
+        bool assembled = false;
+
         if (sentence.startsWith("!AIVDM")) {
             // Legacy recording (keep for compatibility) - record even during playback
-            IAisDvrPlugin* dvr = PluginManager::instance().getPlugin<IAisDvrPlugin>("IAisDvrPlugin");
-            if (dvr && dvr->isRecording() && !sentence.isEmpty()) {
-                dvr->recordRawNmea(sentence);
+            if (!dvrSink) dvrSink = AisDvrSink::forKey();
+            if (dvrSink && dvrSink->isRecording()) {
+                dvrSink->record(sentence);
             }
 
             // Skip AIS processing during playback mode (MOOSDB data should not be displayed)
@@ -7206,6 +8130,14 @@ void EcWidget::processAis(QString ais)
                 // Process AIS sentence - recording will happen in SevenCs callback
                 _aisObj->readAISVariableString(sentence);
             }
+
+            // Fragment multi-sentence messages (type 5, ...) ditahan sampai lengkap; pesan yang
+            // sudah dirakit diteruskan ke DB, tetap satu kalimat per baris seperti sebelumnya
+            const AisFragmentAssembler::Result result = aisAssembler.addSentence(sentence, message);
+            if (result == AisFragmentAssembler::Incomplete) {
+                continue;
+            }
+            assembled = result == AisFragmentAssembler::Complete;
         }
 
         // Record AIS target data to database (record even during playback for parallel operation)
@@ -7220,16 +8152,15 @@ void EcWidget::processAis(QString ais)
                     originalTi = _aisObj->getLatestTi();
                 }
 
-                if (sentence.isEmpty()) {
-                    return;
+                if (!originalTi) {
+                    continue;
                 }
 
-                bool success = AisDatabaseManager::instance().insertParsedAisDataRev(
-                    sentence,
-                    "aistarget",
-                    originalTi->mmsi,
-                    *originalTi
-                );
+                bool success = assembled
+                    ? AisDatabaseManager::instance().insertParsedAisDataRev(
+                          message, "aistarget", originalTi->mmsi, *originalTi)
+                    : AisDatabaseManager::instance().insertParsedAisDataRev(
+                          sentence, "aistarget", originalTi->mmsi, *originalTi);
 
                 qint64 elapsed = timer.elapsed();
                 if (!success) {
@@ -7489,20 +8420,21 @@ void EcWidget::slotUpdateAISTargets( Bool bSymbolize )
 
   // Update AI Target Tracker with latest AIS data
   if (aiTargetTracker.trackingEnabled && Ais::instance()) {
-      QMap<unsigned int, AISTargetData>& aisTargetMap = Ais::instance()->getTargetMap();
+      const AisTargetSnapshot aisTargets = Ais::instance()->targetSnapshot();
       QString targetMMSI = aiTargetTracker.targetMMSI;
 
-      qDebug() << "[slotUpdateAISTargets] Available AIS targets:" << aisTargetMap.size()
+      qDebug() << "[slotUpdateAISTargets] Available AIS targets:" << aisTargets.size()
                << "Looking for MMSI:" << targetMMSI;
 
       if (!targetMMSI.isEmpty()) {
           bool targetFound = false;
           unsigned int targetMMSIUInt = targetMMSI.toUInt();
 
-          // Try to find the target in the AIS map
-          if (aisTargetMap.contains(targetMMSIUInt)) {
-              const AISTargetData& aisTarget = aisTargetMap.value(targetMMSIUInt);
-              if (!aisTarget.mmsi.isEmpty() && aisTarget.lat != 0.0 && aisTarget.lon != 0.0) {
+          // Key store adalah MMSI numerik, jadi satu lookup sudah cukup
+          const int index = aisTargets.indexOf(targetMMSIUInt);
+          if (index >= 0) {
+              if (aisTargets.hasPosition(index)) {
+                  const AISTargetData aisTarget = aisTargets.kinematics(index);
                   qDebug() << "[slotUpdateAISTargets] Found target" << aisTarget.mmsi
                            << "at" << aisTarget.lat << "," << aisTarget.lon;
                   updateAITargetData(aisTarget.mmsi, aisTarget);
@@ -7512,28 +8444,11 @@ void EcWidget::slotUpdateAISTargets( Bool bSymbolize )
               }
           }
 
-          // If not found by exact match, try searching through all targets
-          if (!targetFound) {
-              qDebug() << "[slotUpdateAISTargets] Target not found by key, searching all targets...";
-              for (auto it = aisTargetMap.begin(); it != aisTargetMap.end(); ++it) {
-                  const AISTargetData& aisTarget = it.value();
-                  if (aisTarget.mmsi == targetMMSI) {
-                      qDebug() << "[slotUpdateAISTargets] Found target by string match" << aisTarget.mmsi
-                               << "at" << aisTarget.lat << "," << aisTarget.lon;
-                      if (!aisTarget.mmsi.isEmpty() && aisTarget.lat != 0.0 && aisTarget.lon != 0.0) {
-                          updateAITargetData(aisTarget.mmsi, aisTarget);
-                          targetFound = true;
-                      }
-                      break;
-                  }
-              }
-          }
-
           if (!targetFound) {
               qDebug() << "[slotUpdateAISTargets] Target NOT FOUND in AIS map for MMSI:" << targetMMSI;
               qDebug() << "[slotUpdateAISTargets] Available MMSIs:";
-              for (auto it = aisTargetMap.begin(); it != aisTargetMap.end(); ++it) {
-                  qDebug() << "  Key:" << it.key() << "MMSI:" << it.value().mmsi;
+              for (int i = 0; i < aisTargets.size(); ++i) {
+                  qDebug() << "  MMSI:" << aisTargets.mmsi(i);
               }
           }
       } else {
@@ -7555,32 +8470,55 @@ void EcWidget::drawAISCell()
     return;
   }
 
-  EcChartSymbolizeCell( view, aisCellId );
-
-  // copy the chart pixmap as background for the AIS overlay
-  chartAisPixmap = chartPixmap;
-
   // DRAW OVERLAY ON CHART PIXMAP
 #ifdef _WIN32
-  HDC overlayDC = CreateCompatibleDC( hdc );
-  // hBitmapOverlay = chartAisPixmap.toWinHBITMAP( QPixmap::NoAlpha );
-  hBitmapOverlay = QtWin::toHBITMAP(chartAisPixmap, QtWin::HBitmapNoAlpha);
-  HBITMAP hBitmapOverlayOld = (HBITMAP)SelectObject( overlayDC, hBitmapOverlay );
-  HPALETTE oldPal = SelectPalette( overlayDC, hPalette, TRUE );
+  // Layer AIS dipakai ulang selama chart base dan isi AIS cell tidak berubah
+  const qint64 chartKey = chartPixmap.cacheKey();
+  const quint64 cellRevision = _aisObj->cellRevision();
+  const quint64 epoch = _aisObj->targetStore().epoch();
+  if( aisLayerValid && aisLayerChartKey == chartKey && aisLayerCellId == aisCellId &&
+      aisLayerCellRevision == cellRevision && aisLayerEpoch == epoch )
+  {
+    drawPixmap = aisLayerPixmap;
+  }
+  else
+  {
+    EcChartSymbolizeCell( view, aisCellId );
+
+    // copy the chart pixmap as background for the AIS overlay
+    chartAisPixmap = chartPixmap;
 
-  EcDrawNTDrawCells( view, overlayDC, NULL, 1, &aisCellId, 0 );
+    HDC overlayDC = CreateCompatibleDC( hdc );
+    // hBitmapOverlay = chartAisPixmap.toWinHBITMAP( QPixmap::NoAlpha );
+    hBitmapOverlay = QtWin::toHBITMAP(chartAisPixmap, QtWin::HBitmapNoAlpha);
+    HBITMAP hBitmapOverlayOld = (HBITMAP)SelectObject( overlayDC, hBitmapOverlay );
+    HPALETTE oldPal = SelectPalette( overlayDC, hPalette, TRUE );
 
-  BitBlt( hdc, 0, 0, chartAisPixmap.width(), chartAisPixmap.height(), overlayDC, 0, 0, SRCCOPY );
+    EcDrawNTDrawCells( view, overlayDC, NULL, 1, &aisCellId, 0 );
 
-  SelectPalette( overlayDC, oldPal, FALSE );
+    BitBlt( hdc, 0, 0, chartAisPixmap.width(), chartAisPixmap.height(), overlayDC, 0, 0, SRCCOPY );
 
-  hBitmapOverlay = (HBITMAP)SelectObject( overlayDC, hBitmapOverlayOld );
+    SelectPalette( overlayDC, oldPal, FALSE );
 
-  drawPixmap = QtWin::fromHBITMAP(hBitmapOverlay);
+    hBitmapOverlay = (HBITMAP)SelectObject( overlayDC, hBitmapOverlayOld );
 
-  DeleteObject (hBitmapOverlay);
-  DeleteDC( overlayDC );
+    drawPixmap = QtWin::fromHBITMAP(hBitmapOverlay);
+
+    DeleteObject (hBitmapOverlay);
+    DeleteDC( overlayDC );
+
+    aisLayerPixmap = drawPixmap;
+    aisLayerChartKey = chartKey;
+    aisLayerCellId = aisCellId;
+    aisLayerCellRevision = cellRevision;
+    aisLayerEpoch = epoch;
+    aisLayerValid = true;
+  }
 #else
+  // X11: cell digambar langsung ke x11pixmap milik chart, jadi tidak ada layer yang bisa di-cache
+  EcChartSymbolizeCell( view, aisCellId );
+  chartAisPixmap = chartPixmap;
+
   EcDrawX11DrawCells( view, drawGC, NULL, 1, &aisCellId, 0 );
 
   // bit blit the two pix maps
@@ -7596,7 +8534,7 @@ void EcWidget::drawAISCell()
 
   // ROUTE FIX: Enhanced waypointDraw() to fix route and waypoint label flickering
   // Always ensure routes are drawn even when AIS cell operations occur
-  waypointDraw();
+  drawRouteLayer();
 
   // Draw current visualizations on overlay
   if (m_currentVisualisation) {
@@ -7834,21 +8772,23 @@ void EcWidget::ownShipDraw(){
     }
 
     // GAMBAR NODE SHIPS (Dynamic ships dari NODE_REPORT_*)
-    if (showVessels && showAIS && !nodeShips.isEmpty()) {
-        for (auto it = nodeShips.begin(); it != nodeShips.end(); ++it) {
-            QString nodeName = it.key();
-            ShipStruct nodeShip = it.value();
+    if (showVessels && showAIS && !nodeFleet.isEmpty()) {
+        for (int id = 0; id < nodeFleet.size(); ++id) {
+            const NodeFleet::Node &node = nodeFleet.at(id);
+            const QString &nodeName = node.nodeName;
 
             // Skip jika nodeShip lagi di-track
-            if (nodeShip.name == lastNavigatedShipName){
+            if (node.name == lastNavigatedShipName){
                 continue;
             }
 
             // Skip jika tidak ada lat/lon yang valid
-            if (qIsNaN(nodeShip.lat) || qIsNaN(nodeShip.lon) || nodeShip.lat == 0.0 || nodeShip.lon == 0.0) {
+            if (!node.hasPosition()) {
                 continue;
             }
 
+            const ShipStruct nodeShip = nodeFleet.ship(id);
+
             // Skip jika visibility false (dari panel)
             if (mainWindow && !mainWindow->getNodeShipVisibility(nodeName)) {
                 continue;
@@ -7910,52 +8850,37 @@ void EcWidget::setMainWindow(MainWindow *mw) {
 bool EcWidget::hasNodeShip(const QString& nodeName) const
 {
     // ⭐ Case-insensitive search
-    for (auto it = nodeShips.begin(); it != nodeShips.end(); ++it) {
-        if (it.key().compare(nodeName, Qt::CaseInsensitive) == 0) {
-            qDebug() << "[hasNodeShip] FOUND (case-insensitive):" << nodeName
-                     << "| Matched with:" << it.key();
-            return true;
-        }
+    if (nodeFleet.find(nodeName, Qt::CaseInsensitive) >= 0) {
+        return true;
     }
 
     // Debug log jika tidak ditemukan
     qWarning() << "[hasNodeShip] NOT FOUND:" << nodeName
-               << "| Total ships:" << nodeShips.size()
-               << "| Available keys:" << nodeShips.keys().join(", ");
+               << "| Total ships:" << nodeFleet.size()
+               << "| Available keys:" << nodeFleet.names().join(", ");
     return false;
 }
 
 ShipStruct EcWidget::getNodeShip(const QString& nodeName) const
 {
     // ⭐ Case-insensitive search
-    for (auto it = nodeShips.begin(); it != nodeShips.end(); ++it) {
-        if (it.key().compare(nodeName, Qt::CaseInsensitive) == 0) {
-            ShipStruct result = it.value();
-
-            // Debug log
-            qDebug() << "[getNodeShip] Found:" << nodeName
-                     << "| Key in map:" << it.key()
-                     << "| Name:" << result.name
-                     << "| Lat:" << result.lat
-                     << "| Lon:" << result.lon;
-
-            return result;
-        }
+    const int id = nodeFleet.find(nodeName, Qt::CaseInsensitive);
+    if (id >= 0) {
+        return nodeFleet.ship(id);
     }
 
     // Debug log jika tidak ditemukan
     qWarning() << "[getNodeShip] Ship NOT FOUND:" << nodeName
-                << "| Total ships:" << nodeShips.size()
-                << "| Available keys:" << nodeShips.keys().join(", ");
+                << "| Total ships:" << nodeFleet.size()
+                << "| Available keys:" << nodeFleet.names().join(", ");
 
     return ShipStruct{}; // Return empty ship if not found
 }
 
 QMap<QString, ShipStruct> EcWidget::getAllNodeShips() const
 {
-    qDebug() << "[getAllNodeShips] Returning" << nodeShips.size() << "ships"
-             << "| Keys:" << nodeShips.keys().join(", ");
-    return nodeShips;
+    // Dibentuk saat diminta; penyimpanan aslinya nodeFleet
+    return nodeFleet.toMap();
 }
 
 void EcWidget::setLastNavigatedShip(const ShipStruct& ship, const QString& name) {
@@ -9295,7 +10220,7 @@ void EcWidget::drawWaypointMarker(double lat, double lon)
 }
 
 
-void EcWidget::drawWaypointWithLabel(double lat, double lon, const QString& label, const QColor& color)
+void EcWidget::drawWaypointWithLabel(double lat, double lon, const QString& label, const QColor& color, const QRect& labelRect)
 {
     int x, y;
 
@@ -9339,6 +10264,9 @@ void EcWidget::drawWaypointWithLabel(double lat, double lon, const QString& labe
         textRect.adjust(-8, -4, 8, 4);
         textRect.moveLeft(x + radius + 10);  // Same positioning as POI
         textRect.moveTop(y - textRect.height() / 2);
+        if (!labelRect.isNull()) {
+            textRect = labelRect;   // sudah ditempatkan pemanggil lewat labelPlacer
+        }
 
         // POI-style background (dark, no border)
         QColor labelBg = QColor(20, 20, 20, 110); // Same transparency as inactive POI
@@ -9356,9 +10284,8 @@ void EcWidget::drawWaypointWithLabel(double lat, double lon, const QString& labe
 
 QPoint EcWidget::findOptimalLabelPosition(int waypointX, int waypointY, const QSize& textSize, int minDistance)
 {
-    // Use member variable instead of static to avoid position changes during drag
-    // This ensures stable label positions across frames
-    // usedLabelRects will be cleared in Draw() at the start of each complete redraw
+    // Collision dicek lewat labelPlacer (grid bucket), tidak terhadap semua label
+    // labelPlacer will be cleared in Draw() at the start of each complete redraw
 
     // Daftar posisi kandidat dengan prioritas UI/UX yang baik
     QList<QPoint> candidatePositions;
@@ -9386,36 +10313,17 @@ QPoint EcWidget::findOptimalLabelPosition(int waypointX, int waypointY, const QS
     candidatePositions << QPoint(waypointX + distance, waypointY + distance);
     candidatePositions << QPoint(waypointX - distance, waypointY + distance);
 
-    // Cari posisi optimal - hanya check collision, tidak check bounds
+    // Rectangle label dengan padding (sesuai dengan background baru: -4, -2, +8, +4).
+    // Kalau semua bertabrakan, posisi pertama tetap dipakai (allow off-screen, tanpa bounds check)
+    QVector<QRect> candidates;
+    candidates.reserve(candidatePositions.size());
     for (const QPoint& candidate : candidatePositions) {
-        // Hitung rectangle label dengan padding (sesuai dengan background baru: -4, -2, +8, +4)
-        QRect labelRect(candidate.x() - 4, candidate.y() - textSize.height() - 2,
-                       textSize.width() + 8, textSize.height() + 4);
-
-        // Check collision dengan label lain (dengan margin 2px untuk spacing)
-        bool hasCollision = false;
-        for (const QRect& usedRect : this->usedLabelRects) {
-            QRect expandedUsedRect = usedRect.adjusted(-2, -2, 2, 2); // Add 2px margin
-            if (labelRect.intersects(expandedUsedRect)) {
-                hasCollision = true;
-                break;
-            }
-        }
-
-        // Jika tidak collision, gunakan posisi ini (allow off-screen)
-        if (!hasCollision) {
-            this->usedLabelRects.append(labelRect);
-            return candidate;
-        }
+        candidates << QRect(candidate.x() - 4, candidate.y() - textSize.height() - 2,
+                            textSize.width() + 8, textSize.height() + 4);
     }
 
-    // Fallback - no bounds constraint, just use default position
-    QPoint fallbackPos(waypointX + minDistance, waypointY - minDistance);
-    QRect fallbackRect(fallbackPos.x() - 4, fallbackPos.y() - textSize.height() - 2,
-                       textSize.width() + 8, textSize.height() + 4);
-    this->usedLabelRects.append(fallbackRect);
-
-    return fallbackPos;
+    const int chosen = labelPlacer.place(QString(), QPoint(waypointX, waypointY), candidates);
+    return candidatePositions.at(chosen);
 }
 
 void EcWidget::drawGhostWaypoint(QPainter& painter, double lat, double lon, const QString& label)
@@ -11293,10 +12201,16 @@ void EcWidget::drawLeglineLabels()
         }
     }
 
+    // Route terpilih ditempatkan lebih dulu supaya labelnya mendapat posisi utama
+    QList<int> routeOrder = routeWaypoints.keys();
+    if (routeOrder.removeOne(selectedRouteId)) {
+        routeOrder.prepend(selectedRouteId);
+    }
+    const QFontMetrics fm(painter.font());
+
     // Draw labels within each route separately
-    for (auto it = routeWaypoints.begin(); it != routeWaypoints.end(); ++it) {
-        int routeId = it.key();
-        QList<int> indices = it.value();
+    for (int routeId : routeOrder) {
+        QList<int> indices = routeWaypoints.value(routeId);
 
         // Check visibility - skip labels for hidden routes
         if (!isRouteVisible(routeId)) {
@@ -11368,7 +12282,18 @@ void EcWidget::drawLeglineLabels()
                                    .arg(QString::number(bearing, 'f', 0))
                                    .arg(degree);
 
-                painter.drawText(midX + 20, midY - 15, text);
+                // Kandidat (baseline): kanan atas (posisi lama), kanan bawah, kiri atas, kiri bawah
+                const int w = fm.horizontalAdvance(text);
+                const int h = fm.height();
+                const QVector<QRect> candidates = {
+                    QRect(midX + 20, midY - 15 - fm.ascent(), w, h),
+                    QRect(midX + 20, midY + 15 - fm.ascent(), w, h),
+                    QRect(midX - 20 - w, midY - 15 - fm.ascent(), w, h),
+                    QRect(midX - 20 - w, midY + 15 - fm.ascent(), w, h)
+                };
+                const QRect textRect = candidates.at(labelPlacer.place(QString("leg:%1:%2").arg(routeId).arg(idx1),
+                                                                       QPoint(midX, midY), candidates));
+                painter.drawText(textRect.left(), textRect.top() + fm.ascent(), text);
             }
         }
     }
@@ -11526,16 +12451,22 @@ void EcWidget::drawRouteLinesOverlay(QPainter& painter)
             }
         }
 
-        // Draw lines between consecutive ACTIVE waypoints only
-        for (int i = 0; i < activeIndices.size() - 1; ++i) {
-            int idx1 = activeIndices[i];
-            int idx2 = activeIndices[i + 1];
-
-            const Waypoint &wp1 = waypointList[idx1];
-            const Waypoint &wp2 = waypointList[idx2];
+        // Setiap waypoint diproyeksikan sekali (dulu dua kali: sebagai ujung dua leg)
+        const int activeCount = activeIndices.size();
+        QVector<double> wpLat(activeCount), wpLon(activeCount);
+        for (int i = 0; i < activeCount; ++i) {
+            wpLat[i] = waypointList[activeIndices[i]].lat;
+            wpLon[i] = waypointList[activeIndices[i]].lon;
+        }
+        const ProjectedOverlay &projected = projectOverlay(QString("route:%1").arg(routeId), wpLat, wpLon);
+        const QVector<QPoint> &wpXy = projected.points;
+        const QVector<bool> &wpOk = projected.ok;
 
-            int x1, y1, x2, y2;
-            if (LatLonToXy(wp1.lat, wp1.lon, x1, y1) && LatLonToXy(wp2.lat, wp2.lon, x2, y2)) {
+        // Draw lines between consecutive ACTIVE waypoints only
+        for (int i = 0; i < activeCount - 1; ++i) {
+            if (wpOk[i] && wpOk[i + 1]) {
+                const int x1 = wpXy[i].x(), y1 = wpXy[i].y();
+                const int x2 = wpXy[i + 1].x(), y2 = wpXy[i + 1].y();
                 painter.drawLine(x1, y1, x2, y2);
 
                 // Draw arrow to show direction
@@ -12641,9 +13572,19 @@ void EcWidget::drawGuardZone(QPainter& painter)
                 QPolygon poly;
                 bool validPolygon = true;
 
-                for (int i = 0; i < gz.latLons.size(); i += 2) {
-                    int x, y;
-                    if (LatLonToXy(gz.latLons[i], gz.latLons[i+1], x, y)) {
+                const int vertexCount = gz.latLons.size() / 2;
+                QVector<double> gzLat(vertexCount), gzLon(vertexCount);
+                for (int i = 0; i < vertexCount; ++i) {
+                    gzLat[i] = gz.latLons[2 * i];
+                    gzLon[i] = gz.latLons[2 * i + 1];
+                }
+                const ProjectedOverlay &projected = projectOverlay(QString("guardzone:%1").arg(gz.id), gzLat, gzLon);
+                const QVector<QPoint> &gzXy = projected.points;
+                const QVector<bool> &gzOk = projected.ok;
+
+                for (int i = 0; i < vertexCount; ++i) {
+                    const int x = gzXy[i].x(), y = gzXy[i].y();
+                    if (gzOk[i]) {
                         // CRITICAL: Validate polygon coordinates
                         if (abs(x) > 20000 || abs(y) > 20000) {
                             qDebug() << "[DRAW-GUARDZONE-ERROR] Invalid polygon coordinate:" << x << "," << y << "- skipping polygon";
@@ -13268,14 +14209,14 @@ bool EcWidget::checkTargetsInGuardZone()
         return false;
     }
 
-    QMap<unsigned int, AISTargetData>& aisTargetMap = Ais::instance()->getTargetMap();
+    const AisTargetSnapshot aisTargets = Ais::instance()->targetSnapshot();
 
-    if (aisTargetMap.isEmpty()) {
+    if (aisTargets.isEmpty()) {
         qDebug() << "[REAL-AIS-CHECK] No AIS targets available";
         return false;
     }
 
-    qDebug() << "[REAL-AIS-CHECK] Processing" << aisTargetMap.size() << "real AIS targets";
+    qDebug() << "[REAL-AIS-CHECK] Processing" << aisTargets.size() << "real AIS targets";
 
     // Cari guardzone aktif
     GuardZone* activeGuardZone = nullptr;
@@ -13311,13 +14252,12 @@ bool EcWidget::checkTargetsInGuardZone()
     QString alertMessages;
     int alertCount = 0;
 
-    for (auto it = aisTargetMap.begin(); it != aisTargetMap.end(); ++it) {
-        const AISTargetData& aisTarget = it.value();
-
+    for (int index = 0; index < aisTargets.size(); ++index) {
         // Skip invalid targets
-        if (aisTarget.mmsi.isEmpty() || aisTarget.lat == 0.0 || aisTarget.lon == 0.0) {
+        if (!aisTargets.hasPosition(index)) {
             continue;
         }
+        const AISTargetData aisTarget = aisTargets.kinematics(index);
 
         // Update AI Target Tracker if this is our tracked target
         updateAITargetData(aisTarget.mmsi, aisTarget);
@@ -16013,22 +16953,19 @@ EcAISTargetInfo* EcWidget::findAISTargetInfoAtPosition(const QPoint& mousePos)
         return nullptr;
     }
 
-    // Ambil semua AIS target info lengkap
-    QMap<unsigned int, AISTargetData>& targetDatas = Ais::instance()->getTargetMap();
+    // Posisi dari kolom kinematik; EcAISTargetInfo hanya diambil untuk target terdekat
+    const AisTargetSnapshot targets = Ais::instance()->targetSnapshot();
 
     // Toleransi dalam pixel untuk deteksi hover
     const int tolerancePixels = 20;
 
-    EcAISTargetInfo* closestTarget = nullptr;
+    int closestIndex = -1;
     double closestDistance = tolerancePixels + 1;
 
-    for (auto it = targetDatas.begin(); it != targetDatas.end(); ++it) {
-        AISTargetData& targetData = it.value();
-        EcAISTargetInfo& targetInfo = targetData.rawInfo;
-
+    for (int i = 0; i < targets.size(); ++i) {
         // Konversi posisi AIS target ke screen coordinates
-        double lat = ((double)targetInfo.latitude / 10000.0) / 60.0;
-        double lon = ((double)targetInfo.longitude / 10000.0) / 60.0;
+        double lat = targets.lat(i);
+        double lon = targets.lon(i);
 
         int targetX, targetY;
         if (LatLonToXy(lat, lon, targetX, targetY)) {
@@ -16039,12 +16976,15 @@ EcAISTargetInfo* EcWidget::findAISTargetInfoAtPosition(const QPoint& mousePos)
 
             if (distance <= tolerancePixels && distance < closestDistance) {
                 closestDistance = distance;
-                closestTarget = &targetData.rawInfo;
+                closestIndex = i;
             }
         }
     }
 
-    return closestTarget;
+    if (closestIndex < 0) {
+        return nullptr;
+    }
+    return Ais::instance()->targetStore().rawInfo(targets.mmsi(closestIndex));
 }
 
 // Tambahkan fungsi slot untuk check mouse over AIS target
@@ -16070,11 +17010,11 @@ AISTargetData EcWidget::getEnhancedAISTargetData(const QString& mmsi)
     AISTargetData enhancedData;
 
     // Ambil data dari map yang sudah ada
-    QMap<unsigned int, AISTargetData>& targets = Ais::instance()->getTargetMap();
-    unsigned int mmsiInt = mmsi.toUInt();
+    const AisTargetSnapshot targets = Ais::instance()->targetSnapshot();
+    const int index = targets.indexOf(mmsi.toUInt());
 
-    if (targets.contains(mmsiInt)) {
-        enhancedData = targets[mmsiInt];
+    if (index >= 0) {
+        enhancedData = targets.target(index);
     }
 
     // TODO: Di sini bisa ditambahkan pengambilan data tambahan dari transponder
@@ -17236,13 +18176,6 @@ bool EcWidget::checkShipGuardianZone()
     removeOutdatedObstacleMarkers();
     qDebug() << "[CLEANUP-TIMER] After cleanup, remaining markers:" << obstacleMarkers.size();
 
-    // FORCE TEST: Also run cleanup from update paint event as fallback
-    static int cleanupCounter = 0;
-    if (++cleanupCounter % 50 == 0) { // Every ~50 paint events
-        qDebug() << "[FORCE-CLEANUP] Running fallback cleanup from paint event";
-        removeOutdatedObstacleMarkers();
-    }
-
     // Show alert jika ada obstacles
     if (hasObstacles && !lastDetectedObstacles.isEmpty()) {
         showShipGuardianAlert(lastDetectedObstacles);
@@ -18308,9 +19241,9 @@ void EcWidget::performAutoGuardZoneCheck()
              << "redDotLat:" << redDotLat;
 
     // ========== GUNAKAN AIS CLASS YANG SUDAH ADA ==========
-    QMap<unsigned int, AISTargetData>& aisTargetMap = Ais::instance()->getTargetMap();
+    const AisTargetSnapshot aisTargets = Ais::instance()->targetSnapshot();
 
-    if (aisTargetMap.isEmpty()) {
+    if (aisTargets.isEmpty()) {
         return;
     }
 
@@ -18341,9 +19274,14 @@ void EcWidget::performAutoGuardZoneCheck()
     QMap<unsigned int, EcAISTargetInfo>& targetInfoMap = Ais::instance()->getTargetInfoMap();
 
     // Check setiap AIS target terhadap setiap guardzone aktif
-    for (auto it = aisTargetMap.begin(); it != aisTargetMap.end(); ++it) {
-        unsigned int mmsi = it.key();
-        const AISTargetData& aisTarget = it.value();
+    for (int index = 0; index < aisTargets.size(); ++index) {
+        // Skip invalid targets
+        if (!aisTargets.hasPosition(index)) {
+            continue;
+        }
+
+        unsigned int mmsi = aisTargets.mmsi(index);
+        const AISTargetData aisTarget = aisTargets.kinematics(index);
 
         // Get corresponding EcAISTargetInfo for ship type filtering
         EcAISTargetInfo* targetInfo = nullptr;
@@ -18351,11 +19289,6 @@ void EcWidget::performAutoGuardZoneCheck()
             targetInfo = &targetInfoMap[mmsi];
         }
 
-        // Skip invalid targets
-        if (aisTarget.mmsi.isEmpty() || aisTarget.lat == 0.0 || aisTarget.lon == 0.0) {
-            continue;
-        }
-
         // Check terhadap setiap guardzone aktif
         for (GuardZone* activeGuardZone : activeGuardZones) {
             bool inGuardZone = false;
@@ -21036,7 +21969,7 @@ void EcWidget::drawCPATCPAIndicators(QPainter& painter)
         return;
     }
     // Get all AIS targets and calculate CPA/TCPA for each
-    QMap<unsigned int, AISTargetData> targets = Ais::instance()->getTargetMap();
+    const AisTargetSnapshot targets = Ais::instance()->targetSnapshot();
 
     if (targets.isEmpty()) {
         return;
@@ -21053,24 +21986,24 @@ void EcWidget::drawCPATCPAIndicators(QPainter& painter)
     ownVessel.sog = ownShip.sog;
     ownVessel.cog = ownShip.cog;
 
-    for (const auto& target : targets) {
+    for (int i = 0; i < targets.size(); ++i) {
         // Skip invalid targets
-        if (target.lat == 0.0 || target.lon == 0.0) {
+        if (!targets.hasPosition(i)) {
             continue;
         }
 
         // Convert target position to screen coordinates
         int x, y;
-        if (!LatLonToXy(target.lat, target.lon, x, y)) {
+        if (!LatLonToXy(targets.lat(i), targets.lon(i), x, y)) {
             continue;
         }
 
         // Calculate CPA/TCPA for this target
         VesselState targetVessel;
-        targetVessel.lat = target.lat;
-        targetVessel.lon = target.lon;
-        targetVessel.sog = target.sog;
-        targetVessel.cog = target.cog;
+        targetVessel.lat = targets.lat(i);
+        targetVessel.lon = targets.lon(i);
+        targetVessel.sog = targets.sog(i);
+        targetVessel.cog = targets.cog(i);
 
         CPATCPACalculator calculator;
         CPATCPAResult result = calculator.calculateCPATCPA(ownVessel, targetVessel);
@@ -21119,7 +22052,7 @@ void EcWidget::drawCPATCPAIndicators(QPainter& painter)
         painter.setFont(font);
 
         QString info = QString("%1\nCPA: %2 NM\nTCPA: %3 min")
-                       .arg(target.mmsi)
+                       .arg(targets.mmsi(i))
                        .arg(result.cpa, 0, 'f', 2)
                        .arg(result.tcpa, 0, 'f', 1);
 
@@ -21136,6 +22069,154 @@ void EcWidget::drawCPATCPAIndicators(QPainter& painter)
     painter.restore();
 }
 
+void EcWidget::rebuildAisAnchors(const AisTargetSnapshot& targets)
+{
+    const int n = targets.size();
+    aisAnchorPx.resize(n);
+    aisAnchorLatScale.resize(n);
+    aisAnchorEpoch = targets.epoch();
+    aisAnchorView = viewChangeCounter;
+
+    // Jacobian layar<->geo di tengah view dari tiga titik 100 px, berlaku di semua skala
+    const int x0 = width() / 2, y0 = height() / 2;
+    EcCoordinate lat0, lon0, latX, lonX, latY, lonY;
+    bool ok = XyToLatLon(x0, y0, lat0, lon0) &&
+              XyToLatLon(x0 + 100, y0, latX, lonX) &&
+              XyToLatLon(x0, y0 + 100, latY, lonY);
+
+    const double a = (latX - lat0) / 100.0, b = (latY - lat0) / 100.0;
+    const double c = (lonX - lon0) / 100.0, d = (lonY - lon0) / 100.0;
+    const double det = a * d - b * c;
+    ok = ok && qAbs(det) > 1e-18;
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    if (ok) {
+        aisPxPerDegLat = QPointF(d / det, -c / det);
+        aisPxPerDegLon = QPointF(-b / det, a / det);
+    }
+    const double cosRef = qCos(qDegreesToRadians(lat0));
+
+    for (int i = 0; i < n; ++i) {
+        int x = 0, y = 0;
+        if (ok && targets.hasPosition(i) && LatLonToXy(targets.lat(i), targets.lon(i), x, y)) {
+            aisAnchorPx[i] = QPointF(x, y);
+            const double cosLat = qCos(qDegreesToRadians(targets.lat(i)));
+            aisAnchorLatScale[i] = cosLat > 1e-6 ? cosRef / cosLat : 1.0;
+        } else {
+            aisAnchorPx[i] = QPointF(nan, nan);
+            aisAnchorLatScale[i] = 1.0;
+        }
+    }
+}
+
+void EcWidget::updateAisPrediction()
+{
+    if (shuttingDown || !initialized || !view) {
+        return;
+    }
+
+    if (!showAIS || !showAisPrediction || !Ais::instance() || Ais::instance()->targetSnapshot().isEmpty()) {
+        if (!aisPredictionDirty.isEmpty()) {
+            aisPredictedPx.clear();
+            update(aisPredictionDirty);
+            aisPredictionDirty = QRect();
+        }
+        return;
+    }
+
+    const AisTargetSnapshot targets = Ais::instance()->targetSnapshot();
+
+    // Proyeksi kernel hanya saat frame target atau view berubah; per frame cuma aritmetika
+    if (targets.epoch() != aisAnchorEpoch || viewChangeCounter != aisAnchorView ||
+        aisAnchorPx.size() != targets.size()) {
+        rebuildAisAnchors(targets);
+    }
+
+    // Saat replay (log/DB) target diekstrapolasi ke jam data, bukan jam dinding
+    aisReckoner.predict(targets, Ais::instance()->dataClockMs(), aisPrediction);
+
+    const int n = targets.size();
+    aisPredictedPx.resize(n);
+    QRect dirty;
+    for (int i = 0; i < n; ++i) {
+        const QPointF &anchor = aisAnchorPx[i];
+        if (qIsNaN(anchor.x()) || aisPrediction.confidence[i] <= 0.0f) {
+            aisPredictedPx[i] = anchor;
+            continue;
+        }
+
+        const QPointF p = anchor + aisPxPerDegLon * aisPrediction.dLon[i]
+                                 + aisPxPerDegLat * (aisPrediction.dLat[i] * aisAnchorLatScale[i]);
+        aisPredictedPx[i] = p;
+        dirty |= QRectF(anchor, p).normalized().toAlignedRect().adjusted(-12, -12, 12, 12);
+    }
+
+    // Saat drag paintEvent menggeser painter (lihat dragMode di paintEvent); rect kotor
+    // ikut digeser supaya tetap repaint sebagian, bukan seluruh widget
+    if (dragMode && !dirty.isEmpty()) {
+        int cx = 0, cy = 0;
+        LatLonToXy(currentLat, currentLon, cx, cy);
+        QPoint shift = QPoint(width() / 2, height() / 2) - QPoint(cx, cy);
+        if (isDragging)
+            shift += tempOffset;
+        dirty.translate(shift);
+    }
+
+    // aisPredictionDirty disimpan dalam koordinat layar (sudah tergeser)
+    const QRect repaint = dirty | aisPredictionDirty;
+    if (!repaint.isEmpty()) {
+        update(repaint);
+    }
+    aisPredictionDirty = dirty;
+}
+
+void EcWidget::drawAisPrediction(QPainter& painter)
+{
+    if (!showAIS || !showAisPrediction || aisPredictedPx.size() != aisPrediction.size()) {
+        return;
+    }
+
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    for (int i = 0; i < aisPredictedPx.size(); ++i) {
+        const QPointF &p = aisPredictedPx[i];
+        const float confidence = aisPrediction.confidence[i];
+        if (qIsNaN(p.x()) || confidence <= 0.0f) {
+            continue;
+        }
+
+        // Target diam atau baru saja melapor: simbol kernel sudah di tempat yang benar
+        const QPointF &anchor = aisAnchorPx[i];
+        if (qAbs(p.x() - anchor.x()) + qAbs(p.y() - anchor.y()) < 2.0) {
+            continue;
+        }
+
+        // Makin tua laporan, makin pudar dan makin putus-putus garisnya
+        const int alpha = 60 + int(160 * confidence);
+        const Qt::PenStyle style = confidence > 0.66f ? Qt::SolidLine
+                                 : confidence > 0.33f ? Qt::DashLine
+                                                      : Qt::DotLine;
+        QColor color(0, 140, 255, alpha);
+
+        painter.setPen(QPen(color, 1, Qt::DotLine));
+        painter.drawLine(anchor, p);
+
+        painter.save();
+        painter.translate(p);
+        painter.rotate(aisPrediction.cog[i] - GetHeading());
+        QPolygonF hull;
+        hull << QPointF(0, -8) << QPointF(-5, 6) << QPointF(5, 6);
+        painter.setPen(QPen(color, 1.5, style));
+        color.setAlpha(alpha / 3);
+        painter.setBrush(color);
+        painter.drawPolygon(hull);
+        painter.restore();
+    }
+
+    painter.restore();
+}
+
 void EcWidget::drawPulsingWarning(QPainter& painter, int x, int y, const QColor& baseColor, int size)
 {
     static int pulsePhase = 0;
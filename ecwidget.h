@@ -14,6 +14,8 @@
 #include <QAction>
 #include <QMap>
 #include <QVector>
+#include <QCache>
+#include <QHash>
 
 // Forward declarations
 class TideManager;
@@ -42,6 +44,9 @@ class TideManager;
 // GRIB visualization
 #include "gribvisualisation.h"
 #include "gribdata.h"
+#include "geoprojector.h"
+#include "ownshiptrail.h"
+#include "labelplacer.h"
 class GribManager;
 
 //popup
@@ -128,8 +133,8 @@ extern ShipStruct navShip;
 extern ShipStruct mapShip;
 extern ActiveRouteStruct activeRoute;
 
-// Dynamic node ships storage
-extern QMap<QString, ShipStruct> nodeShips;
+// Dynamic node ships storage (NODE_REPORT_*)
+extern NodeFleet nodeFleet;
 
 extern QString bottomBarText;
 extern QString aivdo;
@@ -174,6 +179,10 @@ class RouteDeviationDetector; // Forward declaration
 // Waypoint
 #define PICKRADIUS  (0.03 * GetRange)
 #define PAN_MARGIN 500
+#define CHART_TILE_CACHE_KB   (192 * 1024)  // batas memori tile chart pan/zoom
+#define CHART_TILE_IDLE_MS    40            // jeda antar render tile prefetch
+#define CHART_TILE_QUIET_MS   750           // prefetch baru mulai setelah view diam selama ini
+#define CHART_TILE_MAX_DRIFT  4             // jarak view dari anchor (dalam tile) sebelum tile set dibangun ulang
 
 //Waypoint
 #include <QJsonDocument>
@@ -182,11 +191,15 @@ class RouteDeviationDetector; // Forward declaration
 #include <QElapsedTimer>
 #include "eblvrm.h"
 #include "aitargettracker.h"
+#include "aisfragmentassembler.h"
+#include "nodefleet.h"
+#include "aisdeadreckoner.h"
 
 // forward declerations1
 class PickWindow;
 class Ais;
 class MainWindow;
+class AisDvrSink;
 
 struct OwnShipStruct
 {
@@ -342,7 +355,13 @@ public:
 
   void drawWaypointMarker(EcCoordinate lat, EcCoordinate lon);
   void drawSingleWaypoint(EcCoordinate lat, EcCoordinate lon, const QString& label, const QColor& color = QColor(255, 140, 0));
-  void drawWaypointWithLabel(double lat, double lon, const QString& label, const QColor& color);
+  // labelRect kosong: label di kanan waypoint tanpa cek tabrakan (perilaku lama)
+  void drawWaypointWithLabel(double lat, double lon, const QString& label, const QColor& color,
+                             const QRect& labelRect = QRect());
+  // Key memori label per waypoint (bukan index di waypointList, yang bergeser saat insert/hapus)
+  QString waypointLabelKey(const Waypoint& wp) const;
+  // Kandidat label waypoint di anchor; priority: route terpilih 0, waypoint aktif 1, sisanya 2
+  LabelPlacer::Request waypointLabelRequest(const Waypoint& wp, const QPoint& anchor) const;
   QPoint findOptimalLabelPosition(int waypointX, int waypointY, const QSize& textSize, int minDistance);
   void drawGhostWaypoint(QPainter& painter, EcCoordinate lat, EcCoordinate lon, const QString& label);
   void drawGhostRouteLines(QPainter& painter, EcCoordinate ghostLat, EcCoordinate ghostLon, int routeId, int waypointIndex);
@@ -790,9 +809,32 @@ public:
   // Transforms geodetic coordinates (WGS84) to device coordinates
   virtual bool LatLonToXy (EcCoordinate lat, EcCoordinate lon, int & x, int & y);
 
+  // Batch LatLonToXy untuk overlay: satu transformasi per frame, hasil sama dengan LatLonToXy
+  // per titik (kecuali titik tepat di tengah dua piksel). ok[i] false untuk titik yang tidak
+  // bisa diproyeksikan.
+  void projectLatLon(const double *lat, const double *lon, int count, QPoint *out, bool *ok);
+  // Sama, tanpa pembulatan ke piksel (kernel fallback tetap piksel bulat)
+  void projectLatLon(const double *lat, const double *lon, int count, QPointF *out, bool *ok);
+  // Berubah setiap kali transformasi lat/lon -> layar berubah; untuk cache titik layar overlay
+  quint64 projectionStamp();
+
+  // Titik layar satu geometri overlay, disimpan sampai view atau isi lat/lon-nya berubah
+  struct ProjectedOverlay {
+      quint64 stamp = 0;
+      uint inputHash = 0;
+      QVector<QPoint> points;
+      QVector<bool> ok;
+  };
+  const ProjectedOverlay &projectOverlay(const QString &key, const QVector<double> &lat, const QVector<double> &lon);
+
   // Draws the chart
   void Draw();
   void waypointDraw();
+  // Seperti Draw(), tapi chart base diambil dari tile cache pan/zoom kalau memungkinkan
+  void DrawFromTiles();
+  // Paksa render ulang chart base pada draw(..., false) berikutnya
+  // (tile satelit baru, perubahan cell/display yang tidak lewat Draw())
+  void invalidateChartLayer() { ++chartLayerRevision; }
   void ownShipDraw();
   void setCustomOwnship(bool state);
 
@@ -907,6 +949,9 @@ public:
   void processDataQuickFix(double, double, double, double, double, double, double, double, double);
   void processMapInfoReq(QString);
   void processAis(QString);
+  void drainNavQueue();
+  NavRecordQueue::Stats navQueueStats() const { return navQueue.stats(); }
+  qint64 navQueueMaxLatencyUs() const { return navQueueMaxLatencyNs / 1000; }
   void publishToMOOSDB(QString, QString);
   void publishToMOOS(QString, QString);
 
@@ -945,8 +990,12 @@ public:
   void setMainWindow(MainWindow*);
 
   // OWNSHIP TRAIL
-  QList<QPair<QString, QString>> ownShipTrailPoints;
+  OwnShipTrail ownShipTrail;
   void clearOwnShipTrail();
+  // Track historis MMSI dalam [from, to] dari AisDatabaseManager::getSimplifiedTracks,
+  // disederhanakan sesuai skala chart dan dimuat ulang saat level toleransi berubah
+  void showHistoricalTracks(const QList<quint32> &mmsis, const QDateTime &from, const QDateTime &to);
+  void clearHistoricalTracks();
   double haversine(double lat1, double lon1, double lat2, double lon2);
 
   // GETTER SETTER AISSUB VAR
@@ -1107,7 +1156,8 @@ protected:
   // Drawing functions
   void clearBackground();
 
-  virtual void draw (bool update);
+  // force = false: kernel chart draw dilewati kalau chartLayerKey masih sama
+  virtual void draw (bool update, bool force = true);
   virtual void drawWorks (bool update);
   virtual void drawAISCell ();
 
@@ -1258,8 +1308,132 @@ public:
   QPixmap drawPixmap; // pixmap used for the final drawing
   QPixmap chartWaypointPixmap;
 
+  // LAYER CACHE
+  // chart base (chartPixmap) -> + AIS cell (aisLayerPixmap) -> + route/waypoint
+  // (routeLayerPixmap, transparan) -> overlay dinamis (ownship, current, dll) selalu digambar ulang.
+  // Tiap layer disimpan bersama key-nya; tick 1 Hz hanya menggambar ulang layer yang key-nya berubah.
+  struct ChartLayerKey {
+      EcCoordinate lat = 0;
+      EcCoordinate lon = 0;
+      int scale = 0;
+      double heading = 0;
+      int projection = 0;
+      QSize size;
+      bool grid = false;
+      bool satellite = false;
+      int colorScheme = 0;
+      int brightness = 0;
+      bool greyMode = false;
+      quint64 revision = 0;
+
+      bool operator== (const ChartLayerKey &o) const {
+          return lat == o.lat && lon == o.lon && scale == o.scale && heading == o.heading &&
+                 projection == o.projection && size == o.size && grid == o.grid &&
+                 satellite == o.satellite && colorScheme == o.colorScheme &&
+                 brightness == o.brightness && greyMode == o.greyMode && revision == o.revision;
+      }
+      bool operator!= (const ChartLayerKey &o) const { return !(*this == o); }
+  };
+  ChartLayerKey currentChartLayerKey() const;
+  uint routeLayerHash();
+  void drawRouteLayer();
+
+  quint64 chartLayerRevision = 0;
+  ChartLayerKey chartLayerKey;        // view saat chartPixmap terakhir dirender kernel
+  qint64 chartLayerPixmapKey = 0;     // chartPixmap.cacheKey() setelah render; beda = pixmap ditimpa pihak lain
+  bool chartLayerValid = false;
+
+  QPixmap aisLayerPixmap;             // chartPixmap + AIS cell
+  qint64 aisLayerChartKey = 0;
+  EcCellId aisLayerCellId = EC_NOCELLID;
+  quint64 aisLayerCellRevision = 0;
+  quint64 aisLayerEpoch = 0;
+  bool aisLayerValid = false;
+
+  // CHART TILE CACHE (pan/zoom)
+  // Tile seukuran viewport (kernel hanya punya satu surface gambar), dirender dengan proyeksi
+  // yang di-anchor ke satu titik sehingga tile (x, y) menutup piksel [x*w, (x+1)*w) dari anchor.
+  // Tile tetangga dan skala zoom berikutnya/sebelumnya dirender saat idle.
+  struct ChartTileId {
+      int scale;
+      int x;
+      int y;
+      bool operator== (const ChartTileId &o) const { return scale == o.scale && x == o.x && y == o.y; }
+      friend uint qHash(const ChartTileId &id, uint seed = 0) { return qHash(id.scale, qHash(id.x, qHash(id.y, seed))); }
+  };
+  void drawScene(bool forceChart);
+  bool chartTilesEnabled() const;
+  ChartLayerKey currentTileSetKey() const;
+  bool chartTileSetMatches() const;
+  void resetChartTiles();
+  bool chartTileOrigin(int scale, EcCoordinate lat, EcCoordinate lon, QPoint &origin);
+  bool renderChartTile(const ChartTileId &id);
+  bool drawChartFromTiles();
+  void noteChartInTileFrame();
+  void restoreChartViewport();
+  void scheduleChartTilePrefetch();
+  int chartTilePrefetchDelay() const;
+  void prefetchChartTile();
+  void drawChartTilesBehind(QPainter &painter);
+  int wheelScale(bool zoomIn) const;
+
+  QCache<ChartTileId, QPixmap> chartTiles;  // cost dalam KB
+  QList<ChartTileId> chartTileQueue;
+  QTimer chartTilePrefetchTimer;
+  QElapsedTimer chartTileQuiet;       // sejak Draw() paksa atau perubahan view terakhir
+  EcCoordinate chartTileQuietLat = 0, chartTileQuietLon = 0;
+  int chartTileQuietScale = 0;
+  ChartLayerKey chartTileKey;         // lat/lon = anchor proyeksi, scale tidak dipakai
+  bool chartTilesValid = false;
+  // Viewport yang sedang ada di chartPixmap; dipulihkan setelah render tile
+  EcCoordinate chartProjLat = 0, chartProjLon = 0;
+  EcCoordinate chartViewLat = 0, chartViewLon = 0;
+  int chartViewScale = 0;
+  QPoint chartViewOrigin;             // posisi chartPixmap dalam frame tile
+  bool chartViewInTileFrame = false;
+  bool panUsesMargin = false;         // drag lama dengan buffer PAN_MARGIN (tile cache tidak aktif)
+
+  // FRAME PROJECTOR
+  // Transformasi lat/lon -> layar dari viewport kernel saat ini, di-capture ulang kalau key berubah
+  struct FrameProjectorKey {
+      EcCoordinate projLat = 0, projLon = 0;
+      EcCoordinate viewLat = 0, viewLon = 0;
+      int scale = 0;
+      double heading = 0;
+      int projection = 0;
+      QSize size;
+      quint64 viewChange = 0;
+      quint64 generation = 0;
+
+      bool operator== (const FrameProjectorKey &o) const {
+          return projLat == o.projLat && projLon == o.projLon && viewLat == o.viewLat &&
+                 viewLon == o.viewLon && scale == o.scale && heading == o.heading &&
+                 projection == o.projection && size == o.size &&
+                 viewChange == o.viewChange && generation == o.generation;
+      }
+  };
+  const GeoProjector &frameProjector();
+  // Viewport kernel mungkin berubah tanpa lewat SetCenter/SetScale/SetHeading (render tile, draw)
+  void invalidateFrameProjector() { ++frameProjectorGeneration; }
+
+  GeoProjector frameProjectorCache;
+  FrameProjectorKey frameProjectorKey;
+  quint64 frameProjectorGeneration = 0;
+  bool frameProjectorCaptured = false;
+  quint64 frameProjectionStamp = 0;
+  QHash<QString, ProjectedOverlay> projectedOverlays;
+  quint64 projectedOverlaysStamp = 0;
+
+  QPixmap routeLayerPixmap;
+  QList<QRect> routeLayerLabelRects;  // label hasil waypointDraw() untuk layer ini
+  int routeLayerWaypointLabelCount = 0;
+  uint routeLayerKey = 0;
+  bool routeLayerValid = false;
+
   bool initialized;
   Ais  *_aisObj;
+  AisFragmentAssembler aisAssembler; // WAIS_NMEA multi-sentence reassembly (recording path)
+  AisDvrSink *dvrSink = nullptr;     // di-resolve sekali, bukan per kalimat
 
   // AOI store
   QList<AOI> aoiList;
@@ -1399,7 +1573,11 @@ private:
   } ghostWaypoint;
 
   // Label collision tracking (cleared at start of each Draw())
-  QList<QRect> usedLabelRects;
+  LabelPlacer labelPlacer;
+  // Label yang sudah ada di drawPixmap (route layer); label overlay paintEvent mulai dari sini
+  QList<QRect> sceneLabelRects;
+  // Jumlah rect label waypoint di awal sceneLabelRects (sisanya label leg)
+  int sceneWaypointLabelCount = 0;
 
   // Highlighted waypoint for route panel selection visualization
   struct HighlightedWaypoint {
@@ -1524,6 +1702,12 @@ private:
   QThread* threadAIS = nullptr;
   AISSubscriber *subscriber = nullptr;
 
+  // Hand-off AISSubscriber -> GUI, di-drain sekali per frame oleh navDrainTimer
+  NavRecordQueue navQueue;
+  QTimer navDrainTimer;
+  qint64 navQueueMaxLatencyNs = 0;
+  quint64 navSpillLostReported = 0;
+
   QThread* threadAISMAP;
   QTcpSocket* socketAISMAP;
   std::atomic<bool> stopThreadMAP;
@@ -1611,6 +1795,23 @@ private:
   void drawWarningTriangle(QPainter& painter, int x, int y, int size, const QColor& color);
   void drawCPATCPAIndicators(QPainter& painter);
 
+  // Prediksi posisi target AIS di antara laporan (dead reckoning per frame)
+  void updateAisPrediction();
+  void rebuildAisAnchors(const AisTargetSnapshot& targets);
+  void drawAisPrediction(QPainter& painter);
+
+  bool showAisPrediction = true;
+  AisDeadReckoner aisReckoner;
+  AisPrediction aisPrediction;
+  QTimer aisPredictTimer;
+  QVector<QPointF> aisAnchorPx;       // posisi laporan (map-space), NaN = di luar view
+  QVector<double> aisAnchorLatScale;  // koreksi Mercator dy/dlat terhadap latitude referensi
+  QPointF aisPxPerDegLat, aisPxPerDegLon;
+  quint64 aisAnchorEpoch = ~quint64(0);
+  quint64 aisAnchorView = ~quint64(0);
+  QVector<QPointF> aisPredictedPx;
+  QRect aisPredictionDirty;
+
   AISTargetData ownShipData;
   bool showCustomOwnShip = false; // Mulai tersembunyi sampai posisi ownship valid
   bool showOwnShipTrail;
@@ -1643,6 +1844,24 @@ private:
   // OWNSHIP TRACK VAR
   void addOwnShipPoint(double, double);
   void drawOwnShipTrail(QPainter &painter);
+  // bbox lat/lon (x = lon, y = lat) area layar; false kalau tidak bisa (proyeksi, antimeridian)
+  bool viewGeoBounds(const QRect &area, QRectF &bounds);
+  QVector<QPolygonF> ownShipTrailPolygons;  // titik layar ekor per potongan, dipakai ulang selama view/ekor/level sama
+  quint64 ownShipTrailStamp = 0;
+  quint64 ownShipTrailRevision = 0;
+  int ownShipTrailLevel = 0;
+
+  // HISTORICAL TRACK VAR (playback DB)
+  void drawHistoricalTracks(QPainter &painter);
+  void loadHistoricalTracks();
+  QList<quint32> historicalTrackMmsis;
+  QDateTime historicalTrackFrom;
+  QDateTime historicalTrackTo;
+  QVector<QVector<TrackPoint>> historicalTracks;  // hasil getSimplifiedTracks untuk historicalTrackLevel
+  int historicalTrackLevel = -1;
+  bool historicalTrackLoadPending = false;
+  QVector<QPolygonF> historicalTrackPolygons;     // titik layar, dipakai ulang selama view/data sama
+  quint64 historicalTrackStamp = 0;
 
   // AUTO RECENTER
   QRect GetVisibleMapRect();
@@ -0,0 +1,235 @@
+#include "geoprojector.h"
+
+#include <QtMath>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double kWgs84E = 0.0818191908426215;     // eksentrisitas WGS84
+const double kMaxMercatorLat = 89.5;
+const int kSampleGrid = 5;                      // 5x5 titik fit di viewport
+
+double normalizeLon(double dLon)
+{
+    return dLon - 360.0 * std::floor((dLon + 180.0) / 360.0);
+}
+
+// Lintang isometrik ellipsoid (ordinat Mercator tanpa skala)
+double isometricLat(double latRad)
+{
+    const double s = std::sin(latRad);
+    return std::atanh(s) - kWgs84E * std::atanh(kWgs84E * s);
+}
+
+} // namespace
+
+bool GeoProjector::capture(Projection projection, double refLat, double refLon, const QSize &viewSize,
+                           const ForwardFn &forward, const InverseFn &inverse)
+{
+    m_valid = false;
+    if (viewSize.width() < 2 || viewSize.height() < 2)
+        return false;
+
+    m_projection = projection;
+    if (projection == PolarStereographic) {
+        // Beda bujur pusat hanya memutar bidang, diserap oleh affine
+        refLat = (refLat >= 0) ? 90.0 : -90.0;
+    }
+    m_refLat = qDegreesToRadians(refLat);
+    m_refLon = refLon;
+    m_sinRef = std::sin(m_refLat);
+    m_cosRef = std::cos(m_refLat);
+    m_mercRef = isometricLat(qDegreesToRadians(qBound(-kMaxMercatorLat, refLat, kMaxMercatorLat)));
+
+    // Titik fit: grid piksel bulat -> lat/lon kernel -> bidang proyeksi
+    QVector<double> lat, lon, sx, sy;
+    for (int j = 0; j < kSampleGrid; ++j) {
+        for (int i = 0; i < kSampleGrid; ++i) {
+            const int x = (viewSize.width() - 1) * i / (kSampleGrid - 1);
+            const int y = (viewSize.height() - 1) * j / (kSampleGrid - 1);
+            double la = 0, lo = 0;
+            if (!inverse(x, y, la, lo) || !std::isfinite(la) || !std::isfinite(lo))
+                continue;
+            lat.append(la);
+            lon.append(lo);
+            sx.append(x);
+            sy.append(y);
+        }
+    }
+    const int n = lat.size();
+    if (n < 6)
+        return false;
+
+    QVector<double> u(n), v(n);
+    toPlane(lat.constData(), lon.constData(), n, u.data(), v.data());
+
+    // Least squares terpusat: (x - mx) = a (u - mu) + b (v - mv), sama untuk y
+    double mu = 0, mv = 0, mx = 0, my = 0;
+    for (int k = 0; k < n; ++k) {
+        if (!std::isfinite(u[k]) || !std::isfinite(v[k]))
+            return false;
+        mu += u[k]; mv += v[k]; mx += sx[k]; my += sy[k];
+    }
+    mu /= n; mv /= n; mx /= n; my /= n;
+
+    double suu = 0, suv = 0, svv = 0, sux = 0, svx = 0, suy = 0, svy = 0;
+    for (int k = 0; k < n; ++k) {
+        const double du = u[k] - mu, dv = v[k] - mv;
+        const double dx = sx[k] - mx, dy = sy[k] - my;
+        suu += du * du; suv += du * dv; svv += dv * dv;
+        sux += du * dx; svx += dv * dx;
+        suy += du * dy; svy += dv * dy;
+    }
+    const double det = suu * svv - suv * suv;
+    if (!(std::fabs(det) > 0))
+        return false;
+
+    m_a = (sux * svv - svx * suv) / det;
+    m_b = (svx * suu - sux * suv) / det;
+    m_d = (suy * svv - svy * suv) / det;
+    m_e = (svy * suu - suy * suv) / det;
+    m_c = mx - m_a * mu - m_b * mv;
+    m_f = my - m_d * mu - m_e * mv;
+
+    // Cek terhadap kernel di titik fit dan di tengah-tengahnya (posisi tidak bulat),
+    // sekaligus menentukan konvensi pembulatan kernel (round atau floor)
+    QVector<double> clat(lat), clon(lon);
+    for (int k = 0; k + 1 < n; ++k) {
+        clat.append((lat[k] + lat[k + 1]) * 0.5);
+        clon.append(lon[k] + normalizeLon(lon[k + 1] - lon[k]) * 0.5);
+    }
+
+    QVector<QPointF> ours(clat.size());
+    project(clat.constData(), clon.constData(), clat.size(), ours.data());
+
+    QVector<QPointF> residual;
+    residual.reserve(clat.size());
+    for (int k = 0; k < clat.size(); ++k) {
+        int kx = 0, ky = 0;
+        if (!forward(clat[k], clon[k], kx, ky) || !std::isfinite(ours[k].x()))
+            continue;
+        residual.append(QPointF(kx - ours[k].x(), ky - ours[k].y()));
+    }
+    if (residual.size() < n)
+        return false;
+
+    auto maxAbs = [&residual](double bias) {
+        double worst = 0;
+        for (const QPointF &r : residual) {
+            worst = qMax(worst, qMax(std::fabs(r.x() - bias), std::fabs(r.y() - bias)));
+        }
+        return worst;
+    };
+
+    // Kernel membulatkan: |r| <= 0.5. Kernel memotong (floor): r di (-1, 0], digeser setengah piksel.
+    const double limit = 0.5 + GEO_PROJECTOR_TOLERANCE_PX;
+    double bias = 0;
+    if (maxAbs(0) > limit && maxAbs(-0.5) <= limit) {
+        bias = -0.5;
+    }
+    m_c += bias;
+    m_f += bias;
+    m_maxError = maxAbs(bias);
+    if (m_maxError > limit)
+        return false;
+
+    m_valid = true;
+    return true;
+}
+
+bool GeoProjector::sameTransform(const GeoProjector &o) const
+{
+    return m_valid == o.m_valid && m_projection == o.m_projection &&
+           m_refLat == o.m_refLat && m_refLon == o.m_refLon &&
+           m_a == o.m_a && m_b == o.m_b && m_c == o.m_c &&
+           m_d == o.m_d && m_e == o.m_e && m_f == o.m_f;
+}
+
+// Bidang lokal per proyeksi; loop tanpa cabang per titik supaya bisa divektorisasi compiler
+void GeoProjector::toPlane(const double *lat, const double *lon, int count, double *u, double *v) const
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double deg = M_PI / 180.0;
+
+    switch (m_projection) {
+    case Mercator:
+        for (int i = 0; i < count; ++i) {
+            const double la = qBound(-kMaxMercatorLat, lat[i], kMaxMercatorLat) * deg;
+            u[i] = normalizeLon(lon[i] - m_refLon) * deg;
+            v[i] = isometricLat(la) - m_mercRef;
+        }
+        break;
+
+    case Cylindrical:
+        for (int i = 0; i < count; ++i) {
+            u[i] = normalizeLon(lon[i] - m_refLon) * deg;
+            v[i] = lat[i] * deg - m_refLat;
+        }
+        break;
+
+    case Stereographic:
+    case PolarStereographic:
+        for (int i = 0; i < count; ++i) {
+            const double la = lat[i] * deg;
+            const double dl = normalizeLon(lon[i] - m_refLon) * deg;
+            const double s = std::sin(la), c = std::cos(la), cdl = std::cos(dl);
+            const double denom = 1.0 + m_sinRef * s + m_cosRef * c * cdl;
+            const double k = (denom > 1e-12) ? 2.0 / denom : nan;
+            u[i] = k * c * std::sin(dl);
+            v[i] = k * (m_cosRef * s - m_sinRef * c * cdl);
+        }
+        break;
+
+    case Gnomonic:
+        for (int i = 0; i < count; ++i) {
+            const double la = lat[i] * deg;
+            const double dl = normalizeLon(lon[i] - m_refLon) * deg;
+            const double s = std::sin(la), c = std::cos(la), cdl = std::cos(dl);
+            const double cosc = m_sinRef * s + m_cosRef * c * cdl;
+            const double k = (cosc > 1e-6) ? 1.0 / cosc : nan;
+            u[i] = k * c * std::sin(dl);
+            v[i] = k * (m_cosRef * s - m_sinRef * c * cdl);
+        }
+        break;
+    }
+}
+
+int GeoProjector::project(const double *lat, const double *lon, int count, QPointF *out) const
+{
+    double u[GEO_PROJECTOR_CHUNK];
+    double v[GEO_PROJECTOR_CHUNK];
+    int valid = 0;
+
+    for (int begin = 0; begin < count; begin += GEO_PROJECTOR_CHUNK) {
+        const int n = qMin(GEO_PROJECTOR_CHUNK, count - begin);
+        toPlane(lat + begin, lon + begin, n, u, v);
+        for (int i = 0; i < n; ++i) {
+            const double x = m_a * u[i] + m_b * v[i] + m_c;
+            const double y = m_d * u[i] + m_e * v[i] + m_f;
+            out[begin + i] = QPointF(x, y);
+            valid += std::isfinite(x) ? 1 : 0;
+        }
+    }
+    return valid;
+}
+
+QPolygonF GeoProjector::project(const QVector<QPointF> &latLon) const
+{
+    const int count = latLon.size();
+    QVector<double> lat(count), lon(count);
+    for (int i = 0; i < count; ++i) {
+        lat[i] = latLon[i].x();
+        lon[i] = latLon[i].y();
+    }
+
+    QPolygonF out(count);
+    project(lat.constData(), lon.constData(), count, out.data());
+    return out;
+}
+
+bool GeoProjector::project(double lat, double lon, QPointF &out) const
+{
+    project(&lat, &lon, 1, &out);
+    return std::isfinite(out.x()) && std::isfinite(out.y());
+}
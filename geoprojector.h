@@ -0,0 +1,68 @@
+#ifndef GEOPROJECTOR_H
+#define GEOPROJECTOR_H
+
+#include <QPoint>
+#include <QPointF>
+#include <QPolygonF>
+#include <QSize>
+#include <QVector>
+#include <functional>
+
+#define GEO_PROJECTOR_TOLERANCE_PX  0.05    // selisih maksimum terhadap kernel di luar pembulatan piksel
+#define GEO_PROJECTOR_CHUNK         256     // titik per blok saat proyeksi array
+
+// Proyeksi lat/lon -> piksel layar untuk satu frame tanpa memanggil kernel per titik.
+// Rumus proyeksi (Mercator WGS84, stereografik, gnomonik, silinder) memberi bidang lokal
+// di sekitar pusat proyeksi; affine ke piksel (skala, heading, offset) di-fit dari titik
+// XyToLatLon kernel lalu dicek ulang dengan LatLonToXy kernel. Hasilnya memakai konvensi
+// pembulatan kernel, jadi QPointF::toPoint() sama dengan LatLonToXy. Kalau cek gagal
+// isValid() false dan pemanggil kembali ke kernel.
+class GeoProjector
+{
+public:
+    enum Projection {
+        Mercator,
+        Stereographic,
+        PolarStereographic,
+        Gnomonic,
+        Cylindrical
+    };
+
+    typedef std::function<bool(double lat, double lon, int &x, int &y)> ForwardFn;
+    typedef std::function<bool(int x, int y, double &lat, double &lon)> InverseFn;
+
+    bool capture(Projection projection, double refLat, double refLon, const QSize &viewSize,
+                 const ForwardFn &forward, const InverseFn &inverse);
+    void reset() { m_valid = false; }
+    bool isValid() const { return m_valid; }
+
+    // Transformasi identik (view tidak berubah sejak capture sebelumnya)
+    bool sameTransform(const GeoProjector &o) const;
+    // Selisih terbesar terhadap kernel saat capture, sudah termasuk pembulatan piksel
+    double maxError() const { return m_maxError; }
+
+    // Proyeksi array. Titik yang tidak bisa diproyeksikan (gnomonik di balik horizon) jadi NaN.
+    // Return jumlah titik valid.
+    int project(const double *lat, const double *lon, int count, QPointF *out) const;
+    // QPointF(lat, lon), konvensi yang sama dengan AOI::vertices
+    QPolygonF project(const QVector<QPointF> &latLon) const;
+    bool project(double lat, double lon, QPointF &out) const;
+
+private:
+    void toPlane(const double *lat, const double *lon, int count, double *u, double *v) const;
+
+    bool m_valid = false;
+    Projection m_projection = Mercator;
+    double m_refLat = 0;        // radian
+    double m_refLon = 0;        // derajat, untuk normalisasi beda bujur
+    double m_sinRef = 0;
+    double m_cosRef = 1;
+    double m_mercRef = 0;
+
+    // piksel = A * (u, v) + t
+    double m_a = 0, m_b = 0, m_c = 0;
+    double m_d = 0, m_e = 0, m_f = 0;
+    double m_maxError = 0;
+};
+
+#endif // GEOPROJECTOR_H
@@ -103,21 +103,25 @@ void GribVisualisation::drawWaveHeightGrid(QPainter& painter,
         return;
     }
 
+    projectMessage(ecWidget, message);
+
     // Calculate cell size in screen coordinates
     // Use first and second points to estimate grid cell size
     int x1, y1, x2, y2;
-    if (!ecWidget->LatLonToXy(message.dataPoints[0].latitude,
-                             message.dataPoints[0].longitude, x1, y1)) {
+    if (!m_screenOk[0]) {
         return;
     }
+    x1 = m_screen[0].x();
+    y1 = m_screen[0].y();
 
     // Find a point in next row/column to estimate cell size
     int nextIdx = message.ni;  // Next row
     if (nextIdx < message.dataPoints.size()) {
-        if (!ecWidget->LatLonToXy(message.dataPoints[nextIdx].latitude,
-                                  message.dataPoints[nextIdx].longitude, x2, y2)) {
+        if (!m_screenOk[nextIdx]) {
             return;
         }
+        x2 = m_screen[nextIdx].x();
+        y2 = m_screen[nextIdx].y();
     } else {
         x2 = x1;
         y2 = y1 + 20;  // Default cell height
@@ -131,15 +135,17 @@ void GribVisualisation::drawWaveHeightGrid(QPainter& painter,
     cellWidth = qBound(6, cellWidth, 75);
 
     // Draw grid cells
-    for (const auto& data : message.dataPoints) {
+    for (int idx = 0; idx < message.dataPoints.size(); ++idx) {
+        const auto& data = message.dataPoints[idx];
         if (!data.isValid || data.waveHeight < -900) {
             continue;
         }
 
-        int x, y;
-        if (!ecWidget->LatLonToXy(data.latitude, data.longitude, x, y)) {
+        if (!m_screenOk[idx]) {
             continue;
         }
+        const int x = m_screen[idx].x();
+        const int y = m_screen[idx].y();
 
         // Check if point is in viewport (with margin)
         QPoint topLeft(x - cellWidth / 2, y - cellHeight / 2);
@@ -171,6 +177,8 @@ void GribVisualisation::drawDirectionArrows(QPainter& painter,
     iStep = density;
     jStep = density;
 
+    projectMessage(ecWidget, message);
+
     QPen arrowPen(QColor(50, 50, 50, 200), 2);
     painter.setPen(arrowPen);
     painter.setBrush(QColor(50, 50, 50, 180));
@@ -187,10 +195,11 @@ void GribVisualisation::drawDirectionArrows(QPainter& painter,
                 continue;
             }
 
-            int x, y;
-            if (!ecWidget->LatLonToXy(data.latitude, data.longitude, x, y)) {
+            if (!m_screenOk[idx]) {
                 continue;
             }
+            const int x = m_screen[idx].x();
+            const int y = m_screen[idx].y();
 
             // Check if point is in viewport
             if (!viewportRect.contains(x, y)) {
@@ -208,6 +217,38 @@ void GribVisualisation::drawDirectionArrows(QPainter& painter,
     }
 }
 
+void GribVisualisation::projectMessage(EcWidget* ecWidget, const GribMessage& message)
+{
+    const int count = message.dataPoints.size();
+    const GribWaveData* data = message.dataPoints.constData();
+    const quint64 stamp = ecWidget->projectionStamp();
+    // Alamat buffer bisa dipakai ulang oleh pesan lain: ujung grid ikut dibandingkan
+    const bool sameMessage = data == m_screenData && count == m_screenCount && count > 0
+                             && m_lat.first() == data[0].latitude && m_lon.first() == data[0].longitude
+                             && m_lat.last() == data[count - 1].latitude && m_lon.last() == data[count - 1].longitude;
+    if (sameMessage && stamp == m_screenStamp) {
+        return;
+    }
+
+    // Koordinat grid disalin ke array lat/lon terpisah hanya saat pesan berganti
+    if (!sameMessage) {
+        m_lat.resize(count);
+        m_lon.resize(count);
+        for (int i = 0; i < count; ++i) {
+            m_lat[i] = data[i].latitude;
+            m_lon[i] = data[i].longitude;
+        }
+    }
+
+    m_screen.resize(count);
+    m_screenOk.resize(count);
+    ecWidget->projectLatLon(m_lat.constData(), m_lon.constData(), count, m_screen.data(), m_screenOk.data());
+
+    m_screenData = data;
+    m_screenCount = count;
+    m_screenStamp = stamp;
+}
+
 QPolygonF GribVisualisation::createArrow(double x, double y, double size, double directionDegrees) const
 {
     // Convert meteorological direction (from North, clockwise) to mathematical angle
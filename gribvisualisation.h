@@ -119,12 +119,27 @@ private:
      */
     void initializeColorScale();
 
+    /**
+     * @brief Screen positions of all data points, projected in one batch
+     * Cached per message until the view transform changes (EcWidget::projectionStamp())
+     */
+    void projectMessage(EcWidget* ecWidget, const GribMessage& message);
+
 private:
     QVector<QColor> m_colorScale;
     QVector<double> m_colorBreakpoints;  // Wave height values for color transitions
     double m_maxWaveHeight;
     int m_heatmapOpacity;
     int m_arrowSize;
+
+    // Screen cache for projectMessage()
+    const GribWaveData* m_screenData = nullptr;
+    int m_screenCount = 0;
+    quint64 m_screenStamp = 0;
+    QVector<double> m_lat;
+    QVector<double> m_lon;
+    QVector<QPoint> m_screen;
+    QVector<bool> m_screenOk;
 };
 
 #endif // GRIBVISUALISATION_H
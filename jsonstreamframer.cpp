@@ -0,0 +1,118 @@
+#include "jsonstreamframer.h"
+
+JsonStreamFramer::JsonStreamFramer(int maxObjectBytes, qint64 staleMs)
+    : m_maxObjectBytes(maxObjectBytes),
+      m_staleMs(staleMs)
+{
+}
+
+void JsonStreamFramer::reset()
+{
+    m_buffer.clear();
+    m_readPos = 0;
+    m_scanPos = 0;
+    m_objectStart = -1;
+    m_depth = 0;
+    m_inString = false;
+    m_escape = false;
+    m_discarding = false;
+}
+
+void JsonStreamFramer::dropPartial()
+{
+    m_readPos = m_scanPos;
+    m_objectStart = -1;
+    m_depth = 0;
+    m_inString = false;
+    m_escape = false;
+    m_discarding = false;
+}
+
+void JsonStreamFramer::append(const QByteArray &data)
+{
+    // A half object that never finishes is stale data, not something to wait for
+    if (m_depth > 0 && m_partialTimer.hasExpired(m_staleMs)) {
+        ++m_stats.stale;
+        dropPartial();
+    }
+
+    if (m_readPos >= m_buffer.size()) {
+        // Everything consumed: start over without moving anything
+        m_buffer.clear();
+        m_readPos = 0;
+        m_scanPos = 0;
+    } else if (m_readPos > 0 && m_readPos >= m_buffer.size() / 2) {
+        // Only the tail of a partial object is left; compacting it here keeps
+        // the total copy cost linear in the stream size
+        m_buffer.remove(0, m_readPos);
+        m_scanPos -= m_readPos;
+        if (m_objectStart >= 0)
+            m_objectStart -= m_readPos;
+        m_readPos = 0;
+    }
+
+    m_buffer.append(data);
+}
+
+bool JsonStreamFramer::next(QByteArray &object)
+{
+    const char *data = m_buffer.constData();
+    const int size = m_buffer.size();
+
+    for (int i = m_scanPos; i < size; ++i) {
+        const char c = data[i];
+
+        if (m_depth == 0) {
+            if (c == '{') {
+                m_objectStart = i;
+                m_depth = 1;
+                m_inString = false;
+                m_escape = false;
+                m_partialTimer.start();
+            } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                ++m_stats.discardedBytes;
+            }
+            continue;
+        }
+
+        if (m_inString) {
+            if (m_escape)
+                m_escape = false;
+            else if (c == '\\')
+                m_escape = true;
+            else if (c == '"')
+                m_inString = false;
+        } else if (c == '"') {
+            m_inString = true;
+        } else if (c == '{') {
+            ++m_depth;
+        } else if (c == '}' && --m_depth == 0) {
+            if (m_discarding) {
+                // End of the oversized object: normal framing resumes after it
+                m_discarding = false;
+                m_readPos = i + 1;
+                continue;
+            }
+            object = QByteArray::fromRawData(data + m_objectStart, i + 1 - m_objectStart);
+            m_scanPos = i + 1;
+            m_readPos = i + 1;
+            m_objectStart = -1;
+            ++m_stats.objects;
+            return true;
+        }
+
+        if (!m_discarding && i + 1 - m_objectStart > m_maxObjectBytes) {
+            // Keep tracking depth and strings until the object closes, so its inner
+            // objects are not mistaken for new top-level ones
+            ++m_stats.overflows;
+            m_discarding = true;
+            m_objectStart = -1;
+            m_readPos = i + 1;
+        }
+    }
+
+    m_scanPos = size;
+    if (m_depth == 0 || m_discarding)
+        m_readPos = size;
+    return false;
+}
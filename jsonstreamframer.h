@@ -0,0 +1,54 @@
+#ifndef JSONSTREAMFRAMER_H
+#define JSONSTREAMFRAMER_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+// Incremental framer for a stream of concatenated JSON objects (MOOS bridge).
+// Scan position and brace/string/escape state survive across append() calls, so
+// every byte is looked at once no matter how the socket splits the stream.
+// Braces inside string values are ignored. Bytes outside an object are skipped.
+class JsonStreamFramer {
+public:
+    struct Stats {
+        quint64 objects = 0;
+        quint64 discardedBytes = 0;  // non-whitespace bytes outside any object
+        quint64 overflows = 0;       // objects dropped for exceeding maxObjectBytes
+        quint64 stale = 0;           // partial objects dropped by timeout
+    };
+
+    explicit JsonStreamFramer(int maxObjectBytes = 50000, qint64 staleMs = 10000);
+
+    void append(const QByteArray &data);
+
+    // Next complete object as a QByteArray::fromRawData view into the internal buffer.
+    // The view stays valid until the next append() or reset().
+    bool next(QByteArray &object);
+
+    void reset();
+
+    bool hasPartial() const { return m_depth > 0; }
+    bool isDiscarding() const { return m_discarding; }
+    int pendingBytes() const { return m_buffer.size() - m_readPos; }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    void dropPartial();
+
+    QByteArray m_buffer;
+    int m_readPos = 0;      // everything before this is consumed
+    int m_scanPos = 0;      // next byte to look at
+    int m_objectStart = -1;
+    int m_depth = 0;
+    bool m_inString = false;
+    bool m_escape = false;
+    bool m_discarding = false;  // skipping the rest of an oversized object
+
+    int m_maxObjectBytes;
+    qint64 m_staleMs;
+    QElapsedTimer m_partialTimer;
+    Stats m_stats;
+};
+
+#endif // JSONSTREAMFRAMER_H
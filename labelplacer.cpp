@@ -0,0 +1,130 @@
+#include "labelplacer.h"
+
+#include <algorithm>
+
+namespace {
+
+const int kMemoryFrames = 16;       // posisi label yang tidak muncul selama N frame dilupakan
+const int kMemoryPruneSize = 1024;
+
+} // namespace
+
+quint64 LabelPlacer::cellKey(int cx, int cy)
+{
+    return (quint64(quint32(cx)) << 32) | quint32(cy);
+}
+
+// Pembagian ke bawah supaya koordinat negatif (label di luar layar) masuk bucket yang benar
+int LabelPlacer::cellOf(int v)
+{
+    return (v >= 0) ? v / LABEL_GRID_CELL : -((-v + LABEL_GRID_CELL - 1) / LABEL_GRID_CELL);
+}
+
+void LabelPlacer::clear()
+{
+    m_rects.clear();
+    m_grid.clear();
+    ++m_frame;
+
+    if (m_memory.size() > kMemoryPruneSize) {
+        for (auto it = m_memory.begin(); it != m_memory.end();) {
+            if (it.value().frame + kMemoryFrames < m_frame)
+                it = m_memory.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+void LabelPlacer::setOccupied(const QList<QRect> &rects)
+{
+    clear();
+    for (const QRect &rect : rects) {
+        occupy(rect);
+    }
+}
+
+bool LabelPlacer::isFree(const QRect &rect) const
+{
+    const QRect probe = rect.adjusted(-LABEL_MARGIN, -LABEL_MARGIN, LABEL_MARGIN, LABEL_MARGIN);
+    const int x0 = cellOf(probe.left()), x1 = cellOf(probe.right());
+    const int y0 = cellOf(probe.top()), y1 = cellOf(probe.bottom());
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const auto bucket = m_grid.constFind(cellKey(cx, cy));
+            if (bucket == m_grid.constEnd())
+                continue;
+            for (int index : bucket.value()) {
+                if (probe.intersects(m_rects.at(index)))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+void LabelPlacer::occupy(const QRect &rect)
+{
+    const int index = m_rects.size();
+    m_rects.append(rect);
+
+    const int x0 = cellOf(rect.left()), x1 = cellOf(rect.right());
+    const int y0 = cellOf(rect.top()), y1 = cellOf(rect.bottom());
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            m_grid[cellKey(cx, cy)].append(index);
+        }
+    }
+}
+
+int LabelPlacer::place(const QString &key, const QPoint &anchor, const QVector<QRect> &candidates)
+{
+    if (candidates.isEmpty())
+        return -1;
+
+    int chosen = -1;
+
+    // Anchor tidak bergerak: posisi frame sebelumnya dipakai lagi kalau masih bebas
+    auto memory = m_memory.find(key);
+    if (memory != m_memory.end() && memory.value().anchor == anchor &&
+        memory.value().candidate < candidates.size() &&
+        isFree(candidates.at(memory.value().candidate))) {
+        chosen = memory.value().candidate;
+    }
+
+    for (int i = 0; chosen < 0 && i < candidates.size(); ++i) {
+        if (isFree(candidates.at(i)))
+            chosen = i;
+    }
+    if (chosen < 0)
+        chosen = 0;
+
+    occupy(candidates.at(chosen));
+
+    if (!key.isEmpty()) {
+        Memory &m = m_memory[key];
+        m.anchor = anchor;
+        m.candidate = chosen;
+        m.frame = m_frame;
+    }
+    return chosen;
+}
+
+QVector<int> LabelPlacer::placeAll(const QVector<Request> &requests)
+{
+    QVector<int> order(requests.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&requests](int a, int b) {
+        return requests.at(a).priority < requests.at(b).priority;
+    });
+
+    QVector<int> result(requests.size(), -1);
+    for (int i : order) {
+        const Request &request = requests.at(i);
+        result[i] = place(request.key, request.anchor, request.candidates);
+    }
+    return result;
+}
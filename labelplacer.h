@@ -0,0 +1,60 @@
+#ifndef LABELPLACER_H
+#define LABELPLACER_H
+
+#include <QtGlobal>
+#include <QHash>
+#include <QList>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+#include <QVector>
+
+#define LABEL_GRID_CELL     64      // ukuran bucket grid (pixel)
+#define LABEL_MARGIN        2       // jarak minimum antar label (pixel)
+
+// Penempatan label tanpa tabrakan. Rect yang sudah dipakai disimpan di grid bucket layar,
+// jadi cek tabrakan hanya melihat bucket yang disentuh kandidat (bukan semua label).
+// Label dengan key yang sama dan anchor yang tidak bergerak mencoba posisi frame
+// sebelumnya lebih dulu, supaya layout tidak melompat-lompat antar frame.
+class LabelPlacer
+{
+public:
+    struct Request {
+        QString key;
+        QPoint anchor;
+        QVector<QRect> candidates;  // urutan preferensi
+        int priority = 0;           // kecil = ditempatkan lebih dulu
+    };
+
+    // Lepas semua rect (frame baru); memori posisi per key tetap
+    void clear();
+    // clear() lalu tempati rects, mis. label layer yang di-cache
+    void setOccupied(const QList<QRect> &rects);
+    const QList<QRect> &occupied() const { return m_rects; }
+
+    bool isFree(const QRect &rect) const;
+    void occupy(const QRect &rect);
+
+    // Index kandidat yang dipakai (dan ditempati). Kalau semua bertabrakan kandidat
+    // pertama tetap dipakai: label tidak pernah disembunyikan.
+    int place(const QString &key, const QPoint &anchor, const QVector<QRect> &candidates);
+    // Greedy berurutan priority (stabil untuk priority sama); hasil sejajar dengan requests
+    QVector<int> placeAll(const QVector<Request> &requests);
+
+private:
+    struct Memory {
+        QPoint anchor;
+        int candidate = 0;
+        quint64 frame = 0;
+    };
+
+    static quint64 cellKey(int cx, int cy);
+    static int cellOf(int v);
+
+    QList<QRect> m_rects;
+    QHash<quint64, QVector<int>> m_grid;    // bucket -> index di m_rects
+    QHash<QString, Memory> m_memory;
+    quint64 m_frame = 0;
+};
+
+#endif // LABELPLACER_H
@@ -6,6 +6,7 @@
 #include "IAisDvrPlugin.h"
 #include "SettingsManager.h"
 #include "PluginManager.h"
+#include "builtindvrrecorder.h"
 #include "aisdatabasemanager.h"
 #include "appconfig.h"
 
@@ -42,6 +43,11 @@ int main( int argc, char ** argv )
       PluginManager::instance().loadPlugin("/AisDvrPlugin.dll", "IAisDvrPlugin");
   }
 
+  // DVR bawaan (segmen append-only) kalau plugin DLL tidak ada / gagal dimuat
+  if (!PluginManager::instance().getPlugin<IAisDvrPlugin>("IAisDvrPlugin")){
+      PluginManager::instance().registerPlugin(new BuiltinDvrRecorder, "IAisDvrPlugin");
+  }
+
   MainWindow * mw;
   try
   {
@@ -27,6 +27,7 @@
 #include "SettingsDialog.h"
 #include "SettingsManager.h"
 #include "PluginManager.h"
+#include "aisdvrsink.h"
 #include "aisdecoder.h"
 #include "guardzone.h"
 #include "guardzonemanager.h"
@@ -39,6 +40,8 @@
 
 #include "aisdecoder.h"
 #include "ais.h"
+#include "aislogreplay.h"
+#include "dvrsegment.h"
 #include "aivdoencoder.h"
 #include "appconfig.h"
 #include "compasswidget.h"
@@ -50,6 +53,12 @@
 
 QTextEdit *informationText;
 
+// Jeda coba ulang playback DB saat jendela prefetch sedang kosong
+static const int kDbUnderrunRetryMs = 20;
+
+// Resolusi slider log player (posisi waktu dalam permil rentang log)
+static const int kLogSliderSteps = 1000;
+
 // DARK MODE
 void MainWindow::setTitleBarDark(bool dark) {
     BOOL enable = dark;
@@ -1181,6 +1190,7 @@ void MainWindow::createMenuBar(){
     if (AppConfig::isDevelopment()) {
         QMenu *debugMenu = menuBar()->addMenu("&Debug");
         debugMenu->addAction("NMEA Decode", this, SLOT(nmeaDecode()));
+        debugMenu->addAction("Database Statistics", this, SLOT(showDatabaseStats()));
     }
 
     // ================================== CPA/TCPA MENU
@@ -1287,6 +1297,13 @@ void MainWindow::fetchNmea(){
     m_endTimeEditDB = new QTimeEdit(QTime(23, 59));  // Default 23:59
     m_endTimeEditDB->setDisplayFormat("hh:mm");
 
+    m_showTracksDB = new QCheckBox("Tampilkan track historis");
+    connect(m_showTracksDB, &QCheckBox::toggled, this, [this](bool on) {
+        if (!on && ecchart) {
+            ecchart->clearHistoricalTracks();
+        }
+    });
+
     m_playButtonDB = new QPushButton("Play");
     m_stopButtonDB = new QPushButton("Stop");
 
@@ -1310,9 +1327,6 @@ void MainWindow::fetchNmea(){
     // Initialize loading dialog as null (will be created when needed)
     m_loadingDialog = nullptr;
 
-    // Initialize data counter
-    m_totalNmeaDataCount = 0;
-
     // Initialize loading flag
     m_isLoadingData = false;
 
@@ -1323,6 +1337,7 @@ void MainWindow::fetchNmea(){
     QFormLayout *timeFormLayout = new QFormLayout();
     timeFormLayout->addRow(startTimeLabel, m_startTimeEditDB);
     timeFormLayout->addRow(endTimeLabel, m_endTimeEditDB);
+    timeFormLayout->addRow(QString(), m_showTracksDB);
 
     // === 3. Buat layout horizontal untuk kontrol kecepatan dan tombol pemutaran ===
     QHBoxLayout *controlLayout = new QHBoxLayout();
@@ -1386,6 +1401,49 @@ void MainWindow::fetchNmea(){
     m_playbackTimerDB = new QTimer(this);
     connect(m_playbackTimerDB, &QTimer::timeout, this, &MainWindow::processNextNmeaDataDB);
 
+    // Data playback di-stream per halaman dari server; playback mulai begitu chunk pertama tiba
+    m_dbStreamer = new NmeaDbStreamer(this);
+    connect(m_dbStreamer, &NmeaDbStreamer::rowsAvailable, this, [this]() {
+        if (!m_isLoadingData) {
+            return;
+        }
+        hideLoadingDialog();
+        m_isLoadingData = false;
+
+        // Reset progress bar saat mulai playback baru
+        m_progressBarDB->setValue(0);
+
+        m_isPlayingDB = true;
+        m_playButtonDB->setText("Pause");
+        m_playButtonDB->setIcon(QIcon(":/icon/pause.svg"));
+
+        // Start NMEA Playback timer (khusus untuk playback, bukan MOOSDB)
+        ecchart->startNmeaPlaybackTimer();
+
+        // Start with immediate processing of first data
+        processNextNmeaDataDB();
+        qDebug() << "Playback dimulai dengan speed:" << m_playbackSpeed << "x";
+    });
+    connect(m_dbStreamer, &NmeaDbStreamer::estimateReady, this,
+            [](qint64 estimatedRows, const QDateTime &first, const QDateTime &last) {
+        qDebug() << "[DB PLAYBACK] ~" << estimatedRows << "rows," << first << "-" << last;
+    });
+    connect(m_dbStreamer, &NmeaDbStreamer::streamFinished, this, [this](qint64 totalRows, bool ok) {
+        if (totalRows > 0 || !m_isLoadingData) {
+            return;
+        }
+        // Tidak ada satu baris pun: playback tidak pernah mulai
+        m_dbStreamer->stop();
+        m_isPlayingDB = false;
+        m_isLoadingData = false;
+        hideLoadingDialog();
+        if (ok) {
+            QMessageBox::information(this, "Data Kosong", "Tidak ada data NMEA dalam rentang waktu yang dipilih.");
+        } else {
+            qDebug() << "Failed to retrieve NMEA data from database - continuing without data";
+        }
+    });
+
     // === 6. Koneksi database ===
     // Coba koneksi dengan IPv4 terlebih dahulu
 
@@ -1483,7 +1541,7 @@ void MainWindow::onPlayClickedDB()
 
         // Logika PLAY: Ada dua kemungkinan (melanjutkan atau mulai baru)
         // Jika antrean kosong, artinya ini adalah pemutaran pertama atau setelah di-stop total
-        if (m_nmeaDataQueueDB.isEmpty()) {
+        if (!m_dbStreamer->isActive()) {
             // Gabungkan tanggal dan waktu
             QDateTime startTime = QDateTime(m_dateEditDB->date(), m_startTimeEditDB->time());
             QDateTime endTime = QDateTime(m_dateEditDB->date(), m_endTimeEditDB->time());
@@ -1508,10 +1566,22 @@ void MainWindow::onPlayClickedDB()
             // CRITICAL: Use QTimer::singleShot to defer ALL heavy operations
             // This allows the loading dialog to fully render BEFORE any blocking operations start
             QTimer::singleShot(0, this, [this, startTime, endTime]() {
-                // ENCODE TARGETS FOR START DATE (first play or after stop)
-                // Moved here to prevent freeze before dialog appears
-                QDateTime startOnly = m_dateEditDB->date().startOfDay();
-                QList<AisDatabaseManager::TargetData> targets = AisDatabaseManager::instance().getTargetsForDateRev(startOnly);
+                // SEEK: keyframe terdekat <= startTime, lalu hanya delta [keyframe, startTime) yang di-replay
+                QList<AisDatabaseManager::TargetData> targets;
+                QDateTime replayFrom = startTime;
+                const AisDatabaseManager::Keyframe keyframe = AisDatabaseManager::instance().loadKeyframe(startTime);
+                if (keyframe.isValid()) {
+                    targets = keyframe.targets;
+                    replayFrom = keyframe.takenAt;
+                    m_dbSeekTarget = startTime;
+                    qDebug() << "[DB PLAYBACK] Keyframe" << keyframe.takenAt << "with" << targets.size()
+                             << "targets, replaying delta to" << startTime;
+                } else {
+                    // Belum ada keyframe (data lama): ENCODE TARGETS FOR START DATE
+                    QDateTime startOnly = m_dateEditDB->date().startOfDay();
+                    targets = AisDatabaseManager::instance().getTargetsForDateRev(startOnly);
+                    m_dbSeekTarget = QDateTime();
+                }
 
                 // Update dialog and process events to keep it responsive
                 if (m_loadingDialog) {
@@ -1519,6 +1589,18 @@ void MainWindow::onPlayClickedDB()
                     QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
                 }
 
+                // Track seluruh rentang playback untuk target yang ada di awal, sudah
+                // disederhanakan sesuai skala (cache per level di AisDatabaseManager)
+                if (m_showTracksDB->isChecked()) {
+                    QList<quint32> mmsis;
+                    for (const AisDatabaseManager::TargetData& target : targets) {
+                        if (target.mmsi != 0) {
+                            mmsis.append(target.mmsi);
+                        }
+                    }
+                    ecchart->showHistoricalTracks(mmsis, startTime, endTime);
+                }
+
                 QStringList encodedNmeaList = AisDatabaseManager::instance().encodeTargetsToNMEA(targets);
 
                 // Feed encoded NMEA ke ecchart (tanpa display)
@@ -1534,7 +1616,7 @@ void MainWindow::onPlayClickedDB()
                 }
 
                 // Now load the actual playback data
-                loadAndStartPlayback(startTime, endTime);
+                loadAndStartPlayback(replayFrom, endTime);
             });
 
             // 3. Unfollow AIS target jika sedang follow
@@ -1556,9 +1638,7 @@ void MainWindow::onPlayClickedDB()
             ecchart->startNmeaPlaybackTimer();
 
             // Resume playback with next data using timestamp-based timing
-            if (!m_nmeaDataQueueDB.isEmpty()) {
-                processNextNmeaDataDB();
-            }
+            processNextNmeaDataDB();
             qDebug() << "Playback dilanjutkan dengan speed:" << m_playbackSpeed << "x";
         }
     }
@@ -1569,62 +1649,10 @@ void MainWindow::onPlayClickedDB()
 
 void MainWindow::loadAndStartPlayback(const QDateTime& startTime, const QDateTime& endTime)
 {
-    // This function is called via QTimer::singleShot, giving the loading dialog time to render
-
-    QSqlQuery query;
-    // Gunakan unified table untuk get kedua ownship dan AIS target data
-    AisDatabaseManager::instance().getCombinedNmeaData(query, startTime, endTime, {"ownship", "aistarget"});
-
-    if (query.isActive()) {
-        // Count total data for progress tracking
-        m_totalNmeaDataCount = 0;
-        int rowCount = 0;
-        while (query.next()) {
-            QVariantList row;
-            row << query.value("timestamp") << query.value("nmea") << query.value("data_source");
-            m_nmeaDataQueueDB.enqueue(row);
-            m_totalNmeaDataCount++;
-            rowCount++;
-
-            // Keep dialog responsive by processing events periodically
-            if (rowCount % 100 == 0 && m_loadingDialog) {
-                m_loadingDialog->repaint();
-                QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
-            }
-        }
-
-        // Hide loading dialog after data is loaded
-        hideLoadingDialog();
-
-        // CRITICAL: Reset loading flag to allow future playback operations
-        m_isLoadingData = false;
-
-        // Reset progress bar saat mulai playback baru
-        m_progressBarDB->setValue(0);
-
-        if (!m_nmeaDataQueueDB.isEmpty()) {
-            m_isPlayingDB = true;
-            m_playButtonDB->setText("Pause");
-            m_playButtonDB->setIcon(QIcon(":/icon/pause.svg"));
-
-            // Start NMEA Playback timer (khusus untuk playback, bukan MOOSDB)
-            ecchart->startNmeaPlaybackTimer();
-
-            // Start with immediate processing of first data
-            processNextNmeaDataDB();
-            qDebug() << "Playback dimulai dengan speed:" << m_playbackSpeed << "x";
-        } else {
-            m_isPlayingDB = false;
-            m_isLoadingData = false;  // Reset flag even when no data
-            hideLoadingDialog();  // Hide dialog when no data
-            QMessageBox::information(this, "Data Kosong", "Tidak ada data NMEA dalam rentang waktu yang dipilih.");
-        }
-    } else {
-        qDebug() << "Failed to retrieve NMEA data from database - continuing without data";
-        m_isLoadingData = false;  // Reset flag on query failure
-        hideLoadingDialog();  // Hide dialog on query failure
-        // No error popup - playback will simply not have data to process
-    }
+    // This function is called via QTimer::singleShot, giving the loading dialog time to render.
+    // Data tidak dimuat di sini: worker men-stream per halaman dari server dan
+    // rowsAvailable memulai playback begitu jendela prefetch pertama terisi.
+    m_dbStreamer->start(startTime, endTime, {"ownship", "aistarget"});
 }
 
 void MainWindow::onStopClickedDB()
@@ -1633,9 +1661,11 @@ void MainWindow::onStopClickedDB()
 
     // Reset ke normal mode saat stop
     Ais::setParallelMode(false, "MOOSDB");
+    Ais::instance()->setReplayClock(0);
 
     ecchart->setCustomOwnship(false);
     ecchart->clearAisTargets();
+    ecchart->clearHistoricalTracks();
 
     // Hapus Dangerous Box merah pada AIS
     ecchart->clearDangerousAISList();
@@ -1643,14 +1673,16 @@ void MainWindow::onStopClickedDB()
     m_playbackTimerDB->stop();
     ecchart->stopNmeaPlaybackTimer();  // Stop NMEA Playback timer
     m_isPlayingDB = false;
-    m_nmeaDataQueueDB.clear();
+    m_isLoadingData = false;
+    m_dbStreamer->stop();
+    m_dbSeekTarget = QDateTime();
+    hideLoadingDialog();
     m_displayEditDB->clear();
     m_playButtonDB->setText("Play");
     m_playButtonDB->setIcon(QIcon(":/icon/play.svg"));
 
     // Reset progress bar saat stop
     m_progressBarDB->setValue(0);
-    m_totalNmeaDataCount = 0;
 
     // 1. Kosongkan AIS Target Detail
     if (aisText) {
@@ -1691,11 +1723,11 @@ void MainWindow::onIncreaseSpeedClickedDB()
         qDebug() << "Playback speed increased to" << m_playbackSpeed << "x";
 
         // Restart timer immediately to apply new speed if playing
-        if (m_isPlayingDB && !m_nmeaDataQueueDB.isEmpty()) {
+        const DbNmeaRow *currentData = m_dbStreamer->peek();
+        if (m_isPlayingDB && currentData) {
             m_playbackTimerDB->stop();
             // Calculate new interval for current data
-            QVariantList currentData = m_nmeaDataQueueDB.head();
-            QDateTime currentTimestamp = currentData.at(0).toDateTime();
+            QDateTime currentTimestamp = currentData->timestamp;
             QDateTime nextTimestamp = m_lastPlaybackTimestamp.isValid() ? m_lastPlaybackTimestamp : currentTimestamp;
             qint64 timeDiffMs = nextTimestamp.msecsTo(currentTimestamp);
             qint64 newInterval = qMax<qint64>(10, static_cast<qint64>(timeDiffMs / m_playbackSpeed));
@@ -1713,11 +1745,11 @@ void MainWindow::onDecreaseSpeedClickedDB()
         qDebug() << "Playback speed decreased to" << m_playbackSpeed << "x";
 
         // Restart timer immediately to apply new speed if playing
-        if (m_isPlayingDB && !m_nmeaDataQueueDB.isEmpty()) {
+        const DbNmeaRow *currentData = m_dbStreamer->peek();
+        if (m_isPlayingDB && currentData) {
             m_playbackTimerDB->stop();
             // Calculate new interval for current data
-            QVariantList currentData = m_nmeaDataQueueDB.head();
-            QDateTime currentTimestamp = currentData.at(0).toDateTime();
+            QDateTime currentTimestamp = currentData->timestamp;
             QDateTime nextTimestamp = m_lastPlaybackTimestamp.isValid() ? m_lastPlaybackTimestamp : currentTimestamp;
             qint64 timeDiffMs = nextTimestamp.msecsTo(currentTimestamp);
             qint64 newInterval = qMax<qint64>(10, static_cast<qint64>(timeDiffMs / m_playbackSpeed));
@@ -1748,24 +1780,64 @@ bool MainWindow::getDatabaseConnectionStatus() const
     return m_isDatabaseConnected;
 }
 
+bool MainWindow::catchUpToSeekTarget()
+{
+    // Delta setelah keyframe: langsung ke chart tanpa timer dan tanpa tampilan teks
+    while (const DbNmeaRow *row = m_dbStreamer->peek()) {
+        if (row->timestamp >= m_dbSeekTarget) {
+            m_dbSeekTarget = QDateTime();
+            return true;
+        }
+        if (ecchart) {
+            Ais::instance()->setReplayClock(row->timestamp.toMSecsSinceEpoch());
+            ecchart->readAISVariableString(row->nmea);
+        }
+        m_dbStreamer->pop();
+    }
+
+    if (m_dbStreamer->atEnd()) {
+        m_dbSeekTarget = QDateTime();
+        return true;
+    }
+
+    // Jendela prefetch kosong: lanjut setelah worker membaca halaman berikutnya
+    if (m_isPlayingDB) {
+        m_playbackTimerDB->start(kDbUnderrunRetryMs);
+    }
+    return false;
+}
+
 void MainWindow::processNextNmeaDataDB()
 {
-    if (!m_nmeaDataQueueDB.isEmpty()) {
-        QVariantList data = m_nmeaDataQueueDB.dequeue();
-        QDateTime timestamp = data.at(0).toDateTime();
-        QString nmea = data.at(1).toString();
-        QString dataSource = data.at(2).toString(); // New field from unified table
+    if (m_dbSeekTarget.isValid() && !catchUpToSeekTarget()) {
+        return;
+    }
+
+    const DbNmeaRow *row = m_dbStreamer->peek();
+    if (!row && !m_dbStreamer->atEnd()) {
+        // Jendela prefetch belum terisi lagi: coba sebentar lagi, jangan dianggap selesai
+        if (m_isPlayingDB) {
+            m_playbackTimerDB->start(kDbUnderrunRetryMs);
+        }
+        return;
+    }
+
+    if (row) {
+        QDateTime timestamp = row->timestamp;
+        QString nmea = row->nmea;
+        QString dataSource = row->dataSource; // New field from unified table
+        m_dbStreamer->pop();
 
         // === UPDATE PROGRESS BAR ===
-        // Hitung persentase: (total - remaining) / total * 100
-        int processedCount = m_totalNmeaDataCount - m_nmeaDataQueueDB.size();
-        int progress = (m_totalNmeaDataCount > 0) ? (processedCount * 100 / m_totalNmeaDataCount) : 0;
-        m_progressBarDB->setValue(progress);
+        // Posisi waktu di rentang data; jumlah baris total tidak pernah dihitung
+        m_progressBarDB->setValue(m_dbStreamer->progressPercent(timestamp));
 
         // === PLAYBACK: SET MODE DATABASE DATA ===
         // Mode sudah diset global di onPlayClickedDB
 
         if(ecchart && !ecchart->isDragging){
+            // Umur target AIS mengikuti waktu rekaman
+            Ais::instance()->setReplayClock(timestamp.toMSecsSinceEpoch());
             ecchart->readAISVariableString(nmea);
             // Emit signal untuk update AIS panels setiap NMEA data diproses
             emit ecchart->tickPerSecond();
@@ -1853,9 +1925,9 @@ void MainWindow::processNextNmeaDataDB()
         m_displayEditDB->setTextCursor(scrollCursor);
 
         // Calculate next interval based on timestamp difference
-        if (!m_nmeaDataQueueDB.isEmpty()) {
-            QVariantList nextData = m_nmeaDataQueueDB.head();
-            QDateTime nextTimestamp = nextData.at(0).toDateTime();
+        const DbNmeaRow *nextData = m_dbStreamer->peek();
+        if (nextData) {
+            QDateTime nextTimestamp = nextData->timestamp;
 
             // Calculate actual time difference between current and next NMEA
             qint64 timeDiffMs = timestamp.msecsTo(nextTimestamp);
@@ -1868,8 +1940,13 @@ void MainWindow::processNextNmeaDataDB()
 
             // Store current timestamp for reference
             m_lastPlaybackTimestamp = timestamp;
+        } else if (!m_dbStreamer->atEnd()) {
+            // Baris berikutnya masih dibaca worker
+            m_lastPlaybackTimestamp = timestamp;
+            m_playbackTimerDB->start(kDbUnderrunRetryMs);
         } else {
             // No more data, stop playback
+            m_dbStreamer->stop();
             m_playbackTimerDB->stop();
             ecchart->stopNmeaPlaybackTimer();  // Stop NMEA timer properly
             m_isPlayingDB = false;
@@ -1881,6 +1958,7 @@ void MainWindow::processNextNmeaDataDB()
             qDebug() << "Playback selesai.";
         }
     } else {
+        m_dbStreamer->stop();
         m_playbackTimerDB->stop();
         ecchart->stopNmeaPlaybackTimer();  // Stop NMEA timer properly
         m_isPlayingDB = false;
@@ -1928,10 +2006,11 @@ void MainWindow::setupUI(){
     m_playPauseButton->setIcon(QIcon(":/icon/play.svg"));
     m_stopButton->setIcon(QIcon(":/icon/stop.svg"));
 
-    QLabel *speedLabel = new QLabel(tr("Interval (ms):"));
+    // Kecepatan replay dalam persen waktu log (100% = waktu asli)
+    QLabel *speedLabel = new QLabel(tr("Speed (%):"));
     m_speedSpinBox = new QSpinBox();
-    m_speedSpinBox->setRange(10, 5000);
-    m_speedSpinBox->setValue(200);
+    m_speedSpinBox->setRange(int(AisLogReplay::MinSpeed * 100), int(AisLogReplay::MaxSpeed * 100));
+    m_speedSpinBox->setValue(100);
     m_speedSpinBox->setSingleStep(50);
 
     // Tata letak tombol dan kontrol dalam grid
@@ -1948,6 +2027,7 @@ void MainWindow::setupUI(){
 
     // Slider di bawah kontrol
     m_slider = new QSlider(Qt::Horizontal);
+    m_slider->setRange(0, kLogSliderSteps);
     mainLayout->addWidget(m_slider);
 
     // Text box untuk log di bagian paling bawah
@@ -1963,10 +2043,6 @@ void MainWindow::setupUI(){
 
 void MainWindow::setupConnections()
 {
-    // Timer untuk memproses data NMEA
-    m_playbackTimer = new QTimer(this);
-    connect(m_playbackTimer, &QTimer::timeout, this, &MainWindow::onPlaybackTimerTimeout);
-
     // ===================================================================
     // --- PENAMBAHAN YANG HILANG ADA DI SINI ---
     // Timer untuk menggambar chart secara periodik
@@ -1983,19 +2059,56 @@ void MainWindow::setupConnections()
     connect(m_slider, &QSlider::sliderPressed, this, &MainWindow::onSliderPressed);
     connect(m_slider, &QSlider::valueChanged, this, &MainWindow::onSliderValueChanged);
     connect(m_slider, &QSlider::sliderReleased, this, &MainWindow::onSliderReleased);
+    connect(m_speedSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int percent) {
+        if (AisLogReplay *replay = logReplay()) {
+            replay->setSpeed(percent / 100.0);
+        }
+    });
+}
+
+AisLogReplay *MainWindow::logReplay()
+{
+    if (m_logReplay || !Ais::instance())
+        return m_logReplay;
+
+    // Replay milik Ais dibuat sekali; sinyalnya disambung ke dock log player di sini
+    m_logReplay = Ais::instance()->logReplay();
+    connect(m_logReplay, &AisLogReplay::indexProgress, this, [this](int percent) {
+        routesStatusText->setText(tr("Indexing log... %1%").arg(percent));
+    });
+    connect(m_logReplay, &AisLogReplay::indexReady, this, [this](qint64, qint64) {
+        m_slider->setEnabled(m_logReplay->canSeek());
+        routesStatusText->setText(m_logReplay->canSeek() ? tr("Log data ready to play.")
+                                                         : tr("Log has no seek points; playing without seek."));
+    });
+    connect(m_logReplay, &AisLogReplay::positionChanged, this, [this](qint64 logTimeMs) {
+        if (!m_logReplay->canSeek() || m_slider->isSliderDown())
+            return;
+        const qint64 span = qMax<qint64>(m_logReplay->endMs() - m_logReplay->startMs(), 1);
+        m_slider->blockSignals(true);
+        m_slider->setValue(int((logTimeMs - m_logReplay->startMs()) * kLogSliderSteps / span));
+        m_slider->blockSignals(false);
+    });
+    connect(m_logReplay, &AisLogReplay::finished, this, [this]() {
+        updatePlayerState(MainWindow::PlayerState::Stopped);
+        m_logTextEdit->append("--- AKHIR DARI LOG ---");
+    });
+    return m_logReplay;
+}
+
+qint64 MainWindow::sliderLogTime(int position) const
+{
+    const qint64 span = m_logReplay->endMs() - m_logReplay->startMs();
+    return m_logReplay->startMs() + span * position / kLogSliderSteps;
 }
 
 void MainWindow::resetUIState(const QString& statusMessage)
 {
     updatePlayerState(MainWindow::PlayerState::Stopped);
     m_selectedFilePath.clear();
-    m_totalLines = 0;
-    m_currentLine = 0;
 
-    delete m_logStream; m_logStream = nullptr;
-    if (m_logFile) {
-        if (m_logFile->isOpen()) m_logFile->close();
-        delete m_logFile; m_logFile = nullptr;
+    if (AisLogReplay *replay = logReplay()) {
+        replay->close();
     }
 
     m_logTextEdit->clear();
@@ -2016,38 +2129,20 @@ void MainWindow::onLogFileClicked(QListWidgetItem *item)
     if (newFilePath.isEmpty() || newFilePath == m_selectedFilePath) return;
 
     resetUIState(QString("Opening file: %1...").arg(item->text()));
-    m_selectedFilePath = newFilePath;
 
-    m_logFile = new QFile(m_selectedFilePath);
-    if (!m_logFile->open(QIODevice::ReadOnly | QIODevice::Text)) {
+    // Index dibangun di background; play bisa langsung, slider aktif setelah indexReady
+    AisLogReplay *replay = logReplay();
+    if (!replay || !replay->open(newFilePath)) {
         resetUIState("Error: Gagal membuka file.");
         return;
     }
+    m_selectedFilePath = newFilePath;
+    replay->setSpeed(m_speedSpinBox->value() / 100.0);
 
-    QProgressDialog progress("Counting lines...", "Cancel", 0, 0, this);
-    progress.setWindowTitle("Processing Data");
-    progress.setWindowModality(Qt::WindowModal);
-    progress.show();
-    m_totalLines = 0;
-    while (!m_logFile->atEnd()) {
-        m_logFile->readLine();
-        m_totalLines++;
-        if (m_totalLines % 10000 == 0) progress.setLabelText(QString("Counting lines... (%1)").arg(m_totalLines));
-        QApplication::processEvents();
-        if (progress.wasCanceled()) {
-            resetUIState("Operasi dibatalkan.");
-            return;
-        }
-    }
-
-    m_logFile->seek(0);
-    m_logStream = new QTextStream(m_logFile);
-
-    m_slider->setRange(0, m_totalLines > 0 ? m_totalLines - 1 : 0);
     m_playPauseButton->setEnabled(true);
     m_stopButton->setEnabled(true);
-    m_slider->setEnabled(true);
-    routesStatusText->setText("Log data ready to play.");
+    m_slider->setEnabled(replay->canSeek());
+    routesStatusText->setText(replay->canSeek() ? tr("Log data ready to play.") : tr("Indexing log..."));
 }
 
 void MainWindow::onPlayPauseClicked()
@@ -2055,9 +2150,6 @@ void MainWindow::onPlayPauseClicked()
     if (m_playerState == MainWindow::PlayerState::Playing) {
         updatePlayerState(MainWindow::PlayerState::Paused);
     } else {
-        if (m_currentLine >= m_totalLines && m_totalLines > 0) {
-            seekToLine(0);
-        }
         updatePlayerState(MainWindow::PlayerState::Playing);
     }
 }
@@ -2067,35 +2159,17 @@ void MainWindow::onStopClicked()
     qDebug() << "onStopClicked() called";
 
     updatePlayerState(MainWindow::PlayerState::Stopped);
-    seekToLine(0);
-
-    qDebug() << "File playback stop completed successfully";
-}
-
-void MainWindow::onPlaybackTimerTimeout()
-{
-    if (!m_logStream || m_logStream->atEnd()) {
-        updatePlayerState(MainWindow::PlayerState::Stopped);
-        m_logTextEdit->append("--- AKHIR DARI LOG ---");
-        return;
-    }
-
-    QString line = m_logStream->readLine();
-
-    // "Beri makan" data ke engine SevenCs Anda
-    if (ecchart){
-        ecchart->readAISVariableString(line);
+    if (m_logReplay && m_logReplay->canSeek()) {
+        seekToTime(m_logReplay->startMs());
+    } else if (!m_selectedFilePath.isEmpty() && m_logReplay) {
+        // Belum bisa seek: buka ulang supaya mulai dari awal log
+        if (ecchart) {
+            ecchart->createDvrRead();
+        }
+        m_logReplay->open(m_selectedFilePath);
     }
 
-    // Update UI
-    QString formattedLine = QString("[%1] %2").arg(m_currentLine).arg(line);
-    m_logTextEdit->append(formattedLine);
-
-    m_slider->blockSignals(true);
-    m_slider->setValue(m_currentLine);
-    m_slider->blockSignals(false);
-
-    m_currentLine++;
+    qDebug() << "File playback stop completed successfully";
 }
 
 void MainWindow::updatePlayerState(PlayerState newState)
@@ -2110,8 +2184,9 @@ void MainWindow::updatePlayerState(PlayerState newState)
 
     switch (m_playerState) {
     case PlayerState::Playing:
-        m_playbackTimer->setInterval(m_speedSpinBox->value());
-        m_playbackTimer->start();
+        if (m_logReplay) {
+            m_logReplay->play();
+        }
         m_playPauseButton->setText(tr("Pause"));
 
         if (AppConfig::isLight()){
@@ -2125,7 +2200,9 @@ void MainWindow::updatePlayerState(PlayerState newState)
         break;
     case PlayerState::Paused:
     case PlayerState::Stopped:
-        m_playbackTimer->stop();
+        if (m_logReplay) {
+            m_logReplay->pause();
+        }
         m_playPauseButton->setText(tr("Play"));
 
         if (AppConfig::isLight()){
@@ -2142,15 +2219,18 @@ void MainWindow::updatePlayerState(PlayerState newState)
 
 void MainWindow::onSliderValueChanged(int position)
 {
-    if (m_slider->isSliderDown()) {
-        routesStatusText->setText(QString("Jump to line %1... Release to render.").arg(position));
+    if (m_slider->isSliderDown() && m_logReplay && m_logReplay->canSeek()) {
+        const QString when = QDateTime::fromMSecsSinceEpoch(sliderLogTime(position), Qt::UTC)
+                                 .toString("yyyy-MM-dd HH:mm:ss");
+        routesStatusText->setText(QString("Jump to %1... Release to render.").arg(when));
     }
 }
 
 void MainWindow::onSliderReleased()
 {
-    int finalPosition = m_slider->value();
-    seekToLine(finalPosition);
+    if (m_logReplay && m_logReplay->canSeek()) {
+        seekToTime(sliderLogTime(m_slider->value()));
+    }
 }
 
 void MainWindow::onSliderPressed()
@@ -2160,47 +2240,26 @@ void MainWindow::onSliderPressed()
     }
 }
 
-void MainWindow::seekToLine(qint64 targetLine)
+void MainWindow::seekToTime(qint64 logTimeMs)
 {
-    if (!m_logFile) return;
+    if (!m_logReplay) return;
 
+    const bool wasPlaying = m_playerState == MainWindow::PlayerState::Playing;
     updatePlayerState(MainWindow::PlayerState::Paused);
 
-    QProgressDialog progress(QString("Rendering data up to line %1...").arg(targetLine), "Cancel", 0, targetLine, this);
-    progress.setWindowTitle("Rendering Data");
-    progress.setWindowModality(Qt::WindowModal);
-    progress.show();
-
-    // 1. Reset transponder
-    if (ecchart){
-        ecchart->createDvrRead();
-    }
-    m_logStream->seek(0);
-
-    // 2. Lakukan simulasi cepat (loop ini akan sangat cepat karena tidak ada drawing)
-    for (qint64 i = 0; i < targetLine; ++i) {
-        if (m_logStream->atEnd()) break;
-        QString line = m_logStream->readLine();
-
-        if (ecchart){
-            ecchart->readAISVariableString(line);
-        }
-
-        if (i % 5000 == 0) {
-            progress.setValue(i);
-            QApplication::processEvents();
-            if (progress.wasCanceled()) break;
-        }
+    // Seek lewat index: pre-roll saja yang diputar ulang, bukan dari awal log
+    if (!m_logReplay->seek(logTimeMs)) {
+        routesStatusText->setText(tr("Log is not seekable yet."));
+        return;
     }
 
-    // 3. Panggil Draw() SATU KALI untuk menampilkan hasil akhir
     if(ecchart && !ecchart->isDragging) {
         ecchart->Draw();
     }
 
-    m_currentLine = targetLine;
-    m_slider->setValue(targetLine);
-    routesStatusText->setText(QString("Data at %1.").arg(targetLine));
+    if (wasPlaying) {
+        updatePlayerState(MainWindow::PlayerState::Playing);
+    }
 }
 
 void MainWindow::onRefreshClicked()
@@ -2217,8 +2276,20 @@ void MainWindow::populateLogFiles()
     nameFilters << "*.log" << "*.txt";
     directory.setNameFilters(nameFilters);
     QStringList fileList = directory.entryList(QDir::Files, QDir::Name);
+
+    // Rekaman DVR bawaan: satu item per rekaman, bukan per segmen
+    QStringList recordings;
+    QStringList recordingPaths;
+    for (const QString &segment : DvrSegmentReader::segmentsIn(m_logDirectoryPath)) {
+        const QString stem = DvrSegmentReader::stemOf(segment);
+        if (!recordings.contains(stem)) {
+            recordings << stem;
+            recordingPaths << segment;
+        }
+    }
+
     m_logListWidget->clear();
-    if(fileList.isEmpty()){
+    if(fileList.isEmpty() && recordings.isEmpty()){
         m_logListWidget->addItem("Tidak ada file .log atau .txt ditemukan.");
         m_logListWidget->setEnabled(false);
     } else {
@@ -2228,6 +2299,11 @@ void MainWindow::populateLogFiles()
             item->setData(Qt::UserRole, directory.filePath(fileName));
             m_logListWidget->addItem(item);
         }
+        for (int i = 0; i < recordings.size(); ++i) {
+            QListWidgetItem *item = new QListWidgetItem(recordings.at(i) + " (DVR)");
+            item->setData(Qt::UserRole, recordingPaths.at(i));
+            m_logListWidget->addItem(item);
+        }
     }
 }
 
@@ -2290,9 +2366,14 @@ void MainWindow::stopAisRecord(){
     IAisDvrPlugin* dvr = PluginManager::instance().getPlugin<IAisDvrPlugin>("IAisDvrPlugin");
 
     if (dvr){
+        AisDvrSink* sink = AisDvrSink::forKey();
+        if (sink) {
+            sink->flush();
+        }
         dvr->stopRecording();
 
         qDebug() << "AIS Recording stopped..";
+        qDebug().noquote() << "[DVR] Throughput:" << AisDvrSink::statsReport();
 
         startAisRecAction->setEnabled(true);
         stopAisRecAction->setEnabled(false);
@@ -2300,8 +2381,9 @@ void MainWindow::stopAisRecord(){
 }
 
 void MainWindow::onNmeaReceived(const QString& line) {
-    if (aisDvr && aisDvr->isRecording()) {
-        aisDvr->recordRawNmea(line);
+    AisDvrSink* dvr = AisDvrSink::forKey();
+    if (dvr && dvr->isRecording()) {
+        dvr->record(line);
     }
 }
 
@@ -2312,6 +2394,23 @@ void MainWindow::nmeaDecode(){
     // ecchart->publishToMOOSDB("WAYPT_NAV", "pts={-7.12, 112.01}");
 }
 
+void MainWindow::showDatabaseStats(){
+    AisDatabaseManager &dbm = AisDatabaseManager::instance();
+    const NmeaRecordWriter::Stats s = dbm.recordWriterStats();
+
+    const QString summary = QString("Recording writer\n"
+                                    "Written: %1   Failed: %2   Dropped (queue full): %3\n"
+                                    "Queued: %4 (max %5)   Commits: %6   Last commit: %7 ms")
+                                .arg(s.written).arg(s.failed).arg(s.dropped)
+                                .arg(s.queued).arg(s.highWater).arg(s.commits).arg(s.lastCommitMs);
+    const QString report = dbm.statementLatencyReport();
+    qInfo().noquote() << "[DB STATS]" << summary << "\n" << report;
+
+    QMessageBox box(QMessageBox::Information, tr("Database Statistics"), summary, QMessageBox::Ok, this);
+    box.setDetailedText(report);
+    box.exec();
+}
+
 void MainWindow::openSettingsDialog() {
     SettingsDialog dlg(this);
 
@@ -2808,8 +2907,10 @@ MainWindow::~MainWindow()
     qDebug() << "[SHUTDOWN] Step 1.5 COMPLETE";
 
     qDebug() << "[SHUTDOWN] Step 1.6: Clearing queues...";
-    // Clear queues
-    m_nmeaDataQueueDB.clear();
+    // Stop DB stream worker (tutup cursor & koneksinya)
+    if (m_dbStreamer) {
+        m_dbStreamer->stop();
+    }
     qDebug() << "[SHUTDOWN] Step 1.6 COMPLETE";
 
     qDebug() << "[SHUTDOWN] Step 1.7: Nullifying panel pointers...";
@@ -2829,21 +2930,11 @@ MainWindow::~MainWindow()
     m_cpaUpdateTimer = nullptr;
     qDebug() << "[SHUTDOWN] Step 1.8 COMPLETE";
 
-    qDebug() << "[SHUTDOWN] Step 1.9: Skipping playback timer (may be dangling)";
-    // CRITICAL: Do NOT access m_playbackTimer - may be dangling
-    m_playbackTimer = nullptr;
-    qDebug() << "[SHUTDOWN] Step 1.9 COMPLETE";
-
     qDebug() << "[SHUTDOWN] Step 1.10: Skipping draw timer (may be dangling)";
     // CRITICAL: Do NOT access m_drawTimer - may be dangling
     m_drawTimer = nullptr;
     qDebug() << "[SHUTDOWN] Step 1.10 COMPLETE";
 
-    qDebug() << "[SHUTDOWN] Step 1.11: Deleting log stream and file...";
-  delete m_logStream;
-  delete m_logFile;
-    qDebug() << "[SHUTDOWN] Step 1.11 COMPLETE";
-
     qDebug() << "[SHUTDOWN] MainWindow destructor try block COMPLETE";
   }
   catch (const std::exception& e) {
@@ -7221,15 +7312,12 @@ void MainWindow::onNodeShipsUpdateTimer()
     // nodeShipsTable->setCellWidget(ownshipRow + 1, 0, separator);
 
     // Get node ships from ecwidget
-    extern QMap<QString, ShipStruct> nodeShips;
-
-    for (auto it = nodeShips.begin(); it != nodeShips.end(); ++it) {
-        QString nodeName = it.key();
-        ShipStruct ship = it.value();
+    for (int id = 0; id < nodeFleet.size(); ++id) {
+        const NodeFleet::Node &ship = nodeFleet.at(id);
+        QString nodeName = ship.nodeName;
 
         // Check if ship has valid position
-        bool isActive = !qIsNaN(ship.lat) && !qIsNaN(ship.lon) &&
-                        ship.lat != 0.0 && ship.lon != 0.0;
+        bool isActive = ship.hasPosition();
 
         // Get visibility (default true)
         bool isVisible = nodeShipsVisibility.value(nodeName, true);
@@ -7301,10 +7389,10 @@ void MainWindow::onNodeShipsUpdateTimer()
                 return;
             }
 
-            // Navigate directly using nodeName (case-sensitive key from map)
-            extern QMap<QString, ShipStruct> nodeShips;
-            if (nodeShips.contains(nodeName)) {
-                ShipStruct ship = nodeShips[nodeName];
+            // Navigate directly using nodeName (case-sensitive key from fleet)
+            const int nodeId = nodeFleet.find(nodeName);
+            if (nodeId >= 0) {
+                ShipStruct ship = nodeFleet.ship(nodeId);
 
                 // Check if coordinates are valid (not NaN and not 0.0)
                 if (qIsNaN(ship.lat) || qIsNaN(ship.lon)) {
@@ -7409,10 +7497,9 @@ void MainWindow::onNavigateToNodeShip(int row)
         return;
     }
 
-    extern QMap<QString, ShipStruct> nodeShips;
-
-    if (nodeShips.contains(nodeName)) {
-        ShipStruct ship = nodeShips[nodeName];
+    const int nodeId = nodeFleet.find(nodeName);
+    if (nodeId >= 0) {
+        ShipStruct ship = nodeFleet.ship(nodeId);
 
         // Navigate to ship position
         if (!qIsNaN(ship.lat) && !qIsNaN(ship.lon)) {
@@ -29,11 +29,13 @@
 #include "gribpanel.h"
 #include "gribmanager.h"
 #include "testpanel.h"
+#include "nmeadbstreamer.h"
 
 // forward declerations
 class PickWindow;
 class SearchWindow;
 class Ais;
+class AisLogReplay;
 class AISSubscriber;
 class QFile;
 
@@ -255,6 +257,7 @@ protected slots:
 
     // NMEA DECODE
     void nmeaDecode();
+    void showDatabaseStats();
     void showSystemStatistics();
     void createTestGuardZones();
 
@@ -337,7 +340,6 @@ private slots:
     void onSliderPressed();
     void onSliderValueChanged(int position);
     void onSliderReleased();
-    void onPlaybackTimerTimeout();
     void onDrawTimerTimeout();
 
     // PLAYBACK DB
@@ -355,6 +357,8 @@ private slots:
     bool getDatabaseConnectionStatus() const;
 
 private:
+    bool catchUpToSeekTarget();     // false = delta belum habis, tunggu chunk berikutnya
+
     GuardZonePanel* guardZonePanel;
     QDockWidget* guardZoneDock;
     AOIPanel* aoiPanel = nullptr;
@@ -484,7 +488,9 @@ private:
     void updatePlayerState(PlayerState newState);
     void resetUIState(const QString& statusMessage);
     void populateLogFiles();
-    void seekToLine(qint64 targetLine); // Fungsi baru untuk "fast-forward"
+    void seekToTime(qint64 logTimeMs);  // seek lewat index log, bukan baca ulang dari awal
+    AisLogReplay *logReplay();          // replay log milik Ais, sinyal disambung sekali
+    qint64 sliderLogTime(int position) const;
 
     // --- Widget UI ---
     QListWidget *m_logListWidget;
@@ -497,16 +503,12 @@ private:
 
     // --- State & File Handling ---
     PlayerState m_playerState;
-    QTimer *m_playbackTimer;
     QTimer *m_drawTimer;
 
     QString m_logDirectoryPath;
     QString m_selectedFilePath;
-    qint64 m_totalLines;
-    qint64 m_currentLine;
 
-    QFile *m_logFile = nullptr;
-    QTextStream *m_logStream = nullptr;
+    AisLogReplay *m_logReplay = nullptr;
 
     // MENU
     QMenu *viewTopMenu;
@@ -520,20 +522,21 @@ private:
     QDateEdit *m_dateEditDB;
     QTimeEdit *m_startTimeEditDB;
     QTimeEdit *m_endTimeEditDB;
+    QCheckBox *m_showTracksDB;      // track historis target di rentang playback
     QTextEdit *m_displayEditDB;
     QLabel *m_speedLabelDB;
     QProgressBar *m_progressBarDB;  // Progress bar for playback
     QDialog *m_loadingDialog;  // Loading dialog for data fetch
 
     QTimer *m_playbackTimerDB;
-    QQueue<QVariantList> m_nmeaDataQueueDB;
+    NmeaDbStreamer *m_dbStreamer = nullptr;  // cursor server + jendela prefetch
     bool m_isPlayingDB = false;
-    int m_totalNmeaDataCount = 0;  // Total data for progress tracking
     bool m_isLoadingData = false;  // Flag to prevent re-entrancy during data loading
 
     // Playback speed and timing
     double m_playbackSpeed = 1.0; // 1.0 = normal speed, 2.0 = 2x speed
     QDateTime m_lastPlaybackTimestamp; // Track last processed timestamp
+    QDateTime m_dbSeekTarget;          // valid selama delta keyframe -> waktu mulai di-replay
 
     // Store last displayed data for 2-line display
     QString m_lastOwnshipLine;
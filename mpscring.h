@@ -0,0 +1,121 @@
+#ifndef MPSCRING_H
+#define MPSCRING_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <utility>
+
+// Multi-producer / single-consumer bounded ring (Vyukov). Any thread may call
+// tryPush(); exactly one thread calls tryPop(). Each cell carries a sequence
+// number, so producers claim a slot with one CAS and never wait on each other
+// or on the consumer. When the ring is full the record is dropped and counted.
+template<typename T, int Capacity>
+class MpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    struct Stats {
+        quint32 depth = 0;
+        quint32 highWater = 0;
+        quint64 pushed = 0;
+        quint64 popped = 0;
+        quint64 drops = 0;
+    };
+
+    MpscRing()
+    {
+        for (int i = 0; i < Capacity; ++i) {
+            m_cells[i].seq.store(quint32(i), std::memory_order_relaxed);
+        }
+    }
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    static constexpr int capacity() { return Capacity; }
+
+    // Producer side, any thread
+    bool tryPush(const T &item)
+    {
+        quint32 pos = m_head.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &m_cells[pos & (Capacity - 1)];
+            const qint32 diff = qint32(cell->seq.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                m_drops.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->item = item;
+        cell->seq.store(pos + 1, std::memory_order_release);
+
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        const quint32 current = depth();
+        if (current > m_highWater.load(std::memory_order_relaxed))
+            m_highWater.store(current, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer side, one thread. Item is moved out so the cell releases its memory.
+    bool tryPop(T &item)
+    {
+        const quint32 pos = m_tail.load(std::memory_order_relaxed);
+        Cell &cell = m_cells[pos & (Capacity - 1)];
+        if (qint32(cell.seq.load(std::memory_order_acquire) - (pos + 1)) < 0)
+            return false;
+
+        item = std::move(cell.item);
+        cell.seq.store(pos + Capacity, std::memory_order_release);
+        m_tail.store(pos + 1, std::memory_order_relaxed);
+        m_popped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate; safe from any thread. Tail is read before head so the snapshot never
+    // sees the consumer ahead of the producers; the result is still clamped to [0, Capacity]
+    // because both counters may move between the two loads.
+    quint32 depth() const
+    {
+        const quint32 tail = m_tail.load(std::memory_order_acquire);
+        const quint32 head = m_head.load(std::memory_order_acquire);
+        const qint32 diff = qint32(head - tail);
+        return quint32(qBound(0, diff, Capacity));
+    }
+
+    Stats stats() const
+    {
+        Stats s;
+        s.depth = depth();
+        s.highWater = m_highWater.load(std::memory_order_relaxed);
+        s.pushed = m_pushed.load(std::memory_order_relaxed);
+        s.popped = m_popped.load(std::memory_order_relaxed);
+        s.drops = m_drops.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    struct Cell {
+        std::atomic<quint32> seq;
+        T item;
+    };
+
+    char m_pad0[64];
+    std::atomic<quint32> m_head{0};
+    char m_pad1[64 - sizeof(std::atomic<quint32>)];
+    std::atomic<quint32> m_tail{0};
+    char m_pad2[64 - sizeof(std::atomic<quint32>)];
+    std::atomic<quint32> m_highWater{0};
+    std::atomic<quint64> m_pushed{0};
+    std::atomic<quint64> m_popped{0};
+    std::atomic<quint64> m_drops{0};
+
+    Cell m_cells[Capacity];
+};
+
+#endif // MPSCRING_H
@@ -0,0 +1,236 @@
+#ifndef NAVRECORD_H
+#define NAVRECORD_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <cstring>
+#include "spscring.h"
+
+#define NAV_SNAPSHOT_TEXT   512
+#define NAV_NODE_TEXT       256
+#define NAV_QUEUE_CAPACITY  1024
+#define NAV_SPILL_SLOTS     64      // teks besar yang menunggu di luar ring
+
+// Beberapa string UTF-8 dalam satu buffer tetap (tanpa alokasi), diisi urutan bebas.
+template<int Slots, int Bytes>
+struct NavTextPool {
+    quint16 offset[Slots];
+    quint16 length[Slots];
+    quint16 used;
+
+    void clear()
+    {
+        std::memset(length, 0, sizeof(length));
+        used = 0;
+    }
+
+    // false kalau tidak muat; slot lain tetap utuh
+    bool set(int slot, const QString &s)
+    {
+        const QByteArray utf8 = s.toUtf8();
+        if (slot < 0 || slot >= Slots || used + utf8.size() > Bytes)
+            return false;
+
+        std::memcpy(data + used, utf8.constData(), size_t(utf8.size()));
+        offset[slot] = used;
+        length[slot] = quint16(utf8.size());
+        used = quint16(used + utf8.size());
+        return true;
+    }
+
+    // Tanpa alokasi untuk teks ASCII (isi NODE_REPORT), fallback ke toUtf8()
+    bool set(int slot, const QChar *s, int n)
+    {
+        if (slot < 0 || slot >= Slots || n < 0 || used + n > Bytes)
+            return false;
+
+        for (int i = 0; i < n; ++i) {
+            const ushort ch = s[i].unicode();
+            if (ch >= 0x80)
+                return set(slot, QString(s, n));
+            data[used + i] = char(ch);
+        }
+        offset[slot] = used;
+        length[slot] = quint16(n);
+        used = quint16(used + n);
+        return true;
+    }
+
+    // Bandingkan tanpa membuat QString (non-ASCII selalu dianggap beda)
+    bool equals(int slot, const QString &s) const
+    {
+        if (slot < 0 || slot >= Slots || length[slot] == 0)
+            return s.isEmpty();
+        return s == QLatin1String(data + offset[slot], length[slot]);
+    }
+
+    QString get(int slot) const
+    {
+        if (slot < 0 || slot >= Slots || length[slot] == 0)
+            return QString();
+        return QString::fromUtf8(data + offset[slot], length[slot]);
+    }
+
+    char data[Bytes];
+};
+
+// Teks yang tidak muat di pool record (burst WAIS_NMEA panjang) dibawa di luar ring:
+// record hanya menyimpan id-nya, urutan terhadap field lain tetap ikut ring.
+// Ukurannya tetap; kalau GUI tertinggal lebih dari NAV_SPILL_SLOTS teks besar,
+// teks tertua tertimpa dan dihitung di lost().
+class NavTextSpill {
+public:
+    static NavTextSpill &instance()
+    {
+        static NavTextSpill spill;
+        return spill;
+    }
+
+    // Producer; id tidak pernah 0
+    quint32 put(const QString &s)
+    {
+        QMutexLocker lock(&m_mutex);
+        if (m_next == 0)
+            m_next = 1;     // wrap, 0 = tidak ada
+        const quint32 id = m_next++;
+        const int slot = int(id % NAV_SPILL_SLOTS);
+        m_id[slot] = id;
+        m_text[slot] = s;
+        ++m_spilled;
+        return id;
+    }
+
+    // Consumer; false kalau teksnya sudah tertimpa
+    bool get(quint32 id, QString &out)
+    {
+        QMutexLocker lock(&m_mutex);
+        const int slot = int(id % NAV_SPILL_SLOTS);
+        if (m_id[slot] != id) {
+            ++m_lost;
+            return false;
+        }
+        out = m_text[slot];
+        return true;
+    }
+
+    quint64 spilled() const { QMutexLocker lock(&m_mutex); return m_spilled; }
+    quint64 lost() const { QMutexLocker lock(&m_mutex); return m_lost; }
+
+private:
+    NavTextSpill() = default;
+
+    mutable QMutex m_mutex;
+    QString m_text[NAV_SPILL_SLOTS];
+    quint32 m_id[NAV_SPILL_SLOTS] = {};
+    quint32 m_next = 1;
+    quint64 m_spilled = 0;
+    quint64 m_lost = 0;
+};
+
+// Isi satu JSON object MOOS (NAV_*, RTE_*, WAIS_NMEA) dalam bentuk POD.
+// 'present' menandai field mana yang ada di object ini, supaya GUI menerapkan
+// semua field sekaligus dan tidak pernah melihat own ship setengah ter-update.
+struct NavSnapshot {
+    enum Value {
+        NavLat, NavLong, NavDepth, NavHeading, NavHeadingOG, NavCourseOG,
+        NavSpeed, NavSpeedOG, NavSOG, NavYaw, NavZ, NavStw, NavDrift, NavDraft,
+        NavDriftAngle, NavSet, NavRot, NavDepthBelowKeel,
+        RteWpBrg, RteCrs, RteCtm, RteDtg, RteDtgM,
+        ValueCount
+    };
+
+    enum Text {
+        NavLatDms, NavLongDms, NavLatDmm, NavLongDmm, NavName, NavDeadReckon,
+        RteXtd, RteTtg, RteEta, WaisNmea,
+        TextCount
+    };
+
+    quint64 present;   // bit v = Value v, bit 32 + t = Text t
+    double value[ValueCount];
+    NavTextPool<TextCount, NAV_SNAPSHOT_TEXT> text;
+    quint32 spill[TextCount];   // id NavTextSpill untuk teks yang tidak muat di pool, 0 = tidak ada
+
+    void clear()
+    {
+        present = 0;
+        text.clear();
+        std::memset(spill, 0, sizeof(spill));
+    }
+
+    bool isEmpty() const { return present == 0; }
+
+    bool has(Value v) const { return present & (Q_UINT64_C(1) << v); }
+    bool has(Text t) const { return present & (Q_UINT64_C(1) << (32 + t)); }
+
+    void set(Value v, double d)
+    {
+        value[v] = d;
+        present |= Q_UINT64_C(1) << v;
+    }
+
+    // false kalau teks tidak muat di pool dan dibawa lewat NavTextSpill (tetap terkirim utuh)
+    bool set(Text t, const QString &s)
+    {
+        present |= Q_UINT64_C(1) << (32 + t);
+        if (text.set(t, s))
+            return true;
+        spill[t] = NavTextSpill::instance().put(s);
+        return false;
+    }
+
+    double get(Value v, double fallback = 0.0) const { return has(v) ? value[v] : fallback; }
+    QString get(Text t) const
+    {
+        QString s;
+        if (spill[t] == 0)
+            return text.get(t);
+        NavTextSpill::instance().get(spill[t], s);
+        return s;
+    }
+};
+
+// Satu NODE_REPORT_<name> yang sudah di-parse
+struct NavNodeReport {
+    enum Value {
+        X, Y, Spd, Hdg, Dep, Lat, Lon, Yaw, Time, Hog, Sog, Cog, Draft, Z,
+        Stw, Drift, DriftAngle, Set, Rot,
+        ValueCount
+    };
+
+    enum Text { NodeName, Name, Type, Mode, TextCount };
+
+    qint32 index;
+    double value[ValueCount];
+    NavTextPool<TextCount, NAV_NODE_TEXT> text;
+};
+
+// Record di ring AISSubscriber (threadAIS) -> GUI.
+// Ukurannya tetap supaya bisa lewat SpscRing tanpa alokasi per record.
+struct NavRecord {
+    enum Kind : quint8 {
+        Snapshot,   // nav
+        NodeShip    // node
+    };
+
+    Kind kind;
+    qint64 enqueuedNs;    // clockNs() saat push, untuk ukur latency ingest
+    union {
+        NavSnapshot nav;
+        NavNodeReport node;
+    };
+
+    // Monotonic clock bersama untuk producer dan consumer
+    static qint64 clockNs()
+    {
+        static QElapsedTimer clock = [] { QElapsedTimer t; t.start(); return t; }();
+        return clock.nsecsElapsed();
+    }
+};
+
+typedef SpscRing<NavRecord, NAV_QUEUE_CAPACITY> NavRecordQueue;
+
+#endif // NAVRECORD_H
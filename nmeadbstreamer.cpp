@@ -0,0 +1,245 @@
+#include "nmeadbstreamer.h"
+#include "aisdatabasemanager.h"
+#include "sqlstatementregistry.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QRegularExpression>
+#include <QThread>
+#include <QSqlDriver>
+#include <QSqlField>
+
+namespace {
+
+// Satu halaman = satu query pendek (transaksi implisit sendiri), jadi tidak ada snapshot
+// yang ditahan selama replay dan vacuum di nmea_records tetap jalan.
+// Keyset (timestamp, id): timestamp dibaca/di-bind sebagai teks supaya presisi mikrodetik
+// tidak hilang lewat QDateTime. Baris satu batch writer bisa punya timestamp sama,
+// id yang menentukan urutan.
+const char *kPageSql =
+    "SELECT id, timestamp::text, timestamp, nmea, data_source FROM nmea_records "
+    "WHERE timestamp BETWEEN ? AND ? "
+    "AND received_at >= ?::timestamp AND received_at < ?::timestamp "
+    "AND data_source = ANY(?::text[]) "
+    "AND timestamp >= ?::timestamp AND (timestamp, id) > (?::timestamp, ?) "
+    "ORDER BY timestamp, id LIMIT %1";
+
+const char *kRangeSql =
+    "SELECT min(timestamp), max(timestamp) FROM nmea_records "
+    "WHERE timestamp BETWEEN ? AND ? "
+    "AND received_at >= ?::timestamp AND received_at < ?::timestamp "
+    "AND data_source = ANY(?::text[])";
+
+QStringList sourcesOrDefault(const QStringList &dataSources)
+{
+    return dataSources.isEmpty() ? QStringList{"ownship", "aistarget"} : dataSources;
+}
+
+// EXPLAIN tidak bisa di-PREPARE: literal dibentuk driver (escape + tipe), bukan string manual
+QString sqlLiteral(const QSqlDatabase &conn, const QVariant &value)
+{
+    QSqlField field(QString(), value.type());
+    field.setValue(value);
+    return conn.driver()->formatValue(field);
+}
+
+} // namespace
+
+NmeaDbStreamer::NmeaDbStreamer(QObject *parent)
+    : QObject(parent)
+{
+    connect(this, &NmeaDbStreamer::estimateReady, this,
+            [this](qint64, const QDateTime &first, const QDateTime &last) {
+        if (first.isValid() && last.isValid() && first < last) {
+            m_rangeStartMs = first.toMSecsSinceEpoch();
+            m_rangeEndMs = last.toMSecsSinceEpoch();
+        }
+    });
+}
+
+NmeaDbStreamer::~NmeaDbStreamer()
+{
+    stop();
+}
+
+void NmeaDbStreamer::start(const QDateTime &startTime, const QDateTime &endTime, const QStringList &dataSources)
+{
+    stop();
+
+    m_ring.reset(new ChunkRing);
+    m_stop = false;
+    m_producerDone = false;
+    m_current.rows.clear();
+    m_currentPos = 0;
+    m_delivered = 0;
+    m_rangeStartMs = startTime.toMSecsSinceEpoch();
+    m_rangeEndMs = endTime.toMSecsSinceEpoch();
+    m_active = true;
+
+    m_future = QtConcurrent::run([this, startTime, endTime, dataSources]() {
+        run(startTime, endTime, dataSources);
+    });
+}
+
+void NmeaDbStreamer::stop()
+{
+    m_stop = true;
+    if (m_future.isRunning()) {
+        m_future.waitForFinished();
+    }
+    m_ring.reset();
+    m_current.rows.clear();
+    m_currentPos = 0;
+    m_active = false;
+}
+
+bool NmeaDbStreamer::push(DbNmeaChunk &chunk)
+{
+    // Jendela prefetch penuh: tunggu GUI mengonsumsi (backpressure ke query halaman)
+    while (m_ring->depth() >= quint32(PrefetchChunks)) {
+        if (m_stop.load())
+            return false;
+        QThread::msleep(10);
+    }
+    m_ring->tryPush(chunk);
+    chunk.rows.clear();
+    return true;
+}
+
+void NmeaDbStreamer::run(const QDateTime &startTime, const QDateTime &endTime, const QStringList &dataSources)
+{
+    const QString connName = QString("nmea_playback_%1").arg(quintptr(QThread::currentThreadId()));
+    qint64 total = 0;
+    bool ok = false;
+
+    {
+        QSqlDatabase conn = AisDatabaseManager::openThreadConnection(connName);
+        if (conn.isOpen()) {
+            SqlStatementRegistry statements(connName);
+
+            // Jendela received_at memangkas partisi harian, timestamp tetap penentu hasil
+            const int slack = AisDatabaseManager::RECEIVED_AT_SLACK_DAYS;
+            QVariantList sources;
+            for (const QString &source : sourcesOrDefault(dataSources)) {
+                sources << source;
+            }
+            const QVariantList range = {
+                SqlStatementRegistry::timestamp(startTime),
+                SqlStatementRegistry::timestamp(endTime),
+                SqlStatementRegistry::utcText(startTime.addDays(-slack)),
+                SqlStatementRegistry::utcText(endTime.addDays(slack)),
+                SqlStatementRegistry::arrayLiteral(sources)
+            };
+
+            // Estimate murah: min/max lewat index timestamp, jumlah baris dari planner
+            qint64 estimated = -1;
+            QDateTime first, last;
+            if (QSqlQuery *minMax = statements.statement("playback_range", kRangeSql)) {
+                for (int i = 0; i < range.size(); ++i) {
+                    minMax->bindValue(i, range.at(i));
+                }
+                if (statements.exec("playback_range") && minMax->next()) {
+                    first = minMax->value(0).toDateTime();
+                    last = minMax->value(1).toDateTime();
+                }
+                minMax->finish();
+            }
+
+            QString explain = QString(kRangeSql).replace("min(timestamp), max(timestamp)", "1");
+            for (const QVariant &value : range) {
+                explain.replace(explain.indexOf('?'), 1, sqlLiteral(conn, value));
+            }
+            QSqlQuery query(conn);
+            if (query.exec("EXPLAIN " + explain) && query.next()) {
+                const QRegularExpressionMatch m = QRegularExpression("rows=(\\d+)").match(query.value(0).toString());
+                if (m.hasMatch()) {
+                    estimated = m.captured(1).toLongLong();
+                }
+            }
+            query.finish();
+            emit estimateReady(estimated, first, last);
+
+            const QString pageKey = "playback_page";
+            QSqlQuery *page = statements.statement(pageKey, QString(kPageSql).arg(int(FetchRows)));
+            ok = page != nullptr;
+
+            // Kunci awal di bawah semua baris rentang (id serial selalu positif)
+            QVariant lastTs = SqlStatementRegistry::utcText(QDateTime::fromMSecsSinceEpoch(0, Qt::UTC));
+            qint64 lastId = -1;
+            DbNmeaChunk chunk;
+
+            while (ok && !m_stop.load()) {
+                int p = 0;
+                for (const QVariant &value : range) {
+                    page->bindValue(p++, value);
+                }
+                page->bindValue(p++, lastTs);
+                page->bindValue(p++, lastTs);
+                page->bindValue(p++, lastId);
+
+                if (!statements.exec(pageKey)) {
+                    qWarning() << "[DB PLAYBACK] Page query failed:" << page->lastError().text();
+                    ok = false;
+                    break;
+                }
+
+                chunk.rows.reserve(FetchRows);
+                while (page->next()) {
+                    lastId = page->value(0).toLongLong();
+                    lastTs = page->value(1).toString();
+                    chunk.rows.append({page->value(2).toDateTime(), page->value(3).toString(), page->value(4).toString()});
+                }
+                page->finish();
+                if (chunk.rows.isEmpty())
+                    break;
+
+                const bool lastPage = chunk.rows.size() < FetchRows;
+                const bool firstChunk = (total == 0);
+                total += chunk.rows.size();
+                if (!push(chunk))
+                    break;
+                if (firstChunk) {
+                    emit rowsAvailable();
+                }
+                if (lastPage)
+                    break;
+            }
+        }
+    }
+    AisDatabaseManager::closeThreadConnection(connName);
+
+    m_producerDone = true;
+    if (!m_stop.load()) {
+        emit streamFinished(total, ok);
+    }
+}
+
+const DbNmeaRow* NmeaDbStreamer::peek()
+{
+    while (m_currentPos >= m_current.rows.size()) {
+        if (!m_ring || !m_ring->tryPop(m_current))
+            return nullptr;
+        m_currentPos = 0;
+    }
+    return &m_current.rows.at(m_currentPos);
+}
+
+void NmeaDbStreamer::pop()
+{
+    if (peek()) {
+        ++m_currentPos;
+        ++m_delivered;
+    }
+}
+
+bool NmeaDbStreamer::atEnd()
+{
+    return m_producerDone.load() && peek() == nullptr;
+}
+
+int NmeaDbStreamer::progressPercent(const QDateTime &at) const
+{
+    const qint64 span = m_rangeEndMs - m_rangeStartMs;
+    if (span <= 0)
+        return 0;
+    return int(qBound<qint64>(0, (at.toMSecsSinceEpoch() - m_rangeStartMs) * 100 / span, 100));
+}
@@ -0,0 +1,89 @@
+#ifndef NMEADBSTREAMER_H
+#define NMEADBSTREAMER_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QStringList>
+#include <QVector>
+#include <QFuture>
+#include <QScopedPointer>
+#include <atomic>
+
+#include "spscring.h"
+
+// Satu baris nmea_records untuk playback
+struct DbNmeaRow {
+    QDateTime timestamp;
+    QString nmea;
+    QString dataSource;
+};
+
+// Satu halaman keyset dari server
+struct DbNmeaChunk {
+    QVector<DbNmeaRow> rows;
+};
+
+// Playback DB tanpa memuat seluruh rentang ke RAM.
+// Thread worker membuka koneksi sendiri dan membaca per FetchRows baris dengan
+// keyset pagination pada (timestamp, id): tiap halaman query pendek, tanpa transaksi
+// panjang yang menahan vacuum. Halaman masuk ke ring SPSC berukuran tetap (jendela prefetch).
+// Kalau ring penuh worker menunggu, jadi memori dibatasi FetchRows x PrefetchChunks baris.
+// GUI membaca lewat peek()/pop() dari timer playback.
+class NmeaDbStreamer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum {
+        FetchRows = 2000,
+        PrefetchChunks = 16
+    };
+
+    explicit NmeaDbStreamer(QObject *parent = nullptr);
+    ~NmeaDbStreamer() override;
+
+    void start(const QDateTime &startTime, const QDateTime &endTime,
+               const QStringList &dataSources = {"ownship", "aistarget"});
+    void stop();
+
+    // Sudah start dan belum di-stop (termasuk saat menunggu chunk pertama)
+    bool isActive() const { return m_active; }
+
+    // Sisi konsumen (thread GUI). nullptr = belum ada baris di jendela prefetch.
+    const DbNmeaRow* peek();
+    void pop();
+    // Worker selesai dan semua baris sudah dikonsumsi
+    bool atEnd();
+
+    qint64 deliveredRows() const { return m_delivered; }
+    // Progres 0..100 berdasarkan posisi waktu di rentang data (bukan jumlah baris)
+    int progressPercent(const QDateTime &at) const;
+
+signals:
+    // Perkiraan planner (EXPLAIN) dan rentang waktu data sebenarnya
+    void estimateReady(qint64 estimatedRows, const QDateTime &first, const QDateTime &last);
+    void rowsAvailable();
+    void streamFinished(qint64 totalRows, bool ok);
+
+private:
+    typedef SpscRing<DbNmeaChunk, PrefetchChunks> ChunkRing;
+
+    void run(const QDateTime &startTime, const QDateTime &endTime, const QStringList &dataSources);
+    bool push(DbNmeaChunk &chunk);
+
+    QScopedPointer<ChunkRing> m_ring;
+    QFuture<void> m_future;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_producerDone{false};
+
+    DbNmeaChunk m_current;
+    int m_currentPos = 0;
+    bool m_active = false;
+    qint64 m_delivered = 0;
+
+    // Rentang untuk progres; dipersempit ke min/max data saat estimate datang
+    qint64 m_rangeStartMs = 0;
+    qint64 m_rangeEndMs = 0;
+};
+
+#endif // NMEADBSTREAMER_H
@@ -0,0 +1,291 @@
+#include "nmearecordwriter.h"
+#include "aisdatabasemanager.h"
+
+#include <QDebug>
+#include <QSqlError>
+#include <QStringList>
+
+namespace {
+
+// timestamp berisi jam TimeZone sesi (konvensi DEFAULT now()). Diisi per baris dari receivedAt
+// lewat ?::timestamptz, yang dikonversi ke jam sesi persis seperti now(); kalau dibiarkan ke
+// DEFAULT, semua baris satu batch mendapat waktu awal transaksi yang sama.
+// received_at berisi jam UTC tanpa zona, di-bind sebagai teks (lihat SqlStatementRegistry::utcText).
+const char *kColumns =
+    "timestamp, received_at, nmea, data_source, mmsi, latitude, longitude, "
+    "vessel_name, raw_data_type, parsed_successfully, message_type, call_sign, "
+    "imo, ship_type, speed_over_ground, course_over_ground, true_heading";
+const int kColumnCount = 17;
+
+const unsigned long kIdleSleepMs = 5;
+const qint64 kReconnectMs = 2000;       // DB mati: jangan coba connect tiap batch
+const qint64 kStatsLogMs = 60 * 1000;
+
+} // namespace
+
+NmeaRecordWriter::NmeaRecordWriter()
+    : m_queue(new MpscRing<NmeaRecordRow, NMEA_WRITER_QUEUE_CAPACITY>)
+{
+}
+
+NmeaRecordWriter::~NmeaRecordWriter()
+{
+    stop();
+    delete m_queue;
+}
+
+void NmeaRecordWriter::start()
+{
+    if (m_thread)
+        return;
+
+    m_stop = false;
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("NmeaRecordWriter");
+    m_thread->start(QThread::LowPriority);
+}
+
+void NmeaRecordWriter::stop()
+{
+    if (!m_thread)
+        return;
+
+    m_stop = true;
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+}
+
+bool NmeaRecordWriter::enqueue(const NmeaRecordRow &row)
+{
+    return m_queue->tryPush(row);
+}
+
+NmeaRecordWriter::Stats NmeaRecordWriter::stats() const
+{
+    const auto q = m_queue->stats();
+    Stats s;
+    s.queued = q.depth;
+    s.highWater = q.highWater;
+    s.dropped = q.drops;
+    s.written = m_written.load(std::memory_order_relaxed);
+    s.failed = m_failed.load(std::memory_order_relaxed);
+    s.commits = m_commits.load(std::memory_order_relaxed);
+    s.lastCommitMs = m_lastCommitMs.load(std::memory_order_relaxed);
+    return s;
+}
+
+bool NmeaRecordWriter::ensureConnection()
+{
+    if (m_conn.isOpen())
+        return true;
+
+    if (m_lastConnectAttempt.isValid() && m_lastConnectAttempt.elapsed() < kReconnectMs)
+        return false;
+    m_lastConnectAttempt.start();
+
+    // Statement lama terikat ke koneksi yang sudah mati
+    m_statements.invalidate();
+    if (QSqlDatabase::contains(m_connName)) {
+        m_conn = QSqlDatabase::database(m_connName, false);
+        m_conn.open();
+    } else {
+        m_conn = AisDatabaseManager::openThreadConnection(m_connName);
+    }
+    return m_conn.isOpen();
+}
+
+QSqlQuery* NmeaRecordWriter::statementFor(int rows, QString &key)
+{
+    key = QString("nmea_records_insert_%1").arg(rows, 3, 10, QLatin1Char('0'));
+
+    // SQL hanya dibangun kalau statement belum ada di registry
+    if (QSqlQuery *query = m_statements.find(key))
+        return query;
+
+    const QString tuple = QStringLiteral("(?::timestamptz, ?::timestamp, ") + QStringLiteral("?, ").repeated(kColumnCount - 3)
+                          + QStringLiteral("?)");
+    QStringList values;
+    values.reserve(rows);
+    for (int r = 0; r < rows; ++r) {
+        values << tuple;
+    }
+    return m_statements.statement(key, QString("INSERT INTO nmea_records (%1) VALUES %2").arg(kColumns, values.join(", ")));
+}
+
+bool NmeaRecordWriter::insertRows(const NmeaRecordRow *rows, int count)
+{
+    QString key;
+    QSqlQuery *query = statementFor(count, key);
+    if (!query)
+        return false;
+
+    int p = 0;
+    for (int r = 0; r < count; ++r) {
+        const NmeaRecordRow &row = rows[r];
+        query->bindValue(p++, SqlStatementRegistry::timestamp(row.receivedAt));
+        query->bindValue(p++, SqlStatementRegistry::utcText(row.receivedAt));
+        query->bindValue(p++, row.nmea);
+        query->bindValue(p++, row.dataSource);
+        query->bindValue(p++, SqlStatementRegistry::mmsi(row.mmsi));
+        query->bindValue(p++, SqlStatementRegistry::real(row.latitude));
+        query->bindValue(p++, SqlStatementRegistry::real(row.longitude));
+        query->bindValue(p++, SqlStatementRegistry::text(row.vesselName));
+        query->bindValue(p++, SqlStatementRegistry::text(row.rawDataType));
+        query->bindValue(p++, true);
+        query->bindValue(p++, SqlStatementRegistry::text(row.messageType));
+        query->bindValue(p++, SqlStatementRegistry::text(row.callSign));
+        query->bindValue(p++, SqlStatementRegistry::int8(qint64(row.imo), row.imo > 0));
+        query->bindValue(p++, row.shipType > 0 ? QVariant(row.shipType) : QVariant(QVariant::Int));
+        query->bindValue(p++, SqlStatementRegistry::real(row.sog));
+        query->bindValue(p++, SqlStatementRegistry::real(row.cog));
+        query->bindValue(p++, SqlStatementRegistry::real(row.heading));
+    }
+
+    if (!m_statements.exec(key)) {
+        m_lastError = query->lastError();
+        if (count == 1) {
+            qWarning() << "[NMEA WRITER] Insert failed, row dropped:" << m_lastError.text()
+                       << "nmea:" << rows[0].nmea.left(100);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool NmeaRecordWriter::commitRows(const NmeaRecordRow *rows, int count)
+{
+    // Pecah ke statement berukuran pangkat dua supaya jumlah prepared statement tetap kecil
+    bool ok = m_conn.transaction();
+    if (!ok) {
+        m_lastError = m_conn.lastError();
+    }
+    int offset = 0;
+    while (ok && offset < count) {
+        int n = MaxRowsPerStatement;
+        while (n > count - offset) {
+            n >>= 1;
+        }
+        ok = insertRows(rows + offset, n);
+        offset += n;
+    }
+
+    if (ok && m_conn.commit())
+        return true;
+    if (ok) {
+        m_lastError = m_conn.lastError();
+    }
+    m_conn.rollback();
+    return false;
+}
+
+int NmeaRecordWriter::writeRows(const NmeaRecordRow *rows, int count)
+{
+    if (commitRows(rows, count))
+        return count;
+
+    // Koneksi putus: semua sisa baris gagal, jangan dibelah sampai per baris.
+    // Koneksi ditutup supaya ensureConnection() membuka ulang di batch berikutnya.
+    if (m_lastError.type() == QSqlError::ConnectionError || !m_conn.isOpen()) {
+        m_conn.close();
+        return 0;
+    }
+    if (count == 1)
+        return 0;
+
+    // Satu baris buruk tidak boleh membuang seluruh batch: belah dua dan coba lagi,
+    // sampai baris yang ditolak terisolasi (paling banyak log2(CommitRows) tingkat)
+    const int half = count / 2;
+    return writeRows(rows, half) + writeRows(rows + half, count - half);
+}
+
+bool NmeaRecordWriter::flush(QVector<NmeaRecordRow> &batch)
+{
+    const int n = batch.size();
+    if (n == 0)
+        return true;
+
+    if (!ensureConnection()) {
+        m_failed.fetch_add(n, std::memory_order_relaxed);
+        batch.clear();
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_lastError = QSqlError();
+    const int written = writeRows(batch.constData(), n);
+    const bool ok = written == n;
+
+    if (written > 0) {
+        m_written.fetch_add(written, std::memory_order_relaxed);
+        m_commits.fetch_add(1, std::memory_order_relaxed);
+        m_lastCommitMs.store(timer.elapsed(), std::memory_order_relaxed);
+    }
+    if (!ok) {
+        m_failed.fetch_add(n - written, std::memory_order_relaxed);
+        qWarning() << "[NMEA WRITER]" << n - written << "of" << n << "rows not written:" << m_lastError.text();
+    }
+
+    batch.clear();
+    return ok;
+}
+
+void NmeaRecordWriter::run()
+{
+    m_connName = QString("nmea_writer_%1").arg(quintptr(this));
+    m_statements.setConnectionName(m_connName);
+    ensureConnection();
+
+    QVector<NmeaRecordRow> batch;
+    batch.reserve(CommitRows);
+
+    QElapsedTimer batchAge;
+    QElapsedTimer statsClock;
+    statsClock.start();
+    Stats lastStats;
+
+    NmeaRecordRow row;
+    for (;;) {
+        const bool stopping = m_stop.load();
+
+        int popped = 0;
+        while (batch.size() < CommitRows && m_queue->tryPop(row)) {
+            if (batch.isEmpty()) {
+                batchAge.start();
+            }
+            batch.append(std::move(row));
+            ++popped;
+        }
+
+        const bool due = !batch.isEmpty()
+                         && (batch.size() >= CommitRows || batchAge.elapsed() >= CommitMs || stopping);
+        if (due) {
+            flush(batch);
+        }
+
+        if (stopping && batch.isEmpty() && m_queue->depth() == 0)
+            break;
+
+        if (popped == 0 && !due) {
+            QThread::msleep(kIdleSleepMs);
+        }
+
+        if (statsClock.elapsed() >= kStatsLogMs) {
+            const Stats s = stats();
+            const double secs = statsClock.elapsed() / 1000.0;
+            qDebug() << "[NMEA WRITER]" << qRound((s.written - lastStats.written) / secs) << "rows/s,"
+                     << "queued" << s.queued << "(max" << s.highWater << "),"
+                     << "dropped" << s.dropped - lastStats.dropped << ","
+                     << "failed" << s.failed - lastStats.failed << ","
+                     << "last commit" << s.lastCommitMs << "ms";
+            lastStats = s;
+            statsClock.restart();
+        }
+    }
+
+    m_statements.invalidate();
+    m_conn = QSqlDatabase();
+    AisDatabaseManager::closeThreadConnection(m_connName);
+}
@@ -0,0 +1,106 @@
+#ifndef NMEARECORDWRITER_H
+#define NMEARECORDWRITER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QDateTime>
+#include <QVector>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <atomic>
+
+#include "mpscring.h"
+#include "sqlstatementregistry.h"
+
+#define NMEA_WRITER_QUEUE_CAPACITY  (1 << 15)   // ~1.5 detik backlog pada 20k baris/detik
+
+// Satu baris nmea_records. Kolom numerik NaN / 0 ditulis NULL, string kosong NULL.
+struct NmeaRecordRow {
+    QDateTime receivedAt;       // UTC, diambil saat kalimat diterima, bukan saat commit
+    QString nmea;
+    QString dataSource;
+    quint32 mmsi = 0;
+    double latitude = qQNaN();
+    double longitude = qQNaN();
+    double sog = qQNaN();
+    double cog = qQNaN();
+    double heading = qQNaN();
+    QString vesselName;
+    QString callSign;
+    QString messageType;
+    QString rawDataType;
+    quint64 imo = 0;
+    int shipType = 0;
+};
+
+// Penulis nmea_records di thread sendiri.
+// Pemanggil hanya enqueue() ke ring MPSC (tanpa lock, tanpa query); thread writer
+// mengumpulkan baris dan menulisnya dengan INSERT multi-baris yang di-prepare sekali
+// per ukuran (256, 128, ... 1 baris), satu transaksi per commit. Transaksi yang gagal
+// di-rollback lalu dibelah dua dan diulang, jadi satu baris buruk tidak membuang batch.
+// Commit terjadi tiap CommitRows baris atau CommitMs sejak baris pertama batch.
+// Ring penuh = baris dibuang dan dihitung (drops), pemanggil tidak pernah diblok.
+class NmeaRecordWriter
+{
+public:
+    enum {
+        MaxRowsPerStatement = 256,
+        CommitRows = 4096,
+        CommitMs = 250
+    };
+
+    struct Stats {
+        quint32 queued = 0;
+        quint32 highWater = 0;
+        quint64 written = 0;
+        quint64 dropped = 0;    // ring penuh
+        quint64 failed = 0;     // baris ditolak DB (baris buruk atau koneksi putus)
+        quint64 commits = 0;
+        qint64 lastCommitMs = 0;
+    };
+
+    NmeaRecordWriter();
+    ~NmeaRecordWriter();
+
+    void start();
+    void stop();        // flush sisa antrian lalu tutup koneksi
+    bool isRunning() const { return m_thread != nullptr; }
+
+    // Thread mana saja; false kalau antrian penuh
+    bool enqueue(const NmeaRecordRow &row);
+
+    Stats stats() const;
+    // Histogram latency INSERT per ukuran statement
+    QString latencyReport() const { return m_statements.latencyReport(); }
+
+private:
+    void run();
+    bool flush(QVector<NmeaRecordRow> &batch);
+    // Satu transaksi untuk count baris; rollback kalau ada statement yang gagal
+    bool commitRows(const NmeaRecordRow *rows, int count);
+    // commitRows, dibelah dua saat gagal supaya hanya baris buruk yang hilang; return baris tertulis
+    int writeRows(const NmeaRecordRow *rows, int count);
+    bool insertRows(const NmeaRecordRow *rows, int count);
+    QSqlQuery* statementFor(int rows, QString &key);
+    bool ensureConnection();
+
+    MpscRing<NmeaRecordRow, NMEA_WRITER_QUEUE_CAPACITY> *m_queue;
+    QThread *m_thread = nullptr;
+    std::atomic<bool> m_stop{false};
+
+    // Hanya dipakai di thread writer
+    QString m_connName;
+    QSqlDatabase m_conn;
+    SqlStatementRegistry m_statements;
+    QElapsedTimer m_lastConnectAttempt;
+    QSqlError m_lastError;
+
+    std::atomic<quint64> m_written{0};
+    std::atomic<quint64> m_failed{0};
+    std::atomic<quint64> m_commits{0};
+    std::atomic<qint64> m_lastCommitMs{0};
+};
+
+#endif // NMEARECORDWRITER_H
@@ -0,0 +1,242 @@
+#include "nodefleet.h"
+#include "ecwidget.h"
+#include <QLocale>
+#include <QStringList>
+#include <limits>
+
+namespace {
+
+enum NodeKey {
+    KeyUnknown = -1,
+    KeyName = -2,
+    KeyType = -3,
+    KeyMode = -4,
+    KeyIndex = -5
+    // >= 0: NavNodeReport::Value
+};
+
+inline bool keyIs(const QChar *key, int length, const char *literal)
+{
+    for (int i = 0; i < length; ++i) {
+        if (literal[i] == 0 || key[i].unicode() != ushort(literal[i]))
+            return false;
+    }
+    return literal[length] == 0;
+}
+
+// Key NODE_REPORT di-intern ke enum lewat switch panjang key
+int lookupKey(const QChar *key, int length)
+{
+    switch (length) {
+    case 1:
+        switch (key[0].unicode()) {
+        case 'X': return NavNodeReport::X;
+        case 'Y': return NavNodeReport::Y;
+        case 'Z': return NavNodeReport::Z;
+        default: break;
+        }
+        break;
+    case 3:
+        if (keyIs(key, length, "LAT")) return NavNodeReport::Lat;
+        if (keyIs(key, length, "LON")) return NavNodeReport::Lon;
+        if (keyIs(key, length, "HDG")) return NavNodeReport::Hdg;
+        if (keyIs(key, length, "SPD")) return NavNodeReport::Spd;
+        if (keyIs(key, length, "SOG")) return NavNodeReport::Sog;
+        if (keyIs(key, length, "COG")) return NavNodeReport::Cog;
+        if (keyIs(key, length, "HOG")) return NavNodeReport::Hog;
+        if (keyIs(key, length, "DEP")) return NavNodeReport::Dep;
+        if (keyIs(key, length, "YAW")) return NavNodeReport::Yaw;
+        if (keyIs(key, length, "STW")) return NavNodeReport::Stw;
+        if (keyIs(key, length, "SET")) return NavNodeReport::Set;
+        if (keyIs(key, length, "ROT")) return NavNodeReport::Rot;
+        break;
+    case 4:
+        if (keyIs(key, length, "NAME")) return KeyName;
+        if (keyIs(key, length, "TYPE")) return KeyType;
+        if (keyIs(key, length, "MODE")) return KeyMode;
+        if (keyIs(key, length, "TIME")) return NavNodeReport::Time;
+        break;
+    case 5:
+        if (keyIs(key, length, "INDEX")) return KeyIndex;
+        if (keyIs(key, length, "DRAFT")) return NavNodeReport::Draft;
+        if (keyIs(key, length, "DRIFT")) return NavNodeReport::Drift;
+        break;
+    case 11:
+        if (keyIs(key, length, "DRIFT_ANGLE")) return NavNodeReport::DriftAngle;
+        break;
+    default:
+        break;
+    }
+    return KeyUnknown;
+}
+
+inline void trim(const QChar *&begin, const QChar *&end)
+{
+    while (begin < end && begin->isSpace()) ++begin;
+    while (end > begin && (end - 1)->isSpace()) --end;
+}
+
+} // namespace
+
+bool NodeFleet::Node::hasPosition() const
+{
+    return !qIsNaN(lat()) && !qIsNaN(lon()) && lat() != 0.0 && lon() != 0.0;
+}
+
+bool NodeFleet::parseReport(const QString &report, NavNodeReport &out)
+{
+    out.index = 0;
+    out.text.clear();
+    for (int i = 0; i < NavNodeReport::ValueCount; ++i) {
+        out.value[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    const QLocale c = QLocale::c();
+    const QChar *p = report.constData();
+    const QChar *end = p + report.size();
+    bool ok = true;
+
+    while (p < end) {
+        // Satu pasangan KEY=VALUE sampai koma berikutnya
+        const QChar *pairEnd = p;
+        const QChar *eq = nullptr;
+        int eqCount = 0;
+        while (pairEnd < end && pairEnd->unicode() != ',') {
+            if (pairEnd->unicode() == '=') {
+                if (!eq) eq = pairEnd;
+                ++eqCount;
+            }
+            ++pairEnd;
+        }
+
+        // Sama seperti split('=') lama: tepat satu key dan satu value
+        if (eqCount == 1 && eq > p && eq + 1 < pairEnd) {
+            const QChar *keyBegin = p, *keyEnd = eq;
+            const QChar *valBegin = eq + 1, *valEnd = pairEnd;
+            trim(keyBegin, keyEnd);
+            trim(valBegin, valEnd);
+
+            const int key = lookupKey(keyBegin, int(keyEnd - keyBegin));
+            const int valLength = int(valEnd - valBegin);
+
+            if (key >= 0) {
+                out.value[key] = c.toDouble(QStringView(valBegin, valLength));
+            } else if (key == KeyName) {
+                ok = out.text.set(NavNodeReport::Name, valBegin, valLength) && ok;
+            } else if (key == KeyType) {
+                ok = out.text.set(NavNodeReport::Type, valBegin, valLength) && ok;
+            } else if (key == KeyMode) {
+                ok = out.text.set(NavNodeReport::Mode, valBegin, valLength) && ok;
+            } else if (key == KeyIndex) {
+                out.index = c.toInt(QStringView(valBegin, valLength));
+            }
+        }
+
+        p = pairEnd + 1;
+    }
+
+    return ok;
+}
+
+int NodeFleet::find(const QString &nodeName, Qt::CaseSensitivity cs) const
+{
+    for (int id = 0; id < m_nodes.size(); ++id) {
+        if (m_nodes[id].nodeName.compare(nodeName, cs) == 0)
+            return id;
+    }
+    return -1;
+}
+
+int NodeFleet::intern(const NavNodeReport &report)
+{
+    // Armada kecil (puluhan node): scan linear atas array kontigu tanpa membuat QString
+    for (int id = 0; id < m_nodes.size(); ++id) {
+        if (report.text.equals(NavNodeReport::NodeName, m_nodes[id].nodeName))
+            return id;
+    }
+
+    Node node;
+    node.nodeName = report.text.get(NavNodeReport::NodeName);
+    for (int i = 0; i < NavNodeReport::ValueCount; ++i) {
+        node.value[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // Nama non-ASCII tidak lolos equals(); cek sekali lagi dengan QString
+    const int existing = find(node.nodeName);
+    if (existing >= 0)
+        return existing;
+
+    m_nodes.append(node);
+    return m_nodes.size() - 1;
+}
+
+int NodeFleet::apply(const NavNodeReport &report)
+{
+    const int id = intern(report);
+    Node &node = m_nodes[id];
+
+    std::memcpy(node.value, report.value, sizeof(node.value));
+    node.index = report.index;
+    ++node.updates;
+
+    // String hanya di-assign kalau berubah
+    if (!report.text.equals(NavNodeReport::Name, node.name))
+        node.name = report.text.get(NavNodeReport::Name);
+    if (!report.text.equals(NavNodeReport::Type, node.type))
+        node.type = report.text.get(NavNodeReport::Type);
+    if (!report.text.equals(NavNodeReport::Mode, node.mode))
+        node.mode = report.text.get(NavNodeReport::Mode);
+
+    return id;
+}
+
+ShipStruct NodeFleet::ship(int id) const
+{
+    ShipStruct ship;
+    if (id < 0 || id >= m_nodes.size())
+        return ship;
+
+    const Node &node = m_nodes[id];
+
+    // Map NODE_REPORT variables to ShipStruct fields
+    // Note: TYPE, MODE, INDEX, TIME are not in ShipStruct
+    ship.name = node.name;
+    ship.x = node.value[NavNodeReport::X];
+    ship.y = node.value[NavNodeReport::Y];
+    ship.speed = node.value[NavNodeReport::Spd];
+    ship.heading = node.value[NavNodeReport::Hdg];
+    ship.heading_og = node.value[NavNodeReport::Hog];
+    ship.depth = node.value[NavNodeReport::Dep];
+    ship.lat = node.value[NavNodeReport::Lat];
+    ship.lon = node.value[NavNodeReport::Lon];
+    ship.yaw = node.value[NavNodeReport::Yaw];
+    ship.speed_og = node.value[NavNodeReport::Sog];
+    ship.sog = node.value[NavNodeReport::Sog];
+    ship.course_og = node.value[NavNodeReport::Cog];
+    ship.draft = node.value[NavNodeReport::Draft];
+    ship.z = node.value[NavNodeReport::Z];
+    ship.stw = node.value[NavNodeReport::Stw];
+    ship.drift = node.value[NavNodeReport::Drift];
+    ship.drift_angle = node.value[NavNodeReport::DriftAngle];
+    ship.set = node.value[NavNodeReport::Set];
+    ship.rot = node.value[NavNodeReport::Rot];
+    return ship;
+}
+
+QMap<QString, ShipStruct> NodeFleet::toMap() const
+{
+    QMap<QString, ShipStruct> map;
+    for (int id = 0; id < m_nodes.size(); ++id) {
+        map.insert(m_nodes[id].nodeName, ship(id));
+    }
+    return map;
+}
+
+QStringList NodeFleet::names() const
+{
+    QStringList list;
+    for (const Node &node : m_nodes) {
+        list.append(node.nodeName);
+    }
+    return list;
+}
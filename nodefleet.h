@@ -0,0 +1,58 @@
+#ifndef NODEFLEET_H
+#define NODEFLEET_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include <QStringList>
+#include "navrecord.h"
+
+struct ShipStruct;
+
+// Fleet state dari NODE_REPORT_<name> (AUV/ASV).
+// Node disimpan berurutan di satu QVector dan diakses lewat id (index) yang
+// stabil selama sesi; tidak ada QString tampilan per node. ShipStruct hanya
+// dibentuk kalau ada yang memintanya lewat ship().
+class NodeFleet {
+public:
+    struct Node {
+        QString nodeName;   // key dari NODE_REPORT_<name>, uppercase
+        QString name;       // NAME
+        QString type;       // TYPE
+        QString mode;       // MODE
+        qint32 index = 0;   // INDEX
+        double value[NavNodeReport::ValueCount];
+        quint64 updates = 0;
+
+        double lat() const { return value[NavNodeReport::Lat]; }
+        double lon() const { return value[NavNodeReport::Lon]; }
+        bool hasPosition() const;
+    };
+
+    // Parse "NAME=archie,X=177.14,...,ROT=0.5" tanpa split/QStringList.
+    // Mengisi value, index dan teks Name/Type/Mode; NodeName diisi pemanggil.
+    static bool parseReport(const QString &report, NavNodeReport &out);
+
+    // Terapkan satu report; return id node
+    int apply(const NavNodeReport &report);
+
+    int find(const QString &nodeName, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+    bool contains(const QString &nodeName) const { return find(nodeName) >= 0; }
+
+    int size() const { return m_nodes.size(); }
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+    const Node& at(int id) const { return m_nodes[id]; }
+
+    ShipStruct ship(int id) const;
+    QMap<QString, ShipStruct> toMap() const;
+    QStringList names() const;
+
+    void clear() { m_nodes.clear(); }
+
+private:
+    int intern(const NavNodeReport &report);
+
+    QVector<Node> m_nodes;
+};
+
+#endif // NODEFLEET_H
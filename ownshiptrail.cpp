@@ -0,0 +1,193 @@
+#include "ownshiptrail.h"
+
+#include <QMutexLocker>
+#include <QtMath>
+#include <cmath>
+
+namespace {
+
+const double kEarthRadiusMeters = 6371000.0;
+
+double haversineMeters(double lat1, double lon1, double lat2, double lon2)
+{
+    const double dLat = qDegreesToRadians(lat2 - lat1);
+    const double dLon = qDegreesToRadians(lon2 - lon1);
+    const double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
+                     std::cos(qDegreesToRadians(lat1)) * std::cos(qDegreesToRadians(lat2)) *
+                     std::sin(dLon / 2) * std::sin(dLon / 2);
+    return kEarthRadiusMeters * 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+}
+
+} // namespace
+
+bool OwnShipTrail::append(qint64 timeMs, double lat, double lon, int mode, int minute, double distanceNm)
+{
+    if (!qIsFinite(lat) || !qIsFinite(lon))
+        return false;
+
+    QMutexLocker lock(&m_mutex);
+    if (!accept(timeMs, lat, lon, mode, minute, distanceNm))
+        return false;
+
+    if (m_chunks.isEmpty()) {
+        m_chunks.resize(OWNSHIP_TRAIL_CHUNKS);
+    }
+
+    const bool needChunk = m_count == 0
+                           || m_chunks[(m_first + m_count - 1) % OWNSHIP_TRAIL_CHUNKS].points.size() >= OWNSHIP_TRAIL_CHUNK;
+    if (needChunk) {
+        if (m_count == OWNSHIP_TRAIL_CHUNKS) {
+            // Penuh: chunk tertua dibuang utuh, slot-nya dipakai ulang (kapasitas tetap)
+            Chunk &oldest = m_chunks[m_first];
+            m_size -= oldest.points.size();
+            oldest.reset();
+            m_first = (m_first + 1) % OWNSHIP_TRAIL_CHUNKS;
+            --m_count;
+        }
+        Chunk &fresh = m_chunks[(m_first + m_count) % OWNSHIP_TRAIL_CHUNKS];
+        fresh.points.reserve(OWNSHIP_TRAIL_CHUNK);
+        ++m_count;
+    }
+
+    const TrackPoint point = { timeMs, lat, lon };
+    m_chunks[(m_first + m_count - 1) % OWNSHIP_TRAIL_CHUNKS].add(point);
+    ++m_size;
+    ++m_revision;
+    return true;
+}
+
+void OwnShipTrail::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    // Buffer chunk dibebaskan; ekor baru mengalokasikan lagi saat titik pertama masuk
+    m_chunks.clear();
+    m_first = 0;
+    m_count = 0;
+    m_size = 0;
+    ++m_revision;
+}
+
+int OwnShipTrail::size() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_size;
+}
+
+quint64 OwnShipTrail::revision() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_revision;
+}
+
+QVector<TrackPoint> OwnShipTrail::decimated(double toleranceMeters, int *level) const
+{
+    const int lvl = TrackSimplifier::toleranceLevel(toleranceMeters);
+    if (level) {
+        *level = lvl;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    QVector<TrackPoint> out;
+    for (int i = 0; i < m_count; ++i) {
+        out += chunkPoints(m_chunks[(m_first + i) % OWNSHIP_TRAIL_CHUNKS], lvl);
+    }
+    return out;
+}
+
+QVector<QVector<TrackPoint>> OwnShipTrail::decimatedRuns(double toleranceMeters, const QRectF &bounds,
+                                                         int *level) const
+{
+    const int lvl = TrackSimplifier::toleranceLevel(toleranceMeters);
+    if (level) {
+        *level = lvl;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    QVector<QVector<TrackPoint>> runs;
+    const Chunk *previous = nullptr;
+    bool previousVisible = false;
+    for (int i = 0; i < m_count; ++i) {
+        const Chunk &chunk = m_chunks[(m_first + i) % OWNSHIP_TRAIL_CHUNKS];
+        const bool visible = chunk.intersects(bounds);
+
+        if (visible) {
+            if (!previousVisible) {
+                runs.append(QVector<TrackPoint>());
+                if (previous) {
+                    runs.last().append(previous->points.last());
+                }
+            }
+            runs.last() += chunkPoints(chunk, lvl);
+        } else if (previousVisible && !chunk.points.isEmpty()) {
+            runs.last().append(chunk.points.first());
+        }
+
+        previous = &chunk;
+        previousVisible = visible;
+    }
+    return runs;
+}
+
+QVector<TrackPoint> OwnShipTrail::chunkPoints(const Chunk &chunk, int level) const
+{
+    // Chunk yang masih terisi disederhanakan setiap kali (paling banyak satu chunk)
+    if (chunk.points.size() < OWNSHIP_TRAIL_CHUNK)
+        return TrackSimplifier::simplify(chunk.points, TrackSimplifier::levelTolerance(level));
+
+    if (!chunk.levels.contains(level)) {
+        chunk.levels.insert(level, TrackSimplifier::simplify(chunk.points, TrackSimplifier::levelTolerance(level)));
+    }
+    return chunk.levels.value(level);
+}
+
+void OwnShipTrail::Chunk::add(const TrackPoint &point)
+{
+    if (points.isEmpty()) {
+        minLat = maxLat = point.lat;
+        minLon = maxLon = point.lon;
+    } else {
+        minLat = qMin(minLat, point.lat);
+        maxLat = qMax(maxLat, point.lat);
+        minLon = qMin(minLon, point.lon);
+        maxLon = qMax(maxLon, point.lon);
+    }
+    points.append(point);
+}
+
+void OwnShipTrail::Chunk::reset()
+{
+    points.resize(0);
+    levels.clear();
+}
+
+// Batas inklusif: bbox chunk bisa berupa garis atau titik (lebar/tinggi 0)
+bool OwnShipTrail::Chunk::intersects(const QRectF &bounds) const
+{
+    return !points.isEmpty()
+           && minLon <= bounds.right() && maxLon >= bounds.left()
+           && minLat <= bounds.bottom() && maxLat >= bounds.top();
+}
+
+bool OwnShipTrail::accept(qint64 timeMs, double lat, double lon, int mode, int minute, double distanceNm) const
+{
+    const TrackPoint *last = lastPoint();
+    if (!last)
+        return true;    // titik pertama langsung disimpan
+
+    switch (mode) {
+    case ByTime:
+        return timeMs - last->timeMs >= qint64(minute) * 60 * 1000;
+    case ByDistance:
+        return haversineMeters(last->lat, last->lon, lat, lon) >= distanceNm * 1852.0;
+    default:
+        return true;
+    }
+}
+
+const TrackPoint *OwnShipTrail::lastPoint() const
+{
+    if (m_count == 0)
+        return nullptr;
+    const Chunk &chunk = m_chunks[(m_first + m_count - 1) % OWNSHIP_TRAIL_CHUNKS];
+    return chunk.points.isEmpty() ? nullptr : &chunk.points.last();
+}
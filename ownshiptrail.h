@@ -0,0 +1,73 @@
+#ifndef OWNSHIPTRAIL_H
+#define OWNSHIPTRAIL_H
+
+#include <QtGlobal>
+#include <QHash>
+#include <QMutex>
+#include <QRectF>
+#include <QVector>
+
+#include "tracksimplifier.h"
+
+#define OWNSHIP_TRAIL_CHUNK     1024    // titik per chunk; chunk penuh tidak berubah lagi
+#define OWNSHIP_TRAIL_CHUNKS    256     // kapasitas 256K titik (~6 MB), chunk tertua dibuang saat penuh
+
+// Ekor ownship: ring chunk berisi record (waktu, lat, lon) yang dipadatkan.
+// Sampling mengikuti setting trail (mode waktu/jarak/setiap fix). Untuk digambar, tiap chunk
+// penuh menyimpan hasil Douglas-Peucker per level toleransi (lihat TrackSimplifier), jadi
+// jumlah vertex mengikuti resolusi layar, bukan panjang ekor.
+// append() dipanggil dari thread callback AIS, decimated() dari thread GUI.
+class OwnShipTrail
+{
+public:
+    // Nilai sama dengan SettingsData::trailMode
+    enum SampleMode {
+        EveryFix = 0,
+        ByTime = 1,
+        ByDistance = 2
+    };
+
+    // Return true kalau titik disimpan
+    bool append(qint64 timeMs, double lat, double lon, int mode, int minute, double distanceNm);
+    void clear();
+
+    int size() const;
+    bool isEmpty() const { return size() == 0; }
+    // Naik setiap ada titik baru atau clear()
+    quint64 revision() const;
+
+    // Titik untuk toleranceMeters (dibulatkan ke level TrackSimplifier, tidak lebih kasar).
+    // level diisi level yang dipakai supaya pemanggil bisa cache hasilnya.
+    QVector<TrackPoint> decimated(double toleranceMeters, int *level = nullptr) const;
+    // Sama, tapi chunk yang bbox-nya di luar bounds (x = lon, y = lat) dilewati tanpa
+    // disederhanakan. Hasil per potongan yang bersambung; tiap potongan ditutup dengan titik
+    // tetangga dari chunk yang dilewati supaya garis ke luar layar tetap tergambar.
+    QVector<QVector<TrackPoint>> decimatedRuns(double toleranceMeters, const QRectF &bounds,
+                                               int *level = nullptr) const;
+
+private:
+    struct Chunk {
+        QVector<TrackPoint> points;
+        mutable QHash<int, QVector<TrackPoint>> levels;     // hanya untuk chunk penuh
+        double minLat = 0, maxLat = 0, minLon = 0, maxLon = 0;
+
+        bool intersects(const QRectF &bounds) const;
+
+        void add(const TrackPoint &point);
+        void reset();
+    };
+
+    QVector<TrackPoint> chunkPoints(const Chunk &chunk, int level) const;
+
+    bool accept(qint64 timeMs, double lat, double lon, int mode, int minute, double distanceNm) const;
+    const TrackPoint *lastPoint() const;
+
+    mutable QMutex m_mutex;
+    QVector<Chunk> m_chunks;        // ring, m_first = chunk tertua
+    int m_first = 0;
+    int m_count = 0;                // chunk terpakai
+    int m_size = 0;                 // total titik
+    quint64 m_revision = 0;
+};
+
+#endif // OWNSHIPTRAIL_H
@@ -6,8 +6,8 @@ CONFIG -= app_bundle
 
 TARGET = simple_qt_test
 
-SOURCES += simple_qt_test.cpp aivdoencoder.cpp
+SOURCES += simple_qt_test.cpp aivdoencoder.cpp aispayload.cpp aisfragmentassembler.cpp
 
-HEADERS += aivdoencoder.h
+HEADERS += aivdoencoder.h aispayload.h aisfragmentassembler.h
 
 DEFINES += _WIN32
\ No newline at end of file
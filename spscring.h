@@ -0,0 +1,142 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <QtGlobal>
+#include <atomic>
+
+// Single-producer / single-consumer ring buffer of fixed-size records.
+// One thread calls tryPush(), one other thread calls tryPop(); no locks, no allocation
+// after construction. When the ring is full the new record is dropped and counted.
+template<typename T, int Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    struct Stats {
+        quint32 depth = 0;       // records waiting right now
+        quint32 highWater = 0;   // deepest the ring has been since resetStats()
+        quint64 pushed = 0;
+        quint64 popped = 0;
+        quint64 drops = 0;       // records rejected because the ring was full
+    };
+
+    SpscRing() = default;
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    static constexpr int capacity() { return Capacity; }
+
+    // Producer side
+    bool tryPush(const T &item)
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        const quint32 tail = m_tail.load(std::memory_order_acquire);
+        const quint32 depth = head - tail;
+
+        if (depth >= quint32(Capacity)) {
+            m_drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_items[head & (Capacity - 1)] = item;
+        m_head.store(head + 1, std::memory_order_release);
+
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        if (depth + 1 > m_highWater.load(std::memory_order_relaxed))
+            m_highWater.store(depth + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Producer side: slot to fill in place, then commitPush(). Avoids a copy of large records.
+    T* beginPush()
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        const quint32 tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail >= quint32(Capacity)) {
+            m_drops.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &m_items[head & (Capacity - 1)];
+    }
+
+    void commitPush()
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed) + 1;
+        m_head.store(head, std::memory_order_release);
+
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+        const quint32 depth = head - m_tail.load(std::memory_order_relaxed);
+        if (depth > m_highWater.load(std::memory_order_relaxed))
+            m_highWater.store(depth, std::memory_order_relaxed);
+    }
+
+    // Consumer side
+    bool tryPop(T &item)
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return false;
+
+        item = m_items[tail & (Capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        m_popped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer side: peek at the oldest record without copying, then release() it.
+    const T* front() const
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return nullptr;
+        return &m_items[tail & (Capacity - 1)];
+    }
+
+    void release()
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        m_popped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Safe from either thread; the value may be stale by the time it is used.
+    quint32 depth() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    Stats stats() const
+    {
+        Stats s;
+        s.depth = depth();
+        s.highWater = m_highWater.load(std::memory_order_relaxed);
+        s.pushed = m_pushed.load(std::memory_order_relaxed);
+        s.popped = m_popped.load(std::memory_order_relaxed);
+        s.drops = m_drops.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void resetStats()
+    {
+        m_highWater.store(depth(), std::memory_order_relaxed);
+        m_pushed.store(0, std::memory_order_relaxed);
+        m_popped.store(0, std::memory_order_relaxed);
+        m_drops.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // Producer and consumer indices on separate cache lines (padding instead of
+    // alignas so the ring can live inside heap objects without aligned new)
+    char m_pad0[64];
+    std::atomic<quint32> m_head{0};
+    char m_pad1[64 - sizeof(std::atomic<quint32>)];
+    std::atomic<quint32> m_tail{0};
+    char m_pad2[64 - sizeof(std::atomic<quint32>)];
+    std::atomic<quint32> m_highWater{0};
+    std::atomic<quint64> m_pushed{0};
+    std::atomic<quint64> m_popped{0};
+    std::atomic<quint64> m_drops{0};
+
+    T m_items[Capacity];
+};
+
+#endif // SPSCRING_H
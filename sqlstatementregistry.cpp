@@ -0,0 +1,190 @@
+#include "sqlstatementregistry.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QSqlError>
+#include <cmath>
+
+void SqlStatementRegistry::Latency::add(quint64 us)
+{
+    int bucket = 0;
+    for (quint64 v = us; v != 0 && bucket < LatencyBuckets - 1; v >>= 1) {
+        ++bucket;
+    }
+    ++buckets[bucket];
+    ++count;
+    totalUs += us;
+    maxUs = qMax(maxUs, us);
+}
+
+quint64 SqlStatementRegistry::Latency::percentileUs(double p) const
+{
+    if (count == 0)
+        return 0;
+
+    const quint64 rank = qMax<quint64>(1, quint64(std::ceil(p * count)));
+    quint64 seen = 0;
+    for (int i = 0; i < LatencyBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // Bucket i berisi [2^(i-1), 2^i) us
+            return qMin(maxUs, (quint64(1) << i) - 1);
+        }
+    }
+    return maxUs;
+}
+
+SqlStatementRegistry::SqlStatementRegistry()
+    : m_connName(QLatin1String(QSqlDatabase::defaultConnection))
+{
+}
+
+SqlStatementRegistry::SqlStatementRegistry(const QString &connectionName)
+    : m_connName(connectionName)
+{
+}
+
+void SqlStatementRegistry::setConnectionName(const QString &connectionName)
+{
+    invalidate();
+    m_connName = connectionName;
+}
+
+QSqlQuery* SqlStatementRegistry::statement(const QString &key, const QString &sql)
+{
+    auto it = m_queries.find(key);
+    if (it != m_queries.end())
+        return &it.value();
+
+    QSqlQuery query(QSqlDatabase::database(m_connName, false));
+    if (!query.prepare(sql)) {
+        qWarning() << "[SQL] Prepare" << key << "failed:" << query.lastError().text();
+        return nullptr;
+    }
+    return &m_queries.insert(key, query).value();
+}
+
+QSqlQuery* SqlStatementRegistry::find(const QString &key)
+{
+    auto it = m_queries.find(key);
+    return it != m_queries.end() ? &it.value() : nullptr;
+}
+
+bool SqlStatementRegistry::exec(const QString &key)
+{
+    auto it = m_queries.find(key);
+    if (it == m_queries.end()) {
+        qWarning() << "[SQL] Statement" << key << "not prepared";
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = it.value().exec();
+    const quint64 us = quint64(timer.nsecsElapsed() / 1000);
+
+    QMutexLocker locker(&m_latencyMutex);
+    Latency &latency = m_latency[key];
+    latency.add(us);
+    if (!ok) {
+        ++latency.failed;
+    }
+    return ok;
+}
+
+void SqlStatementRegistry::invalidate()
+{
+    m_queries.clear();
+}
+
+QHash<QString, SqlStatementRegistry::Latency> SqlStatementRegistry::latencies() const
+{
+    QMutexLocker locker(&m_latencyMutex);
+    return m_latency;
+}
+
+QString SqlStatementRegistry::latencyReport() const
+{
+    const QHash<QString, Latency> snapshot = latencies();
+    QStringList keys = snapshot.keys();
+    keys.sort();
+
+    QString report = QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                         .arg("statement", -28).arg("count", 9).arg("fail", 6).arg("avg_us", 9)
+                         .arg("p50_us", 9).arg("p95_us", 9).arg("p99_us", 9).arg("max_us", 9);
+    for (const QString &key : keys) {
+        const Latency &l = snapshot[key];
+        report += QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                      .arg(key, -28)
+                      .arg(l.count, 9)
+                      .arg(l.failed, 6)
+                      .arg(l.count ? l.totalUs / l.count : 0, 9)
+                      .arg(l.percentileUs(0.50), 9)
+                      .arg(l.percentileUs(0.95), 9)
+                      .arg(l.percentileUs(0.99), 9)
+                      .arg(l.maxUs, 9);
+    }
+    return report;
+}
+
+void SqlStatementRegistry::resetLatencies()
+{
+    QMutexLocker locker(&m_latencyMutex);
+    m_latency.clear();
+}
+
+QVariant SqlStatementRegistry::timestamp(const QDateTime &t)
+{
+    return t.isValid() ? QVariant(t.toUTC()) : QVariant(QVariant::DateTime);
+}
+
+QVariant SqlStatementRegistry::utcText(const QDateTime &t)
+{
+    return t.isValid() ? QVariant(t.toUTC().toString("yyyy-MM-dd hh:mm:ss.zzz")) : QVariant(QVariant::String);
+}
+
+QVariant SqlStatementRegistry::real(double v)
+{
+    return std::isnan(v) ? QVariant(QVariant::Double) : QVariant(v);
+}
+
+QVariant SqlStatementRegistry::int8(qint64 v, bool valid)
+{
+    return valid ? QVariant(v) : QVariant(QVariant::LongLong);
+}
+
+QVariant SqlStatementRegistry::mmsi(quint32 mmsi)
+{
+    return int8(qint64(mmsi), mmsi != 0);
+}
+
+QVariant SqlStatementRegistry::text(const QString &s)
+{
+    return s.isEmpty() ? QVariant(QVariant::String) : QVariant(s);
+}
+
+QString SqlStatementRegistry::arrayLiteral(const QVariantList &values)
+{
+    QString out;
+    out.reserve(values.size() * 12 + 2);
+    out += QLatin1Char('{');
+    for (int i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            out += QLatin1Char(',');
+        }
+
+        const QVariant &v = values.at(i);
+        if (v.isNull()) {
+            out += QLatin1String("NULL");
+            continue;
+        }
+
+        QString element = v.type() == QVariant::Double ? QString::number(v.toDouble(), 'g', 17)
+                                                       : v.toString();
+        element.replace(QLatin1Char('\\'), QLatin1String("\\\\"));
+        element.replace(QLatin1Char('"'), QLatin1String("\\\""));
+        out += QLatin1Char('"') + element + QLatin1Char('"');
+    }
+    out += QLatin1Char('}');
+    return out;
+}
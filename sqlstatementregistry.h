@@ -0,0 +1,78 @@
+#ifndef SQLSTATEMENTREGISTRY_H
+#define SQLSTATEMENTREGISTRY_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QVariant>
+#include <QHash>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+// Registry prepared statement untuk satu koneksi.
+// Tiap statement di-prepare sekali (server-side PREPARE lewat QPSQL) lalu dipakai ulang
+// dengan bind bertipe; exec() mencatat latency ke histogram per statement.
+// Dipakai dari thread pemilik koneksi saja; latencyReport() aman dari thread lain.
+class SqlStatementRegistry
+{
+public:
+    enum { LatencyBuckets = 24 };   // bucket log2 mikrodetik, terakhir = >= ~4 detik
+
+    struct Latency {
+        quint64 count = 0;
+        quint64 failed = 0;
+        quint64 totalUs = 0;
+        quint64 maxUs = 0;
+        quint64 buckets[LatencyBuckets] = {};
+
+        void add(quint64 us);
+        // Batas atas bucket tempat persentil p (0..1) jatuh
+        quint64 percentileUs(double p) const;
+    };
+
+    SqlStatementRegistry();
+    explicit SqlStatementRegistry(const QString &connectionName);
+
+    // Ganti koneksi; statement lama dibuang, histogram tetap
+    void setConnectionName(const QString &connectionName);
+    QString connectionName() const { return m_connName; }
+
+    // Prepared sekali per koneksi; nullptr kalau prepare gagal
+    QSqlQuery* statement(const QString &key, const QString &sql);
+    // Statement yang sudah di-prepare, tanpa membangun SQL; nullptr kalau belum ada
+    QSqlQuery* find(const QString &key);
+    // Jalankan statement yang sudah di-bind dan catat latency-nya
+    bool exec(const QString &key);
+
+    // Koneksi ditutup/dibuka ulang: prepared statement di server sudah hilang
+    void invalidate();
+
+    QHash<QString, Latency> latencies() const;
+    QString latencyReport() const;
+    void resetLatencies();
+
+    // Bind bertipe; nilai "tidak ada" jadi NULL dengan tipe yang benar
+    static QVariant timestamp(const QDateTime &t);     // selalu UTC
+    // Jam UTC sebagai teks ISO, untuk ?::timestamp ke kolom tanpa zona yang berisi jam UTC
+    // (received_at, minute, taken_at). QDateTime biasa dikirim QPSQL sebagai timestamptz
+    // dan dikonversi lewat TimeZone sesi.
+    static QVariant utcText(const QDateTime &t);
+    static QVariant real(double v);                    // NaN -> NULL
+    static QVariant int8(qint64 v, bool valid = true);
+    static QVariant mmsi(quint32 mmsi);                // 0 -> NULL, int8
+    static QVariant text(const QString &s);            // kosong -> NULL
+
+    // Literal array PostgreSQL untuk bind ke ?::tipe[] (mis. unnest); QVariant null -> NULL
+    static QString arrayLiteral(const QVariantList &values);
+
+private:
+    QString m_connName;
+    QHash<QString, QSqlQuery> m_queries;
+
+    mutable QMutex m_latencyMutex;
+    QHash<QString, Latency> m_latency;
+};
+
+#endif // SQLSTATEMENTREGISTRY_H
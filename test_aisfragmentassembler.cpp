@@ -0,0 +1,248 @@
+// Unit test AisFragmentAssembler: urutan fragment, checksum, fragment pertama yang
+// diulang, kedaluwarsa, tabel slot penuh dan kalimat yang ditolak.
+
+#include <QtTest>
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QVector>
+#include "aisfragmentassembler.h"
+
+namespace {
+
+// Kalimat NMEA lengkap dengan checksum dari isi antara '!' dan '*'
+QByteArray withChecksum(const QByteArray &body)
+{
+    int checksum = 0;
+    for (char c : body) {
+        checksum ^= static_cast<unsigned char>(c);
+    }
+    return "!" + body + "*" + QByteArray::number(checksum, 16).toUpper().rightJustified(2, '0');
+}
+
+QByteArray fragment(int total, int part, const QByteArray &sequenceId, char channel,
+                    const QByteArray &payload, int fillBits, const QByteArray &talker = "AIVDM")
+{
+    return withChecksum(talker + "," + QByteArray::number(total) + "," + QByteArray::number(part) + ","
+                        + sequenceId + "," + QByteArray(1, channel) + "," + payload + ","
+                        + QByteArray::number(fillBits));
+}
+
+AisFragmentAssembler::Result add(AisFragmentAssembler &assembler, const QByteArray &sentence,
+                                 AisAssembledMessage &out, qint64 nowMs)
+{
+    return assembler.addSentence(sentence.constData(), sentence.size(), out, nowMs);
+}
+
+QByteArray payloadOf(const AisAssembledMessage &out)
+{
+    return QByteArray(out.payload, out.payloadLength);
+}
+
+} // namespace
+
+class TestAisFragmentAssembler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void singleSentence();
+    void checksumAndLineEnding();
+    void twoParts();
+    void interleavedMessages();
+    void repeatedFirstPartRestarts();
+    void staleFragmentsExpire();
+    void fullTableEvictsOldest();
+    void rejectsMalformed();
+    void qstringOverload();
+};
+
+void TestAisFragmentAssembler::singleSentence()
+{
+    AisFragmentAssembler assembler;
+    AisAssembledMessage out;
+    const QByteArray sentence = fragment(1, 1, "", 'B', "13u?etPv2;0n:dDPwUM1U1Cb069D", 0);
+
+    QCOMPARE(add(assembler, sentence, out, 1000), AisFragmentAssembler::Complete);
+    QCOMPARE(payloadOf(out), QByteArray("13u?etPv2;0n:dDPwUM1U1Cb069D"));
+    QCOMPARE(QByteArray(out.sentences, out.sentencesLength), sentence);
+    QCOMPARE(out.fragmentCount, 1);
+    QCOMPARE(QByteArray(out.fragments[0], out.fragmentLengths[0]), sentence);
+    QCOMPARE(out.channel, 'B');
+    QVERIFY(!out.ownShip);
+    QCOMPARE(assembler.pendingCount(), 0);
+
+    const QByteArray own = fragment(1, 1, "", 'A', "B52K>;h00Fc>jpUlNV@ikwpUoP06", 0, "AIVDO");
+    QCOMPARE(add(assembler, own, out, 1001), AisFragmentAssembler::Complete);
+    QVERIFY(out.ownShip);
+}
+
+void TestAisFragmentAssembler::checksumAndLineEnding()
+{
+    AisFragmentAssembler assembler;
+    AisAssembledMessage out;
+    QByteArray sentence = fragment(1, 1, "", 'A', "15M67FC000G?ufbE`FepT@3n00Sa", 0);
+
+    // CR/LF di ujung diabaikan
+    QCOMPARE(add(assembler, sentence + "\r\n", out, 1000), AisFragmentAssembler::Complete);
+    QCOMPARE(out.sentencesLength, sentence.size());
+
+    // Tanpa checksum tetap diterima
+    QCOMPARE(add(assembler, sentence.left(sentence.size() - 3), out, 1000), AisFragmentAssembler::Complete);
+
+    // Checksum salah ditolak
+    sentence[sentence.size() - 1] = sentence.at(sentence.size() - 1) == '0' ? '1' : '0';
+    QCOMPARE(add(assembler, sentence, out, 1000), AisFragmentAssembler::Rejected);
+    QCOMPARE(assembler.stats().rejected, quint64(1));
+}
+
+void TestAisFragmentAssembler::twoParts()
+{
+    const QByteArray first = fragment(2, 1, "3", 'A', "55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53", 0);
+    const QByteArray second = fragment(2, 2, "3", 'A', "1@0000000000000", 2);
+
+    AisFragmentAssembler assembler;
+    AisAssembledMessage out;
+    QCOMPARE(add(assembler, first, out, 1000), AisFragmentAssembler::Incomplete);
+    QCOMPARE(assembler.pendingCount(), 1);
+    QCOMPARE(add(assembler, second, out, 1010), AisFragmentAssembler::Complete);
+
+    // Payload disambung urut part, fill bits dari part terakhir
+    QCOMPARE(payloadOf(out), QByteArray("55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53"
+                                        "1@0000000000000"));
+    QCOMPARE(out.fillBits, 2);
+    QCOMPARE(out.fragmentCount, 2);
+    QCOMPARE(QByteArray(out.sentences, out.sentencesLength), first + "\r\n" + second);
+    // Tiap kalimat asli bisa diambil tanpa memecah ulang 'sentences'
+    QCOMPARE(QByteArray(out.fragments[0], out.fragmentLengths[0]), first);
+    QCOMPARE(QByteArray(out.fragments[1], out.fragmentLengths[1]), second);
+    QCOMPARE(assembler.pendingCount(), 0);
+}
+
+void TestAisFragmentAssembler::interleavedMessages()
+{
+    AisFragmentAssembler assembler;
+    AisAssembledMessage out;
+
+    // Key = (channel, sequence id, total): tiga pesan berbeda berjalan bersamaan
+    QCOMPARE(add(assembler, fragment(2, 1, "1", 'A', "AAAA", 0), out, 1000), AisFragmentAssembler::Incomplete);
+    QCOMPARE(add(assembler, fragment(2, 1, "1", 'B', "BBBB", 0), out, 1001), AisFragmentAssembler::Incomplete);
+    QCOMPARE(add(assembler, fragment(3, 1, "1", 'A', "CCCC", 0), out, 1002), AisFragmentAssembler::Incomplete);
+    QCOMPARE(assembler.pendingCount(), 3);
+
+    QCOMPARE(add(assembler, fragment(2, 2, "1", 'B', "bb", 4), out, 1003), AisFragmentAssembler::Complete);
+    QCOMPARE(payloadOf(out), QByteArray("BBBBbb"));
+    QCOMPARE(add(assembler, fragment(2, 2, "1", 'A', "aa", 0), out, 1004), AisFragmentAssembler::Complete);
+    QCOMPARE(payloadOf(out), QByteArray("AAAAaa"));
+    QCOMPARE(assembler.pendingCount(), 1);
+}
+
+void TestAisFragmentAssembler::repeatedFirstPartRestarts()
+{
+    AisFragmentAssembler assembler;
+    AisAssembledMessage out;
+
+    // Part 2 yang hilang: part 1 baru dengan key sama memulai pesan baru
+    QCOMPARE(add(assembler, fragment(2, 1, "5", 'A', "OLD", 0), out, 1000), AisFragmentAssembler::Incomplete);
+    QCOMPARE(add(assembler, fragment(2, 1, "5", 'A', "NEW", 0), out, 1100), AisFragmentAssembler::Incomplete);
+    QCOMPARE(assembler.stats().expired, quint64(1));
+    QCOMPARE(add(assembler, fragment(2, 2, "5", 'A', "END", 0), out, 1200), AisFragmentAssembler::Complete);
+    QCOMPARE(payloadOf(out), QByteArray("NEWEND"));
+
+    // Part 1 yang datang sesudah part 2 juga memulai ulang (part 2 dianggap sisa pesan lain)
+    QCOMPARE(add(assembler, fragment(2, 2, "6", 'A', "TAIL", 0), out, 1300), AisFragmentAssembler::Incomplete);
+    QCOMPARE(add(assembler, fragment(2, 1, "6", 'A', "HEAD", 0), out, 1310), AisFragmentAssembler::Incomplete);
+    QCOMPARE(assembler.stats().expired, quint64(2));
+    QCOMPARE(assembler.pendingCount(), 1);
+}
+
+void TestAisFragmentAssembler::staleFragmentsExpire()
+{
+    AisFragmentAssembler assembler(5000);
+    AisAssembledMessage out;
+
+    QCOMPARE(add(assembler, fragment(2, 1, "7", 'A', "FIRST", 0), out, 1000), AisFragmentAssembler::Incomplete);
+    // Sisa pesan datang jauh setelah maxAge: tidak boleh disambung ke part 1 yang basi
+    QCOMPARE(add(assembler, fragment(2, 2, "7", 'A', "LATE", 0), out, 6300), AisFragmentAssembler::Incomplete);
+    QCOMPARE(assembler.stats().expired, quint64(1));
+    QCOMPARE(assembler.pendingCount(), 1);
+}
+
+void TestAisFragmentAssembler::fullTableEvictsOldest()
+{
+    AisFragmentAssembler assembler;
+    AisAssembledMessage out;
+    const int slotCount = AisFragmentAssembler::SLOT_COUNT;
+
+    // Key unik dari (channel, sequence id, total)
+    QVector<QByteArray> keys;
+    for (int total = 2; keys.size() <= slotCount; ++total) {
+        for (char channel : { 'A', 'B' }) {
+            for (int seq = 0; seq <= 9 && keys.size() <= slotCount; ++seq) {
+                keys.append(QByteArray::number(total) + "," + QByteArray::number(seq) + "," + channel);
+            }
+        }
+    }
+
+    const auto firstPart = [](const QByteArray &key) {
+        const QList<QByteArray> f = key.split(',');
+        return fragment(f.at(0).toInt(), 1, f.at(1), f.at(2).at(0), "PART", 0);
+    };
+
+    for (int i = 0; i < slotCount; ++i) {
+        QCOMPARE(add(assembler, firstPart(keys.at(i)), out, 1000 + i), AisFragmentAssembler::Incomplete);
+    }
+    QCOMPARE(assembler.pendingCount(), slotCount);
+    QCOMPARE(assembler.stats().evicted, quint64(0));
+
+    QCOMPARE(add(assembler, firstPart(keys.at(slotCount)), out, 1000 + slotCount), AisFragmentAssembler::Incomplete);
+    QCOMPARE(assembler.pendingCount(), slotCount);
+    QCOMPARE(assembler.stats().evicted, quint64(1));
+
+    // Pesan tertua sudah dibuang: part 2-nya tidak melengkapi apa pun
+    QCOMPARE(add(assembler, fragment(2, 2, "0", 'A', "TAIL", 0), out, 1100), AisFragmentAssembler::Incomplete);
+    QCOMPARE(assembler.stats().evicted, quint64(2));
+
+    // Pesan yang masih ada tetap bisa selesai
+    QCOMPARE(add(assembler, fragment(2, 2, "5", 'A', "TAIL", 0), out, 1101), AisFragmentAssembler::Complete);
+    QCOMPARE(payloadOf(out), QByteArray("PARTTAIL"));
+}
+
+void TestAisFragmentAssembler::rejectsMalformed()
+{
+    AisFragmentAssembler assembler;
+    AisAssembledMessage out;
+    const QByteArray tooLong(AisFragmentAssembler::MAX_FRAGMENT_PAYLOAD + 1, '0');
+
+    const QList<QByteArray> bad = {
+        withChecksum("GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"),
+        fragment(1, 1, "", 'A', "", 0),             // payload kosong
+        fragment(2, 3, "1", 'A', "ABCD", 0),        // part > total
+        withChecksum("AIVDM,10,1,1,A,ABCD,0"),      // total lebih dari MAX_PARTS
+        fragment(1, 1, "", 'A', tooLong, 0),
+        "!AIVDM,1,1"
+    };
+    for (const QByteArray &sentence : bad) {
+        QCOMPARE(add(assembler, sentence, out, 1000), AisFragmentAssembler::Rejected);
+    }
+    QCOMPARE(assembler.stats().rejected, quint64(bad.size()));
+    QCOMPARE(assembler.pendingCount(), 0);
+}
+
+void TestAisFragmentAssembler::qstringOverload()
+{
+    AisFragmentAssembler assembler;
+    AisAssembledMessage out;
+    const QString sentence = QString::fromLatin1(fragment(1, 1, "", 'A', "15M67FC000G?ufbE`FepT@3n00Sa", 0));
+
+    QCOMPARE(assembler.addSentence(sentence, out, 1000), AisFragmentAssembler::Complete);
+    QCOMPARE(out.sentencesString(), sentence);
+
+    // Karakter non-ASCII jadi '?' sehingga checksum tidak cocok lagi
+    QString corrupted = sentence;
+    corrupted[20] = QChar(0x00e9);
+    QCOMPARE(assembler.addSentence(corrupted, out, 1000), AisFragmentAssembler::Rejected);
+}
+
+QTEST_APPLESS_MAIN(TestAisFragmentAssembler)
+#include "test_aisfragmentassembler.moc"
@@ -0,0 +1,14 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_aisfragmentassembler
+
+SOURCES += \
+    test_aisfragmentassembler.cpp \
+    aisfragmentassembler.cpp
+
+HEADERS += \
+    aisfragmentassembler.h
@@ -0,0 +1,213 @@
+// Unit test AisTargetStore: tabel MMSI open addressing (backward-shift delete,
+// cluster yang melingkar ke awal tabel, rehash), swap-remove kolom dan snapshot.
+
+#include <QtTest>
+#include <QHash>
+#include <QVector>
+#include "aistargetstore.h"
+#include "ecwidget.h"
+
+namespace {
+
+const int kSlots = 64;      // ukuran tabel awal store (load factor 0.5 -> 32 target tanpa rehash)
+
+AISTargetData targetAt(double lat, double lon)
+{
+    AISTargetData data = AISTargetData();
+    data.lat = lat;
+    data.lon = lon;
+    return data;
+}
+
+// MMSI yang home slot-nya sama di tabel 64 slot
+QVector<quint32> idsWithHome(quint32 home, int count, quint32 from = 200000000)
+{
+    QVector<quint32> ids;
+    for (quint32 id = from; ids.size() < count; ++id) {
+        if ((AisTargetColumns::hash(id) & (kSlots - 1)) == home)
+            ids.append(id);
+    }
+    return ids;
+}
+
+// Setiap MMSI di kolom bisa ditemukan lewat tabel dan menunjuk ke index-nya sendiri
+bool consistent(const AisTargetStore &store, const AisTargetSnapshot &snapshot)
+{
+    const AisTargetColumns &cols = snapshot.columns();
+    int used = 0;
+    for (qint32 index : cols.slotTable) {
+        if (index >= 0)
+            ++used;
+    }
+    if (used != cols.size() || cols.size() != store.size())
+        return false;
+
+    for (int i = 0; i < cols.size(); ++i) {
+        if (store.indexOf(cols.mmsi.at(i)) != i)
+            return false;
+        // lat disimpan = MMSI, jadi kolom yang tidak ikut dipindah ketahuan di sini
+        if (cols.lat.at(i) != double(cols.mmsi.at(i)))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+class TestAisTargetStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void upsertAndUpdate();
+    void backwardShiftInCluster();
+    void backwardShiftAcrossTableEnd();
+    void rehashKeepsEntries();
+    void randomChurnMatchesReference();
+    void snapshotIsFrozen();
+    void decodeRot();
+};
+
+void TestAisTargetStore::upsertAndUpdate()
+{
+    AisTargetStore store;
+    QCOMPARE(store.upsert(525000001, targetAt(-6.1, 106.8)), 0);
+    QCOMPARE(store.upsert(525000002, targetAt(-6.2, 106.9)), 1);
+    QCOMPARE(store.upsert(525000001, targetAt(-6.3, 107.0)), 0);   // update, bukan entry baru
+    QCOMPARE(store.size(), 2);
+
+    const AisTargetSnapshot &snapshot = store.publish();
+    QCOMPARE(snapshot.lat(snapshot.indexOf(525000001)), -6.3);
+    QVERIFY(!store.remove(999));
+    QVERIFY(store.remove(525000001));
+    QVERIFY(!store.contains(525000001));
+    QCOMPARE(store.indexOf(525000002), 0);
+}
+
+void TestAisTargetStore::backwardShiftInCluster()
+{
+    // Dua kelompok home slot bersebelahan membentuk satu rantai probe panjang
+    const QVector<quint32> first = idsWithHome(10, 6);
+    const QVector<quint32> second = idsWithHome(11, 4, first.last() + 1);
+
+    AisTargetStore store;
+    for (int i = 0; i < 6; ++i) {
+        store.upsert(first.at(i), targetAt(first.at(i), 0.0));
+        if (i < second.size())
+            store.upsert(second.at(i), targetAt(second.at(i), 0.0));
+    }
+    QVERIFY(consistent(store, store.publish()));
+
+    // Hapus dari kepala, tengah dan ekor rantai; sisanya harus tetap ketemu
+    const QVector<quint32> removeOrder = { first.at(0), second.at(1), first.at(3), second.at(3), first.at(5) };
+    for (quint32 id : removeOrder) {
+        QVERIFY(store.remove(id));
+        QVERIFY(!store.contains(id));
+        QVERIFY(consistent(store, store.publish()));
+    }
+    QCOMPARE(store.size(), 5);
+
+    // Slot yang dibebaskan dipakai ulang tanpa duplikasi
+    for (quint32 id : removeOrder) {
+        store.upsert(id, targetAt(id, 0.0));
+    }
+    QCOMPARE(store.size(), 10);
+    QVERIFY(consistent(store, store.publish()));
+}
+
+void TestAisTargetStore::backwardShiftAcrossTableEnd()
+{
+    // Rantai mulai di slot terakhir dan melingkar ke slot 0, 1, ...
+    const QVector<quint32> tail = idsWithHome(kSlots - 1, 4);
+    const QVector<quint32> head = idsWithHome(0, 2, tail.last() + 1);
+
+    AisTargetStore store;
+    for (quint32 id : tail + head) {
+        store.upsert(id, targetAt(id, 0.0));
+    }
+    QVERIFY(consistent(store, store.publish()));
+
+    QVERIFY(store.remove(tail.at(0)));
+    QVERIFY(consistent(store, store.publish()));
+    QVERIFY(store.remove(tail.at(2)));
+    QVERIFY(consistent(store, store.publish()));
+
+    // Entry home 0 yang terdorong melewati batas tabel kembali ke dekat home-nya
+    for (quint32 id : head) {
+        const int slot = store.publish().columns().slotOf(id);
+        QVERIFY(slot >= 0);
+    }
+    QVERIFY(store.remove(head.at(0)));
+    QVERIFY(consistent(store, store.publish()));
+    QCOMPARE(store.size(), 3);
+}
+
+void TestAisTargetStore::rehashKeepsEntries()
+{
+    AisTargetStore store;
+    for (quint32 id = 1; id <= 5000; ++id) {
+        store.upsert(id * 7919, targetAt(id * 7919, 0.0));
+    }
+    const AisTargetSnapshot &snapshot = store.publish();
+    QCOMPARE(store.size(), 5000);
+    QVERIFY(snapshot.columns().slotTable.size() >= 2 * store.size());
+    QVERIFY(consistent(store, snapshot));
+}
+
+void TestAisTargetStore::randomChurnMatchesReference()
+{
+    AisTargetStore store;
+    QHash<quint32, bool> reference;
+    quint32 seed = 12345;
+
+    for (int op = 0; op < 20000; ++op) {
+        seed = seed * 1103515245u + 12345u;
+        const quint32 id = 1000 + (seed >> 16) % 300;
+        if ((seed >> 8) & 1) {
+            store.upsert(id, targetAt(id, 0.0));
+            reference.insert(id, true);
+        } else {
+            QCOMPARE(store.remove(id), reference.remove(id) > 0);
+        }
+    }
+
+    QCOMPARE(store.size(), reference.size());
+    for (quint32 id = 1000; id < 1300; ++id) {
+        QCOMPARE(store.contains(id), reference.contains(id));
+    }
+    QVERIFY(consistent(store, store.publish()));
+}
+
+void TestAisTargetStore::snapshotIsFrozen()
+{
+    AisTargetStore store;
+    store.upsert(1, targetAt(1.0, 2.0));
+    const AisTargetSnapshot frozen = store.publish();
+    QCOMPARE(store.publish().epoch(), frozen.epoch());  // tanpa perubahan, frame sama
+
+    store.upsert(2, targetAt(3.0, 4.0));
+    store.remove(1);
+    store.setFlags(2, AisTargetColumns::Lost);
+
+    QCOMPARE(frozen.size(), 1);
+    QVERIFY(frozen.contains(1));
+    QCOMPARE(frozen.lon(0), 2.0);
+
+    const AisTargetSnapshot &next = store.publish();
+    QVERIFY(next.epoch() > frozen.epoch());
+    QVERIFY(!next.contains(1));
+    QVERIFY(next.isLost(next.indexOf(2)));
+}
+
+void TestAisTargetStore::decodeRot()
+{
+    QVERIFY(qIsNaN(AisTargetColumns::decodeRot(-128)));
+    QVERIFY(qIsNaN(AisTargetColumns::decodeRot(127)));
+    QVERIFY(qIsNaN(AisTargetColumns::decodeRot(-127)));
+    QCOMPARE(AisTargetColumns::decodeRot(0), 0.0);
+    QVERIFY(AisTargetColumns::decodeRot(-20) < 0.0);
+    QVERIFY(qAbs(AisTargetColumns::decodeRot(126) - 708.7) < 0.5);
+}
+
+QTEST_APPLESS_MAIN(TestAisTargetStore)
+#include "test_aistargetstore.moc"
@@ -0,0 +1,24 @@
+QT += core testlib
+QT += gui widgets network winextras
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_aistargetstore
+
+# AISTargetData ada di ecwidget.h, jadi header SevenCs ikut dibutuhkan (sama dengan ecdis.pro)
+win32:KERNELPATH = C:/EC2007/5.22.69.3
+INCLUDEPATH += .
+win32:INCLUDEPATH += $${KERNELPATH}/include
+unix:INCLUDEPATH += /usr/include/EC2007/5.22/kernel
+win32:LIBS += $${KERNELPATH}/lib/eckernel-5.22-dynr.lib
+win32:DEFINES += _WINNT_SOURCE
+unix:LIBS += -leckernel-5.22-dynr -lX11
+unix:DEFINES += _LINUX_SOURCE
+
+SOURCES += \
+    test_aistargetstore.cpp \
+    aistargetstore.cpp
+
+HEADERS += \
+    aistargetstore.h
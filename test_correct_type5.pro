@@ -10,10 +10,14 @@ TARGET = test_correct_type5
 SOURCES += \
     test_correct_type5.cpp \
     aivdoencoder.cpp \
+    aispayload.cpp \
+    aisfragmentassembler.cpp \
     aisdatabasemanager.cpp
 
 HEADERS += \
     aivdoencoder.h \
+    aispayload.h \
+    aisfragmentassembler.h \
     aisdatabasemanager.h
 
 # Include database driver
@@ -6,8 +6,8 @@ CONFIG -= app_bundle
 
 TARGET = test_decoder
 
-SOURCES += test_decoder_fix.cpp aivdoencoder.cpp
+SOURCES += test_decoder_fix.cpp aivdoencoder.cpp aispayload.cpp aisfragmentassembler.cpp
 
-HEADERS += aivdoencoder.h
+HEADERS += aivdoencoder.h aispayload.h aisfragmentassembler.h
 
 DEFINES += _WIN32
\ No newline at end of file
@@ -0,0 +1,449 @@
+// Unit test format .dvrseg: round trip lintas blok, waktu monoton, scan rentang waktu
+// dan filter MMSI (fragmen lanjutan), pemulihan segmen yang crash, blok rusak,
+// stemOf/segmentsIn dan playback lewat DvrReplayStreamer.
+
+#include <QtTest>
+#include <QByteArray>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QTemporaryDir>
+#include <QThread>
+#include <limits>
+#include "dvrsegment.h"
+#include "dvrreplaystreamer.h"
+
+namespace {
+
+typedef QPair<qint64, QByteArray> Line;
+
+const QByteArray kPosition = "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C";     // MMSI 477553000
+const QByteArray kStatic1 = "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E53,0*3E";
+const QByteArray kStatic2 = "!AIVDM,2,2,3,B,1@0000000000000,2*55";                 // MMSI 369190000
+const QByteArray kOther = "!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*24";        // MMSI 265547250
+
+bool append(DvrSegmentWriter &writer, qint64 timeMs, const QByteArray &line)
+{
+    if (writer.append(timeMs, line.constData(), line.size()))
+        return true;
+    return writer.closeBlock() && writer.append(timeMs, line.constData(), line.size());
+}
+
+QList<Line> scanAll(DvrSegmentReader &reader, qint64 fromMs = std::numeric_limits<qint64>::min(),
+                    qint64 toMs = std::numeric_limits<qint64>::max(), quint32 mmsi = 0, bool *ok = nullptr)
+{
+    QList<Line> lines;
+    const bool scanned = reader.scan(fromMs, toMs, mmsi, [&lines](qint64 timeMs, const char *line, int length) {
+        lines.append(qMakePair(timeMs, QByteArray(line, length)));
+        return true;
+    });
+    if (ok)
+        *ok = scanned;
+    return lines;
+}
+
+QByteArray readAll(const QString &path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+bool writeAll(const QString &path, const QByteArray &bytes)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(bytes) == bytes.size();
+}
+
+// Konsumsi streamer sampai worker selesai (batas 5 detik)
+QList<Line> drain(DvrReplayStreamer &streamer)
+{
+    QList<Line> lines;
+    QElapsedTimer timer;
+    timer.start();
+    while (!streamer.atEnd() && timer.elapsed() < 5000) {
+        qint64 timeMs;
+        const char *line;
+        int length;
+        if (!streamer.peek(timeMs, line, length)) {
+            QThread::msleep(1);
+            continue;
+        }
+        lines.append(qMakePair(timeMs, QByteArray(line, length)));
+        streamer.pop();
+    }
+    return lines;
+}
+
+} // namespace
+
+class TestDvrSegment : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTripAcrossBlocks();
+    void appendRefusesWhenBlockFull();
+    void timesStayMonotonic();
+    void timeRangeScan();
+    void mmsiFilterFollowsFragments();
+    void strayFragmentExpires();
+    void recoversUnfinishedSegment();
+    void corruptBlockFailsScan();
+    void sentenceHelpers();
+    void stemAndSegments();
+    void replayStreamer();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+void TestDvrSegment::roundTripAcrossBlocks()
+{
+    const QString path = m_dir.filePath("roundtrip.0001" DVR_SEGMENT_SUFFIX);
+    QList<Line> written;
+    {
+        DvrSegmentWriter writer;
+        QVERIFY(writer.open(path));
+        for (int i = 0; i < 3000; ++i) {
+            const Line line(100000 + i * 250, (i % 3 == 0) ? kPosition : kOther);
+            QVERIFY(append(writer, line.first, line.second));
+            written.append(line);
+            if (i % 1000 == 999) {
+                QVERIFY(writer.closeBlock());
+            }
+        }
+        QCOMPARE(writer.blockCount(), 3);
+        QCOMPARE(writer.firstMs(), qint64(100000));
+        QVERIFY(writer.finish());
+    }
+
+    DvrSegmentReader reader;
+    QVERIFY(reader.open(path));
+    QVERIFY(reader.isComplete());
+    QCOMPARE(reader.blocks().size(), 3);
+    QCOMPARE(reader.firstMs(), written.first().first);
+    QCOMPARE(reader.lastMs(), written.last().first);
+
+    quint32 lineCount = 0;
+    for (const DvrBlockSummary &block : reader.blocks()) {
+        lineCount += block.lineCount;
+        QVERIFY(block.mayContain(477553000));
+    }
+    QCOMPARE(lineCount, quint32(3000));
+    QCOMPARE(scanAll(reader), written);
+}
+
+void TestDvrSegment::appendRefusesWhenBlockFull()
+{
+    DvrSegmentWriter writer;
+    QVERIFY(writer.open(m_dir.filePath("full.0001" DVR_SEGMENT_SUFFIX)));
+
+    const QByteArray line(1000, 'x');
+    int accepted = 0;
+    while (writer.append(accepted, line.constData(), line.size())) {
+        ++accepted;
+        QVERIFY(accepted < 1000);
+    }
+    // Blok berhenti sebelum melewati DVR_BLOCK_RAW_BYTES (6 byte frame per baris)
+    QCOMPARE(accepted, DVR_BLOCK_RAW_BYTES / (line.size() + 6));
+    QVERIFY(!writer.blockEmpty());
+
+    QVERIFY(writer.closeBlock());
+    QVERIFY(writer.blockEmpty());
+    QVERIFY(writer.append(accepted, line.constData(), line.size()));
+
+    // Baris tunggal yang lebih besar dari blok tetap masuk ke blok kosong
+    QVERIFY(writer.closeBlock());
+    const QByteArray huge(0xffff, 'y');
+    QVERIFY(writer.append(accepted + 1, huge.constData(), huge.size()));
+    QVERIFY(writer.finish());
+}
+
+void TestDvrSegment::timesStayMonotonic()
+{
+    const QString path = m_dir.filePath("monotonic.0001" DVR_SEGMENT_SUFFIX);
+    {
+        DvrSegmentWriter writer;
+        QVERIFY(writer.open(path));
+        QVERIFY(append(writer, 1000, kOther));
+        QVERIFY(append(writer, 990, kOther));     // producer lain sedikit di belakang
+        QVERIFY(writer.closeBlock());
+        QVERIFY(append(writer, 980, kOther));     // mundur melewati batas blok
+        QVERIFY(append(writer, 1010, kOther));
+        QVERIFY(writer.finish());
+    }
+
+    DvrSegmentReader reader;
+    QVERIFY(reader.open(path));
+    const QList<Line> lines = scanAll(reader);
+    QCOMPARE(lines.size(), 4);
+    QCOMPARE(lines.at(0).first, qint64(1000));
+    QCOMPARE(lines.at(1).first, qint64(1000));
+    QCOMPARE(lines.at(2).first, qint64(1000));
+    QCOMPARE(lines.at(3).first, qint64(1010));
+    QCOMPARE(reader.blocks().at(1).firstMs, qint64(1000));
+}
+
+void TestDvrSegment::timeRangeScan()
+{
+    const QString path = m_dir.filePath("range.0001" DVR_SEGMENT_SUFFIX);
+    {
+        DvrSegmentWriter writer;
+        QVERIFY(writer.open(path));
+        for (int i = 0; i < 100; ++i) {
+            QVERIFY(append(writer, i * 1000, kOther));
+            if (i % 25 == 24) {
+                QVERIFY(writer.closeBlock());
+            }
+        }
+        QVERIFY(writer.finish());
+    }
+
+    DvrSegmentReader reader;
+    QVERIFY(reader.open(path));
+
+    // Rentang inklusif di kedua ujung, melintasi batas blok 25
+    const QList<Line> lines = scanAll(reader, 20000, 30000);
+    QCOMPARE(lines.size(), 11);
+    QCOMPARE(lines.first().first, qint64(20000));
+    QCOMPARE(lines.last().first, qint64(30000));
+
+    QVERIFY(scanAll(reader, 200000, 300000).isEmpty());
+
+    // Visitor boleh berhenti lebih awal
+    int visited = 0;
+    QVERIFY(reader.scan(0, 99000, 0, [&visited](qint64, const char *, int) { return ++visited < 5; }));
+    QCOMPARE(visited, 5);
+}
+
+void TestDvrSegment::mmsiFilterFollowsFragments()
+{
+    const QString path = m_dir.filePath("mmsi.0001" DVR_SEGMENT_SUFFIX);
+    {
+        DvrSegmentWriter writer;
+        QVERIFY(writer.open(path));
+        QVERIFY(append(writer, 1000, kPosition));
+        QVERIFY(append(writer, 1001, kOther));
+        QVERIFY(append(writer, 1002, kStatic1));
+        QVERIFY(writer.inMultipart(1002));
+        // Fragmen kedua jatuh di blok berikutnya: bloom blok itu tidak memuat MMSI-nya
+        QVERIFY(writer.closeBlock());
+        QVERIFY(append(writer, 1003, kStatic2));
+        QVERIFY(!writer.inMultipart(1003));
+        QVERIFY(append(writer, 1004, kOther));
+        QVERIFY(append(writer, 1005, kPosition));
+        QVERIFY(writer.finish());
+    }
+
+    DvrSegmentReader reader;
+    QVERIFY(reader.open(path));
+    const QList<Line> statics = scanAll(reader, 0, 10000, 369190000);
+    QCOMPARE(statics, QList<Line>({ Line(1002, kStatic1), Line(1003, kStatic2) }));
+
+    const QList<Line> positions = scanAll(reader, 0, 10000, 477553000);
+    QCOMPARE(positions, QList<Line>({ Line(1000, kPosition), Line(1005, kPosition) }));
+
+    QVERIFY(scanAll(reader, 0, 10000, 123456789).isEmpty());
+}
+
+void TestDvrSegment::strayFragmentExpires()
+{
+    DvrSegmentWriter writer;
+    QVERIFY(writer.open(m_dir.filePath("stray.0001" DVR_SEGMENT_SUFFIX)));
+
+    // "1 dari 2" tanpa pasangan, diikuti kalimat non-AIS
+    QVERIFY(append(writer, 1000, kStatic1));
+    const QByteArray rmc = "$GPRMC,120000,A,0710.000,S,11247.000,E,5.0,90.0,010124,,*00";
+    QVERIFY(append(writer, 2000, rmc));
+    QVERIFY(writer.inMultipart(2000));
+    QVERIFY(writer.inMultipart(1000 + DVR_FRAGMENT_MAX_AGE_MS - 1));
+    QVERIFY(!writer.inMultipart(1000 + DVR_FRAGMENT_MAX_AGE_MS));
+
+    // Grup baru memulai umur dari fragmen pertamanya sendiri
+    QVERIFY(append(writer, 9000, kStatic1));
+    QVERIFY(writer.inMultipart(9000 + DVR_FRAGMENT_MAX_AGE_MS - 1));
+    QVERIFY(append(writer, 9001, kPosition));
+    QVERIFY(!writer.inMultipart(9001));
+    QVERIFY(writer.finish());
+}
+
+void TestDvrSegment::recoversUnfinishedSegment()
+{
+    const QString path = m_dir.filePath("live.0001" DVR_SEGMENT_SUFFIX);
+    DvrSegmentWriter writer;
+    QVERIFY(writer.open(path));
+    for (int i = 0; i < 20; ++i) {
+        QVERIFY(append(writer, i * 100, kOther));
+        if (i % 10 == 9) {
+            QVERIFY(writer.closeBlock());
+        }
+    }
+    QVERIFY(writer.sync());
+
+    // Salinan file saat writer masih terbuka = keadaan setelah crash (tanpa footer)
+    const QByteArray live = readAll(path);
+    const QString crashed = m_dir.filePath("crashed.0001" DVR_SEGMENT_SUFFIX);
+    QVERIFY(writeAll(crashed, live));
+    {
+        DvrSegmentReader reader;
+        QVERIFY(reader.open(crashed));
+        QVERIFY(!reader.isComplete());
+        QCOMPARE(reader.blocks().size(), 2);
+        QCOMPARE(scanAll(reader).size(), 20);
+    }
+
+    // Ekor sobek: header blok ketiga terpotong, lalu payload blok kedua terpotong
+    QVERIFY(writeAll(crashed, live + QByteArray("DVRB\x10\x00", 6)));
+    {
+        DvrSegmentReader reader;
+        QVERIFY(reader.open(crashed));
+        QCOMPARE(reader.blocks().size(), 2);
+    }
+    QVERIFY(writeAll(crashed, live.left(live.size() - 3)));
+    {
+        DvrSegmentReader reader;
+        QVERIFY(reader.open(crashed));
+        QVERIFY(!reader.isComplete());
+        QCOMPARE(reader.blocks().size(), 1);
+        QCOMPARE(scanAll(reader).size(), 10);
+    }
+
+    // Bukan file segmen
+    QVERIFY(writeAll(crashed, "not a segment file at all"));
+    DvrSegmentReader reader;
+    QVERIFY(!reader.open(crashed));
+
+    QVERIFY(writer.finish());
+}
+
+void TestDvrSegment::corruptBlockFailsScan()
+{
+    const QString path = m_dir.filePath("corrupt.0001" DVR_SEGMENT_SUFFIX);
+    {
+        DvrSegmentWriter writer;
+        QVERIFY(writer.open(path));
+        for (int i = 0; i < 10; ++i) {
+            QVERIFY(append(writer, i, kOther));
+        }
+        QVERIFY(writer.finish());
+    }
+
+    qint64 payloadAt = 0;
+    {
+        DvrSegmentReader reader;
+        QVERIFY(reader.open(path));
+        payloadAt = reader.blocks().first().offset + 68 + 8;  // di dalam payload blok pertama
+    }
+    QByteArray bytes = readAll(path);
+    bytes[int(payloadAt)] = char(bytes.at(int(payloadAt)) ^ 0x5a);
+    QVERIFY(writeAll(path, bytes));
+
+    // Footer masih utuh, tapi crc blok tidak cocok
+    DvrSegmentReader reader;
+    QVERIFY(reader.open(path));
+    QVERIFY(reader.isComplete());
+    bool ok = true;
+    QVERIFY(scanAll(reader, std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max(), 0, &ok).isEmpty());
+    QVERIFY(!ok);
+}
+
+void TestDvrSegment::sentenceHelpers()
+{
+    int number = 0, count = 0;
+    QVERIFY(DvrSegmentReader::fragmentOf(kStatic2.constData(), kStatic2.size(), number, count));
+    QCOMPARE(number, 2);
+    QCOMPARE(count, 2);
+    QVERIFY(!DvrSegmentReader::fragmentOf("$GPRMC,1,2,3", 12, number, count));
+
+    QCOMPARE(DvrSegmentReader::mmsiOf(kPosition.constData(), kPosition.size()), quint32(477553000));
+    QCOMPARE(DvrSegmentReader::mmsiOf(kStatic1.constData(), kStatic1.size()), quint32(369190000));
+    QCOMPARE(DvrSegmentReader::mmsiOf(kStatic2.constData(), kStatic2.size()), quint32(0));
+
+    // Koma di dalam tag block tidak menggeser field
+    const QByteArray withTag = "\\s:r1,c:1704164647*7A\\" + kPosition;
+    QVERIFY(DvrSegmentReader::fragmentOf(withTag.constData(), withTag.size(), number, count));
+    QCOMPARE(DvrSegmentReader::mmsiOf(withTag.constData(), withTag.size()), quint32(477553000));
+
+    DvrBlockSummary summary;
+    summary.firstMs = 1000;
+    summary.lastMs = 2000;
+    summary.addMmsi(477553000);
+    QVERIFY(summary.mayContain(477553000));
+    QVERIFY(summary.overlaps(2000, 3000));
+    QVERIFY(!summary.overlaps(2001, 3000));
+}
+
+void TestDvrSegment::stemAndSegments()
+{
+    QCOMPARE(DvrSegmentReader::stemOf("/data/dvr/ais_log_x.0003" DVR_SEGMENT_SUFFIX), QString("ais_log_x"));
+    QCOMPARE(DvrSegmentReader::stemOf("ais.log.v2.0001" DVR_SEGMENT_SUFFIX), QString("ais.log.v2"));
+    QCOMPARE(DvrSegmentReader::stemOf("single" DVR_SEGMENT_SUFFIX), QString("single"));
+
+    const QString dir = m_dir.filePath("segments");
+    QVERIFY(QDir().mkpath(dir));
+    for (const char *name : { "rec.0002", "rec.0001", "rec2.0001", "other.0001" }) {
+        QVERIFY(writeAll(QDir(dir).filePath(QString(name) + DVR_SEGMENT_SUFFIX), "x"));
+    }
+    QVERIFY(writeAll(QDir(dir).filePath("rec.0001.txt"), "x"));
+
+    const QStringList rec = DvrSegmentReader::segmentsIn(dir, "rec");
+    QCOMPARE(rec.size(), 2);
+    QVERIFY(rec.at(0).endsWith("rec.0001" DVR_SEGMENT_SUFFIX));
+    QVERIFY(rec.at(1).endsWith("rec.0002" DVR_SEGMENT_SUFFIX));
+    QCOMPARE(DvrSegmentReader::segmentsIn(dir).size(), 4);
+}
+
+void TestDvrSegment::replayStreamer()
+{
+    const QString dir = m_dir.filePath("replay");
+    QVERIFY(QDir().mkpath(dir));
+    const QString first = QDir(dir).filePath("rec.0001" DVR_SEGMENT_SUFFIX);
+    const QString second = QDir(dir).filePath("rec.0002" DVR_SEGMENT_SUFFIX);
+    {
+        DvrSegmentWriter writer;
+        QVERIFY(writer.open(first));
+        QVERIFY(append(writer, 1000, kPosition + "\r\n"));
+        QVERIFY(append(writer, 2000, kOther));
+        QVERIFY(writer.finish());
+        QVERIFY(writer.open(second));
+        QVERIFY(append(writer, 3000, kStatic1));
+        QVERIFY(append(writer, 3000, kStatic2));
+        QVERIFY(writer.finish());
+    }
+
+    DvrReplayStreamer streamer;
+    QVERIFY(!streamer.open(QDir(dir).filePath("missing.0001" DVR_SEGMENT_SUFFIX)));
+    QVERIFY(streamer.open(second));
+    QCOMPARE(streamer.segments().size(), 2);
+
+    qint64 firstMs = -1;
+    qint64 lastMs = -1;
+    int ranges = 0;
+    QObject::connect(&streamer, &DvrReplayStreamer::rangeReady, [&](qint64 a, qint64 b) {
+        firstMs = a;
+        lastMs = b;
+        ++ranges;
+    });
+
+    // Semua segmen rekaman, urut; line ending dibuang
+    streamer.start(std::numeric_limits<qint64>::min());
+    QCOMPARE(drain(streamer), QList<Line>({ qMakePair(qint64(1000), kPosition), qMakePair(qint64(2000), kOther),
+                                            qMakePair(qint64(3000), kStatic1), qMakePair(qint64(3000), kStatic2) }));
+    QCOMPARE(ranges, 1);
+    QCOMPARE(firstMs, qint64(1000));
+    QCOMPARE(lastMs, qint64(3000));
+
+    // Seek: segmen yang berakhir sebelum waktu tujuan dilewati; rentang tidak dikirim ulang
+    streamer.start(2500);
+    QCOMPARE(drain(streamer), QList<Line>({ qMakePair(qint64(3000), kStatic1), qMakePair(qint64(3000), kStatic2) }));
+    QCOMPARE(ranges, 1);
+
+    streamer.start(5000);
+    QVERIFY(drain(streamer).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestDvrSegment)
+#include "test_dvrsegment.moc"
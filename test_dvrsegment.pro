@@ -0,0 +1,19 @@
+QT += core concurrent testlib
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_dvrsegment
+
+SOURCES += \
+    test_dvrsegment.cpp \
+    dvrsegment.cpp \
+    dvrreplaystreamer.cpp \
+    aispayload.cpp
+
+HEADERS += \
+    dvrsegment.h \
+    dvrreplaystreamer.h \
+    spscring.h \
+    aispayload.h
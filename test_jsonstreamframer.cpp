@@ -0,0 +1,161 @@
+// Unit test JsonStreamFramer: stream terpotong acak, kurung di dalam string,
+// sampah di luar objek, objek kebesaran dan partial yang basi.
+
+#include <QtTest>
+#include <QByteArray>
+#include <QList>
+#include "jsonstreamframer.h"
+
+namespace {
+
+QList<QByteArray> drain(JsonStreamFramer &framer)
+{
+    QList<QByteArray> objects;
+    QByteArray object;
+    while (framer.next(object)) {
+        objects.append(QByteArray(object.constData(), object.size()));   // salin, view tidak bertahan
+    }
+    return objects;
+}
+
+} // namespace
+
+class TestJsonStreamFramer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void concatenatedObjects();
+    void byteByByte();
+    void bracesInsideStrings();
+    void garbageBetweenObjects();
+    void oversizedObjectSkippedWhole();
+    void oversizedAcrossAppends();
+    void stalePartialDropped();
+    void resetClearsPartial();
+};
+
+void TestJsonStreamFramer::concatenatedObjects()
+{
+    JsonStreamFramer framer;
+    framer.append("{\"a\":1}{\"b\":{\"c\":2}}\n{\"d\":[3]}");
+
+    const QList<QByteArray> objects = drain(framer);
+    QCOMPARE(objects.size(), 3);
+    QCOMPARE(objects.at(0), QByteArray("{\"a\":1}"));
+    QCOMPARE(objects.at(1), QByteArray("{\"b\":{\"c\":2}}"));
+    QCOMPARE(objects.at(2), QByteArray("{\"d\":[3]}"));
+    QCOMPARE(framer.stats().objects, quint64(3));
+    QCOMPARE(framer.stats().discardedBytes, quint64(0));
+    QCOMPARE(framer.pendingBytes(), 0);
+}
+
+void TestJsonStreamFramer::byteByByte()
+{
+    const QByteArray stream("{\"key\":\"x{y}\",\"n\":{\"m\":1}} {\"k\":2}");
+    JsonStreamFramer framer;
+    QList<QByteArray> objects;
+    for (char c : stream) {
+        framer.append(QByteArray(1, c));
+        objects += drain(framer);
+    }
+
+    QCOMPARE(objects.size(), 2);
+    QCOMPARE(objects.at(0), QByteArray("{\"key\":\"x{y}\",\"n\":{\"m\":1}}"));
+    QCOMPARE(objects.at(1), QByteArray("{\"k\":2}"));
+    QVERIFY(!framer.hasPartial());
+}
+
+void TestJsonStreamFramer::bracesInsideStrings()
+{
+    // Kutip yang di-escape tidak menutup string; kurung setelahnya tetap bagian dari string
+    const QByteArray text("{\"s\":\"a\\\"}{\\\\\",\"t\":\"}\"}");
+    JsonStreamFramer framer;
+    framer.append(text + "{\"u\":0}");
+
+    const QList<QByteArray> objects = drain(framer);
+    QCOMPARE(objects.size(), 2);
+    QCOMPARE(objects.at(0), text);
+    QCOMPARE(objects.at(1), QByteArray("{\"u\":0}"));
+}
+
+void TestJsonStreamFramer::garbageBetweenObjects()
+{
+    JsonStreamFramer framer;
+    framer.append("xx{\"a\":1} \r\n\t}]{\"b\":2}zz");
+
+    const QList<QByteArray> objects = drain(framer);
+    QCOMPARE(objects.size(), 2);
+    QCOMPARE(objects.at(1), QByteArray("{\"b\":2}"));
+    // Whitespace tidak dihitung sebagai sampah
+    QCOMPARE(framer.stats().discardedBytes, quint64(6));
+    QCOMPARE(framer.pendingBytes(), 0);
+}
+
+void TestJsonStreamFramer::oversizedObjectSkippedWhole()
+{
+    JsonStreamFramer framer(16);
+    // Objek dalam dari objek kebesaran tidak boleh muncul sebagai objek top-level
+    framer.append("{\"big\":\"0123456789abcdef\",\"inner\":{\"x\":1}}{\"ok\":1}");
+
+    const QList<QByteArray> objects = drain(framer);
+    QCOMPARE(objects.size(), 1);
+    QCOMPARE(objects.at(0), QByteArray("{\"ok\":1}"));
+    QCOMPARE(framer.stats().overflows, quint64(1));
+    QVERIFY(!framer.isDiscarding());
+}
+
+void TestJsonStreamFramer::oversizedAcrossAppends()
+{
+    JsonStreamFramer framer(16);
+    framer.append("{\"big\":\"0123456789abcdef");
+    QVERIFY(drain(framer).isEmpty());
+    QVERIFY(framer.isDiscarding());
+    QCOMPARE(framer.pendingBytes(), 0);     // byte objek kebesaran tidak ditahan
+
+    framer.append("\",\"inner\":{\"x\":\"}\"}}");
+    QVERIFY(drain(framer).isEmpty());
+    QVERIFY(!framer.isDiscarding());
+
+    framer.append("{\"ok\":1}");
+    const QList<QByteArray> objects = drain(framer);
+    QCOMPARE(objects.size(), 1);
+    QCOMPARE(objects.at(0), QByteArray("{\"ok\":1}"));
+    QCOMPARE(framer.stats().overflows, quint64(1));
+}
+
+void TestJsonStreamFramer::stalePartialDropped()
+{
+    JsonStreamFramer framer(50000, 1);
+    framer.append("{\"half\":");
+    QVERIFY(drain(framer).isEmpty());
+    QVERIFY(framer.hasPartial());
+
+    QTest::qSleep(20);
+    framer.append("{\"fresh\":1}");
+
+    const QList<QByteArray> objects = drain(framer);
+    QCOMPARE(objects.size(), 1);
+    QCOMPARE(objects.at(0), QByteArray("{\"fresh\":1}"));
+    QCOMPARE(framer.stats().stale, quint64(1));
+}
+
+void TestJsonStreamFramer::resetClearsPartial()
+{
+    JsonStreamFramer framer;
+    framer.append("{\"a\":\"{");
+    QVERIFY(drain(framer).isEmpty());
+    QVERIFY(framer.hasPartial());
+
+    framer.reset();
+    QVERIFY(!framer.hasPartial());
+    QCOMPARE(framer.pendingBytes(), 0);
+
+    framer.append("{\"b\":1}");
+    const QList<QByteArray> objects = drain(framer);
+    QCOMPARE(objects.size(), 1);
+    QCOMPARE(objects.at(0), QByteArray("{\"b\":1}"));
+}
+
+QTEST_APPLESS_MAIN(TestJsonStreamFramer)
+#include "test_jsonstreamframer.moc"
@@ -0,0 +1,14 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_jsonstreamframer
+
+SOURCES += \
+    test_jsonstreamframer.cpp \
+    jsonstreamframer.cpp
+
+HEADERS += \
+    jsonstreamframer.h
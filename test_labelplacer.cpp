@@ -0,0 +1,196 @@
+// Unit test LabelPlacer: kandidat bebas pertama, margin, bucket grid (koordinat negatif,
+// rect lintas bucket), memori posisi antar frame, setOccupied dan placeAll.
+
+#include <QtTest>
+#include <QList>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+#include <QVector>
+#include "labelplacer.h"
+
+namespace {
+
+// Kandidat kanan, kiri, atas, bawah dari anchor (mirip markerLabelCandidates)
+QVector<QRect> around(const QPoint &anchor, const QSize &size = QSize(40, 12))
+{
+    const int x = anchor.x(), y = anchor.y();
+    const int w = size.width(), h = size.height();
+    return {
+        QRect(x + 10, y - h / 2, w, h),
+        QRect(x - 10 - w, y - h / 2, w, h),
+        QRect(x - w / 2, y - 10 - h, w, h),
+        QRect(x - w / 2, y + 10, w, h)
+    };
+}
+
+} // namespace
+
+class TestLabelPlacer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void firstFreeCandidate();
+    void allBlockedFallsBackToFirst();
+    void marginCountsAsCollision();
+    void gridNegativeAndSpanningRects();
+    void memoryKeepsPositionWhileAnchorStill();
+    void memoryForgottenAfterIdleFrames();
+    void setOccupiedReplacesRects();
+    void placeAllHonoursPriority();
+};
+
+void TestLabelPlacer::firstFreeCandidate()
+{
+    LabelPlacer placer;
+    const QVector<QRect> candidates = around(QPoint(100, 100));
+
+    QCOMPARE(placer.place(QString(), QPoint(100, 100), candidates), 0);
+    QVERIFY(!placer.isFree(candidates.at(0)));
+
+    // Marker kedua di tempat yang sama: kanan sudah terpakai, pindah ke kiri
+    QCOMPARE(placer.place(QString(), QPoint(100, 100), candidates), 1);
+    QCOMPARE(placer.occupied().size(), 2);
+    QCOMPARE(placer.occupied().at(1), candidates.at(1));
+    QCOMPARE(placer.place(QString(), QPoint(), QVector<QRect>()), -1);
+}
+
+void TestLabelPlacer::allBlockedFallsBackToFirst()
+{
+    LabelPlacer placer;
+    placer.occupy(QRect(0, 0, 400, 400));
+
+    // Label tidak pernah disembunyikan: kandidat pertama tetap dipakai dan ditempati
+    const QVector<QRect> candidates = around(QPoint(200, 200));
+    QCOMPARE(placer.place(QString(), QPoint(200, 200), candidates), 0);
+    QCOMPARE(placer.occupied().size(), 2);
+    QCOMPARE(placer.occupied().last(), candidates.at(0));
+}
+
+void TestLabelPlacer::marginCountsAsCollision()
+{
+    LabelPlacer placer;
+    placer.occupy(QRect(0, 0, 10, 10));
+
+    // QRect(0,0,10,10) berakhir di x=9; jarak kurang dari LABEL_MARGIN dianggap bertabrakan
+    QVERIFY(!placer.isFree(QRect(10 + LABEL_MARGIN - 1, 0, 10, 10)));
+    QVERIFY(placer.isFree(QRect(10 + LABEL_MARGIN + 1, 0, 10, 10)));
+    QVERIFY(!placer.isFree(QRect(0, 10 + LABEL_MARGIN - 1, 10, 10)));
+    QVERIFY(placer.isFree(QRect(0, 10 + LABEL_MARGIN + 1, 10, 10)));
+}
+
+void TestLabelPlacer::gridNegativeAndSpanningRects()
+{
+    LabelPlacer placer;
+
+    // Label di luar layar (koordinat negatif) tetap masuk bucket yang benar
+    placer.occupy(QRect(-70, -70, 20, 20));
+    QVERIFY(!placer.isFree(QRect(-60, -60, 5, 5)));
+    QVERIFY(placer.isFree(QRect(-20, -20, 5, 5)));
+    QVERIFY(placer.isFree(QRect(30, 30, 5, 5)));
+
+    // Rect lebar yang melintasi beberapa bucket ditemukan dari bucket mana pun
+    placer.occupy(QRect(0, 200, 5 * LABEL_GRID_CELL, 10));
+    for (int x = 0; x < 5 * LABEL_GRID_CELL; x += LABEL_GRID_CELL / 2) {
+        QVERIFY(!placer.isFree(QRect(x, 205, 4, 4)));
+    }
+    QVERIFY(placer.isFree(QRect(5 * LABEL_GRID_CELL + 10, 205, 4, 4)));
+
+    // Kandidat besar menutupi rect kecil yang jauh dari pojok kiri atasnya
+    placer.occupy(QRect(3 * LABEL_GRID_CELL + 5, 3 * LABEL_GRID_CELL + 5, 4, 4));
+    QVERIFY(!placer.isFree(QRect(LABEL_GRID_CELL, LABEL_GRID_CELL, 3 * LABEL_GRID_CELL, 3 * LABEL_GRID_CELL)));
+}
+
+void TestLabelPlacer::memoryKeepsPositionWhileAnchorStill()
+{
+    LabelPlacer placer;
+    const QPoint anchor(300, 300);
+    const QVector<QRect> candidates = around(anchor);
+
+    // Frame 1: kanan terhalang, label ke kiri
+    placer.occupy(candidates.at(0));
+    QCOMPARE(placer.place("wp:1", anchor, candidates), 1);
+
+    // Frame 2: halangan hilang, tapi anchor sama -> tetap di kiri (tidak melompat)
+    placer.clear();
+    QCOMPARE(placer.place("wp:1", anchor, candidates), 1);
+
+    // Key lain atau key kosong tidak ikut memori
+    placer.clear();
+    QCOMPARE(placer.place("wp:2", anchor, candidates), 0);
+    placer.clear();
+    QCOMPARE(placer.place(QString(), anchor, candidates), 0);
+
+    // Anchor bergerak: posisi dihitung ulang dari kandidat pertama
+    placer.clear();
+    const QPoint moved(310, 300);
+    QCOMPARE(placer.place("wp:1", moved, around(moved)), 0);
+
+    // Posisi yang diingat kini terhalang: pilih kandidat bebas lain
+    placer.clear();
+    placer.occupy(around(moved).at(0));
+    QCOMPARE(placer.place("wp:1", moved, around(moved)), 1);
+}
+
+void TestLabelPlacer::memoryForgottenAfterIdleFrames()
+{
+    LabelPlacer placer;
+    const QPoint anchor(50, 50);
+    const QVector<QRect> candidates = around(anchor);
+
+    placer.occupy(candidates.at(0));
+    QCOMPARE(placer.place("poi:1", anchor, candidates), 1);
+
+    // Banyak key lain membuat memori melewati batas prune; key yang lama tidak muncul dilupakan
+    placer.clear();
+    for (int i = 0; i < 1100; ++i) {
+        const QPoint p(1000 + (i % 40) * 60, 1000 + (i / 40) * 60);
+        placer.place(QString("poi:other:%1").arg(i), p, around(p));
+    }
+    for (int frame = 0; frame < 20; ++frame) {
+        placer.clear();
+    }
+    QCOMPARE(placer.place("poi:1", anchor, candidates), 0);
+}
+
+void TestLabelPlacer::setOccupiedReplacesRects()
+{
+    LabelPlacer placer;
+    placer.occupy(QRect(0, 0, 10, 10));
+
+    const QList<QRect> cached = { QRect(100, 100, 20, 10), QRect(200, 100, 20, 10) };
+    placer.setOccupied(cached);
+    QCOMPARE(placer.occupied(), cached);
+    QVERIFY(placer.isFree(QRect(0, 0, 10, 10)));
+    QVERIFY(!placer.isFree(QRect(105, 102, 4, 4)));
+
+    // Label baru ditambahkan di belakang rect cache (pemanggil memakai mid() atas urutan ini)
+    placer.occupy(QRect(300, 300, 5, 5));
+    QCOMPARE(placer.occupied().mid(cached.size()), QList<QRect>({ QRect(300, 300, 5, 5) }));
+}
+
+void TestLabelPlacer::placeAllHonoursPriority()
+{
+    LabelPlacer placer;
+    const QPoint anchor(500, 500);
+
+    // Tiga label berebut kandidat yang sama; priority kecil menang, sama priority = urutan input
+    QVector<LabelPlacer::Request> requests(3);
+    for (int i = 0; i < requests.size(); ++i) {
+        requests[i].key = QString("wp:%1").arg(i);
+        requests[i].anchor = anchor;
+        requests[i].candidates = around(anchor);
+    }
+    requests[0].priority = 2;
+    requests[1].priority = 1;
+    requests[2].priority = 1;
+
+    const QVector<int> placed = placer.placeAll(requests);
+    QCOMPARE(placed, QVector<int>({ 2, 0, 1 }));
+    QCOMPARE(placer.occupied().first(), requests.at(1).candidates.at(0));
+    QVERIFY(placer.placeAll(QVector<LabelPlacer::Request>()).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestLabelPlacer)
+#include "test_labelplacer.moc"
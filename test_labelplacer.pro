@@ -0,0 +1,14 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_labelplacer
+
+SOURCES += \
+    test_labelplacer.cpp \
+    labelplacer.cpp
+
+HEADERS += \
+    labelplacer.h
@@ -0,0 +1,13 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_mpscring
+
+SOURCES += \
+    test_mpscring.cpp
+
+HEADERS += \
+    mpscring.h
@@ -0,0 +1,297 @@
+// Unit test NmeaLogIndex / IndexerWorker: waktu dari tag block, RMC dan ZDA, log jarang
+// (entry cadangan yang diinterpolasi), log tanpa waktu, sidecar dan pembatalan scan.
+
+#include <QtTest>
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QList>
+#include <QTemporaryDir>
+#include <atomic>
+#include "IndexerWorker.h"
+
+namespace {
+
+const QByteArray kFiller = "!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*24";    // tanpa waktu
+
+qint64 utcMs(int year, int month, int day, int hh, int mm, int ss, int msec = 0)
+{
+    return QDateTime(QDate(year, month, day), QTime(hh, mm, ss, msec), Qt::UTC).toMSecsSinceEpoch();
+}
+
+qint64 timeOf(const QByteArray &line)
+{
+    return IndexerWorker::lineTimeMs(line.constData(), line.size());
+}
+
+// Baris ZDA untuk detik ke-n setelah 2024-01-02 00:00:00 UTC
+QByteArray zdaLine(int second)
+{
+    const QTime t = QTime(0, 0).addSecs(second);
+    return "$GPZDA," + t.toString("hhmmss").toLatin1() + ".00,02,01,2024,00,00*6A";
+}
+
+bool writeLog(const QString &path, const QList<QByteArray> &lines)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    for (const QByteArray &line : lines) {
+        file.write(line);
+        file.write("\r\n");
+    }
+    return true;
+}
+
+} // namespace
+
+class TestNmeaLogIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void lineTimes();
+    void lookups();
+    void cursorLines();
+    void timedLogSkipsBackwardTime();
+    void sparseLogGetsInterpolatedEntries();
+    void untimedLogGetsSyntheticEntries();
+    void sidecarRoundTripAndInvalidation();
+    void stopFlagCancels();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+void TestNmeaLogIndex::lineTimes()
+{
+    // Tag block c: dalam detik atau ms
+    QCOMPARE(timeOf("\\s:r1,c:1704164647*7A\\" + kFiller), qint64(1704164647000));
+    QCOMPARE(timeOf("\\c:1704164647123*4B\\" + kFiller), qint64(1704164647123));
+
+    QCOMPARE(timeOf("$GPRMC,030405.50,A,0611.000,S,10649.000,E,5.0,90.0,020124,,,A*6C"),
+             utcMs(2024, 1, 2, 3, 4, 5, 500));
+    QCOMPARE(timeOf("$GPRMC,235959,A,0611.000,S,10649.000,E,5.0,90.0,311299,,,A*6C"),
+             utcMs(1999, 12, 31, 23, 59, 59));
+    QCOMPARE(timeOf("$GPZDA,030406.00,02,01,2024,00,00*6A"), utcMs(2024, 1, 2, 3, 4, 6));
+
+    // Tag block tanpa c: jatuh ke kalimat di belakangnya
+    QCOMPARE(timeOf("\\s:r1*00\\$GPZDA,030406.00,02,01,2024,00,00*6A"), utcMs(2024, 1, 2, 3, 4, 6));
+
+    QCOMPARE(timeOf(kFiller), qint64(-1));
+    QCOMPARE(timeOf("$GPGGA,030405.00,0611.000,S,10649.000,E,1,08,0.9,5.0,M,0.0,M,,*47"), qint64(-1));
+    QCOMPARE(timeOf("$GPRMC,030405,V,,,,,,,,,,N*53"), qint64(-1));                      // tanpa tanggal
+    QCOMPARE(timeOf("$GPZDA,030406.00,31,02,2024,00,00*6A"), qint64(-1));             // 31 Februari
+    QCOMPARE(timeOf("$GPZDA,256406.00,02,01,2024,00,00*6A"), qint64(-1));             // jam 25
+    QCOMPARE(timeOf("\\c:1704164647*7A"), qint64(-1));                                // tag block tidak ditutup
+    QCOMPARE(timeOf(""), qint64(-1));
+}
+
+void TestNmeaLogIndex::lookups()
+{
+    NmeaLogIndex index;
+    QCOMPARE(index.offsetAt(1000), qint64(0));
+
+    index.entries = { { 1000, 0 }, { 2000, 500 }, { 3000, 900 } };
+    QCOMPARE(index.startMs(), qint64(1000));
+    QCOMPARE(index.endMs(), qint64(3000));
+
+    QCOMPARE(index.offsetAt(0), qint64(0));         // sebelum entry pertama
+    QCOMPARE(index.offsetAt(1000), qint64(0));
+    QCOMPARE(index.offsetAt(2999), qint64(500));
+    QCOMPARE(index.offsetAt(3000), qint64(900));
+    QCOMPARE(index.offsetAt(99999), qint64(900));
+
+    QCOMPARE(index.timeAt(0), qint64(1000));
+    QCOMPARE(index.timeAt(499), qint64(1000));
+    QCOMPARE(index.timeAt(500), qint64(2000));
+    QCOMPARE(index.timeAt(5000), qint64(3000));
+}
+
+void TestNmeaLogIndex::cursorLines()
+{
+    const QString path = m_dir.filePath("cursor.nmea");
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("a\r\nbb\n\nccc");  // baris kosong dan baris terakhir tanpa newline
+    }
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    NmeaLogCursor cursor(&file);
+
+    const char *line = nullptr;
+    int len = 0;
+    QList<QByteArray> lines;
+    QList<qint64> offsets;
+    while (cursor.next(line, len)) {
+        lines.append(QByteArray(line, len));
+        offsets.append(cursor.lineOffset());
+    }
+    QCOMPARE(lines, QList<QByteArray>({ "a", "bb", "", "ccc" }));
+    QCOMPARE(offsets, QList<qint64>({ 0, 3, 6, 7 }));
+    QVERIFY(cursor.atEnd());
+
+    QVERIFY(cursor.seek(3));
+    QVERIFY(cursor.next(line, len));
+    QCOMPARE(QByteArray(line, len), QByteArray("bb"));
+    QVERIFY(!cursor.seek(cursor.size() + 1));
+}
+
+void TestNmeaLogIndex::timedLogSkipsBackwardTime()
+{
+    const QString path = m_dir.filePath("timed.nmea");
+    QVERIFY(writeLog(path, { zdaLine(10), kFiller, zdaLine(20), zdaLine(20), zdaLine(15), kFiller, zdaLine(30) }));
+
+    IndexerWorker worker;
+    worker.filePath = path;
+    QList<qint64> finished;
+    worker.onFinished = [&finished](const QList<qint64> &offsets) { finished = offsets; };
+    worker.process();
+
+    const qint64 line = zdaLine(10).size() + 2;     // semua baris sama panjang
+    const NmeaLogIndex &index = worker.index;
+    QCOMPARE(index.entries.size(), 3);
+    QCOMPARE(index.entries.at(0).timeMs, utcMs(2024, 1, 2, 0, 0, 10));
+    QCOMPARE(index.entries.at(1).timeMs, utcMs(2024, 1, 2, 0, 0, 20));
+    QCOMPARE(index.entries.at(1).offset, qint64(kFiller.size() + 2) + line);
+    QCOMPARE(index.entries.at(2).timeMs, utcMs(2024, 1, 2, 0, 0, 30));
+    QCOMPARE(index.lineCount, qint64(7));
+    QVERIFY(!index.untimed);
+    QCOMPARE(finished, QList<qint64>({ index.entries.at(0).offset, index.entries.at(1).offset,
+                                       index.entries.at(2).offset }));
+}
+
+void TestNmeaLogIndex::sparseLogGetsInterpolatedEntries()
+{
+    // ~2.5 MB tanpa waktu di antara dua timestamp: entry cadangan tiap 1 MB
+    QList<QByteArray> lines;
+    lines.append(zdaLine(0));
+    for (int i = 0; i < 50000; ++i) {
+        lines.append(kFiller);
+    }
+    lines.append(zdaLine(100));
+
+    const QString path = m_dir.filePath("sparse.nmea");
+    QVERIFY(writeLog(path, lines));
+
+    IndexerWorker worker;
+    worker.filePath = path;
+    worker.process();
+
+    const NmeaLogIndex &index = worker.index;
+    const qint64 first = zdaLine(0).size() + 2;
+    const qint64 filler = kFiller.size() + 2;
+    const qint64 t0 = utcMs(2024, 1, 2, 0, 0, 0);
+    const qint64 t1 = utcMs(2024, 1, 2, 0, 1, 40);
+
+    QCOMPARE(index.entries.size(), 4);
+    QCOMPARE(index.entries.first().timeMs, t0);
+    QCOMPARE(index.entries.last().timeMs, t1);
+    QCOMPARE(index.entries.last().offset, first + 50000 * filler);
+    for (int i = 1; i < index.entries.size(); ++i) {
+        const NmeaLogIndexEntry &e = index.entries.at(i);
+        QVERIFY(e.timeMs > index.entries.at(i - 1).timeMs);
+        QVERIFY(e.offset > index.entries.at(i - 1).offset);
+        QCOMPARE((e.offset - first) % filler, qint64(0));      // selalu awal baris
+    }
+
+    // Waktu cadangan sebanding dengan posisinya di antara dua timestamp
+    const NmeaLogIndexEntry &mid = index.entries.at(1);
+    const qint64 expected = t0 + (t1 - t0) * mid.offset / index.entries.last().offset;
+    QVERIFY(qAbs(mid.timeMs - expected) <= 1);
+    QCOMPARE(index.offsetAt(mid.timeMs + 1), mid.offset);
+}
+
+void TestNmeaLogIndex::untimedLogGetsSyntheticEntries()
+{
+    QList<QByteArray> lines;
+    for (int i = 0; i < 50000; ++i) {
+        lines.append(kFiller);
+    }
+    const QString path = m_dir.filePath("untimed.nmea");
+    QVERIFY(writeLog(path, lines));
+
+    IndexerWorker worker;
+    worker.filePath = path;
+    worker.process();
+
+    const NmeaLogIndex &index = worker.index;
+    const qint64 filler = kFiller.size() + 2;
+    QVERIFY(index.untimed);
+    QCOMPARE(index.lineCount, qint64(50000));
+    QVERIFY(index.entries.size() >= 3);
+    QCOMPARE(index.entries.first().timeMs, qint64(0));
+    QCOMPARE(index.entries.first().offset, qint64(0));
+
+    // Waktu sintetis = nomor baris * UntimedLineMs, sama dengan jarak replay
+    for (const NmeaLogIndexEntry &e : index.entries) {
+        QCOMPARE(e.offset % filler, qint64(0));
+        QCOMPARE(e.timeMs, (e.offset / filler) * NmeaLogIndex::UntimedLineMs);
+    }
+}
+
+void TestNmeaLogIndex::sidecarRoundTripAndInvalidation()
+{
+    const QString path = m_dir.filePath("sidecar.nmea");
+    QVERIFY(writeLog(path, { zdaLine(1), kFiller, zdaLine(2), zdaLine(3) }));
+
+    IndexerWorker scan;
+    scan.filePath = path;
+    scan.process();
+    QVERIFY(QFile::exists(NmeaLogIndex::sidecarPath(path)));
+
+    NmeaLogIndex loaded;
+    QVERIFY(loaded.load(path));
+    QCOMPARE(loaded.entries.size(), scan.index.entries.size());
+    for (int i = 0; i < loaded.entries.size(); ++i) {
+        QCOMPARE(loaded.entries.at(i).timeMs, scan.index.entries.at(i).timeMs);
+        QCOMPARE(loaded.entries.at(i).offset, scan.index.entries.at(i).offset);
+    }
+    QCOMPARE(loaded.lineCount, scan.index.lineCount);
+    QCOMPARE(loaded.fileSize, QFileInfo(path).size());
+
+    // Sidecar dipakai tanpa scan ulang: progress langsung 100
+    QList<int> progress;
+    IndexerWorker cached;
+    cached.filePath = path;
+    cached.onProgress = [&progress](int percent) { progress.append(percent); };
+    cached.process();
+    QCOMPARE(progress, QList<int>({ 100 }));
+    QCOMPARE(cached.index.entries.size(), scan.index.entries.size());
+
+    // Log bertambah: sidecar basi dan tidak boleh dipakai
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::Append));
+        file.write(zdaLine(4) + "\r\n");
+    }
+    NmeaLogIndex stale;
+    QVERIFY(!stale.load(path));
+}
+
+void TestNmeaLogIndex::stopFlagCancels()
+{
+    QList<QByteArray> lines;
+    for (int i = 0; i < 10000; ++i) {
+        lines.append(zdaLine(i));
+    }
+    const QString path = m_dir.filePath("cancel.nmea");
+    QVERIFY(writeLog(path, lines));
+
+    std::atomic<bool> stop(true);
+    bool finished = false;
+    IndexerWorker worker;
+    worker.filePath = path;
+    worker.stopFlag = &stop;
+    worker.onFinished = [&finished](const QList<qint64> &) { finished = true; };
+    worker.process();
+
+    QVERIFY(!finished);
+    QVERIFY(!QFile::exists(NmeaLogIndex::sidecarPath(path)));
+}
+
+QTEST_APPLESS_MAIN(TestNmeaLogIndex)
+#include "test_nmealogindex.moc"
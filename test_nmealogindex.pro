@@ -0,0 +1,14 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_nmealogindex
+
+SOURCES += \
+    test_nmealogindex.cpp \
+    IndexerWorker.cpp
+
+HEADERS += \
+    IndexerWorker.h
@@ -0,0 +1,164 @@
+// Unit test SpscRing: urutan FIFO, ring penuh (drop), wraparound index dan dua thread.
+
+#include <QtTest>
+#include <atomic>
+#include <thread>
+#include "spscring.h"
+
+class TestSpscRing : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fifoOrder();
+    void overflowDropsNewest();
+    void wrapAround();
+    void inPlacePushAndPeek();
+    void statsAndReset();
+    void twoThreads();
+};
+
+void TestSpscRing::fifoOrder()
+{
+    SpscRing<int, 8> ring;
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(ring.tryPush(i));
+    }
+    QCOMPARE(ring.depth(), quint32(5));
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(ring.tryPop(value));
+        QCOMPARE(value, i);
+    }
+    QVERIFY(!ring.tryPop(value));
+    QCOMPARE(ring.depth(), quint32(0));
+}
+
+void TestSpscRing::overflowDropsNewest()
+{
+    SpscRing<int, 4> ring;
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(ring.tryPush(i));
+    }
+    QVERIFY(!ring.tryPush(100));
+    QVERIFY(!ring.tryPush(101));
+    QVERIFY(ring.beginPush() == nullptr);
+    QCOMPARE(ring.stats().drops, quint64(3));
+    QCOMPARE(ring.depth(), quint32(4));
+
+    // Record yang sudah ada tidak tertimpa
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(ring.tryPop(value));
+        QCOMPARE(value, i);
+    }
+
+    // Setelah kosong ring bisa dipakai lagi
+    QVERIFY(ring.tryPush(7));
+    QVERIFY(ring.tryPop(value));
+    QCOMPARE(value, 7);
+}
+
+void TestSpscRing::wrapAround()
+{
+    // Index melewati Capacity berkali-kali dengan ring hampir penuh
+    SpscRing<int, 4> ring;
+    int next = 0;
+    int expected = 0;
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(ring.tryPush(next++));
+    }
+    for (int round = 0; round < 1000; ++round) {
+        QVERIFY(ring.tryPush(next++));
+        QVERIFY(!ring.tryPush(-1));
+        int value = -1;
+        QVERIFY(ring.tryPop(value));
+        QCOMPARE(value, expected++);
+        QCOMPARE(ring.depth(), quint32(3));
+    }
+
+    int value = -1;
+    while (ring.tryPop(value)) {
+        QCOMPARE(value, expected++);
+    }
+    QCOMPARE(expected, next);
+    QCOMPARE(ring.stats().drops, quint64(1000));
+}
+
+void TestSpscRing::inPlacePushAndPeek()
+{
+    SpscRing<int, 2> ring;
+    for (int round = 0; round < 5; ++round) {
+        int *slot = ring.beginPush();
+        QVERIFY(slot != nullptr);
+        *slot = round * 10;
+        ring.commitPush();
+
+        const int *front = ring.front();
+        QVERIFY(front != nullptr);
+        QCOMPARE(*front, round * 10);
+        ring.release();
+        QVERIFY(ring.front() == nullptr);
+    }
+    QCOMPARE(ring.stats().pushed, quint64(5));
+    QCOMPARE(ring.stats().popped, quint64(5));
+}
+
+void TestSpscRing::statsAndReset()
+{
+    SpscRing<int, 8> ring;
+    for (int i = 0; i < 6; ++i) {
+        ring.tryPush(i);
+    }
+    int value = 0;
+    ring.tryPop(value);
+    ring.tryPop(value);
+
+    SpscRing<int, 8>::Stats s = ring.stats();
+    QCOMPARE(s.depth, quint32(4));
+    QCOMPARE(s.highWater, quint32(6));
+    QCOMPARE(s.pushed, quint64(6));
+    QCOMPARE(s.popped, quint64(2));
+    QCOMPARE(s.drops, quint64(0));
+
+    // highWater mulai lagi dari kedalaman saat ini
+    ring.resetStats();
+    s = ring.stats();
+    QCOMPARE(s.highWater, quint32(4));
+    QCOMPARE(s.pushed, quint64(0));
+    QCOMPARE(s.popped, quint64(0));
+}
+
+void TestSpscRing::twoThreads()
+{
+    const int count = 200000;
+    SpscRing<int, 64> ring;
+    std::atomic<bool> ordered{true};
+    int received = 0;
+
+    std::thread consumer([&] {
+        int value = -1;
+        while (received < count) {
+            if (!ring.tryPop(value))
+                continue;
+            if (value != received)
+                ordered = false;
+            ++received;
+        }
+    });
+
+    for (int i = 0; i < count;) {
+        if (ring.tryPush(i))
+            ++i;
+    }
+    consumer.join();
+
+    QVERIFY(ordered);
+    QCOMPARE(received, count);
+    QCOMPARE(ring.stats().pushed, quint64(count));
+    QCOMPARE(ring.stats().popped, quint64(count));
+}
+
+QTEST_APPLESS_MAIN(TestSpscRing)
+#include "test_spscring.moc"
@@ -0,0 +1,183 @@
+// Unit test TimingWheel: jatuh tempo tepat di tiap level, cascade, deadline di luar
+// jangkauan wheel, jam mundur dan lompatan jam besar.
+
+#include <QtTest>
+#include <QVector>
+#include "timingwheel.h"
+
+class TestTimingWheel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void firesAtDeadline();
+    void rescheduleAndCancel();
+    void pastDeadlineFiresNextAdvance();
+    void cascadesAcrossLevels();
+    void beyondRangeIsParked();
+    void clockGoesBackwards();
+    void largeJumpRebuilds();
+    void roundsDeadlineUpToTick();
+    void reusesFreedNodes();
+};
+
+void TestTimingWheel::firesAtDeadline()
+{
+    TimingWheel wheel(1);
+    QVector<quint64> due;
+    wheel.schedule(7, 10);
+
+    QCOMPARE(wheel.advance(9, due), 0);
+    QVERIFY(wheel.isScheduled(7));
+    QCOMPARE(wheel.advance(10, due), 1);
+    QCOMPARE(due, QVector<quint64>({ 7 }));
+    QVERIFY(!wheel.isScheduled(7));
+    QVERIFY(wheel.isEmpty());
+}
+
+void TestTimingWheel::rescheduleAndCancel()
+{
+    TimingWheel wheel(1);
+    QVector<quint64> due;
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 10);
+    wheel.schedule(1, 500);     // dipindah, bukan diduplikasi
+    QCOMPARE(wheel.size(), 2);
+
+    QVERIFY(wheel.cancel(2));
+    QVERIFY(!wheel.cancel(2));
+    QCOMPARE(wheel.advance(10, due), 0);
+
+    QCOMPARE(wheel.advance(499, due), 0);
+    QCOMPARE(wheel.advance(500, due), 1);
+    QCOMPARE(due, QVector<quint64>({ 1 }));
+}
+
+void TestTimingWheel::pastDeadlineFiresNextAdvance()
+{
+    TimingWheel wheel(1);
+    QVector<quint64> due;
+    QCOMPARE(wheel.advance(100, due), 0);
+
+    wheel.schedule(3, 50);
+    QCOMPARE(wheel.advance(101, due), 1);
+    QCOMPARE(due, QVector<quint64>({ 3 }));
+}
+
+void TestTimingWheel::cascadesAcrossLevels()
+{
+    // Deadline tepat di dan sekitar batas slot tiap level
+    const QVector<qint64> deadlines = { 1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145, 300000 };
+    TimingWheel wheel(1);
+    for (int i = 0; i < deadlines.size(); ++i) {
+        wheel.schedule(quint64(i), deadlines.at(i));
+    }
+
+    QVector<qint64> firedAt(deadlines.size(), -1);
+    QVector<quint64> due;
+    for (qint64 now = 1; now <= 300000; ++now) {
+        due.clear();
+        wheel.advance(now, due);
+        for (quint64 key : due) {
+            QCOMPARE(firedAt.at(int(key)), qint64(-1));
+            firedAt[int(key)] = now;
+        }
+    }
+
+    for (int i = 0; i < deadlines.size(); ++i) {
+        QCOMPARE(firedAt.at(i), deadlines.at(i));
+    }
+    QVERIFY(wheel.isEmpty());
+}
+
+void TestTimingWheel::beyondRangeIsParked()
+{
+    // 4 level x 6 bit = 2^24 tick; deadline lebih jauh diparkir lalu di-cascade ulang
+    const qint64 deadline = (qint64(1) << 24) + 1000;
+    TimingWheel wheel(1);
+    wheel.schedule(9, deadline);
+
+    QVector<quint64> due;
+    qint64 now = 0;
+    while (now + 4096 < deadline - 64) {
+        now += 4096;
+        QCOMPARE(wheel.advance(now, due), 0);
+    }
+    while (now < deadline - 1) {
+        QCOMPARE(wheel.advance(++now, due), 0);
+    }
+    QCOMPARE(wheel.advance(deadline, due), 1);
+    QCOMPARE(due, QVector<quint64>({ 9 }));
+}
+
+void TestTimingWheel::clockGoesBackwards()
+{
+    TimingWheel wheel(1);
+    QVector<quint64> due;
+    wheel.schedule(4, 1000);
+    wheel.schedule(5, 200);
+
+    QCOMPARE(wheel.advance(500, due), 1);
+    QCOMPARE(due, QVector<quint64>({ 5 }));
+
+    // Seek mundur: yang belum jatuh tempo tetap di wheel dan jatuh tempo di waktu yang sama
+    due.clear();
+    QCOMPARE(wheel.advance(100, due), 0);
+    wheel.schedule(6, 150);
+    QCOMPARE(wheel.advance(150, due), 1);
+    QCOMPARE(due, QVector<quint64>({ 6 }));
+    QCOMPARE(wheel.advance(999, due), 0);
+    QCOMPARE(wheel.advance(1000, due), 1);
+    QCOMPARE(due.last(), quint64(4));
+}
+
+void TestTimingWheel::largeJumpRebuilds()
+{
+    TimingWheel wheel(1);
+    QVector<quint64> due;
+    for (quint64 key = 0; key < 100; ++key) {
+        wheel.schedule(key, qint64(key) * 1000 + 1);
+    }
+
+    // Lompatan > 4096 tick: semua yang lewat dilepas sekaligus, sisanya tetap tepat waktu
+    QCOMPARE(wheel.advance(50000, due), 50);
+    QCOMPARE(wheel.size(), 50);
+    due.clear();
+    QCOMPARE(wheel.advance(50000, due), 0);
+    QCOMPARE(wheel.advance(50001, due), 1);
+    QCOMPARE(due, QVector<quint64>({ 50 }));
+}
+
+void TestTimingWheel::roundsDeadlineUpToTick()
+{
+    // Deadline dibulatkan ke atas: tidak pernah jatuh tempo sebelum waktunya
+    TimingWheel wheel(250);
+    QVector<quint64> due;
+    wheel.schedule(1, 1001);
+
+    QCOMPARE(wheel.advance(1000, due), 0);
+    QCOMPARE(wheel.advance(1249, due), 0);
+    QCOMPARE(wheel.advance(1250, due), 1);
+}
+
+void TestTimingWheel::reusesFreedNodes()
+{
+    TimingWheel wheel(1);
+    QVector<quint64> due;
+    for (int round = 0; round < 10; ++round) {
+        for (quint64 key = 0; key < 32; ++key) {
+            wheel.schedule(key, round * 100 + 50 + qint64(key));
+        }
+        QCOMPARE(wheel.advance(round * 100 + 99, due), 32);
+        QVERIFY(wheel.isEmpty());
+    }
+    QCOMPARE(due.size(), 320);
+
+    wheel.schedule(1, 5000);
+    wheel.clear();
+    QVERIFY(wheel.isEmpty());
+    QVERIFY(!wheel.isScheduled(1));
+}
+
+QTEST_APPLESS_MAIN(TestTimingWheel)
+#include "test_timingwheel.moc"
@@ -0,0 +1,14 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_timingwheel
+
+SOURCES += \
+    test_timingwheel.cpp \
+    timingwheel.cpp
+
+HEADERS += \
+    timingwheel.h
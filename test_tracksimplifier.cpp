@@ -0,0 +1,188 @@
+// Unit test TrackSimplifier: level toleransi, garis lurus, track bolak-balik dan
+// batas error (setiap titik yang dibuang tetap dalam toleransi dari hasil).
+
+#include <QtTest>
+#include <QVector>
+#include <cmath>
+#include "tracksimplifier.h"
+
+namespace {
+
+const double kMetersPerDegLat = 110574.0;
+const double kMetersPerDegLon = 111320.0;
+
+TrackPoint point(qint64 timeMs, double lat, double lon)
+{
+    TrackPoint p;
+    p.timeMs = timeMs;
+    p.lat = lat;
+    p.lon = lon;
+    return p;
+}
+
+// Jarak (meter) titik p ke segmen a-b, proyeksi lokal yang sama dengan TrackSimplifier
+double segmentDistance(const TrackPoint &origin, const TrackPoint &p, const TrackPoint &a, const TrackPoint &b)
+{
+    const double kx = kMetersPerDegLon * std::cos(origin.lat * M_PI / 180.0);
+    const double ax = (a.lon - origin.lon) * kx, ay = (a.lat - origin.lat) * kMetersPerDegLat;
+    const double bx = (b.lon - origin.lon) * kx, by = (b.lat - origin.lat) * kMetersPerDegLat;
+    const double px = (p.lon - origin.lon) * kx, py = (p.lat - origin.lat) * kMetersPerDegLat;
+
+    const double dx = bx - ax, dy = by - ay;
+    const double len2 = dx * dx + dy * dy;
+    double t = len2 > 0.0 ? ((px - ax) * dx + (py - ay) * dy) / len2 : 0.0;
+    t = qBound(0.0, t, 1.0);
+    return std::hypot(px - ax - t * dx, py - ay - t * dy);
+}
+
+// Titik yang dibuang harus dekat dengan segmen hasil yang mengapitnya (berdasarkan waktu)
+bool withinTolerance(const QVector<TrackPoint> &input, const QVector<TrackPoint> &output, double tolerance)
+{
+    int segment = 0;
+    for (const TrackPoint &p : input) {
+        while (segment + 1 < output.size() - 1 && output.at(segment + 1).timeMs <= p.timeMs) {
+            ++segment;
+        }
+        const double d = segmentDistance(input.first(), p, output.at(segment), output.at(segment + 1));
+        if (d > tolerance + 1e-6)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+class TestTrackSimplifier : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void metersPerPixel();
+    void toleranceLevels();
+    void shortOrZeroToleranceUnchanged();
+    void straightLineCollapses();
+    void spikeKept();
+    void backtrackKept();
+    void errorBoundOnLongTrack();
+};
+
+void TestTrackSimplifier::metersPerPixel()
+{
+    QCOMPARE(TrackSimplifier::metersPerPixel(10000), 2.8);
+    QVERIFY(TrackSimplifier::metersPerPixel(0) > 0.0);
+}
+
+void TestTrackSimplifier::toleranceLevels()
+{
+    QCOMPARE(TrackSimplifier::toleranceLevel(1.0), 0);
+    QCOMPARE(TrackSimplifier::toleranceLevel(1.99), 0);
+    QCOMPARE(TrackSimplifier::toleranceLevel(2.0), 1);
+    QCOMPARE(TrackSimplifier::toleranceLevel(100.0), 6);
+
+    // Di luar jangkauan dijepit, nilai tidak valid jadi level terhalus
+    QCOMPARE(TrackSimplifier::toleranceLevel(0.01), -2);
+    QCOMPARE(TrackSimplifier::toleranceLevel(0.0), -2);
+    QCOMPARE(TrackSimplifier::toleranceLevel(-5.0), -2);
+    QCOMPARE(TrackSimplifier::toleranceLevel(std::nan("")), -2);
+    QCOMPARE(TrackSimplifier::toleranceLevel(1e9), 16);
+
+    // Level tidak pernah lebih kasar dari toleransi yang diminta
+    for (double tolerance = 0.25; tolerance < 60000.0; tolerance *= 1.37) {
+        const double rounded = TrackSimplifier::levelTolerance(TrackSimplifier::toleranceLevel(tolerance));
+        QVERIFY(rounded <= tolerance);
+        QVERIFY(rounded * 2.0 > tolerance);
+    }
+}
+
+void TestTrackSimplifier::shortOrZeroToleranceUnchanged()
+{
+    const QVector<TrackPoint> two = { point(0, -6.0, 106.0), point(1000, -6.1, 106.1) };
+    QCOMPARE(TrackSimplifier::simplify(two, 100.0).size(), 2);
+
+    QVector<TrackPoint> wiggly;
+    for (int i = 0; i < 10; ++i) {
+        wiggly.append(point(i * 1000, -6.0 + (i % 2) * 1e-7, 106.0 + i * 1e-4));
+    }
+    QCOMPARE(TrackSimplifier::simplify(wiggly, 0.0).size(), wiggly.size());
+    QCOMPARE(TrackSimplifier::simplify(QVector<TrackPoint>(), 10.0).size(), 0);
+}
+
+void TestTrackSimplifier::straightLineCollapses()
+{
+    QVector<TrackPoint> line;
+    for (int i = 0; i <= 100; ++i) {
+        line.append(point(i * 1000, -6.0 + i * 1e-4, 106.0 + i * 2e-4));
+    }
+
+    const QVector<TrackPoint> out = TrackSimplifier::simplify(line, 1.0);
+    QCOMPARE(out.size(), 2);
+    QCOMPARE(out.first().timeMs, line.first().timeMs);
+    QCOMPARE(out.last().timeMs, line.last().timeMs);
+}
+
+void TestTrackSimplifier::spikeKept()
+{
+    // Penyimpangan ~111 m di tengah garis lurus: hilang di toleransi 200 m, tetap di 50 m
+    QVector<TrackPoint> track;
+    for (int i = 0; i <= 20; ++i) {
+        track.append(point(i * 1000, -6.0 + (i == 10 ? 0.001 : 0.0), 106.0 + i * 1e-3));
+    }
+
+    QCOMPARE(TrackSimplifier::simplify(track, 200.0).size(), 2);
+
+    const QVector<TrackPoint> out = TrackSimplifier::simplify(track, 50.0);
+    bool spike = false;
+    for (const TrackPoint &p : out) {
+        spike = spike || p.timeMs == 10000;
+    }
+    QVERIFY(spike);
+}
+
+void TestTrackSimplifier::backtrackKept()
+{
+    // Kapal maju 2.2 km lalu kembali 1.1 km di garis yang sama: titik balik berjarak 0
+    // dari garis, tapi 1.1 km dari segmen awal-akhir
+    const QVector<TrackPoint> track = {
+        point(0, -6.0, 106.0),
+        point(1000, -5.98, 106.0),
+        point(2000, -5.99, 106.0)
+    };
+    const QVector<TrackPoint> out = TrackSimplifier::simplify(track, 10.0);
+    QCOMPARE(out.size(), 3);
+
+    // Track yang kembali ke titik awal (segmen panjang 0) juga
+    const QVector<TrackPoint> loop = {
+        point(0, -6.0, 106.0),
+        point(1000, -5.99, 106.01),
+        point(2000, -6.0, 106.0)
+    };
+    QCOMPARE(TrackSimplifier::simplify(loop, 10.0).size(), 3);
+}
+
+void TestTrackSimplifier::errorBoundOnLongTrack()
+{
+    // 24 jam fix tiap 2 detik: kelokan halus plus noise GPS deterministik
+    QVector<TrackPoint> track;
+    quint32 seed = 7;
+    for (int i = 0; i < 43200; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        const double noise = (int((seed >> 16) & 0xFF) - 128) * 2e-8;
+        const double s = i * 2e-5;
+        track.append(point(qint64(i) * 2000, -6.0 + 0.05 * std::sin(s) + noise, 106.0 + s * 0.1 + noise));
+    }
+
+    for (double tolerance : { 1.0, 8.0, 64.0, 512.0 }) {
+        const QVector<TrackPoint> out = TrackSimplifier::simplify(track, tolerance);
+        QVERIFY(out.size() >= 2);
+        QVERIFY(out.size() < track.size());
+        QCOMPARE(out.first().timeMs, track.first().timeMs);
+        QCOMPARE(out.last().timeMs, track.last().timeMs);
+        for (int i = 1; i < out.size(); ++i) {
+            QVERIFY(out.at(i).timeMs > out.at(i - 1).timeMs);
+        }
+        QVERIFY(withinTolerance(track, out, tolerance));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestTrackSimplifier)
+#include "test_tracksimplifier.moc"
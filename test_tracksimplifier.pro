@@ -0,0 +1,14 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = test_tracksimplifier
+
+SOURCES += \
+    test_tracksimplifier.cpp \
+    tracksimplifier.cpp
+
+HEADERS += \
+    tracksimplifier.h
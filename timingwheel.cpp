@@ -0,0 +1,192 @@
+#include "timingwheel.h"
+
+namespace {
+
+// Lompatan jam lebih dari ini (mis. pertama kali jalan, atau sistem sleep)
+// lebih murah dibangun ulang daripada diputar tick per tick
+const qint64 kMaxStepTicks = 4096;
+
+} // namespace
+
+TimingWheel::TimingWheel(qint64 tickMs)
+    : m_tickMs(tickMs > 0 ? tickMs : 1)
+{
+    clear();
+}
+
+void TimingWheel::clear()
+{
+    m_nodes.clear();
+    m_free.clear();
+    m_index.clear();
+    m_currentTick = 0;  // jam advance() berikutnya diterima apa adanya (rebuild)
+    for (int level = 0; level < Levels; ++level) {
+        for (int slot = 0; slot < Slots; ++slot) {
+            m_heads[level][slot] = -1;
+        }
+    }
+}
+
+void TimingWheel::link(qint32 n, qint64 earliestTick)
+{
+    Node &node = m_nodes[n];
+    qint64 tick = qMax(node.deadlineTick, earliestTick);
+    const qint64 delta = tick - m_currentTick;
+
+    int level = 0;
+    while (level < Levels - 1 && delta >= (qint64(1) << (SlotBits * (level + 1)))) {
+        ++level;
+    }
+
+    // Di luar jangkauan: parkir di slot terjauh level teratas
+    const qint64 range = qint64(1) << (SlotBits * Levels);
+    if (delta >= range) {
+        tick = m_currentTick + range - 1;
+    }
+
+    node.level = qint16(level);
+    node.slot = qint16((tick >> (SlotBits * level)) & SlotMask);
+    node.prev = -1;
+    node.next = m_heads[level][node.slot];
+    if (node.next >= 0) {
+        m_nodes[node.next].prev = n;
+    }
+    m_heads[level][node.slot] = n;
+}
+
+void TimingWheel::unlink(qint32 n)
+{
+    Node &node = m_nodes[n];
+    if (node.prev >= 0) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        m_heads[node.level][node.slot] = node.next;
+    }
+    if (node.next >= 0) {
+        m_nodes[node.next].prev = node.prev;
+    }
+    node.prev = node.next = -1;
+}
+
+void TimingWheel::release(qint32 n)
+{
+    m_index.remove(m_nodes[n].key);
+    m_nodes[n].slot = -1;
+    m_free.append(n);
+}
+
+void TimingWheel::schedule(quint64 key, qint64 deadlineMs)
+{
+    qint32 n = m_index.value(key, -1);
+    if (n >= 0) {
+        unlink(n);
+    } else {
+        if (!m_free.isEmpty()) {
+            n = m_free.takeLast();
+        } else {
+            n = m_nodes.size();
+            m_nodes.append(Node());
+        }
+        m_nodes[n].key = key;
+        m_index.insert(key, n);
+    }
+
+    // Deadline yang sudah lewat ikut advance() berikutnya
+    m_nodes[n].deadlineTick = toTick(deadlineMs);
+    link(n, m_currentTick + 1);
+}
+
+bool TimingWheel::cancel(quint64 key)
+{
+    const qint32 n = m_index.value(key, -1);
+    if (n < 0)
+        return false;
+    unlink(n);
+    release(n);
+    return true;
+}
+
+void TimingWheel::cascade(int level)
+{
+    const int slot = int((m_currentTick >> (SlotBits * level)) & SlotMask);
+    qint32 n = m_heads[level][slot];
+    m_heads[level][slot] = -1;
+
+    while (n >= 0) {
+        const qint32 next = m_nodes[n].next;
+        // Boleh jatuh ke slot tick sekarang: collect() jalan sesudah cascade
+        link(n, m_currentTick);
+        n = next;
+    }
+}
+
+void TimingWheel::collect(int slot, QVector<quint64> &due)
+{
+    qint32 n = m_heads[0][slot];
+    m_heads[0][slot] = -1;
+
+    while (n >= 0) {
+        const qint32 next = m_nodes[n].next;
+        if (m_nodes[n].deadlineTick <= m_currentTick) {
+            due.append(m_nodes[n].key);
+            release(n);
+        } else {
+            link(n, m_currentTick + 1);
+        }
+        n = next;
+    }
+}
+
+void TimingWheel::rebuild(qint64 nowTick, QVector<quint64> &due)
+{
+    m_currentTick = nowTick;
+    for (int level = 0; level < Levels; ++level) {
+        for (int slot = 0; slot < Slots; ++slot) {
+            m_heads[level][slot] = -1;
+        }
+    }
+
+    for (qint32 n = 0; n < m_nodes.size(); ++n) {
+        if (m_nodes[n].slot < 0)
+            continue;
+        if (m_nodes[n].deadlineTick <= nowTick) {
+            due.append(m_nodes[n].key);
+            release(n);
+        } else {
+            link(n, m_currentTick + 1);
+        }
+    }
+}
+
+int TimingWheel::advance(qint64 nowMs, QVector<quint64> &due)
+{
+    const int before = due.size();
+    const qint64 nowTick = nowMs / m_tickMs;
+
+    if (nowTick == m_currentTick)
+        return 0;
+
+    // Jam mundur (seek replay ke belakang) atau lompat jauh: susun ulang dari deadline
+    if (nowTick < m_currentTick || nowTick - m_currentTick > kMaxStepTicks) {
+        rebuild(nowTick, due);
+        return due.size() - before;
+    }
+
+    while (m_currentTick < nowTick) {
+        ++m_currentTick;
+
+        // Turunkan level atas setiap kali level di bawahnya berputar penuh.
+        // Dari atas ke bawah, supaya entry yang turun dua level ikut ter-cascade.
+        int top = 0;
+        while (top < Levels - 1 && (m_currentTick & ((qint64(1) << (SlotBits * (top + 1))) - 1)) == 0) {
+            ++top;
+        }
+        for (int level = top; level >= 1; --level) {
+            cascade(level);
+        }
+
+        collect(int(m_currentTick & SlotMask), due);
+    }
+
+    return due.size() - before;
+}
@@ -0,0 +1,67 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QHash>
+
+// Hierarchical timing wheel (4 level x 64 slot) untuk deadline per key.
+// schedule() dan cancel() O(1): node dipindah antar list slot tanpa menyapu
+// semua entry. advance() hanya menyentuh slot yang dilewati jam; entry di level
+// atas turun (cascade) ke level bawah saat jam melewati batas slotnya.
+// Deadline di luar jangkauan wheel disimpan di slot terjauh lalu di-cascade ulang.
+class TimingWheel {
+public:
+    explicit TimingWheel(qint64 tickMs = 250);
+
+    // Pasang atau pindahkan deadline key (ms, clock yang sama dengan advance())
+    void schedule(quint64 key, qint64 deadlineMs);
+    bool cancel(quint64 key);
+
+    bool isScheduled(quint64 key) const { return m_index.contains(key); }
+    int size() const { return m_index.size(); }
+    bool isEmpty() const { return m_index.isEmpty(); }
+
+    // Majukan jam ke nowMs. Key yang jatuh tempo dilepas dari wheel dan
+    // ditambahkan ke 'due'; return jumlahnya. Jam yang mundur menyusun ulang wheel
+    // dari deadline yang tersimpan (jam replay boleh di-seek ke belakang).
+    int advance(qint64 nowMs, QVector<quint64> &due);
+
+    void clear();
+
+private:
+    enum {
+        Levels = 4,
+        SlotBits = 6,
+        Slots = 1 << SlotBits,
+        SlotMask = Slots - 1
+    };
+
+    struct Node {
+        quint64 key;
+        qint64 deadlineTick;
+        qint32 prev;
+        qint32 next;
+        qint16 level;
+        qint16 slot;    // -1 = node bebas
+    };
+
+    qint64 toTick(qint64 ms) const { return (ms + m_tickMs - 1) / m_tickMs; }
+
+    void link(qint32 n, qint64 earliestTick);
+    void unlink(qint32 n);
+    void release(qint32 n);
+    void cascade(int level);
+    void collect(int slot, QVector<quint64> &due);
+    void rebuild(qint64 nowTick, QVector<quint64> &due);
+
+    QVector<Node> m_nodes;
+    QVector<qint32> m_free;
+    QHash<quint64, qint32> m_index;
+    qint32 m_heads[Levels][Slots];
+
+    qint64 m_tickMs;
+    qint64 m_currentTick = 0;
+};
+
+#endif // TIMINGWHEEL_H
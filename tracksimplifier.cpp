@@ -0,0 +1,99 @@
+#include "tracksimplifier.h"
+
+#include <QPair>
+#include <cmath>
+
+namespace {
+
+const double kScreenPixelMeters = 0.28e-3;
+const double kMetersPerDegLat = 110574.0;
+const double kMetersPerDegLon = 111320.0;
+const int kMinLevel = -2;       // 0.25 m
+const int kMaxLevel = 16;       // ~65 km
+
+} // namespace
+
+double TrackSimplifier::metersPerPixel(int scale)
+{
+    return qMax(1, scale) * kScreenPixelMeters;
+}
+
+int TrackSimplifier::toleranceLevel(double toleranceMeters)
+{
+    if (!(toleranceMeters > 0))
+        return kMinLevel;
+    // Dibulatkan ke bawah: hasil tidak pernah lebih kasar dari yang diminta
+    return qBound(kMinLevel, int(std::floor(std::log2(toleranceMeters))), kMaxLevel);
+}
+
+double TrackSimplifier::levelTolerance(int level)
+{
+    return std::ldexp(1.0, level);
+}
+
+QVector<TrackPoint> TrackSimplifier::simplify(const QVector<TrackPoint> &points, double toleranceMeters)
+{
+    const int n = points.size();
+    if (n <= 2 || !(toleranceMeters > 0))
+        return points;
+
+    const double kx = kMetersPerDegLon * std::cos(points.first().lat * M_PI / 180.0);
+    const double ky = kMetersPerDegLat;
+    QVector<double> xs(n), ys(n);
+    for (int i = 0; i < n; ++i) {
+        xs[i] = (points[i].lon - points.first().lon) * kx;
+        ys[i] = (points[i].lat - points.first().lat) * ky;
+    }
+
+    const double tol2 = toleranceMeters * toleranceMeters;
+    QVector<char> keep(n, 0);
+    keep[0] = 1;
+    keep[n - 1] = 1;
+
+    // Iteratif: track 24 jam bisa puluhan ribu titik, rekursi terlalu dalam
+    QVector<QPair<int, int>> stack;
+    stack.append(qMakePair(0, n - 1));
+    while (!stack.isEmpty()) {
+        const QPair<int, int> segment = stack.takeLast();
+        const int a = segment.first;
+        const int b = segment.second;
+        if (b - a < 2)
+            continue;
+
+        const double dx = xs[b] - xs[a];
+        const double dy = ys[b] - ys[a];
+        const double len2 = dx * dx + dy * dy;
+
+        double worst = -1.0;
+        int worstIndex = -1;
+        for (int i = a + 1; i < b; ++i) {
+            double px = xs[i] - xs[a];
+            double py = ys[i] - ys[a];
+            if (len2 > 0.0) {
+                const double t = qBound(0.0, (px * dx + py * dy) / len2, 1.0);
+                px -= t * dx;
+                py -= t * dy;
+            }
+            const double d2 = px * px + py * py;
+            if (d2 > worst) {
+                worst = d2;
+                worstIndex = i;
+            }
+        }
+
+        if (worst > tol2) {
+            keep[worstIndex] = 1;
+            stack.append(qMakePair(a, worstIndex));
+            stack.append(qMakePair(worstIndex, b));
+        }
+    }
+
+    QVector<TrackPoint> out;
+    out.reserve(n / 4 + 2);
+    for (int i = 0; i < n; ++i) {
+        if (keep[i]) {
+            out.append(points[i]);
+        }
+    }
+    return out;
+}
@@ -0,0 +1,31 @@
+#ifndef TRACKSIMPLIFIER_H
+#define TRACKSIMPLIFIER_H
+
+#include <QtGlobal>
+#include <QVector>
+
+// Satu titik track historis (waktu UTC ms, derajat)
+struct TrackPoint {
+    qint64 timeMs;
+    double lat;
+    double lon;
+};
+
+// Douglas-Peucker dengan toleransi dalam meter.
+// Titik diproyeksikan ke bidang lokal (equirectangular di lintang titik pertama), cukup akurat
+// untuk satu track kapal; jarak diukur ke segmen, bukan garis, supaya track bolak-balik aman.
+class TrackSimplifier
+{
+public:
+    // Skala chart 1:scale -> meter per pixel layar (pixel standar ECDIS 0.28 mm)
+    static double metersPerPixel(int scale);
+
+    // Toleransi dibulatkan ke level pangkat dua (meter) supaya cache multi-resolusi
+    // hanya menyimpan sedikit varian per track
+    static int toleranceLevel(double toleranceMeters);
+    static double levelTolerance(int level);
+
+    static QVector<TrackPoint> simplify(const QVector<TrackPoint> &points, double toleranceMeters);
+};
+
+#endif // TRACKSIMPLIFIER_H